@@ -63,12 +63,15 @@ public:
 
   size_t getMaxSize() const;
 
+  ReferenceSample::StorageMode getStorageMode() const;
+
 private:
-  boost::filesystem::path  m_reference_sample_out;
-  std::vector<std::string> m_phosphoros_catalog;
-  std::string              m_catalog_format;
-  bool                     m_overwrite;
-  size_t                   m_max_size;
+  boost::filesystem::path      m_reference_sample_out;
+  std::vector<std::string>     m_phosphoros_catalog;
+  std::string                  m_catalog_format;
+  bool                         m_overwrite;
+  size_t                       m_max_size;
+  ReferenceSample::StorageMode m_storage_mode;
 };  // End of BuildReferenceSampleConfig class
 
 }  // namespace PhzConfiguration
@@ -0,0 +1,63 @@
+/**
+ * Copyright (C) 2022 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file PhzConfiguration/ComputeCombinedModelGridsConfig.h
+ * @date 2026/10/18
+ */
+
+#ifndef PHZCONFIGURATION_COMPUTECOMBINEDMODELGRIDSCONFIG_H
+#define PHZCONFIGURATION_COMPUTECOMBINEDMODELGRIDSCONFIG_H
+
+#include "Configuration/Configuration.h"
+
+namespace Euclid {
+namespace PhzConfiguration {
+
+/**
+ * @class ComputeCombinedModelGridsConfig
+ * @brief
+ * Umbrella configuration of the executable computing in a single pass the
+ * model grid, the filter variation coefficient grid and the galactic
+ * correction coefficient grid
+ */
+class ComputeCombinedModelGridsConfig : public Configuration::Configuration {
+
+public:
+  /**
+   * @brief Constructor
+   */
+  ComputeCombinedModelGridsConfig(long manager_id);
+
+  /**
+   * @brief Destructor
+   */
+  virtual ~ComputeCombinedModelGridsConfig() = default;
+
+  /**
+   * @brief ensure that the ModelGridOutputConfig default sub-dir is set to
+   * "ModelGrids", and that the model flux algorithm is INTERPOLATION, the
+   * only one the combined grids are computed with
+   */
+  void preInitialize(const UserValues& args) override;
+};
+
+}  // end of namespace PhzConfiguration
+}  // end of namespace Euclid
+
+#endif /* PHZCONFIGURATION_COMPUTECOMBINEDMODELGRIDSCONFIG_H */
@@ -38,7 +38,8 @@ namespace PhzConfiguration {
  * @brief
  * This class defines the model grid parameter option used by the ComputeModelGrid
  * executable. It is an umbrella class which mainly define dependencies to other
- * configurations.
+ * configurations. It also defines the "model-grid-memory-limit" option, limiting
+ * the parameter space regions built concurrently.
  */
 class ComputeModelGridConfig : public Configuration::Configuration {
 
@@ -53,12 +54,25 @@ public:
    */
   virtual ~ComputeModelGridConfig() = default;
 
+  std::map<std::string, OptionDescriptionList> getProgramOptions() override;
+
   /**
    * @brief ensure that the ModelGridOutputConfig default sub-dir is set to
-   * "ModelGrids"
+   * "ModelGrids" and that the memory limit is not negative
    */
   void preInitialize(const UserValues& args) override;
 
+  void initialize(const UserValues& args) override;
+
+  /**
+   * @brief Returns the maximum memory (in bytes) used by the parameter space
+   * regions which are built concurrently. Zero means no limit.
+   */
+  size_t getMemoryLimit() const;
+
+private:
+  size_t m_memory_limit = 0;
+
 }; /* End of ComputeModelGridConfig class */
 
 }  // end of namespace PhzConfiguration
@@ -26,11 +26,14 @@
 #define _PHZCONFIGURATION_COMPUTEPHOTOMETRICCORRECTIONSCONFIG_H
 
 #include <functional>
+#include <string>
 
+#include "AlexandriaKernel/ThreadPool.h"
 #include "Configuration/Configuration.h"
 #include "SourceCatalog/Catalog.h"
 
 #include "PhzDataModel/PhotometricCorrectionMap.h"
+#include "PhzPhotometricCorrection/BestFitModelCache.h"
 #include "PhzPhotometricCorrection/PhotometricCorrectionAlgorithm.h"
 #include "PhzPhotometricCorrection/PhotometricCorrectionCalculator.h"
 
@@ -76,6 +79,16 @@ public:
    * - phot-corr-selection-method : The method to select the photometric correction of each
    *                                filter from the optimal corrections of each source.
    *                                One of MEDIAN (default), WEIGHTED_MEDIAN, MEAN, WEIGHTED_MEAN
+   * - phot-corr-warm-start       : If the iterations after the first one fit the sources
+   *                                only in the neighbourhood of their previous best fitted
+   *                                model. One of YES, NO (default)
+   * - phot-corr-neighbourhood-ebv : The number of EBV axis knots at each side of the previous
+   *                                best fitted model to search (defaults to 2)
+   * - phot-corr-neighbourhood-reddening-curve : The number of reddening curve axis knots at
+   *                                each side of the previous best fitted model to search
+   *                                (defaults to 1)
+   * - phot-corr-neighbourhood-sed : The number of SED axis knots at each side of the previous
+   *                                best fitted model to search (defaults to 2)
    *
    * All options are in a group called "Compute Photometric Corrections options".
    *
@@ -83,7 +96,8 @@ public:
    */
   std::map<std::string, OptionDescriptionList> getProgramOptions() override;
 
-  /// Validates that the phot-corr-selection-method is one of the allowed values
+  /// Validates that the phot-corr-selection-method and phot-corr-warm-start are
+  /// one of the allowed values and that the neighbourhood sizes are positive
   void preInitialize(const UserValues& args) override;
 
   /**
@@ -118,10 +132,23 @@ public:
   /// optimal corrections of each source
   const PhotCorrSelectorType& getPhotometricCorrectionSelector();
 
+  /// Returns the method to use for selecting the photometric correction, which
+  /// computes the corrections of the filters in parallel using the given thread pool
+  PhotCorrSelectorType getPhotometricCorrectionSelector(ThreadPool& thread_pool);
+
+  /// Returns true if the iterations are warm started from the previous best fitted models
+  bool isWarmStartEnabled();
+
+  /// Returns the size of the neighbourhood searched around the previous best fitted models
+  const PhzPhotometricCorrection::BestFitModelCache::NeighbourhoodSize& getWarmStartNeighbourhoodSize();
+
 private:
   OutputFunction                                                                  m_output_function;
   PhzPhotometricCorrection::PhotometricCorrectionCalculator::StopCriteriaFunction m_stop_criteria;
+  std::string                                                                     m_phot_corr_method;
   PhotCorrSelectorType                                                            m_phot_corr_selector;
+  bool                                                                            m_warm_start{false};
+  PhzPhotometricCorrection::BestFitModelCache::NeighbourhoodSize                  m_neighbourhood_size{0, 0, 0};
 
 }; /* End of ComputePhotometricCorrectionsConfig class */
 
@@ -26,6 +26,7 @@
 #define PHZCONFIGURATION_COMPUTEREDSHIFTSCONFIG_H
 
 #include "Configuration/Configuration.h"
+#include "PhzConfiguration/ScaleFactorMarginalizationConfig.h"
 #include "PhzLikelihood/CatalogHandler.h"
 #include "PhzOutput/OutputHandler.h"
 #include <boost/filesystem/operations.hpp>
@@ -75,6 +76,20 @@ public:
   std::size_t getSkipFirstNumber() const;
   std::size_t getProcessMaxNumber() const;
 
+  /**
+   * @return
+   *  true if the likelihood and posterior outputs are sampled over the scale factor samples, false if they are
+   *  taken from the likelihood grids already marginalized over the scale factor, as with the analytic method
+   */
+  static bool useScaleSampledOutputs(const ScaleFactorMarginalizationConfig& scale_factor_config);
+
+  /**
+   * @brief Checks that the scale factor samples can be used by the sampled likelihood and posterior outputs
+   * @throw Elements::Exception
+   *  If the scale factor samples are the Gauss-Hermite nodes, as the outputs expect evenly spaced samples
+   */
+  static void checkScaleSampledOutputs(const ScaleFactorMarginalizationConfig& scale_factor_config);
+
 private:
   bool m_cat_flag = false;
 
@@ -85,6 +100,7 @@ private:
   boost::filesystem::path m_out_likelihood_dir;
   bool                    m_posterior_flag = false;
   boost::filesystem::path m_out_posterior_dir;
+  bool                    m_scale_sampled_outputs = false;
 
   std::size_t m_input_buffer_size = 5000;
   std::size_t m_input_skip_first  = 0;
@@ -55,6 +55,9 @@ public:
   const std::string& getOutputFile() const;
   int getWeightSampling() const;
 
+  /// Returns the seed of the weight sampling, which is negative for using a random seed
+  long getWeightSamplingSeed() const;
+
   /**
    * @brief Destructor
    */
@@ -63,6 +66,7 @@ public:
 private:
   std::string m_output_file;
   int m_sampling;
+  long m_seed;
 
 }; /* End of ComputeSedWeightConfig class */
 
@@ -30,6 +30,7 @@
 #include "PhzModeling/PhotometryGridCreator.h"
 #include <boost/filesystem/operations.hpp>
 #include <cstdlib>
+#include <map>
 #include <string>
 
 namespace Euclid {
@@ -93,8 +94,25 @@ public:
    */
   const OutputFunction& getOutputFunction();
 
+  /**
+   * @brief
+   * Returns the name of the file the grid is written to, which is the grid
+   * extended when building incrementally
+   */
+  const std::string& getOutputFilename() const;
+
+  /**
+   * @brief
+   * Returns the provenance record stored with the grid: the cosmology, the
+   * reference solar SED and the delta lambda sampling of the filter variation.
+   * An existing grid is extended only if it has the same.
+   */
+  const std::map<std::string, std::string>& getProvenance() const;
+
 private:
-  OutputFunction m_output_function;
+  OutputFunction                     m_output_function;
+  std::string                        m_filename;
+  std::map<std::string, std::string> m_provenance;
 };
 
 }  // end of namespace PhzConfiguration
@@ -26,15 +26,22 @@
 #define _PHZCONFIGURATION_GRIDFILEHELPER_H
 
 #include "GridContainer/serialize.h"
+#include "PhysicsUtils/CosmologicalParameters.h"
 #include "PhzConfiguration/IgmConfig.h"
+#include "PhzDataModel/ArchiveFormat.h"
 #include "PhzDataModel/PhotometryGrid.h"
 #include "PhzDataModel/serialization/PhotometryGridInfo.h"
+#include "PhzModeling/PhotometryGridCreator.h"
 #include "XYDataset/QualifiedName.h"
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/text_iarchive.hpp>
 #include <fstream>
 #include <map>
+#include <sstream>
 #include <string>
 #include <vector>
 
+#include "ElementsKernel/Exception.h"
 #include "ElementsKernel/Logging.h"
 
 namespace po = boost::program_options;
@@ -43,9 +50,35 @@ namespace fs = boost::filesystem;
 namespace Euclid {
 namespace PhzConfiguration {
 
+/**
+ * Returns the provenance record stored with the grids computed with the given
+ * cosmology and model flux algorithm, and normalized with the given solar SED.
+ * The grids depending on more parameters add their own entries to it.
+ */
+inline std::map<std::string, std::string>
+makeGridProvenance(const PhysicsUtils::CosmologicalParameters& cosmology, const XYDataset::QualifiedName& solar_sed,
+                   PhzModeling::PhotometryGridCreator::FluxAlgorithm flux_algorithm =
+                       PhzModeling::PhotometryGridCreator::FluxAlgorithm::INTERPOLATION,
+                   double validation_tolerance = 0.) {
+  std::ostringstream cosmology_str;
+  cosmology_str.precision(17);
+  cosmology_str << cosmology.getOmegaM() << ' ' << cosmology.getOmegaLambda() << ' ' << cosmology.getHubbleConstant();
+  std::ostringstream tolerance_str;
+  tolerance_str.precision(17);
+  tolerance_str << validation_tolerance;
+  std::string algorithm_str =
+      flux_algorithm == PhzModeling::PhotometryGridCreator::FluxAlgorithm::PREFIX_INTEGRAL ? "PREFIX_INTEGRAL"
+                                                                                            : "INTERPOLATION";
+  return {{"cosmology", cosmology_str.str()},
+          {"solar-sed", solar_sed.qualifiedName()},
+          {"model-flux-algorithm", algorithm_str},
+          {"model-flux-validation-tolerance", tolerance_str.str()}};
+}
+
 template <typename OArchive>
 static void outputFunction(const std::string& filename, PhzConfiguration::IgmConfig& igm_config,
                            XYDataset::QualifiedName&                                  luminosity_filter,
+                           const std::map<std::string, std::string>&                  provenance,
                            const std::map<std::string, PhzDataModel::PhotometryGrid>& grid_map) {
   auto                                  local_logger = Elements::Logging::getLogger("PhzOutput");
   std::ofstream                         out{filename};
@@ -55,6 +88,7 @@ static void outputFunction(const std::string& filename, PhzConfiguration::IgmCon
   OArchive boa{out};
   // Store the info object describing the grids
   PhzDataModel::PhotometryGridInfo info{grid_map, igm_config.getIgmAbsorptionType(), luminosity_filter, filter_list};
+  info.provenance = provenance;
   boa << info;
   // Store the grids themselves
   for (auto& pair : grid_map) {
@@ -63,6 +97,33 @@ static void outputFunction(const std::string& filename, PhzConfiguration::IgmCon
   local_logger.info() << "Created the model grid in file " << filename;
 }
 
+template <typename IArchive>
+static void readGridFile(std::ifstream& in, PhzDataModel::PhotometryGridInfo& info,
+                         std::map<std::string, PhzDataModel::PhotometryGrid>& grids) {
+  IArchive iarchive{in};
+  iarchive >> info;
+
+  for (auto& pair : info.region_axes_map) {
+    grids.emplace(std::make_pair(pair.first, GridContainer::gridImport<PhzDataModel::PhotometryGrid, IArchive>(in)));
+  }
+}
+
+/// Reads a grid file written by the outputFunction, in any of the archive formats
+inline void readGridFile(const std::string& filename, PhzDataModel::PhotometryGridInfo& info,
+                         std::map<std::string, PhzDataModel::PhotometryGrid>& grids) {
+  std::ifstream in{filename};
+  switch (PhzDataModel::guessArchiveFormat(in)) {
+  case PhzDataModel::ArchiveFormat::BINARY:
+    readGridFile<boost::archive::binary_iarchive>(in, info, grids);
+    break;
+  case PhzDataModel::ArchiveFormat::TEXT:
+    readGridFile<boost::archive::text_iarchive>(in, info, grids);
+    break;
+  default:
+    throw Elements::Exception() << "Unknown grid format in file " << filename;
+  }
+}
+
 }  // namespace PhzConfiguration
 }  // namespace Euclid
 
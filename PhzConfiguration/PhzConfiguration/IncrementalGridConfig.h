@@ -0,0 +1,114 @@
+/**
+ * Copyright (C) 2022 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file PhzConfiguration/IncrementalGridConfig.h
+ * @date 2026/10/18
+ */
+
+#ifndef PHZCONFIGURATION_INCREMENTALGRIDCONFIG_H
+#define PHZCONFIGURATION_INCREMENTALGRIDCONFIG_H
+
+#include "Configuration/Configuration.h"
+#include "PhzDataModel/PhotometryGrid.h"
+#include "XYDataset/QualifiedName.h"
+#include <map>
+#include <string>
+#include <vector>
+
+namespace Euclid {
+namespace PhzConfiguration {
+
+/**
+ * @class IncrementalGridConfig
+ * @brief
+ * This class defines the option enabling the incremental build of the model,
+ * filter variation and galactic correction grids
+ * @details
+ * When enabled, the grid already in the output file is loaded and only the
+ * models it misses are computed. The existing grid is used only if it has been
+ * computed with the same filters, IGM absorption and normalization filter as
+ * the current run, and if its provenance record (cosmology, reference solar
+ * SED, model flux algorithm, and the parameters specific to the grid type) is
+ * the same.
+ */
+class IncrementalGridConfig : public Configuration::Configuration {
+
+public:
+  /**
+   * @brief Constructor
+   */
+  IncrementalGridConfig(long manager_id);
+
+  /**
+   * @brief Destructor
+   */
+  virtual ~IncrementalGridConfig() = default;
+
+  /**
+   * @details
+   * This class defines the "incremental-grid-build" option in the
+   * "Incremental grid options" group
+   */
+  std::map<std::string, OptionDescriptionList> getProgramOptions() override;
+
+  /**
+   * @details
+   * Checks that the option is one of YES, NO
+   */
+  void preInitialize(const UserValues& args) override;
+
+  void initialize(const UserValues& args) override;
+
+  /**
+   * @brief Returns true if the grids are built incrementally
+   */
+  bool isEnabled() const;
+
+  /**
+   * @brief Returns the grids to extend
+   * @details
+   * Returns an empty map if the incremental build is disabled or the file does
+   * not exist.
+   *
+   * @param filename
+   * The grid file, usually the output file of the program
+   *
+   * @param filter_names
+   * The filters of the grids to build
+   *
+   * @param provenance
+   * The provenance record of the grids to build, as given by the output
+   * configuration of the grid
+   *
+   * @throw Elements::Exception
+   * If the existing grid has been computed with a different setup
+   */
+  std::map<std::string, PhzDataModel::PhotometryGrid>
+  readExistingGrids(const std::string& filename, const std::vector<XYDataset::QualifiedName>& filter_names,
+                    const std::map<std::string, std::string>& provenance);
+
+private:
+  bool m_enabled = false;
+
+}; /* End of IncrementalGridConfig class */
+
+}  // end of namespace PhzConfiguration
+}  // end of namespace Euclid
+
+#endif /* PHZCONFIGURATION_INCREMENTALGRIDCONFIG_H */
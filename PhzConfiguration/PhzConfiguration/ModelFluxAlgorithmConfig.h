@@ -0,0 +1,89 @@
+/**
+ * Copyright (C) 2022 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file PhzConfiguration/ModelFluxAlgorithmConfig.h
+ * @date 2026/10/18
+ */
+
+#ifndef PHZCONFIGURATION_MODELFLUXALGORITHMCONFIG_H
+#define PHZCONFIGURATION_MODELFLUXALGORITHMCONFIG_H
+
+#include "Configuration/Configuration.h"
+#include "PhzModeling/PhotometryGridCreator.h"
+
+namespace Euclid {
+namespace PhzConfiguration {
+
+/**
+ * @class ModelFluxAlgorithmConfig
+ * @brief
+ * This class defines the options selecting the algorithm used for computing
+ * the model fluxes of the photometry grids
+ */
+class ModelFluxAlgorithmConfig : public Configuration::Configuration {
+
+public:
+  /**
+   * @brief Constructor
+   */
+  ModelFluxAlgorithmConfig(long manager_id);
+
+  /**
+   * @brief Destructor
+   */
+  virtual ~ModelFluxAlgorithmConfig() = default;
+
+  /**
+   * @details
+   * This class defines the "model-flux-algorithm" and the
+   * "model-flux-validation-tolerance" options in the "Model flux options" group
+   */
+  std::map<std::string, OptionDescriptionList> getProgramOptions() override;
+
+  /**
+   * @details
+   * Checks that the algorithm is one of INTERPOLATION, PREFIX_INTEGRAL and
+   * that the tolerance is not negative
+   */
+  void preInitialize(const UserValues& args) override;
+
+  void initialize(const UserValues& args) override;
+
+  /**
+   * @brief Returns the algorithm to use for computing the model fluxes
+   */
+  PhzModeling::PhotometryGridCreator::FluxAlgorithm getFluxAlgorithm() const;
+
+  /**
+   * @brief Returns the tolerance of the validation of the prefix integral
+   * algorithm against the interpolation one. Zero means no validation.
+   */
+  double getValidationTolerance() const;
+
+private:
+  PhzModeling::PhotometryGridCreator::FluxAlgorithm m_flux_algorithm =
+      PhzModeling::PhotometryGridCreator::FluxAlgorithm::INTERPOLATION;
+  double m_validation_tolerance = 0.;
+
+}; /* End of ModelFluxAlgorithmConfig class */
+
+}  // end of namespace PhzConfiguration
+}  // end of namespace Euclid
+
+#endif /* PHZCONFIGURATION_MODELFLUXALGORITHMCONFIG_H */
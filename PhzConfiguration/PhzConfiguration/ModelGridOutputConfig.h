@@ -30,6 +30,7 @@
 #include "PhzModeling/PhotometryGridCreator.h"
 #include <boost/filesystem/operations.hpp>
 #include <cstdlib>
+#include <map>
 #include <string>
 
 namespace Euclid {
@@ -98,9 +99,26 @@ public:
    */
   const OutputFunction& getOutputFunction();
 
+  /**
+   * @brief
+   * Returns the name of the file the grid is written to, which is the grid
+   * extended when building incrementally
+   */
+  const std::string& getOutputFilename() const;
+
+  /**
+   * @brief
+   * Returns the provenance record stored with the grid: the cosmology, the
+   * reference solar SED and the model flux algorithm with its validation
+   * tolerance. An existing grid is extended only if it has the same.
+   */
+  const std::map<std::string, std::string>& getProvenance() const;
+
 private:
-  OutputFunction m_output_function;
-  std::string    m_grid_type = "ModelGrids";
+  OutputFunction                     m_output_function;
+  std::string                        m_filename;
+  std::map<std::string, std::string> m_provenance;
+  std::string                        m_grid_type = "ModelGrids";
 
 }; /* End of AuxDataDirConfig class */
 
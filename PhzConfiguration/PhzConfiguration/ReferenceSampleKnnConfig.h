@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2022 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file PhzConfiguration/ReferenceSampleKnnConfig.h
+ * @date 2026/10/18
+ */
+
+#ifndef _PHZCONFIGURATION_REFERENCESAMPLEKNNCONFIG_H
+#define _PHZCONFIGURATION_REFERENCESAMPLEKNNCONFIG_H
+
+#include "Configuration/Configuration.h"
+#include "PhzOutput/OutputHandler.h"
+#include "PhzReferenceSample/ReferenceSample.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Euclid {
+namespace PhzConfiguration {
+
+/**
+ * @class ReferenceSampleKnnConfig
+ * @brief
+ *  Configuration of the quick-look redshifts computed from the k nearest
+ *  neighbours of the sources in a reference sample.
+ * @details
+ *  The reference photometry is the catalog written by PhosphorosBuildPhotometry,
+ *  with a column per filter of the input catalog band mapping. The redshift PDZ
+ *  of each source is written through the PHZ output catalog.
+ */
+class ReferenceSampleKnnConfig : public Configuration::Configuration {
+
+public:
+  explicit ReferenceSampleKnnConfig(long manager_id);
+
+  /**
+   * @brief Destructor
+   */
+  virtual ~ReferenceSampleKnnConfig() = default;
+
+  std::map<std::string, OptionDescriptionList> getProgramOptions() override;
+
+  void preInitialize(const UserValues& args) override;
+
+  void initialize(const UserValues& args) override;
+
+  /// @return The reference sample with the PDZs of the neighbours
+  const ReferenceSample::ReferenceSample& getReferenceSample() const;
+
+  /// @return The filters of the colour space, in the order of the band mapping
+  const std::vector<std::string>& getFilterNames() const;
+
+  /// @return The pairs of reference object ID and fluxes, in the order of getFilterNames()
+  const std::vector<std::pair<int64_t, std::vector<double>>>& getReferenceFluxes() const;
+
+  std::size_t getNeighborNumber() const;
+
+  std::size_t getInputBufferSize() const;
+
+  /// @return The handler writing the PHZ output catalog
+  std::unique_ptr<PhzOutput::OutputHandler> getOutputHandler() const;
+
+private:
+  std::unique_ptr<ReferenceSample::ReferenceSample>    m_reference_sample;
+  std::vector<std::string>                             m_filter_names;
+  std::vector<std::pair<int64_t, std::vector<double>>> m_reference_fluxes;
+  std::size_t                                          m_neighbor_number   = 20;
+  std::size_t                                          m_input_buffer_size = 5000;
+
+}; /* End of ReferenceSampleKnnConfig class */
+
+}  // namespace PhzConfiguration
+}  // namespace Euclid
+
+#endif
@@ -39,6 +39,13 @@ namespace PhzConfiguration {
 class ScaleFactorMarginalizationConfig : public Configuration::Configuration {
 
 public:
+  /// How the likelihood is marginalized over the scale factor
+  enum class Method {
+    UNIFORM,        ///< Evenly spaced samples in the range
+    GAUSS_HERMITE,  ///< The nodes of a Gauss-Hermite quadrature
+    ANALYTIC        ///< No sampling, the Gaussian integral around the best fitted scale factor
+  };
+
   ScaleFactorMarginalizationConfig(long manager_id);
 
   /**
@@ -56,10 +63,14 @@ public:
   size_t getSampleNumber() const;
   double getRangeInSigma() const;
 
+  /// @return How the likelihood is marginalized over the scale factor
+  Method getMethod() const;
+
 private:
   bool   m_enable_scale_factor_normalization = false;
   size_t m_sample_number;
   double m_range_in_sigma;
+  Method m_method;
 
 }; /* End of ScaleFactorMarginalizationConfig class */
 
@@ -20,6 +20,7 @@
 #include "PhzConfiguration/FilterProviderConfig.h"
 #include "PhzConfiguration/IgmConfig.h"
 #include "PhzConfiguration/ModelNormalizationConfig.h"
+#include "PhzConfiguration/MultithreadConfig.h"
 #include "PhzConfiguration/ReddeningProviderConfig.h"
 #include "PhzConfiguration/RedshiftFunctorConfig.h"
 #include "PhzConfiguration/SedProviderConfig.h"
@@ -37,18 +38,20 @@ namespace PhzConfiguration {
 static const std::string REFSAMPLE_DIR{"reference-sample-dir"};
 static const std::string REFSAMPLE_OVERWRITE{"reference-sample-overwrite"};
 static const std::string REFSAMPLE_MAXSIZE{"reference-sample-max-file-size"};
+static const std::string REFSAMPLE_STORAGE{"reference-sample-storage"};
 static const std::string PHOSPHOROS_CATALOG{"phosphoros-catalog"};
 static const std::string PHOSPHOROS_CATALOG_LIST{"phosphoros-catalog-list"};
 static const std::string PHOSPHOROS_CATALOG_FORMAT{"phosphoros-catalog-format"};
 
 BuildReferenceSampleConfig::BuildReferenceSampleConfig(long manager_id)
-    : Configuration(manager_id), m_overwrite(false), m_max_size(1000000000) {
+    : Configuration(manager_id), m_overwrite(false), m_max_size(1000000000), m_storage_mode(StorageMode::FLOAT32) {
   declareDependency<SedProviderConfig>();
   declareDependency<ReddeningProviderConfig>();
   declareDependency<FilterProviderConfig>();
   declareDependency<IgmConfig>();
   declareDependency<RedshiftFunctorConfig>();
   declareDependency<ModelNormalizationConfig>();
+  declareDependency<MultithreadConfig>();
 }
 
 auto BuildReferenceSampleConfig::getProgramOptions() -> std::map<std::string, OptionDescriptionList> {
@@ -57,6 +60,9 @@ auto BuildReferenceSampleConfig::getProgramOptions() -> std::map<std::string, Op
              "The directory of the reference sample to create"},
             {REFSAMPLE_OVERWRITE.c_str(), po::bool_switch(), "Overwrite the reference sample"},
             {REFSAMPLE_MAXSIZE.c_str(), po::value<size_t>()->default_value(1000000000), "Maximum file size"},
+            {REFSAMPLE_STORAGE.c_str(), po::value<std::string>()->default_value("FLOAT32"),
+             "Storage of the SED and PDZ data (FLOAT32, FLOAT32_SHARED_AXIS for a shared axis table, or FLOAT16 for "
+             "a shared axis table and half precision values)"},
             {PHOSPHOROS_CATALOG.c_str(), po::value<std::string>()->default_value(""),
              "Filename of the Phosphoros output catalog"},
             {PHOSPHOROS_CATALOG_LIST.c_str(), po::value<std::string>()->default_value(""),
@@ -66,6 +72,10 @@ auto BuildReferenceSampleConfig::getProgramOptions() -> std::map<std::string, Op
 }
 
 void BuildReferenceSampleConfig::preInitialize(const Euclid::Configuration::Configuration::UserValues& args) {
+  auto storage = args.at(REFSAMPLE_STORAGE).as<std::string>();
+  if (storage != "FLOAT32" && storage != "FLOAT32_SHARED_AXIS" && storage != "FLOAT16") {
+    throw Elements::Exception() << "Invalid value for option " << REFSAMPLE_STORAGE << ": " << storage;
+  }
   auto phosphoros_format = args.at(PHOSPHOROS_CATALOG_FORMAT).as<std::string>();
   if (phosphoros_format != "ASCII" && phosphoros_format != "FITS") {
     throw Elements::Exception() << "Invalid value for option " << PHOSPHOROS_CATALOG_FORMAT << ": "
@@ -82,6 +92,14 @@ void BuildReferenceSampleConfig::preInitialize(const Euclid::Configuration::Conf
 void BuildReferenceSampleConfig::initialize(const Euclid::Configuration::Configuration::UserValues& args) {
   m_reference_sample_out = args.at(REFSAMPLE_DIR).as<std::string>();
   m_max_size             = args.at(REFSAMPLE_MAXSIZE).as<size_t>();
+  auto storage           = args.at(REFSAMPLE_STORAGE).as<std::string>();
+  if (storage == "FLOAT16") {
+    m_storage_mode = StorageMode::FLOAT16;
+  } else if (storage == "FLOAT32_SHARED_AXIS") {
+    m_storage_mode = StorageMode::FLOAT32_SHARED_AXIS;
+  } else {
+    m_storage_mode = StorageMode::FLOAT32;
+  }
   if (args.count(REFSAMPLE_OVERWRITE))
     m_overwrite = args.at(REFSAMPLE_OVERWRITE).as<bool>();
 
@@ -133,5 +151,9 @@ size_t BuildReferenceSampleConfig::getMaxSize() const {
   return m_max_size;
 }
 
+StorageMode BuildReferenceSampleConfig::getStorageMode() const {
+  return m_storage_mode;
+}
+
 }  // namespace PhzConfiguration
 }  // namespace Euclid
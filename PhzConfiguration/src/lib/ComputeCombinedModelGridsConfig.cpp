@@ -0,0 +1,66 @@
+/**
+ * Copyright (C) 2022 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file src/lib/ComputeCombinedModelGridsConfig.cpp
+ * @date 2026/10/18
+ */
+
+#include "PhzConfiguration/ComputeCombinedModelGridsConfig.h"
+#include "ElementsKernel/Exception.h"
+#include "PhzConfiguration/CorrectionCoefficientGridOutputConfig.h"
+#include "PhzConfiguration/FilterConfig.h"
+#include "PhzConfiguration/FilterVariationCoefficientGridOutputConfig.h"
+#include "PhzConfiguration/FilterVariationConfig.h"
+#include "PhzConfiguration/IgmConfig.h"
+#include "PhzConfiguration/IncrementalGridConfig.h"
+#include "PhzConfiguration/MilkyWayReddeningConfig.h"
+#include "PhzConfiguration/ModelGridOutputConfig.h"
+#include "PhzConfiguration/ModelNormalizationConfig.h"
+#include "PhzConfiguration/MultithreadConfig.h"
+#include "PhzConfiguration/ParameterSpaceConfig.h"
+
+namespace Euclid {
+namespace PhzConfiguration {
+
+ComputeCombinedModelGridsConfig::ComputeCombinedModelGridsConfig(long manager_id) : Configuration(manager_id) {
+  declareDependency<ModelGridOutputConfig>();
+  declareDependency<FilterVariationCoefficientGridOutputConfig>();
+  declareDependency<CorrectionCoefficientGridOutputConfig>();
+  declareDependency<IgmConfig>();
+  declareDependency<ParameterSpaceConfig>();
+  declareDependency<FilterConfig>();
+  declareDependency<MultithreadConfig>();
+  declareDependency<ModelNormalizationConfig>();
+  declareDependency<MilkyWayReddeningConfig>();
+  declareDependency<FilterVariationConfig>();
+  declareDependency<IncrementalGridConfig>();
+}
+
+void ComputeCombinedModelGridsConfig::preInitialize(const UserValues& args) {
+  getDependency<ModelGridOutputConfig>().changeDefaultSubdir("ModelGrids");
+  // The combined grids are always computed by interpolation, which is what their provenance must record
+  auto algorithm = args.find("model-flux-algorithm");
+  if (algorithm != args.end() && algorithm->second.as<std::string>() != "INTERPOLATION") {
+    throw Elements::Exception() << "The combined model grids can only be computed with the INTERPOLATION "
+                                << "model-flux-algorithm";
+  }
+}
+
+}  // namespace PhzConfiguration
+}  // namespace Euclid
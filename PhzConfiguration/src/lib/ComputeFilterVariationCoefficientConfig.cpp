@@ -29,6 +29,7 @@
 #include "PhzConfiguration/FilterProviderConfig.h"
 #include "PhzConfiguration/FilterVariationCoefficientGridOutputConfig.h"
 #include "PhzConfiguration/FilterVariationConfig.h"
+#include "PhzConfiguration/IncrementalGridConfig.h"
 #include "PhzConfiguration/MilkyWayReddeningConfig.h"
 #include "PhzConfiguration/ModelNormalizationConfig.h"
 #include "PhzConfiguration/MultithreadConfig.h"
@@ -60,6 +61,7 @@ ComputeFilterVariationCoefficientConfig::ComputeFilterVariationCoefficientConfig
   declareDependency<FilterProviderConfig>();
   declareDependency<ModelNormalizationConfig>();
   declareDependency<FilterVariationConfig>();
+  declareDependency<IncrementalGridConfig>();
 }
 
 }  // namespace PhzConfiguration
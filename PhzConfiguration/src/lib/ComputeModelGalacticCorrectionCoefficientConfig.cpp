@@ -29,6 +29,7 @@
 #include <cstdlib>
 
 #include "PhzConfiguration/CatalogTypeConfig.h"
+#include "PhzConfiguration/IncrementalGridConfig.h"
 #include "PhzConfiguration/PhotometryGridConfig.h"
 #include "PhzConfiguration/PhzOutputDirConfig.h"
 #include "PhzConfiguration/ResultsDirConfig.h"
@@ -60,6 +61,7 @@ ComputeModelGalacticCorrectionCoefficientConfig::ComputeModelGalacticCorrectionC
   declareDependency<MultithreadConfig>();
   declareDependency<FilterProviderConfig>();
   declareDependency<ModelNormalizationConfig>();
+  declareDependency<IncrementalGridConfig>();
 }
 
 }  // namespace PhzConfiguration
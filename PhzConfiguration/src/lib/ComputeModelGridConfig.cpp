@@ -27,6 +27,8 @@
 #include "ElementsKernel/Logging.h"
 #include "PhzConfiguration/FilterConfig.h"
 #include "PhzConfiguration/IgmConfig.h"
+#include "PhzConfiguration/IncrementalGridConfig.h"
+#include "PhzConfiguration/ModelFluxAlgorithmConfig.h"
 #include "PhzConfiguration/ModelGridOutputConfig.h"
 #include "PhzConfiguration/ModelNormalizationConfig.h"
 #include "PhzConfiguration/MultithreadConfig.h"
@@ -39,6 +41,8 @@ namespace fs = boost::filesystem;
 namespace Euclid {
 namespace PhzConfiguration {
 
+static const std::string MODEL_GRID_MEMORY_LIMIT{"model-grid-memory-limit"};
+
 ComputeModelGridConfig::ComputeModelGridConfig(long manager_id) : Configuration(manager_id) {
   declareDependency<ModelGridOutputConfig>();
   declareDependency<IgmConfig>();
@@ -46,10 +50,37 @@ ComputeModelGridConfig::ComputeModelGridConfig(long manager_id) : Configuration(
   declareDependency<FilterConfig>();
   declareDependency<MultithreadConfig>();
   declareDependency<ModelNormalizationConfig>();
+  declareDependency<ModelFluxAlgorithmConfig>();
+  declareDependency<IncrementalGridConfig>();
+}
+
+auto ComputeModelGridConfig::getProgramOptions() -> std::map<std::string, OptionDescriptionList> {
+  return {{"Compute Model Grid options",
+           {{MODEL_GRID_MEMORY_LIMIT.c_str(), po::value<int>()->default_value(0),
+             "The maximum memory (in MB) used by the parameter space regions built concurrently (0 for no limit)"}}}};
 }
 
-void ComputeModelGridConfig::preInitialize(const UserValues&) {
+void ComputeModelGridConfig::preInitialize(const UserValues& args) {
   getDependency<ModelGridOutputConfig>().changeDefaultSubdir("ModelGrids");
+  auto memory_limit = args.find(MODEL_GRID_MEMORY_LIMIT);
+  if (memory_limit != args.end() && memory_limit->second.as<int>() < 0) {
+    throw Elements::Exception() << MODEL_GRID_MEMORY_LIMIT << " must not be negative but was "
+                                << memory_limit->second.as<int>();
+  }
+}
+
+void ComputeModelGridConfig::initialize(const UserValues& args) {
+  auto memory_limit = args.find(MODEL_GRID_MEMORY_LIMIT);
+  if (memory_limit != args.end()) {
+    m_memory_limit = static_cast<size_t>(memory_limit->second.as<int>()) * 1024 * 1024;
+  }
+}
+
+size_t ComputeModelGridConfig::getMemoryLimit() const {
+  if (getCurrentState() < Configuration::Configuration::State::INITIALIZED) {
+    throw Elements::Exception() << "Call to getMemoryLimit() on a not initialized instance.";
+  }
+  return m_memory_limit;
 }
 
 }  // namespace PhzConfiguration
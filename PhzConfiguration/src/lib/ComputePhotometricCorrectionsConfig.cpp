@@ -71,6 +71,10 @@ static const std::string OUTPUT_PHOT_CORR_FILE{"output-phot-corr-file"};
 static const std::string PHOT_CORR_ITER_NO{"phot-corr-iter-no"};
 static const std::string PHOT_CORR_TOLERANCE{"phot-corr-tolerance"};
 static const std::string PHOT_CORR_SELECTION_METHOD{"phot-corr-selection-method"};
+static const std::string PHOT_CORR_WARM_START{"phot-corr-warm-start"};
+static const std::string PHOT_CORR_NEIGHBOURHOOD_EBV{"phot-corr-neighbourhood-ebv"};
+static const std::string PHOT_CORR_NEIGHBOURHOOD_REDDENING_CURVE{"phot-corr-neighbourhood-reddening-curve"};
+static const std::string PHOT_CORR_NEIGHBOURHOOD_SED{"phot-corr-neighbourhood-sed"};
 
 ComputePhotometricCorrectionsConfig::ComputePhotometricCorrectionsConfig(long manager_id) : Configuration(manager_id) {
   declareDependency<IntermediateDirConfig>();
@@ -109,7 +113,16 @@ auto ComputePhotometricCorrectionsConfig::getProgramOptions() -> std::map<std::s
              "iteration stops"},
             {PHOT_CORR_SELECTION_METHOD.c_str(), boost::program_options::value<std::string>()->default_value("MEDIAN"),
              "The method used for selecting the photometric correction (MEDIAN, "
-             "WEIGHTED_MEDIAN, MEAN, WEIGHTED_MEAN)"}}}};
+             "WEIGHTED_MEDIAN, MEAN, WEIGHTED_MEAN)"},
+            {PHOT_CORR_WARM_START.c_str(), boost::program_options::value<std::string>()->default_value("NO"),
+             "If the iterations after the first search only the neighbourhood of the "
+             "previous best fitted models (YES/NO)"},
+            {PHOT_CORR_NEIGHBOURHOOD_EBV.c_str(), boost::program_options::value<int>()->default_value(2),
+             "The number of EBV knots at each side of the previous best fitted model to search"},
+            {PHOT_CORR_NEIGHBOURHOOD_REDDENING_CURVE.c_str(), boost::program_options::value<int>()->default_value(1),
+             "The number of reddening curve knots at each side of the previous best fitted model to search"},
+            {PHOT_CORR_NEIGHBOURHOOD_SED.c_str(), boost::program_options::value<int>()->default_value(2),
+             "The number of SED knots at each side of the previous best fitted model to search"}}}};
 }
 
 void ComputePhotometricCorrectionsConfig::preInitialize(const UserValues& args) {
@@ -118,6 +131,19 @@ void ComputePhotometricCorrectionsConfig::preInitialize(const UserValues& args)
     logger.error() << "Unknown photometric correction selection method " << method;
     throw Elements::Exception() << "Unknown photometric correction selection method " << method;
   }
+  auto warm_start = args.at(PHOT_CORR_WARM_START).as<std::string>();
+  if (warm_start != "YES" && warm_start != "NO") {
+    throw Elements::Exception() << "Invalid " << PHOT_CORR_WARM_START << " value " << warm_start
+                                << " (allowed values: YES, NO)";
+  }
+  for (auto& option : {PHOT_CORR_NEIGHBOURHOOD_EBV, PHOT_CORR_NEIGHBOURHOOD_REDDENING_CURVE,
+                       PHOT_CORR_NEIGHBOURHOOD_SED}) {
+    // With no knot at each side all the models would be on an inner boundary of their neighbourhood
+    if (args.at(option).as<int>() <= 0) {
+      throw Elements::Exception() << "Invalid " << option << " value " << args.at(option).as<int>()
+                                  << " (must be bigger than 0)";
+    }
+  }
 }
 
 static fs::path getOutputPathFromOptions(const std::map<std::string, po::variable_value>& args,
@@ -130,15 +156,23 @@ static fs::path getOutputPathFromOptions(const std::map<std::string, po::variabl
   return result;
 }
 
-ComputePhotometricCorrectionsConfig::PhotCorrSelectorType initializePhotCorrSelector(const std::string& method) {
+template <typename Functor>
+static ComputePhotometricCorrectionsConfig::PhotCorrSelectorType createPhotCorrSelector(ThreadPool* thread_pool) {
+  return (thread_pool != nullptr) ? Functor{*thread_pool} : Functor{};
+}
+
+ComputePhotometricCorrectionsConfig::PhotCorrSelectorType initializePhotCorrSelector(const std::string& method,
+                                                                                     ThreadPool* thread_pool) {
   if (method == "MEDIAN") {
-    return PhzPhotometricCorrection::FindMedianPhotometricCorrectionsFunctor{};
+    return createPhotCorrSelector<PhzPhotometricCorrection::FindMedianPhotometricCorrectionsFunctor>(thread_pool);
   } else if (method == "WEIGHTED_MEDIAN") {
-    return PhzPhotometricCorrection::FindWeightedMedianPhotometricCorrectionsFunctor{};
+    return createPhotCorrSelector<PhzPhotometricCorrection::FindWeightedMedianPhotometricCorrectionsFunctor>(
+        thread_pool);
   } else if (method == "MEAN") {
-    return PhzPhotometricCorrection::FindMeanPhotometricCorrectionsFunctor{};
+    return createPhotCorrSelector<PhzPhotometricCorrection::FindMeanPhotometricCorrectionsFunctor>(thread_pool);
   } else if (method == "WEIGHTED_MEAN") {
-    return PhzPhotometricCorrection::FindWeightedMeanPhotometricCorrectionsFunctor{};
+    return createPhotCorrSelector<PhzPhotometricCorrection::FindWeightedMeanPhotometricCorrectionsFunctor>(
+        thread_pool);
   }
   throw Elements::Exception() << "Unknown " << PHOT_CORR_SELECTION_METHOD << " : " << method;
 }
@@ -174,8 +208,14 @@ void ComputePhotometricCorrectionsConfig::initialize(const UserValues& args) {
   m_stop_criteria  = PhzPhotometricCorrection::DefaultStopCriteria(iter_no, tolerance);
 
   // Initialize the photometric correction selector
-  auto method          = args.at(PHOT_CORR_SELECTION_METHOD).as<std::string>();
-  m_phot_corr_selector = initializePhotCorrSelector(method);
+  m_phot_corr_method   = args.at(PHOT_CORR_SELECTION_METHOD).as<std::string>();
+  m_phot_corr_selector = initializePhotCorrSelector(m_phot_corr_method, nullptr);
+
+  // Initialize the warm start of the iterations
+  m_warm_start         = args.at(PHOT_CORR_WARM_START).as<std::string>() == "YES";
+  m_neighbourhood_size = {static_cast<std::size_t>(args.at(PHOT_CORR_NEIGHBOURHOOD_EBV).as<int>()),
+                          static_cast<std::size_t>(args.at(PHOT_CORR_NEIGHBOURHOOD_REDDENING_CURVE).as<int>()),
+                          static_cast<std::size_t>(args.at(PHOT_CORR_NEIGHBOURHOOD_SED).as<int>())};
 }
 
 const ComputePhotometricCorrectionsConfig::OutputFunction& ComputePhotometricCorrectionsConfig::getOutputFunction() {
@@ -194,6 +234,32 @@ auto ComputePhotometricCorrectionsConfig::getPhotometricCorrectionSelector() ->
   return m_phot_corr_selector;
 }
 
+auto ComputePhotometricCorrectionsConfig::getPhotometricCorrectionSelector(ThreadPool& thread_pool)
+    -> PhotCorrSelectorType {
+  if (getCurrentState() < State::INITIALIZED) {
+    throw Elements::Exception() << "getPhotometricCorrectionSelector() call on uninitialized "
+                                << "ComputePhotometricCorrectionsConfig";
+  }
+  return initializePhotCorrSelector(m_phot_corr_method, &thread_pool);
+}
+
+bool ComputePhotometricCorrectionsConfig::isWarmStartEnabled() {
+  if (getCurrentState() < State::INITIALIZED) {
+    throw Elements::Exception() << "isWarmStartEnabled() call on uninitialized "
+                                << "ComputePhotometricCorrectionsConfig";
+  }
+  return m_warm_start;
+}
+
+const PhzPhotometricCorrection::BestFitModelCache::NeighbourhoodSize&
+ComputePhotometricCorrectionsConfig::getWarmStartNeighbourhoodSize() {
+  if (getCurrentState() < State::INITIALIZED) {
+    throw Elements::Exception() << "getWarmStartNeighbourhoodSize() call on uninitialized "
+                                << "ComputePhotometricCorrectionsConfig";
+  }
+  return m_neighbourhood_size;
+}
+
 const PhzPhotometricCorrection::PhotometricCorrectionCalculator::StopCriteriaFunction&
 ComputePhotometricCorrectionsConfig::getStopCriteria() {
   if (getCurrentState() < State::INITIALIZED) {
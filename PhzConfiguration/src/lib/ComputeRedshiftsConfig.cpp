@@ -270,6 +270,11 @@ void ComputeRedshiftsConfig::initialize(const UserValues& args) {
     m_out_posterior_dir = output_dir / "posteriors";
   }
 
+  m_scale_sampled_outputs = useScaleSampledOutputs(getDependency<ScaleFactorMarginalizationConfig>());
+  if (m_likelihood_flag || m_posterior_flag) {
+    checkScaleSampledOutputs(getDependency<ScaleFactorMarginalizationConfig>());
+  }
+
   m_input_buffer_size = args.at(INPUT_BUFFER_SIZE).as<int>();
 
   m_input_process_max = args.at(INPUT_PROCESS_MAX).as<int>();
@@ -291,14 +296,12 @@ std::unique_ptr<PhzOutput::OutputHandler> ComputeRedshiftsConfig::getOutputHandl
     result.addHandler(std::move(handler));
   }
 
-  bool has_scale_sampling = getDependency<ScaleFactorMarginalizationConfig>().getIsEnabled();
-
   const auto& pp_config = getDependency<PhysicalParametersConfig>().getParamConfig();
 
   const auto& model_grid = getDependency<PhotometryGridConfig>().getPhotometryGrid();
   if (m_likelihood_flag) {
 
-    if (has_scale_sampling) {
+    if (m_scale_sampled_outputs) {
       result.addHandler(std::unique_ptr<PhzOutput::OutputHandler>{new PhzOutput::LikelihoodHandler<
           PhzDataModel::RegionResultType::LIKELIHOOD_SCALING_LOG_GRID,
           PhzOutput::GridSamplerScale<PhzDataModel::RegionResultType::LIKELIHOOD_SCALING_LOG_GRID>>{
@@ -314,7 +317,7 @@ std::unique_ptr<PhzOutput::OutputHandler> ComputeRedshiftsConfig::getOutputHandl
 
   if (m_posterior_flag) {
 
-    if (has_scale_sampling) {
+    if (m_scale_sampled_outputs) {
       result.addHandler(std::unique_ptr<PhzOutput::OutputHandler>{new PhzOutput::LikelihoodHandler<
           PhzDataModel::RegionResultType::POSTERIOR_SCALING_LOG_GRID,
           PhzOutput::GridSamplerScale<PhzDataModel::RegionResultType::POSTERIOR_SCALING_LOG_GRID>>{
@@ -331,6 +334,20 @@ std::unique_ptr<PhzOutput::OutputHandler> ComputeRedshiftsConfig::getOutputHandl
   return output_handler;
 }
 
+bool ComputeRedshiftsConfig::useScaleSampledOutputs(const ScaleFactorMarginalizationConfig& scale_factor_config) {
+  // The analytic marginalization does not fill the scale factor sampled grids
+  return scale_factor_config.getIsEnabled() &&
+         scale_factor_config.getMethod() != ScaleFactorMarginalizationConfig::Method::ANALYTIC;
+}
+
+void ComputeRedshiftsConfig::checkScaleSampledOutputs(const ScaleFactorMarginalizationConfig& scale_factor_config) {
+  if (scale_factor_config.getIsEnabled() &&
+      scale_factor_config.getMethod() == ScaleFactorMarginalizationConfig::Method::GAUSS_HERMITE) {
+    throw Elements::Exception() << "The " << CREATE_OUTPUT_LIKELIHOODS_FLAG << " and " << CREATE_OUTPUT_POSTERIORS_FLAG
+                                << " outputs are not supported with the GAUSS_HERMITE scale factor marginalization";
+  }
+}
+
 std::size_t ComputeRedshiftsConfig::getInputBufferSize() const {
   if (getCurrentState() < Configuration::Configuration::State::INITIALIZED) {
     throw Elements::Exception() << "Call to getInputBufferSize() on a not initialized instance.";
@@ -42,6 +42,7 @@ namespace PhzConfiguration {
 
 static const std::string SED_WEIGHT_OUTPUT{"SED-Weight-Output"};
 static const std::string SED_WEIGHT_SAMPLING{"SED-Weight-sampling"};
+static const std::string SED_WEIGHT_SEED{"SED-Weight-seed"};
 
 ComputeSedWeightConfig::ComputeSedWeightConfig(long manager_id) : Configuration(manager_id) {
   declareDependency<AuxDataDirConfig>();
@@ -59,7 +60,9 @@ auto ComputeSedWeightConfig::getProgramOptions() -> std::map<std::string, Option
                 "Path of the file into which output the SED weights. Relative path are relative to "
                 "<AuxDataDir>/GenericPriors/SedWeight/"},
 	           {SED_WEIGHT_SAMPLING.c_str(), po::value<int>()->default_value(100000),
-	                "Number of sample for computing SED weight, if put to 0 all weight are set to 1"}
+	                "Number of sample for computing SED weight, if put to 0 all weight are set to 1"},
+	           {SED_WEIGHT_SEED.c_str(), po::value<long>()->default_value(-1),
+	                "Seed of the SED weight sampling, if negative a random seed is used"}
 
            }}};
 }
@@ -79,6 +82,7 @@ void ComputeSedWeightConfig::initialize(const UserValues& args) {
   }
 
   m_sampling = args.find(SED_WEIGHT_SAMPLING)->second.as<int>();
+  m_seed     = args.find(SED_WEIGHT_SEED)->second.as<long>();
 }
 
 const std::string& ComputeSedWeightConfig::getOutputFile() const {
@@ -95,6 +99,13 @@ int ComputeSedWeightConfig::getWeightSampling() const {
   return m_sampling;
 }
 
+long ComputeSedWeightConfig::getWeightSamplingSeed() const {
+  if (getCurrentState() < Configuration::Configuration::State::INITIALIZED) {
+    throw Elements::Exception() << "Call to getWeightSamplingSeed() on a not initialized instance.";
+  }
+  return m_seed;
+}
+
 
 }  // namespace PhzConfiguration
 }  // namespace Euclid
@@ -26,9 +26,11 @@
 #include "ElementsKernel/Exception.h"
 #include "ElementsKernel/Logging.h"
 #include "PhzConfiguration/CatalogTypeConfig.h"
+#include "PhzConfiguration/CosmologicalParameterConfig.h"
 #include "PhzConfiguration/GridFileHelper.h"
 #include "PhzConfiguration/IgmConfig.h"
 #include "PhzConfiguration/IntermediateDirConfig.h"
+#include "PhzConfiguration/MilkyWayReddeningConfig.h"
 #include "PhzConfiguration/ModelNormalizationConfig.h"
 #include "PhzDataModel/ArchiveFormat.h"
 #include "PhzDataModel/PhotometryGridInfo.h"
@@ -54,6 +56,8 @@ CorrectionCoefficientGridOutputConfig::CorrectionCoefficientGridOutputConfig(lon
   declareDependency<IntermediateDirConfig>();
   declareDependency<IgmConfig>();
   declareDependency<ModelNormalizationConfig>();
+  declareDependency<CosmologicalParameterConfig>();
+  declareDependency<MilkyWayReddeningConfig>();
 }
 
 auto CorrectionCoefficientGridOutputConfig::getProgramOptions() -> std::map<std::string, OptionDescriptionList> {
@@ -84,14 +88,21 @@ void CorrectionCoefficientGridOutputConfig::initialize(const UserValues& args) {
   // Extract file option
   std::string filename = getFilenameFromOptions(args, getDependency<IntermediateDirConfig>().getIntermediateDir(),
                                                 getDependency<CatalogTypeConfig>().getCatalogType());
+  m_filename = filename;
 
   // Check directory and write permissions
   Euclid::PhzUtils::checkCreateDirectoryWithFile(filename);
 
   typedef std::function<void(const std::string&, IgmConfig&, XYDataset::QualifiedName&,
+                             const std::map<std::string, std::string>&,
                              const std::map<std::string, PhzDataModel::PhotometryGrid>&)>
       InnerOutputFunction;
 
+  m_provenance = makeGridProvenance(getDependency<CosmologicalParameterConfig>().getCosmologicalParam(),
+                                    getDependency<ModelNormalizationConfig>().getReferenceSolarSed());
+  m_provenance["milky-way-reddening-curve"] =
+      getDependency<MilkyWayReddeningConfig>().getMilkyWayReddeningCurve().qualifiedName();
+
   InnerOutputFunction inner_output_function;
 
   std::string output_format_str = "BINARY";
@@ -117,7 +128,7 @@ void CorrectionCoefficientGridOutputConfig::initialize(const UserValues& args) {
     auto igm_config   = getDependency<IgmConfig>();
     auto lum_filter   = getDependency<ModelNormalizationConfig>().getNormalizationFilter();
 
-    inner_output_function(filename, igm_config, lum_filter, grid_map);
+    inner_output_function(filename, igm_config, lum_filter, m_provenance, grid_map);
     local_logger.info() << "Created the model grid in file " << filename;
   };
 }
@@ -131,5 +142,21 @@ CorrectionCoefficientGridOutputConfig::getOutputFunction() {
   return m_output_function;
 }
 
+const std::string& CorrectionCoefficientGridOutputConfig::getOutputFilename() const {
+  if (getCurrentState() < Configuration::Configuration::State::INITIALIZED) {
+    throw Elements::Exception() << "Call to getOutputFilename() on a not initialized instance.";
+  }
+
+  return m_filename;
+}
+
+const std::map<std::string, std::string>& CorrectionCoefficientGridOutputConfig::getProvenance() const {
+  if (getCurrentState() < Configuration::Configuration::State::INITIALIZED) {
+    throw Elements::Exception() << "Call to getProvenance() on a not initialized instance.";
+  }
+
+  return m_provenance;
+}
+
 }  // namespace PhzConfiguration
 }  // namespace Euclid
@@ -26,6 +26,9 @@
 #include "ElementsKernel/Exception.h"
 #include "ElementsKernel/Logging.h"
 #include "PhzConfiguration/CatalogTypeConfig.h"
+#include "PhzConfiguration/CosmologicalParameterConfig.h"
+#include "PhzConfiguration/FilterVariationConfig.h"
+#include "PhzConfiguration/GridFileHelper.h"
 #include "PhzConfiguration/IgmConfig.h"
 #include "PhzConfiguration/IntermediateDirConfig.h"
 #include "PhzConfiguration/ModelNormalizationConfig.h"
@@ -36,6 +39,7 @@
 #include "PhzUtils/FileUtils.h"
 #include <boost/archive/text_oarchive.hpp>
 #include <fstream>
+#include <sstream>
 
 namespace po = boost::program_options;
 namespace fs = boost::filesystem;
@@ -54,6 +58,8 @@ FilterVariationCoefficientGridOutputConfig::FilterVariationCoefficientGridOutput
   declareDependency<IntermediateDirConfig>();
   declareDependency<IgmConfig>();
   declareDependency<ModelNormalizationConfig>();
+  declareDependency<CosmologicalParameterConfig>();
+  declareDependency<FilterVariationConfig>();
 }
 
 auto FilterVariationCoefficientGridOutputConfig::getProgramOptions() -> std::map<std::string, OptionDescriptionList> {
@@ -80,39 +86,30 @@ static std::string getFilenameFromOptions(const std::map<std::string, po::variab
   return result.string();
 }
 
-template <typename OArchive>
-static void outputFunction(const std::string& filename, IgmConfig& igm_config,
-                           XYDataset::QualifiedName&                                  luminosity_filter,
-                           const std::map<std::string, PhzDataModel::PhotometryGrid>& grid_map) {
-  auto                                  local_logger = Elements::Logging::getLogger("PhzOutput");
-  std::ofstream                         out{filename};
-  auto&                                 filter_names_str = grid_map.begin()->second.getCellManager().filterNames();
-  std::vector<XYDataset::QualifiedName> filter_list;
-  std::copy(filter_names_str.begin(), filter_names_str.end(), std::back_inserter(filter_list));
-  OArchive boa{out};
-  // Store the info object describing the grids
-  PhzDataModel::PhotometryGridInfo info{grid_map, igm_config.getIgmAbsorptionType(), luminosity_filter, filter_list};
-  boa << info;
-  // Store the grids themselves
-  for (auto& pair : grid_map) {
-    GridContainer::gridExport<OArchive>(out, pair.second);
-  }
-  local_logger.info() << "Created the model grid in file " << filename;
-}
-
 void FilterVariationCoefficientGridOutputConfig::initialize(const UserValues& args) {
 
   // Extract file option
   std::string filename = getFilenameFromOptions(args, getDependency<IntermediateDirConfig>().getIntermediateDir(),
                                                 getDependency<CatalogTypeConfig>().getCatalogType());
+  m_filename = filename;
 
   // Check directory and write permissions
   Euclid::PhzUtils::checkCreateDirectoryWithFile(filename);
 
   typedef std::function<void(const std::string&, IgmConfig&, XYDataset::QualifiedName&,
+                             const std::map<std::string, std::string>&,
                              const std::map<std::string, PhzDataModel::PhotometryGrid>&)>
       InnerOutputFunction;
 
+  m_provenance = makeGridProvenance(getDependency<CosmologicalParameterConfig>().getCosmologicalParam(),
+                                    getDependency<ModelNormalizationConfig>().getReferenceSolarSed());
+  std::ostringstream sampling_str;
+  sampling_str.precision(17);
+  for (auto delta_lambda : getDependency<FilterVariationConfig>().getSampling()) {
+    sampling_str << delta_lambda << ' ';
+  }
+  m_provenance["filter-variation-sampling"] = sampling_str.str();
+
   InnerOutputFunction inner_output_function;
 
   std::string output_format_str = "BINARY";
@@ -138,7 +135,7 @@ void FilterVariationCoefficientGridOutputConfig::initialize(const UserValues& ar
     auto igm_config   = getDependency<IgmConfig>();
     auto lum_filter   = getDependency<ModelNormalizationConfig>().getNormalizationFilter();
 
-    inner_output_function(filename, igm_config, lum_filter, grid_map);
+    inner_output_function(filename, igm_config, lum_filter, m_provenance, grid_map);
     local_logger.info() << "Created the model grid in file " << filename;
   };
 }
@@ -152,5 +149,21 @@ FilterVariationCoefficientGridOutputConfig::getOutputFunction() {
   return m_output_function;
 }
 
+const std::string& FilterVariationCoefficientGridOutputConfig::getOutputFilename() const {
+  if (getCurrentState() < Configuration::Configuration::State::INITIALIZED) {
+    throw Elements::Exception() << "Call to getOutputFilename() on a not initialized instance.";
+  }
+
+  return m_filename;
+}
+
+const std::map<std::string, std::string>& FilterVariationCoefficientGridOutputConfig::getProvenance() const {
+  if (getCurrentState() < Configuration::Configuration::State::INITIALIZED) {
+    throw Elements::Exception() << "Call to getProvenance() on a not initialized instance.";
+  }
+
+  return m_provenance;
+}
+
 }  // namespace PhzConfiguration
 }  // namespace Euclid
@@ -0,0 +1,129 @@
+/**
+ * Copyright (C) 2022 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file src/lib/IncrementalGridConfig.cpp
+ * @date 2026/10/18
+ */
+
+#include "PhzConfiguration/IncrementalGridConfig.h"
+#include "ElementsKernel/Exception.h"
+#include "ElementsKernel/Logging.h"
+#include "PhzConfiguration/GridFileHelper.h"
+#include "PhzConfiguration/IgmConfig.h"
+#include "PhzConfiguration/ModelNormalizationConfig.h"
+#include <boost/filesystem/operations.hpp>
+#include <boost/program_options.hpp>
+
+namespace po = boost::program_options;
+namespace fs = boost::filesystem;
+
+namespace Euclid {
+namespace PhzConfiguration {
+
+static const std::string INCREMENTAL_GRID_BUILD{"incremental-grid-build"};
+
+static Elements::Logging logger = Elements::Logging::getLogger("IncrementalGridConfig");
+
+IncrementalGridConfig::IncrementalGridConfig(long manager_id) : Configuration(manager_id) {
+  declareDependency<IgmConfig>();
+  declareDependency<ModelNormalizationConfig>();
+}
+
+auto IncrementalGridConfig::getProgramOptions() -> std::map<std::string, OptionDescriptionList> {
+  return {{"Incremental grid options",
+           {{INCREMENTAL_GRID_BUILD.c_str(), po::value<std::string>()->default_value("NO"),
+             "If YES, the existing output grid is extended with the missing models instead of being recomputed "
+             "(YES/NO, default: NO)"}}}};
+}
+
+void IncrementalGridConfig::preInitialize(const UserValues& args) {
+  auto flag = args.find(INCREMENTAL_GRID_BUILD);
+  if (flag != args.end() && flag->second.as<std::string>() != "YES" && flag->second.as<std::string>() != "NO") {
+    throw Elements::Exception() << "Invalid value for option " << INCREMENTAL_GRID_BUILD << ": "
+                                << flag->second.as<std::string>();
+  }
+}
+
+void IncrementalGridConfig::initialize(const UserValues& args) {
+  auto flag = args.find(INCREMENTAL_GRID_BUILD);
+  m_enabled = flag != args.end() && flag->second.as<std::string>() == "YES";
+}
+
+bool IncrementalGridConfig::isEnabled() const {
+  return m_enabled;
+}
+
+std::map<std::string, PhzDataModel::PhotometryGrid>
+IncrementalGridConfig::readExistingGrids(const std::string&                           filename,
+                                         const std::vector<XYDataset::QualifiedName>& filter_names,
+                                         const std::map<std::string, std::string>&    provenance) {
+  if (getCurrentState() < State::INITIALIZED) {
+    throw Elements::Exception() << "readExistingGrids() call on uninitialized IncrementalGridConfig";
+  }
+
+  std::map<std::string, PhzDataModel::PhotometryGrid> grids{};
+  if (!m_enabled) {
+    return grids;
+  }
+  if (!fs::exists(filename)) {
+    logger.info() << "No existing grid in " << filename << ", computing the full grid";
+    return grids;
+  }
+
+  PhzDataModel::PhotometryGridInfo info{};
+  readGridFile(filename, info, grids);
+
+  // Refuse to mix models computed with a different setup
+  if (info.filter_names != filter_names) {
+    throw Elements::Exception() << "Cannot extend the grid " << filename << ": it has been computed for different "
+                                << "filters";
+  }
+  if (info.igm_method != getDependency<IgmConfig>().getIgmAbsorptionType()) {
+    throw Elements::Exception() << "Cannot extend the grid " << filename << ": it has been computed with the IGM "
+                                << "absorption " << info.igm_method;
+  }
+  if (!(info.luminosity_filter_name == getDependency<ModelNormalizationConfig>().getNormalizationFilter())) {
+    throw Elements::Exception() << "Cannot extend the grid " << filename << ": it has been normalized with the filter "
+                                << info.luminosity_filter_name.qualifiedName();
+  }
+  if (info.provenance.empty()) {
+    throw Elements::Exception() << "Cannot extend the grid " << filename << ": it has no provenance record";
+  }
+  for (auto& entry : provenance) {
+    auto existing = info.provenance.find(entry.first);
+    if (existing == info.provenance.end()) {
+      throw Elements::Exception() << "Cannot extend the grid " << filename << ": its provenance record has no "
+                                  << entry.first;
+    }
+    if (existing->second != entry.second) {
+      throw Elements::Exception() << "Cannot extend the grid " << filename << ": it has been computed with the "
+                                  << entry.first << " " << existing->second << " instead of " << entry.second;
+    }
+  }
+  if (info.provenance.size() != provenance.size()) {
+    throw Elements::Exception() << "Cannot extend the grid " << filename << ": its provenance record has "
+                                << "unexpected entries";
+  }
+
+  logger.info() << "Extending the existing grid " << filename;
+  return grids;
+}
+
+}  // namespace PhzConfiguration
+}  // namespace Euclid
@@ -28,6 +28,7 @@
 #include "ElementsKernel/Logging.h"
 #include "PhzConfiguration/ProgramOptionsHelper.h"
 #include "PhzConfiguration/ScaleFactorMarginalizationConfig.h"
+#include "PhzLikelihood/AnalyticMarginalizationLikelihoodGridFunctor.h"
 #include "PhzLikelihood/ChiSquareLikelihoodLogarithm.h"
 #include "PhzLikelihood/LikelihoodGridFunctor.h"
 #include "PhzLikelihood/LikelihoodLogarithmAlgorithm.h"
@@ -78,13 +79,26 @@ const PhzLikelihood::SourcePhzFunctor::LikelihoodGridFunction& LikelihoodGridFun
       }
     }
 
-    if (getDependency<ScaleFactorMarginalizationConfig>().getIsEnabled()) {
+    auto& marginalization_config = getDependency<ScaleFactorMarginalizationConfig>();
+    if (marginalization_config.getIsEnabled() &&
+        marginalization_config.getMethod() == ScaleFactorMarginalizationConfig::Method::ANALYTIC) {
+
+      m_grid_function = PhzLikelihood::AnalyticMarginalizationLikelihoodGridFunctor{
+          PhzLikelihood::LikelihoodScaleSampleLogarithmAlgorithm{
+              std::move(scale_factor), PhzLikelihood::SigmaScaleFactorFunctor{}, std::move(likelihood_logarithm)}};
+    } else if (marginalization_config.getIsEnabled() &&
+               marginalization_config.getMethod() == ScaleFactorMarginalizationConfig::Method::GAUSS_HERMITE) {
+
+      m_grid_function =
+          PhzLikelihood::ScalingSamplingLikelihoodGridFunctor{PhzLikelihood::LikelihoodScaleSampleLogarithmAlgorithm{
+              std::move(scale_factor), PhzLikelihood::SigmaScaleFactorFunctor{}, std::move(likelihood_logarithm),
+              PhzDataModel::ScaleFactorSampling::gaussHermite(marginalization_config.getSampleNumber())}};
+    } else if (marginalization_config.getIsEnabled()) {
 
       m_grid_function =
           PhzLikelihood::ScalingSamplingLikelihoodGridFunctor{PhzLikelihood::LikelihoodScaleSampleLogarithmAlgorithm{
               std::move(scale_factor), PhzLikelihood::SigmaScaleFactorFunctor{}, std::move(likelihood_logarithm),
-              getDependency<ScaleFactorMarginalizationConfig>().getSampleNumber(),
-              getDependency<ScaleFactorMarginalizationConfig>().getRangeInSigma()}};
+              marginalization_config.getSampleNumber(), marginalization_config.getRangeInSigma()}};
     } else {
       m_grid_function = PhzLikelihood::LikelihoodGridFunctor{
           PhzLikelihood::LikelihoodLogarithmAlgorithm{std::move(scale_factor), std::move(likelihood_logarithm)}};
@@ -106,9 +106,16 @@ void LuminosityPriorConfig::initialize(const UserValues& args) {
 
   if (m_is_configured) {
 
+    auto& marginalization_config = getDependency<ScaleFactorMarginalizationConfig>();
+    if (marginalization_config.getIsEnabled() &&
+        marginalization_config.getMethod() == ScaleFactorMarginalizationConfig::Method::ANALYTIC) {
+      throw Elements::Exception() << "The luminosity prior depends on the scale factor and can not be used with the "
+                                  << "ANALYTIC scale factor marginalization";
+    }
+
     bool inMag = getDependency<LuminosityFunctionConfig>().isExpressedInMagnitude();
 
-    double scale_sampling_range_sigma = getDependency<ScaleFactorMarginalizationConfig>().getRangeInSigma();
+    double scale_sampling_range_sigma = marginalization_config.getRangeInSigma();
 
     // Get a copy of the Luminosity Function
     auto& luminosity_function = getDependency<LuminosityFunctionConfig>().getLuminosityFunction();
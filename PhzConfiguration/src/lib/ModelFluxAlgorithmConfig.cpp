@@ -0,0 +1,81 @@
+/**
+ * Copyright (C) 2022 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file src/lib/ModelFluxAlgorithmConfig.cpp
+ * @date 2026/10/18
+ */
+
+#include "PhzConfiguration/ModelFluxAlgorithmConfig.h"
+#include "ElementsKernel/Exception.h"
+#include <boost/program_options.hpp>
+
+namespace po = boost::program_options;
+
+namespace Euclid {
+namespace PhzConfiguration {
+
+static const std::string MODEL_FLUX_ALGORITHM{"model-flux-algorithm"};
+static const std::string MODEL_FLUX_VALIDATION_TOLERANCE{"model-flux-validation-tolerance"};
+
+ModelFluxAlgorithmConfig::ModelFluxAlgorithmConfig(long manager_id) : Configuration(manager_id) {}
+
+auto ModelFluxAlgorithmConfig::getProgramOptions() -> std::map<std::string, OptionDescriptionList> {
+  return {{"Model flux options",
+           {{MODEL_FLUX_ALGORITHM.c_str(), po::value<std::string>()->default_value("INTERPOLATION"),
+             "The algorithm used for computing the model fluxes (one of INTERPOLATION, PREFIX_INTEGRAL)"},
+            {MODEL_FLUX_VALIDATION_TOLERANCE.c_str(), po::value<double>()->default_value(0.),
+             "If positive, the PREFIX_INTEGRAL fluxes are checked against the INTERPOLATION ones with this "
+             "relative tolerance"}}}};
+}
+
+void ModelFluxAlgorithmConfig::preInitialize(const UserValues& args) {
+  auto algorithm = args.find(MODEL_FLUX_ALGORITHM);
+  if (algorithm != args.end() && algorithm->second.as<std::string>() != "INTERPOLATION" &&
+      algorithm->second.as<std::string>() != "PREFIX_INTEGRAL") {
+    throw Elements::Exception() << "Unknown " << MODEL_FLUX_ALGORITHM << " option \""
+                                << algorithm->second.as<std::string>() << "\"";
+  }
+  auto tolerance = args.find(MODEL_FLUX_VALIDATION_TOLERANCE);
+  if (tolerance != args.end() && tolerance->second.as<double>() < 0) {
+    throw Elements::Exception() << MODEL_FLUX_VALIDATION_TOLERANCE << " must not be negative but was "
+                                << tolerance->second.as<double>();
+  }
+}
+
+void ModelFluxAlgorithmConfig::initialize(const UserValues& args) {
+  auto algorithm = args.find(MODEL_FLUX_ALGORITHM);
+  if (algorithm != args.end() && algorithm->second.as<std::string>() == "PREFIX_INTEGRAL") {
+    m_flux_algorithm = PhzModeling::PhotometryGridCreator::FluxAlgorithm::PREFIX_INTEGRAL;
+  }
+  auto tolerance = args.find(MODEL_FLUX_VALIDATION_TOLERANCE);
+  if (tolerance != args.end()) {
+    m_validation_tolerance = tolerance->second.as<double>();
+  }
+}
+
+PhzModeling::PhotometryGridCreator::FluxAlgorithm ModelFluxAlgorithmConfig::getFluxAlgorithm() const {
+  return m_flux_algorithm;
+}
+
+double ModelFluxAlgorithmConfig::getValidationTolerance() const {
+  return m_validation_tolerance;
+}
+
+}  // namespace PhzConfiguration
+}  // namespace Euclid
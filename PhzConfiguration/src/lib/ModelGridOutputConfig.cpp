@@ -26,9 +26,11 @@
 #include "ElementsKernel/Exception.h"
 #include "ElementsKernel/Logging.h"
 #include "PhzConfiguration/CatalogTypeConfig.h"
+#include "PhzConfiguration/CosmologicalParameterConfig.h"
 #include "PhzConfiguration/GridFileHelper.h"
 #include "PhzConfiguration/IgmConfig.h"
 #include "PhzConfiguration/IntermediateDirConfig.h"
+#include "PhzConfiguration/ModelFluxAlgorithmConfig.h"
 #include "PhzConfiguration/ModelNormalizationConfig.h"
 #include "PhzDataModel/ArchiveFormat.h"
 #include "PhzDataModel/serialization/PhotometryGrid.h"
@@ -56,6 +58,8 @@ ModelGridOutputConfig::ModelGridOutputConfig(long manager_id) : Configuration(ma
   declareDependency<IntermediateDirConfig>();
   declareDependency<IgmConfig>();
   declareDependency<ModelNormalizationConfig>();
+  declareDependency<CosmologicalParameterConfig>();
+  declareDependency<ModelFluxAlgorithmConfig>();
 }
 
 auto ModelGridOutputConfig::getProgramOptions() -> std::map<std::string, OptionDescriptionList> {
@@ -85,14 +89,22 @@ void ModelGridOutputConfig::initialize(const UserValues& args) {
   // Extract file option
   std::string filename = getFilenameFromOptions(args, getDependency<IntermediateDirConfig>().getIntermediateDir(),
                                                 getDependency<CatalogTypeConfig>().getCatalogType(), m_grid_type);
+  m_filename = filename;
 
   // Check directory and write permissions
   Euclid::PhzUtils::checkCreateDirectoryWithFile(filename);
 
   typedef std::function<void(const std::string&, IgmConfig&, XYDataset::QualifiedName&,
+                             const std::map<std::string, std::string>&,
                              const std::map<std::string, PhzDataModel::PhotometryGrid>&)>
       InnerOutputFunction;
 
+  auto& flux_algorithm_config = getDependency<ModelFluxAlgorithmConfig>();
+  m_provenance                = makeGridProvenance(getDependency<CosmologicalParameterConfig>().getCosmologicalParam(),
+                                                   getDependency<ModelNormalizationConfig>().getReferenceSolarSed(),
+                                                   flux_algorithm_config.getFluxAlgorithm(),
+                                                   flux_algorithm_config.getValidationTolerance());
+
   InnerOutputFunction inner_output_function;
 
   std::string output_format_str = "BINARY";
@@ -116,7 +128,7 @@ void ModelGridOutputConfig::initialize(const UserValues& args) {
                        inner_output_function](const std::map<std::string, PhzDataModel::PhotometryGrid>& grid_map) {
     auto igm_config = getDependency<IgmConfig>();
     auto lum_filter = getDependency<ModelNormalizationConfig>().getNormalizationFilter();
-    inner_output_function(filename, igm_config, lum_filter, grid_map);
+    inner_output_function(filename, igm_config, lum_filter, m_provenance, grid_map);
   };
 }
 
@@ -132,5 +144,21 @@ const ModelGridOutputConfig::OutputFunction& ModelGridOutputConfig::getOutputFun
   return m_output_function;
 }
 
+const std::string& ModelGridOutputConfig::getOutputFilename() const {
+  if (getCurrentState() < Configuration::Configuration::State::INITIALIZED) {
+    throw Elements::Exception() << "Call to getOutputFilename() on a not initialized instance.";
+  }
+
+  return m_filename;
+}
+
+const std::map<std::string, std::string>& ModelGridOutputConfig::getProvenance() const {
+  if (getCurrentState() < Configuration::Configuration::State::INITIALIZED) {
+    throw Elements::Exception() << "Call to getProvenance() on a not initialized instance.";
+  }
+
+  return m_provenance;
+}
+
 }  // namespace PhzConfiguration
 }  // namespace Euclid
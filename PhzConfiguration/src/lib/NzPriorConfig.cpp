@@ -69,6 +69,9 @@ static const std::string NZ_PRIOR_CSTT3{"Nz-prior_cst_T3"};
 
 static const std::string NZ_PRIOR_EFFECTIVENESS{"Nz-prior-effectiveness"};
 
+static const std::string NZ_PRIOR_MAGNITUDE_STEP{"Nz-prior-magnitude-step"};
+static const std::string NZ_PRIOR_MAGNITUDE_INTERPOLATION{"Nz-prior-magnitude-interpolation"};
+
 NzPriorConfig::NzPriorConfig(long manager_id) : Configuration(manager_id) {
   declareDependency<PriorConfig>();
   declareDependency<SedProviderConfig>();
@@ -126,6 +129,12 @@ auto NzPriorConfig::getProgramOptions() -> std::map<std::string, OptionDescripti
                 "Value for the Cst' param for T3 region (Default=0.8874)"},
                {NZ_PRIOR_EFFECTIVENESS.c_str(), po::value<double>()->default_value(1.),
                 "A value in the range [0,1] showing how strongly to apply the N(z) prior"},
+               {NZ_PRIOR_MAGNITUDE_STEP.c_str(), po::value<double>()->default_value(0.),
+                "If positive, the N(z) prior is computed once per bin of this width of the I magnitude, and reused for "
+                "all the sources of the bin (default: 0, computed for each source)"},
+               {NZ_PRIOR_MAGNITUDE_INTERPOLATION.c_str(), po::value<std::string>()->default_value("NO"),
+                "If YES, the N(z) prior is interpolated between the two magnitude bins around the source magnitude "
+                "(YES/NO, default: NO)"},
 
            }}};
 }
@@ -145,6 +154,17 @@ void NzPriorConfig::preInitialize(const UserValues& args) {
     if (args.at(NZ_PRIOR_IFILTER).as<std::string>() == "") {
       throw Elements::Exception() << "Missing " << NZ_PRIOR_IFILTER;
     }
+
+    if (args.at(NZ_PRIOR_MAGNITUDE_STEP).as<double>() < 0) {
+      throw Elements::Exception() << "Invalid " << NZ_PRIOR_MAGNITUDE_STEP << " value: "
+                                  << args.at(NZ_PRIOR_MAGNITUDE_STEP).as<double>() << " (must not be negative)";
+    }
+
+    auto& interpolation = args.at(NZ_PRIOR_MAGNITUDE_INTERPOLATION).as<std::string>();
+    if (interpolation != "NO" && interpolation != "YES") {
+      throw Elements::Exception() << "Invalid " << NZ_PRIOR_MAGNITUDE_INTERPOLATION << " value: " << interpolation
+                                  << " (allowed values: YES, NO)";
+    }
   }
 }
 
@@ -181,6 +201,9 @@ void NzPriorConfig::initialize(const UserValues& args) {
 
     double effectiveness = args.at(NZ_PRIOR_EFFECTIVENESS).as<double>();
 
+    double magnitude_step = args.at(NZ_PRIOR_MAGNITUDE_STEP).as<double>();
+    bool   interpolate    = args.at(NZ_PRIOR_MAGNITUDE_INTERPOLATION).as<std::string>() == "YES";
+
     auto param = PhzNzPrior::NzPriorParam(z0_t1, km_t1, alpha_t1, k_t1, f_t1, cst_t1, z0_t2, km_t2, alpha_t2, k_t2,
                                           f_t2, cst_t2, z0_t3, km_t3, alpha_t3, cst_t3);
 
@@ -205,8 +228,11 @@ void NzPriorConfig::initialize(const UserValues& args) {
     // Classify the SEDs
     auto sed_groups = sed_classifier(b_filter, i_filter, SEDs);
 
-    // Add the prior
-    getDependency<PriorConfig>().addPrior(PhzNzPrior::NzPrior(sed_groups, i_filter, param, effectiveness));
+    // Add the prior. The corrected source photometries share the filter names of the grids
+    std::shared_ptr<std::vector<std::string>> grid_filter_names =
+        grids.empty() ? nullptr : grids.begin()->second.getCellManager().filterNamesPtr();
+    getDependency<PriorConfig>().addPrior(PhzNzPrior::NzPrior(sed_groups, i_filter, param, effectiveness,
+                                                              magnitude_step, interpolate, grid_filter_names));
   }
 }
 
@@ -38,6 +38,7 @@
 #include "Configuration/ConfigManager.h"
 #include "Configuration/PhotometricBandMappingConfig.h"
 #include "PhzConfiguration/CatalogTypeConfig.h"
+#include "PhzConfiguration/GridFileHelper.h"
 #include "PhzConfiguration/IntermediateDirConfig.h"
 #include "PhzConfiguration/PhotometryGridConfig.h"
 
@@ -68,17 +69,6 @@ auto PhotometryGridConfig::getProgramOptions() -> std::map<std::string, OptionDe
              "The path and filename of the model grid file"}}}};
 }
 
-template <typename IArchive>
-static void readModelGridFile(std::ifstream& in, PhzDataModel::PhotometryGridInfo& info,
-                              std::map<std::string, PhzDataModel::PhotometryGrid>& grids) {
-  IArchive iarchive{in};
-  iarchive >> info;
-
-  for (auto& pair : info.region_axes_map) {
-    grids.emplace(std::make_pair(pair.first, GridContainer::gridImport<PhzDataModel::PhotometryGrid, IArchive>(in)));
-  }
-}
-
 void PhotometryGridConfig::initialize(const UserValues& args) {
   auto     intermediate_dir = getDependency<IntermediateDirConfig>().getIntermediateDir();
   auto     catalog_type     = getDependency<CatalogTypeConfig>().getCatalogType();
@@ -95,11 +85,11 @@ void PhotometryGridConfig::initialize(const UserValues& args) {
   switch (format) {
   case PhzDataModel::ArchiveFormat::BINARY:
     logger.info() << "Model grid in binary format";
-    readModelGridFile<boost::archive::binary_iarchive>(in, m_info, m_grids);
+    readGridFile<boost::archive::binary_iarchive>(in, m_info, m_grids);
     break;
   case PhzDataModel::ArchiveFormat::TEXT:
     logger.info() << "Model grid in text format";
-    readModelGridFile<boost::archive::text_iarchive>(in, m_info, m_grids);
+    readGridFile<boost::archive::text_iarchive>(in, m_info, m_grids);
     break;
   default:
     throw Elements::Exception() << "Unknown model grid format";
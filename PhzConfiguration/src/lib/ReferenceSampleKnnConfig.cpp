@@ -0,0 +1,176 @@
+/*
+ * Copyright (C) 2022 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file src/lib/ReferenceSampleKnnConfig.cpp
+ * @date 2026/10/18
+ */
+
+#include "PhzConfiguration/ReferenceSampleKnnConfig.h"
+#include "Configuration/CatalogConfig.h"
+#include "Configuration/PhotometricBandMappingConfig.h"
+#include "Configuration/PhotometryCatalogConfig.h"
+#include "ElementsKernel/Logging.h"
+#include "PhzConfiguration/MultithreadConfig.h"
+#include "PhzConfiguration/OutputCatalogConfig.h"
+#include "PhzConfiguration/PhosphorosCatalogConfig.h"
+#include "PhzConfiguration/PhzOutputDirConfig.h"
+#include "PhzOutput/PhzColumnHandlers/Pdf.h"
+#include "Table/FitsReader.h"
+#include <AlexandriaKernel/memory_tools.h>
+#include <boost/filesystem/operations.hpp>
+
+namespace po = boost::program_options;
+namespace fs = boost::filesystem;
+
+using Euclid::make_unique;
+
+namespace Euclid {
+namespace PhzConfiguration {
+
+static Elements::Logging logger = Elements::Logging::getLogger("ReferenceSampleKnnConfig");
+
+static const std::string REFSAMPLE_DIR{"reference-sample-dir"};
+static const std::string REFSAMPLE_PHOTOMETRY{"reference-sample-photometry"};
+static const std::string KNN_NEIGHBOR_NUMBER{"knn-neighbor-number"};
+static const std::string INPUT_BUFFER_SIZE{"input-buffer-size"};
+
+ReferenceSampleKnnConfig::ReferenceSampleKnnConfig(long manager_id) : Configuration(manager_id) {
+  declareDependency<PhosphorosCatalogConfig>();
+  declareDependency<Euclid::Configuration::CatalogConfig>();
+  declareDependency<Euclid::Configuration::PhotometryCatalogConfig>();
+  declareDependency<Euclid::Configuration::PhotometricBandMappingConfig>();
+  declareDependency<OutputCatalogConfig>();
+  declareDependency<PhzOutputDirConfig>();
+  declareDependency<MultithreadConfig>();
+}
+
+auto ReferenceSampleKnnConfig::getProgramOptions() -> std::map<std::string, OptionDescriptionList> {
+  return {{"Reference sample kNN options",
+           {{REFSAMPLE_DIR.c_str(), po::value<std::string>()->required(),
+             "The directory of the reference sample with the neighbour PDZs"},
+            {REFSAMPLE_PHOTOMETRY.c_str(), po::value<std::string>()->required(),
+             "The FITS file with the reference sample photometry, as written by PhosphorosBuildPhotometry"},
+            {KNN_NEIGHBOR_NUMBER.c_str(), po::value<int>()->default_value(20),
+             "The number of neighbours combined for the PDZ of each source"},
+            {INPUT_BUFFER_SIZE.c_str(), po::value<int>()->default_value(5000),
+             "The size of input sources chunk that are kept in memory at the same time"}}}};
+}
+
+void ReferenceSampleKnnConfig::preInitialize(const UserValues& args) {
+  if (args.at(KNN_NEIGHBOR_NUMBER).as<int>() <= 0) {
+    throw Elements::Exception() << "Option " << KNN_NEIGHBOR_NUMBER << " must be bigger than 0";
+  }
+  if (args.at(INPUT_BUFFER_SIZE).as<int>() <= 0) {
+    throw Elements::Exception() << "Option " << INPUT_BUFFER_SIZE << " must be bigger than 0";
+  }
+}
+
+void ReferenceSampleKnnConfig::initialize(const UserValues& args) {
+  m_neighbor_number   = args.at(KNN_NEIGHBOR_NUMBER).as<int>();
+  m_input_buffer_size = args.at(INPUT_BUFFER_SIZE).as<int>();
+
+  m_filter_names.clear();
+  for (auto& pair : getDependency<Euclid::Configuration::PhotometricBandMappingConfig>().getPhotometricBandMapping()) {
+    m_filter_names.push_back(pair.first);
+  }
+
+  m_reference_sample =
+      make_unique<ReferenceSample::ReferenceSample>(args.at(REFSAMPLE_DIR).as<std::string>(), 1073741824, true);
+
+  // The photometry has an ID column and a flux column per filter, named after the filter
+  fs::path photometry_path = args.at(REFSAMPLE_PHOTOMETRY).as<std::string>();
+  if (!fs::exists(photometry_path)) {
+    throw Elements::Exception() << "The reference sample photometry " << photometry_path << " does not exist";
+  }
+  auto table       = Table::FitsReader{photometry_path.native(), 1}.read();
+  auto column_info = table.getColumnInfo();
+  auto id_index    = column_info->find("ID");
+  if (!id_index) {
+    throw Elements::Exception() << "The reference sample photometry " << photometry_path << " has no ID column";
+  }
+  std::vector<std::size_t> flux_indices{};
+  for (auto& filter_name : m_filter_names) {
+    auto flux_index = column_info->find(filter_name);
+    if (!flux_index) {
+      throw Elements::Exception() << "The reference sample photometry " << photometry_path << " has no column for "
+                                  << filter_name;
+    }
+    flux_indices.emplace_back(*flux_index);
+  }
+
+  m_reference_fluxes.clear();
+  m_reference_fluxes.reserve(table.size());
+  for (auto& row : table) {
+    std::vector<double> fluxes{};
+    fluxes.reserve(flux_indices.size());
+    for (auto flux_index : flux_indices) {
+      fluxes.emplace_back(boost::get<float>(row[flux_index]));
+    }
+    m_reference_fluxes.emplace_back(boost::get<int64_t>(row[*id_index]), std::move(fluxes));
+  }
+  logger.info() << "Read the photometry of " << m_reference_fluxes.size() << " reference objects";
+
+  getDependency<OutputCatalogConfig>().addColumnHandler(std::unique_ptr<PhzOutput::ColumnHandler>{
+      new PhzOutput::ColumnHandlers::Pdf<PhzDataModel::GridType::POSTERIOR, PhzDataModel::ModelParameter::Z>{}});
+}
+
+const ReferenceSample::ReferenceSample& ReferenceSampleKnnConfig::getReferenceSample() const {
+  if (getCurrentState() < Configuration::Configuration::State::INITIALIZED) {
+    throw Elements::Exception() << "Call to getReferenceSample() on a not initialized instance.";
+  }
+  return *m_reference_sample;
+}
+
+const std::vector<std::string>& ReferenceSampleKnnConfig::getFilterNames() const {
+  if (getCurrentState() < Configuration::Configuration::State::INITIALIZED) {
+    throw Elements::Exception() << "Call to getFilterNames() on a not initialized instance.";
+  }
+  return m_filter_names;
+}
+
+const std::vector<std::pair<int64_t, std::vector<double>>>& ReferenceSampleKnnConfig::getReferenceFluxes() const {
+  if (getCurrentState() < Configuration::Configuration::State::INITIALIZED) {
+    throw Elements::Exception() << "Call to getReferenceFluxes() on a not initialized instance.";
+  }
+  return m_reference_fluxes;
+}
+
+std::size_t ReferenceSampleKnnConfig::getNeighborNumber() const {
+  if (getCurrentState() < Configuration::Configuration::State::INITIALIZED) {
+    throw Elements::Exception() << "Call to getNeighborNumber() on a not initialized instance.";
+  }
+  return m_neighbor_number;
+}
+
+std::size_t ReferenceSampleKnnConfig::getInputBufferSize() const {
+  if (getCurrentState() < Configuration::Configuration::State::INITIALIZED) {
+    throw Elements::Exception() << "Call to getInputBufferSize() on a not initialized instance.";
+  }
+  return m_input_buffer_size;
+}
+
+std::unique_ptr<PhzOutput::OutputHandler> ReferenceSampleKnnConfig::getOutputHandler() const {
+  if (getCurrentState() < Configuration::Configuration::State::INITIALIZED) {
+    throw Elements::Exception() << "Call to getOutputHandler() on a not initialized instance.";
+  }
+  return getDependency<OutputCatalogConfig>().getOutputHandler();
+}
+
+}  // namespace PhzConfiguration
+}  // namespace Euclid
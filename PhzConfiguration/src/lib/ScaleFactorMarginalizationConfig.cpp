@@ -39,9 +39,13 @@ static Elements::Logging logger = Elements::Logging::getLogger("PhzConfiguration
 static const std::string SCALE_FACTOR_MARGINALIZATION_ENABLED{"scale-factor-marginalization-enabled"};
 static const std::string SCALE_FACTOR_SAMPLE_NUMBER{"scale-factor-marginalization-sample-number"};
 static const std::string SCALE_FACTOR_RANGE{"scale-factor-marginalization-range-size"};
+static const std::string SCALE_FACTOR_METHOD{"scale-factor-marginalization-method"};
 
 ScaleFactorMarginalizationConfig::ScaleFactorMarginalizationConfig(long manager_id)
-    : Configuration(manager_id), m_sample_number(101), m_range_in_sigma(5) {}
+    : Configuration(manager_id)
+    , m_sample_number(101)
+    , m_range_in_sigma(5)
+    , m_method(Method::UNIFORM) {}
 
 auto ScaleFactorMarginalizationConfig::getProgramOptions() -> std::map<std::string, OptionDescriptionList> {
   return {{"Scale factor marginalization options",
@@ -51,7 +55,13 @@ auto ScaleFactorMarginalizationConfig::getProgramOptions() -> std::map<std::stri
              "Number of sample for the scale factor marginalization (must be bigger than 2, default: 101)"},
             {SCALE_FACTOR_RANGE.c_str(), po::value<double>()->default_value(5.),
              "Range (express in multiple of sigma) for the sampling of the scale factor (default:5 ie: [-5 sigma; 5 "
-             "sigma])"}}}};
+             "sigma], not used by the GAUSS_HERMITE method)"},
+            {SCALE_FACTOR_METHOD.c_str(), po::value<std::string>()->default_value("UNIFORM"),
+             "How the scale factor is marginalized: UNIFORM (evenly spaced samples in the range), GAUSS_HERMITE (the "
+             "nodes of a Gauss-Hermite quadrature centred on the best scale factor and scaled by its sigma, for which "
+             "8 to 16 samples are usually enough, not compatible with the likelihood and posterior outputs) or "
+             "ANALYTIC (no sampling, the likelihood is integrated as a Gaussian around the best scale factor, not "
+             "compatible with the luminosity prior) (default: UNIFORM)"}}}};
 }
 
 void ScaleFactorMarginalizationConfig::preInitialize(const UserValues& args) {
@@ -71,6 +81,14 @@ void ScaleFactorMarginalizationConfig::preInitialize(const UserValues& args) {
         throw Elements::Exception() << SCALE_FACTOR_RANGE << " value must be bigger than 0";
       }
     }
+
+    if (args.count(SCALE_FACTOR_METHOD) == 1) {
+      auto method = args.at(SCALE_FACTOR_METHOD).as<std::string>();
+      if (method != "UNIFORM" && method != "GAUSS_HERMITE" && method != "ANALYTIC") {
+        throw Elements::Exception() << "Invalid " << SCALE_FACTOR_METHOD << " value: " << method
+                                    << " (allowed values: UNIFORM, GAUSS_HERMITE, ANALYTIC)";
+      }
+    }
   }
 }
 
@@ -90,6 +108,14 @@ void ScaleFactorMarginalizationConfig::initialize(const UserValues& args) {
     } else {
       m_range_in_sigma = 5.0;
     }
+    auto method = args.count(SCALE_FACTOR_METHOD) == 1 ? args.at(SCALE_FACTOR_METHOD).as<std::string>() : "";
+    if (method == "GAUSS_HERMITE") {
+      m_method = Method::GAUSS_HERMITE;
+    } else if (method == "ANALYTIC") {
+      m_method = Method::ANALYTIC;
+    } else {
+      m_method = Method::UNIFORM;
+    }
   }
 }
 
@@ -114,5 +140,12 @@ double ScaleFactorMarginalizationConfig::getRangeInSigma() const {
   return m_range_in_sigma;
 }
 
+ScaleFactorMarginalizationConfig::Method ScaleFactorMarginalizationConfig::getMethod() const {
+  if (getCurrentState() < Configuration::Configuration::State::INITIALIZED) {
+    throw Elements::Exception() << "Call to getMethod() on a not initialized instance.";
+  }
+  return m_method;
+}
+
 }  // namespace PhzConfiguration
 }  // namespace Euclid
@@ -33,6 +33,7 @@ struct BuildReferenceSampleConfig_fixture : public ConfigManager_fixture {
   const std::string REFSAMPLE_DIR{"reference-sample-dir"};
   const std::string PHOSPHOROS_CATALOG{"phosphoros-catalog"};
   const std::string PHOSPHOROS_CATALOG_FORMAT{"phosphoros-catalog-format"};
+  const std::string REFSAMPLE_STORAGE{"reference-sample-storage"};
 };
 
 //-----------------------------------------------------------------------------
@@ -53,6 +54,7 @@ BOOST_FIXTURE_TEST_CASE(getProgramOptions_test, BuildReferenceSampleConfig_fixtu
   BOOST_CHECK_NO_THROW(options.find(REFSAMPLE_DIR, false));
   BOOST_CHECK_NO_THROW(options.find(PHOSPHOROS_CATALOG, false));
   BOOST_CHECK_NO_THROW(options.find(PHOSPHOROS_CATALOG_FORMAT, false));
+  BOOST_CHECK_NO_THROW(options.find(REFSAMPLE_STORAGE, false));
 }
 //-----------------------------------------------------------------------------
 
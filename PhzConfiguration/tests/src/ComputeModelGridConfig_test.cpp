@@ -29,6 +29,7 @@
 #include <iostream>
 
 #include "ConfigManager_fixture.h"
+#include "ElementsKernel/Exception.h"
 #include "PhzConfiguration/ComputeModelGridConfig.h"
 #include "PhzConfiguration/IgmConfig.h"
 #include "PhzConfiguration/ModelGridOutputConfig.h"
@@ -164,6 +165,7 @@ BOOST_FIXTURE_TEST_CASE(checkDependency_test, ConfigManager_fixture) {
   options_map["cosmology-omega-m"].value()         = boost::any(omega_m);
   options_map["cosmology-omega-lambda"].value()    = boost::any(omega_lambda);
   options_map["cosmology-hubble-constant"].value() = boost::any(h_0);
+  options_map["model-grid-memory-limit"].value()   = boost::any(512);
 
   // When
   config_manager.initialize(options_map);
@@ -172,6 +174,30 @@ BOOST_FIXTURE_TEST_CASE(checkDependency_test, ConfigManager_fixture) {
   BOOST_CHECK_NO_THROW(config_manager.getConfiguration<ModelGridOutputConfig>());
   BOOST_CHECK_NO_THROW(config_manager.getConfiguration<IgmConfig>());
   BOOST_CHECK_NO_THROW(config_manager.getConfiguration<ParameterSpaceConfig>());
+  BOOST_CHECK_EQUAL(config_manager.getConfiguration<ComputeModelGridConfig>().getMemoryLimit(), 512ul * 1024 * 1024);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(memoryLimit_test, ConfigManager_fixture) {
+
+  // Given
+  config_manager.registerConfiguration<ComputeModelGridConfig>();
+  auto options = config_manager.closeRegistration();
+
+  // Then
+  BOOST_CHECK_NO_THROW(options.find("model-grid-memory-limit", false));
+
+  // Given
+  ComputeModelGridConfig                    config{timestamp};
+  std::map<std::string, po::variable_value> options_map;
+  options_map["model-grid-memory-limit"].value() = boost::any(0);
+
+  // Then
+  BOOST_CHECK_NO_THROW(config.preInitialize(options_map));
+
+  options_map["model-grid-memory-limit"].value() = boost::any(-1);
+  BOOST_CHECK_THROW(config.preInitialize(options_map), Elements::Exception);
 }
 
 //-----------------------------------------------------------------------------
@@ -25,9 +25,11 @@
 #include <boost/test/unit_test.hpp>
 
 #include "ConfigManager_fixture.h"
+#include "ElementsKernel/Exception.h"
 #include "PhzConfiguration/ComputePhotometricCorrectionsConfig.h"
 
 using namespace Euclid::PhzConfiguration;
+namespace po = boost::program_options;
 
 struct ComputePhotometricCorrectionsConfig_fixture : public ConfigManager_fixture {
 
@@ -35,6 +37,10 @@ struct ComputePhotometricCorrectionsConfig_fixture : public ConfigManager_fixtur
   const std::string PHOT_CORR_ITER_NO{"phot-corr-iter-no"};
   const std::string PHOT_CORR_TOLERANCE{"phot-corr-tolerance"};
   const std::string PHOT_CORR_SELECTION_METHOD{"phot-corr-selection-method"};
+  const std::string PHOT_CORR_WARM_START{"phot-corr-warm-start"};
+  const std::string PHOT_CORR_NEIGHBOURHOOD_EBV{"phot-corr-neighbourhood-ebv"};
+  const std::string PHOT_CORR_NEIGHBOURHOOD_REDDENING_CURVE{"phot-corr-neighbourhood-reddening-curve"};
+  const std::string PHOT_CORR_NEIGHBOURHOOD_SED{"phot-corr-neighbourhood-sed"};
 };
 
 //-----------------------------------------------------------------------------
@@ -56,7 +62,34 @@ BOOST_FIXTURE_TEST_CASE(getProgramOptions_test, ComputePhotometricCorrectionsCon
   BOOST_CHECK_NO_THROW(options.find(PHOT_CORR_ITER_NO, false));
   BOOST_CHECK_NO_THROW(options.find(PHOT_CORR_TOLERANCE, false));
   BOOST_CHECK_NO_THROW(options.find(PHOT_CORR_SELECTION_METHOD, false));
+  BOOST_CHECK_NO_THROW(options.find(PHOT_CORR_WARM_START, false));
+  BOOST_CHECK_NO_THROW(options.find(PHOT_CORR_NEIGHBOURHOOD_EBV, false));
+  BOOST_CHECK_NO_THROW(options.find(PHOT_CORR_NEIGHBOURHOOD_REDDENING_CURVE, false));
+  BOOST_CHECK_NO_THROW(options.find(PHOT_CORR_NEIGHBOURHOOD_SED, false));
 }
 //-----------------------------------------------------------------------------
 
+BOOST_FIXTURE_TEST_CASE(preInitialize_neighbourhood_test, ComputePhotometricCorrectionsConfig_fixture) {
+
+  // Given
+  ComputePhotometricCorrectionsConfig       config{timestamp};
+  std::map<std::string, po::variable_value> options_map{};
+  options_map[PHOT_CORR_SELECTION_METHOD].value()              = boost::any(std::string{"MEDIAN"});
+  options_map[PHOT_CORR_WARM_START].value()                    = boost::any(std::string{"YES"});
+  options_map[PHOT_CORR_NEIGHBOURHOOD_EBV].value()             = boost::any(2);
+  options_map[PHOT_CORR_NEIGHBOURHOOD_REDDENING_CURVE].value() = boost::any(1);
+  options_map[PHOT_CORR_NEIGHBOURHOOD_SED].value()             = boost::any(2);
+
+  // Then
+  BOOST_CHECK_NO_THROW(config.preInitialize(options_map));
+
+  options_map[PHOT_CORR_NEIGHBOURHOOD_REDDENING_CURVE].value() = boost::any(0);
+  BOOST_CHECK_THROW(config.preInitialize(options_map), Elements::Exception);
+
+  options_map[PHOT_CORR_NEIGHBOURHOOD_REDDENING_CURVE].value() = boost::any(-1);
+  BOOST_CHECK_THROW(config.preInitialize(options_map), Elements::Exception);
+}
+
+//-----------------------------------------------------------------------------
+
 BOOST_AUTO_TEST_SUITE_END()
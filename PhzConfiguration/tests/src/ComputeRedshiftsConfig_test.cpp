@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2022 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file tests/src/ComputeRedshiftsConfig_test.cpp
+ * @date 2026/10/18
+ */
+
+#include "ConfigManager_fixture.h"
+#include "Configuration/ConfigManager.h"
+#include "ElementsKernel/Exception.h"
+#include "PhzConfiguration/ComputeRedshiftsConfig.h"
+#include "PhzConfiguration/ScaleFactorMarginalizationConfig.h"
+#include <boost/test/unit_test.hpp>
+
+using namespace Euclid;
+using namespace Euclid::PhzConfiguration;
+namespace po = boost::program_options;
+
+struct ComputeRedshiftsConfig_fixture : public ConfigManager_fixture {
+
+  std::map<std::string, po::variable_value> options_map{};
+
+  ComputeRedshiftsConfig_fixture() {
+    config_manager.registerConfiguration<ScaleFactorMarginalizationConfig>();
+    config_manager.closeRegistration();
+  }
+
+  const ScaleFactorMarginalizationConfig& initializeScaleFactor(const std::string& enabled, const std::string& method) {
+    options_map["scale-factor-marginalization-enabled"].value() = boost::any(enabled);
+    options_map["scale-factor-marginalization-method"].value()  = boost::any(method);
+    config_manager.initialize(options_map);
+    return config_manager.getConfiguration<ScaleFactorMarginalizationConfig>();
+  }
+};
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE(ComputeRedshiftsConfig_test)
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(useScaleSampledOutputs_disabled_test, ComputeRedshiftsConfig_fixture) {
+  auto& scale_factor_config = initializeScaleFactor("NO", "UNIFORM");
+  BOOST_CHECK(!ComputeRedshiftsConfig::useScaleSampledOutputs(scale_factor_config));
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(useScaleSampledOutputs_uniform_test, ComputeRedshiftsConfig_fixture) {
+  auto& scale_factor_config = initializeScaleFactor("YES", "UNIFORM");
+  BOOST_CHECK(ComputeRedshiftsConfig::useScaleSampledOutputs(scale_factor_config));
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(useScaleSampledOutputs_analytic_test, ComputeRedshiftsConfig_fixture) {
+  // The analytic marginalization does not fill the sampled grids, so the plain likelihood outputs must be used
+  auto& scale_factor_config = initializeScaleFactor("YES", "ANALYTIC");
+  BOOST_CHECK(!ComputeRedshiftsConfig::useScaleSampledOutputs(scale_factor_config));
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(checkScaleSampledOutputs_test, ComputeRedshiftsConfig_fixture) {
+  // The sampled outputs expect evenly spaced scale factor samples
+  auto& scale_factor_config = initializeScaleFactor("YES", "GAUSS_HERMITE");
+  BOOST_CHECK_THROW(ComputeRedshiftsConfig::checkScaleSampledOutputs(scale_factor_config), Elements::Exception);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(checkScaleSampledOutputs_uniform_test, ComputeRedshiftsConfig_fixture) {
+  auto& scale_factor_config = initializeScaleFactor("YES", "UNIFORM");
+  BOOST_CHECK_NO_THROW(ComputeRedshiftsConfig::checkScaleSampledOutputs(scale_factor_config));
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,106 @@
+/**
+ * Copyright (C) 2022 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file tests/src/ModelFluxAlgorithmConfig_test.cpp
+ * @date 2026/10/18
+ */
+
+#include "ConfigManager_fixture.h"
+#include "PhzConfiguration/ModelFluxAlgorithmConfig.h"
+#include <boost/test/unit_test.hpp>
+
+using namespace Euclid::PhzConfiguration;
+using Euclid::PhzModeling::PhotometryGridCreator;
+namespace po = boost::program_options;
+
+namespace {
+
+const std::string MODEL_FLUX_ALGORITHM{"model-flux-algorithm"};
+const std::string MODEL_FLUX_VALIDATION_TOLERANCE{"model-flux-validation-tolerance"};
+
+}  // namespace
+
+struct ModelFluxAlgorithmConfig_fixture : public ConfigManager_fixture {
+
+  std::map<std::string, po::variable_value> options_map{};
+
+  ModelFluxAlgorithmConfig_fixture() {
+    options_map = registerConfigAndGetDefaultOptionsMap<ModelFluxAlgorithmConfig>();
+  }
+};
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE(ModelFluxAlgorithmConfig_test)
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(default_value, ModelFluxAlgorithmConfig_fixture) {
+
+  // When
+  config_manager.initialize(options_map);
+  auto& config = config_manager.getConfiguration<ModelFluxAlgorithmConfig>();
+
+  // Then
+  BOOST_CHECK(config.getFluxAlgorithm() == PhotometryGridCreator::FluxAlgorithm::INTERPOLATION);
+  BOOST_CHECK_EQUAL(config.getValidationTolerance(), 0.);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(prefix_integral, ModelFluxAlgorithmConfig_fixture) {
+
+  // Given
+  options_map[MODEL_FLUX_ALGORITHM].value()            = boost::any(std::string{"PREFIX_INTEGRAL"});
+  options_map[MODEL_FLUX_VALIDATION_TOLERANCE].value() = boost::any(1E-3);
+
+  // When
+  config_manager.initialize(options_map);
+  auto& config = config_manager.getConfiguration<ModelFluxAlgorithmConfig>();
+
+  // Then
+  BOOST_CHECK(config.getFluxAlgorithm() == PhotometryGridCreator::FluxAlgorithm::PREFIX_INTEGRAL);
+  BOOST_CHECK_EQUAL(config.getValidationTolerance(), 1E-3);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(invalid_values, ModelFluxAlgorithmConfig_fixture) {
+
+  // Given
+  options_map[MODEL_FLUX_ALGORITHM].value() = boost::any(std::string{"UNKNOWN"});
+
+  // Then
+  BOOST_CHECK_THROW(config_manager.initialize(options_map), Elements::Exception);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(negative_tolerance, ModelFluxAlgorithmConfig_fixture) {
+
+  // Given
+  options_map[MODEL_FLUX_VALIDATION_TOLERANCE].value() = boost::any(-1.);
+
+  // Then
+  BOOST_CHECK_THROW(config_manager.initialize(options_map), Elements::Exception);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -35,6 +35,7 @@
 #include "ElementsKernel/Auxiliary.h"
 #include "ElementsKernel/Temporary.h"
 #include "GridContainer/serialize.h"
+#include "PhzConfiguration/IncrementalGridConfig.h"
 #include "PhzConfiguration/ModelGridOutputConfig.h"
 #include "PhzDataModel/serialization/PhotometryGrid.h"
 #include "PhzDataModel/serialization/PhotometryGridInfo.h"
@@ -373,4 +374,95 @@ BOOST_FIXTURE_TEST_CASE_TEMPLATE(getOutputFunctionDefault_test, T, archive_types
 
 //-----------------------------------------------------------------------------
 
+//-----------------------------------------------------------------------------
+// Test the grid written can be extended only with the same provenance
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(incrementalProvenance_test, ModelGridOutputConfig_fixture) {
+  // Given
+  config_manager.registerConfiguration<ModelGridOutputConfig>();
+  config_manager.registerConfiguration<IncrementalGridConfig>();
+  config_manager.closeRegistration();
+
+  options_map["output-model-grid"].value()       = (temp_dir.path() / "incremental.dat").string();
+  options_map["incremental-grid-build"].value()  = std::string{"YES"};
+  options_map["normalization-solar-sed"].value() = boost::any(solar_sed);
+  std::vector<Euclid::XYDataset::QualifiedName> filter_names{{"filter1"}, {"filter2"}};
+
+  config_manager.initialize(options_map);
+  auto& output_config      = config_manager.getConfiguration<ModelGridOutputConfig>();
+  auto& incremental_config = config_manager.getConfiguration<IncrementalGridConfig>();
+  auto& provenance         = output_config.getProvenance();
+  BOOST_CHECK_EQUAL(provenance.at("solar-sed"), solar_sed);
+  BOOST_CHECK_EQUAL(provenance.at("model-flux-algorithm"), "INTERPOLATION");
+  BOOST_CHECK(
+      incremental_config.readExistingGrids(output_config.getOutputFilename(), filter_names, provenance).empty());
+
+  auto                                 axes = Euclid::PhzDataModel::createAxesTuple(zs, ebvs, reddeing_curves, seds);
+  Euclid::PhzDataModel::PhotometryGrid original_grid{axes, *filter_1};
+  original_grid(0, 0, 0, 0) = photometry_1;
+  std::map<std::string, Euclid::PhzDataModel::PhotometryGrid> grid_map{};
+  grid_map.emplace(std::make_pair(std::string(""), std::move(original_grid)));
+  output_config.getOutputFunction()(grid_map);
+
+  // When
+  auto existing = incremental_config.readExistingGrids(output_config.getOutputFilename(), filter_names, provenance);
+
+  // Then
+  BOOST_CHECK_EQUAL(existing.size(), 1);
+  BOOST_CHECK_EQUAL(existing.at("").size(), 4);
+  BOOST_CHECK_EQUAL(existing.at("")(0, 0, 0, 0).find("filter1")->flux, 1.1);
+  std::vector<Euclid::XYDataset::QualifiedName> other_filter_names{{"filter1"}, {"filter3"}};
+  BOOST_CHECK_THROW(
+      incremental_config.readExistingGrids(output_config.getOutputFilename(), other_filter_names, provenance),
+      Elements::Exception);
+
+  // A different reference solar SED, or a parameter the grid does not record
+  auto other_provenance         = provenance;
+  other_provenance["solar-sed"] = "other_solar_sed";
+  BOOST_CHECK_THROW(
+      incremental_config.readExistingGrids(output_config.getOutputFilename(), filter_names, other_provenance),
+      Elements::Exception);
+  other_provenance                              = provenance;
+  other_provenance["milky-way-reddening-curve"] = "F99/F99_3.1";
+  BOOST_CHECK_THROW(
+      incremental_config.readExistingGrids(output_config.getOutputFilename(), filter_names, other_provenance),
+      Elements::Exception);
+  other_provenance                         = provenance;
+  other_provenance["model-flux-algorithm"] = "PREFIX_INTEGRAL";
+  BOOST_CHECK_THROW(
+      incremental_config.readExistingGrids(output_config.getOutputFilename(), filter_names, other_provenance),
+      Elements::Exception);
+
+  // Given
+  auto& other_manager = Euclid::Configuration::ConfigManager::getInstance(Euclid::Configuration::getUniqueManagerId());
+  other_manager.registerConfiguration<ModelGridOutputConfig>();
+  other_manager.registerConfiguration<IncrementalGridConfig>();
+  other_manager.closeRegistration();
+  options_map["cosmology-hubble-constant"].value() = 50.;
+  other_manager.initialize(options_map);
+  auto& other_provenance_config = other_manager.getConfiguration<ModelGridOutputConfig>();
+
+  // Then
+  BOOST_CHECK_THROW(other_manager.getConfiguration<IncrementalGridConfig>().readExistingGrids(
+                        output_config.getOutputFilename(), filter_names, other_provenance_config.getProvenance()),
+                    Elements::Exception);
+
+  // Given
+  auto& prefix_manager = Euclid::Configuration::ConfigManager::getInstance(Euclid::Configuration::getUniqueManagerId());
+  prefix_manager.registerConfiguration<ModelGridOutputConfig>();
+  prefix_manager.registerConfiguration<IncrementalGridConfig>();
+  prefix_manager.closeRegistration();
+  options_map.erase("cosmology-hubble-constant");
+  options_map["model-flux-algorithm"].value() = std::string{"PREFIX_INTEGRAL"};
+  prefix_manager.initialize(options_map);
+  auto& prefix_provenance_config = prefix_manager.getConfiguration<ModelGridOutputConfig>();
+
+  // Then
+  BOOST_CHECK_EQUAL(prefix_provenance_config.getProvenance().at("model-flux-algorithm"), "PREFIX_INTEGRAL");
+  BOOST_CHECK_THROW(prefix_manager.getConfiguration<IncrementalGridConfig>().readExistingGrids(
+                        output_config.getOutputFilename(), filter_names, prefix_provenance_config.getProvenance()),
+                    Elements::Exception);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,91 @@
+/*
+ * Copyright (C) 2022 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file tests/src/ReferenceSampleKnnConfig_test.cpp
+ * @date 2026/10/18
+ */
+
+#include <boost/test/unit_test.hpp>
+
+#include "ConfigManager_fixture.h"
+#include "ElementsKernel/Exception.h"
+#include "PhzConfiguration/ReferenceSampleKnnConfig.h"
+
+using namespace Euclid::PhzConfiguration;
+namespace po = boost::program_options;
+
+struct ReferenceSampleKnnConfig_fixture : public ConfigManager_fixture {
+
+  const std::string REFSAMPLE_DIR{"reference-sample-dir"};
+  const std::string REFSAMPLE_PHOTOMETRY{"reference-sample-photometry"};
+  const std::string KNN_NEIGHBOR_NUMBER{"knn-neighbor-number"};
+  const std::string INPUT_BUFFER_SIZE{"input-buffer-size"};
+
+  std::map<std::string, po::variable_value> options_map{};
+
+  ReferenceSampleKnnConfig_fixture() {
+    options_map[REFSAMPLE_DIR].value()        = boost::any(std::string{"/reference_sample"});
+    options_map[REFSAMPLE_PHOTOMETRY].value() = boost::any(std::string{"/reference_photometry.fits"});
+    options_map[KNN_NEIGHBOR_NUMBER].value()  = boost::any(20);
+    options_map[INPUT_BUFFER_SIZE].value()    = boost::any(5000);
+  }
+};
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE(ReferenceSampleKnnConfig_test)
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(getProgramOptions_test, ReferenceSampleKnnConfig_fixture) {
+
+  // Given
+  config_manager.registerConfiguration<ReferenceSampleKnnConfig>();
+
+  // When
+  auto options = config_manager.closeRegistration();
+
+  // Then
+  BOOST_CHECK_NO_THROW(options.find(REFSAMPLE_DIR, false));
+  BOOST_CHECK_NO_THROW(options.find(REFSAMPLE_PHOTOMETRY, false));
+  BOOST_CHECK_NO_THROW(options.find(KNN_NEIGHBOR_NUMBER, false));
+  BOOST_CHECK_NO_THROW(options.find(INPUT_BUFFER_SIZE, false));
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(preInitialize_test, ReferenceSampleKnnConfig_fixture) {
+
+  // Given
+  ReferenceSampleKnnConfig config{timestamp};
+
+  // Then
+  BOOST_CHECK_NO_THROW(config.preInitialize(options_map));
+
+  options_map[KNN_NEIGHBOR_NUMBER].value() = boost::any(0);
+  BOOST_CHECK_THROW(config.preInitialize(options_map), Elements::Exception);
+
+  options_map[KNN_NEIGHBOR_NUMBER].value() = boost::any(20);
+  options_map[INPUT_BUFFER_SIZE].value()   = boost::any(-1);
+  BOOST_CHECK_THROW(config.preInitialize(options_map), Elements::Exception);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END()
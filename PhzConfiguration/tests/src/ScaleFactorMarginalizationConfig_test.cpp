@@ -50,6 +50,7 @@ BOOST_AUTO_TEST_CASE(getProgramOptions_test) {
   BOOST_CHECK_NO_THROW(options.find("scale-factor-marginalization-enabled", false));
   BOOST_CHECK_NO_THROW(options.find("scale-factor-marginalization-sample-number", false));
   BOOST_CHECK_NO_THROW(options.find("scale-factor-marginalization-range-size", false));
+  BOOST_CHECK_NO_THROW(options.find("scale-factor-marginalization-method", false));
 }
 
 //-----------------------------------------------------------------------------
@@ -88,6 +89,8 @@ BOOST_AUTO_TEST_CASE(default_values_param_test) {
   BOOST_CHECK_EQUAL(config_manager.getConfiguration<ScaleFactorMarginalizationConfig>().getIsEnabled(), true);
   BOOST_CHECK_EQUAL(config_manager.getConfiguration<ScaleFactorMarginalizationConfig>().getSampleNumber(), 101);
   BOOST_CHECK_CLOSE(config_manager.getConfiguration<ScaleFactorMarginalizationConfig>().getRangeInSigma(), 5.0, 0.001);
+  BOOST_CHECK(config_manager.getConfiguration<ScaleFactorMarginalizationConfig>().getMethod() ==
+              ScaleFactorMarginalizationConfig::Method::UNIFORM);
 }
 
 //-----------------------------------------------------------------------------
@@ -199,4 +202,75 @@ BOOST_AUTO_TEST_CASE(exception_range_test) {
 
 //-----------------------------------------------------------------------------
 
+BOOST_AUTO_TEST_CASE(getMethod_GAUSS_HERMITE_test) {
+
+  long timestamp = Euclid::Configuration::getUniqueManagerId();
+
+  Euclid::Configuration::ConfigManager& config_manager = Euclid::Configuration::ConfigManager::getInstance(timestamp);
+  config_manager.registerConfiguration<ScaleFactorMarginalizationConfig>();
+  config_manager.closeRegistration();
+
+  std::map<std::string, po::variable_value> options_map{};
+
+  int         param_number = 12;
+  std::string param        = "YES";
+  std::string method       = "GAUSS_HERMITE";
+
+  options_map["scale-factor-marginalization-enabled"].value()       = boost::any(param);
+  options_map["scale-factor-marginalization-sample-number"].value() = boost::any(param_number);
+  options_map["scale-factor-marginalization-method"].value()        = boost::any(method);
+
+  config_manager.initialize(options_map);
+
+  BOOST_CHECK(config_manager.getConfiguration<ScaleFactorMarginalizationConfig>().getMethod() ==
+              ScaleFactorMarginalizationConfig::Method::GAUSS_HERMITE);
+  BOOST_CHECK_EQUAL(config_manager.getConfiguration<ScaleFactorMarginalizationConfig>().getSampleNumber(), 12);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(getMethod_ANALYTIC_test) {
+
+  long timestamp = Euclid::Configuration::getUniqueManagerId();
+
+  Euclid::Configuration::ConfigManager& config_manager = Euclid::Configuration::ConfigManager::getInstance(timestamp);
+  config_manager.registerConfiguration<ScaleFactorMarginalizationConfig>();
+  config_manager.closeRegistration();
+
+  std::map<std::string, po::variable_value> options_map{};
+
+  std::string param  = "YES";
+  std::string method = "ANALYTIC";
+
+  options_map["scale-factor-marginalization-enabled"].value() = boost::any(param);
+  options_map["scale-factor-marginalization-method"].value()  = boost::any(method);
+
+  config_manager.initialize(options_map);
+
+  BOOST_CHECK(config_manager.getConfiguration<ScaleFactorMarginalizationConfig>().getMethod() ==
+              ScaleFactorMarginalizationConfig::Method::ANALYTIC);
+}
+
+//-----------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(exception_method_test) {
+
+  long timestamp = Euclid::Configuration::getUniqueManagerId();
+
+  Euclid::Configuration::ConfigManager& config_manager = Euclid::Configuration::ConfigManager::getInstance(timestamp);
+  config_manager.registerConfiguration<ScaleFactorMarginalizationConfig>();
+  config_manager.closeRegistration();
+
+  std::map<std::string, po::variable_value> options_map{};
+
+  std::string method                                         = "SIMPSON";
+  options_map["scale-factor-marginalization-method"].value() = boost::any(method);
+
+  std::string param                                           = "YES";
+  options_map["scale-factor-marginalization-enabled"].value() = boost::any(param);
+
+  BOOST_CHECK_THROW(config_manager.initialize(options_map), Elements::Exception);
+}
+
+//-----------------------------------------------------------------------------
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -26,16 +26,286 @@
 #define PHZDATAMODEL_DOUBLELISTGRID_H
 
 #include "PhzDataModel/PhzModel.h"
+#include <GridContainer/GridCellManagerTraits.h>
+#include <algorithm>
+#include <cassert>
+#include <memory>
 #include <vector>
 
 namespace Euclid {
 namespace PhzDataModel {
 
-typedef std::vector<std::vector<double>> DoubleListCellManager;
+/**
+ * @brief Handle the cells storing a list of samples (the scale factor samples) for each model of the grid
+ * @details
+ * To avoid allocating one vector of samples per cell, this cell manager does one single allocation of
+ * n.cells * n.samples, so a grid is a dense 5-D array, with the sample as the fastest axis.
+ * Iterating over the grid yields a proxy object, referencing the samples of a single cell, which can be iterated
+ * and indexed as a std::vector<double> of fixed size.
+ */
+class DoubleListCellManager {
+public:
+  /**
+   * Proxy class for the samples of a cell.
+   * @note A DoubleListProxy is the reference *and* the pointer type for a cell inside a DoubleListGrid.
+   */
+  class DoubleListProxy {
+  public:
+    typedef double*       iterator;
+    typedef const double* const_iterator;
+
+    DoubleListProxy(const DoubleListProxy&) = default;
+
+    iterator begin() {
+      return m_begin;
+    }
+
+    iterator end() {
+      return m_end;
+    }
+
+    const_iterator begin() const {
+      return m_begin;
+    }
+
+    const_iterator end() const {
+      return m_end;
+    }
+
+    std::size_t size() const {
+      return m_end - m_begin;
+    }
+
+    double& operator[](std::size_t i) {
+      return m_begin[i];
+    }
+
+    const double& operator[](std::size_t i) const {
+      return m_begin[i];
+    }
+
+    /**
+     * Since DoubleListProxy is the pointer-type, it needs to provide a dereference operator,
+     * which eventually returns a pointer.
+     */
+    DoubleListProxy* operator->() const {
+      return const_cast<DoubleListProxy*>(this);
+    }
+
+    /// Copy the samples of another cell, which must have the same size
+    DoubleListProxy& operator=(const DoubleListProxy& other) {
+      assert(other.size() == size());
+      std::copy(other.m_begin, other.m_end, m_begin);
+      return *this;
+    }
+
+    /// For compatibility, the proxy can be assigned a std::vector<double> of the same size
+    DoubleListProxy& operator=(const std::vector<double>& samples) {
+      assert(samples.size() == size());
+      std::copy(samples.begin(), samples.end(), m_begin);
+      return *this;
+    }
+
+    /// Copy the samples, for code expecting the cells to be std::vector<double>
+    explicit operator std::vector<double>() const {
+      return {m_begin, m_end};
+    }
+
+  protected:
+    DoubleListProxy(double* begin_, double* end_) : m_begin(begin_), m_end(end_) {}
+
+    double* m_begin;
+    double* m_end;
+
+    friend class DoubleListCellManager;
+  };
+
+  /**
+   * Iterator class to iterate over the cells. It keeps the index of the cell, so it works for cells without
+   * samples too.
+   */
+  class iterator {
+  public:
+    iterator(const iterator& other) = default;
+
+    /**
+     * DoubleListProxy is the reference-type
+     */
+    DoubleListProxy operator*() const {
+      double* begin = m_parent->m_data.data() + m_index * m_parent->m_sample_number;
+      return {begin, begin + m_parent->m_sample_number};
+    }
+
+    /**
+     * DoubleListProxy is the pointer type.
+     */
+    DoubleListProxy operator->() const {
+      return **this;
+    }
+
+    iterator& operator++() {
+      ++m_index;
+      return *this;
+    }
+
+    iterator& operator+=(ssize_t diff) {
+      m_index += diff;
+      return *this;
+    }
+
+    ssize_t operator-(const iterator& other) const {
+      return static_cast<ssize_t>(m_index) - static_cast<ssize_t>(other.m_index);
+    }
+
+    bool operator>(const iterator& other) const {
+      return m_index > other.m_index;
+    }
+
+    bool operator==(const iterator& other) const {
+      return m_index == other.m_index;
+    }
+
+    bool operator!=(const iterator& other) const {
+      return m_index != other.m_index;
+    }
+
+    iterator& operator=(const iterator& other) {
+      assert(m_parent == other.m_parent);
+      m_index = other.m_index;
+      return *this;
+    }
+
+  protected:
+    iterator(DoubleListCellManager& parent, std::size_t index) : m_parent(&parent), m_index(index) {}
+
+    DoubleListCellManager* m_parent;
+    std::size_t            m_index;
+
+    friend class DoubleListCellManager;
+  };
+
+  /**
+   * Constructor. All the samples are set to 0.
+   * @param size
+   *  The number of cells
+   * @param sample_number
+   *  The number of samples of each cell
+   */
+  DoubleListCellManager(std::size_t size, std::size_t sample_number)
+      : m_size(size), m_sample_number(sample_number), m_data(size * sample_number, 0.) {}
+
+  DoubleListCellManager(DoubleListCellManager&&) = default;
+
+  DoubleListCellManager(const DoubleListCellManager& other) = default;
+
+  DoubleListCellManager& operator=(const DoubleListCellManager&) = delete;
+
+  std::size_t size() const {
+    return m_size;
+  }
+
+  bool empty() const {
+    return m_size == 0;
+  }
+
+  std::size_t capacity() const {
+    return m_size;
+  }
+
+  iterator begin() {
+    return iterator(*this, 0);
+  }
+
+  iterator end() {
+    return iterator(*this, m_size);
+  }
+
+  DoubleListProxy operator[](std::size_t i) {
+    double* begin = m_data.data() + i * m_sample_number;
+    return {begin, begin + m_sample_number};
+  }
+
+  /// @return The number of samples of each cell
+  std::size_t sampleNumber() const {
+    return m_sample_number;
+  }
+
+  /// @return The samples of all the cells, cell after cell
+  double* data() {
+    return m_data.data();
+  }
+
+  const double* data() const {
+    return m_data.data();
+  }
+
+  std::size_t getConstructorParameters() const {
+    return m_sample_number;
+  }
+
+private:
+  std::size_t         m_size;
+  std::size_t         m_sample_number;
+  std::vector<double> m_data;
+};
 
 typedef PhzGrid<DoubleListCellManager> DoubleListGrid;
 
 }  // namespace PhzDataModel
+
+namespace GridContainer {
+/**
+ * @struct Euclid::GridContainer::GridCellManagerTraits<DoubleListCellManager>
+ * @brief Specialization of the GridCellManagerTraits template.
+ *
+ * @details
+ * The factory needs the number of samples of each cell, and the cells are accessed via a proxy
+ */
+template <>
+struct GridCellManagerTraits<PhzDataModel::DoubleListCellManager> {
+  typedef std::size_t                                          constructor_parameters;
+  typedef PhzDataModel::DoubleListCellManager::DoubleListProxy data_type;
+  typedef PhzDataModel::DoubleListCellManager::DoubleListProxy pointer_type;
+  typedef PhzDataModel::DoubleListCellManager::DoubleListProxy reference_type;
+
+  typedef typename PhzDataModel::DoubleListCellManager::iterator iterator;
+
+  /**
+   * @brief Factory to build a DoubleListCellManager with all the samples set to 0
+   *
+   * @param size
+   * The number of cells
+   *
+   * @param sample_number
+   * The number of samples of each cell
+   */
+  static std::unique_ptr<PhzDataModel::DoubleListCellManager> factory(size_t size, size_t sample_number);
+
+  /**
+   * @brief Initialize from another DoubleListCellManager, copying its samples
+   */
+  static std::unique_ptr<PhzDataModel::DoubleListCellManager> factory(size_t                                     size,
+                                                                      const PhzDataModel::DoubleListCellManager& other);
+
+  /**
+   * @brief return the size of the DoubleListCellManager
+   */
+  static size_t size(const PhzDataModel::DoubleListCellManager& manager);
+
+  /**
+   * @brief static iterator on the DoubleListCellManager
+   */
+  static iterator begin(PhzDataModel::DoubleListCellManager& manager);
+
+  /**
+   * @brief static iterator on the DoubleListCellManager
+   */
+  static iterator end(PhzDataModel::DoubleListCellManager& manager);
+
+  static const bool enable_boost_serialize = false;
+};  // end of GridCellManagerTraits
+
+}  // end of namespace GridContainer
 }  // end of namespace Euclid
 
 #endif /* PHZDATAMODEL_DOUBLELISTGRID_H */
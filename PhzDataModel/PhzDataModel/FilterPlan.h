@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2022 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file PhzDataModel/FilterPlan.h
+ * @date 2026/10/18
+ */
+
+#ifndef _PHZDATAMODEL_FILTERPLAN_H
+#define _PHZDATAMODEL_FILTERPLAN_H
+
+#include "PhzDataModel/AdjustErrorParamMap.h"
+#include "PhzDataModel/PhotometricCorrectionMap.h"
+#include "SourceCatalog/SourceAttributes/Photometry.h"
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace Euclid {
+namespace PhzDataModel {
+
+/**
+ * @class FilterPlan
+ * @brief
+ *  Maps the filters of the catalog photometries to the filters of the model grid, with their photometric
+ *  corrections and error adjustment parameters
+ * @details
+ *  The filters are matched by name once, when the plan is built. The photometry of a source, which is expected to
+ *  have the filters of the catalog in the given order, is then corrected and reordered by index only, to the filter
+ *  order of the model grid. All the photometries built with the plan share the same filter names.
+ */
+class FilterPlan {
+public:
+  /**
+   * @param catalog_filters
+   *    The filters of the source photometries, in the order of the catalog columns
+   * @param grid_filters
+   *    The filters of the model photometries, in the order of the model grid. The corrected photometries share
+   *    them, so when they are the names of the grid (see PhotometryCellManager::filterNamesPtr), the photometries
+   *    are known to be in the filter order of the grid without comparing the names
+   * @param phot_corr_map
+   *    The photometric correction of each filter
+   * @param adjust_error_param_map
+   *    The (alpha, beta, gamma) parameters for recomputing the error of each filter
+   * @throw Elements::Exception
+   *    If a catalog filter is not in the model grid, or has no photometric correction or error adjustment parameters
+   */
+  FilterPlan(const std::vector<std::string>& catalog_filters, std::shared_ptr<std::vector<std::string>> grid_filters,
+             const PhotometricCorrectionMap& phot_corr_map, const AdjustErrorParamMap& adjust_error_param_map);
+
+  /// @return The number of filters of the source photometries
+  std::size_t catalogSize() const;
+
+  /// @return The names of the filters, in the order of the model grid
+  const std::shared_ptr<std::vector<std::string>>& getFilterNames() const;
+
+  /// @return For each catalog filter, its position in the model grid filters
+  const std::vector<std::size_t>& getGridIndices() const;
+
+  /**
+   * @return The position of the given filter in the model grid filters
+   * @throw Elements::Exception
+   *    If the filter is not in the model grid
+   */
+  std::size_t getGridIndex(const std::string& filter) const;
+
+  /// @return The photometric corrections, in the order of the catalog filters
+  const std::vector<double>& getCorrections() const;
+
+  /// @return The error adjustment parameters, in the order of the catalog filters
+  const std::vector<std::tuple<double, double, double>>& getErrorAdjustments() const;
+
+  /**
+   * Fills the buffer with the photometry of a source in the filter order of the model grid, with the photometric
+   * correction applied and the errors recomputed. The grid filters which are not in the catalog are flagged as
+   * missing.
+   *
+   * @param source_photometry
+   *    The photometry of the source, with the catalog filters in the order given to the constructor
+   * @param fluxes
+   *    The buffer to fill. It is resized to the number of grid filters
+   */
+  void apply(const SourceCatalog::Photometry&           source_photometry,
+             std::vector<SourceCatalog::FluxErrorPair>& fluxes) const;
+
+private:
+  std::shared_ptr<std::vector<std::string>>       m_grid_filters;
+  std::vector<std::size_t>                        m_grid_indices;
+  std::vector<double>                             m_corrections;
+  std::vector<std::tuple<double, double, double>> m_error_adjustments;
+};
+
+}  // namespace PhzDataModel
+}  // namespace Euclid
+
+#endif /* _PHZDATAMODEL_FILTERPLAN_H */
@@ -83,19 +83,19 @@ public:
     PhotometryProxy(const PhotometryProxy&) = default;
 
     iterator begin() {
-      return PhotometryIteratorWrapper<false>(m_parent.m_filter_names.begin(), m_begin);
+      return PhotometryIteratorWrapper<false>(m_parent.m_filter_names->begin(), m_begin);
     }
 
     iterator end() {
-      return PhotometryIteratorWrapper<false>(m_parent.m_filter_names.end(), m_end);
+      return PhotometryIteratorWrapper<false>(m_parent.m_filter_names->end(), m_end);
     }
 
     const_iterator begin() const {
-      return PhotometryIteratorWrapper<true>(m_parent.m_filter_names.begin(), m_begin);
+      return PhotometryIteratorWrapper<true>(m_parent.m_filter_names->begin(), m_begin);
     }
 
     const_iterator end() const {
-      return PhotometryIteratorWrapper<true>(m_parent.m_filter_names.end(), m_end);
+      return PhotometryIteratorWrapper<true>(m_parent.m_filter_names->end(), m_end);
     }
 
     std::size_t size() const {
@@ -133,11 +133,10 @@ public:
      * to get a copy and not to modify the original. This is how this can be achieved.
      * @note
      *  This works as long as SourceCatalog::Photometry are sparingly used and short lived.
-     *  If it ends being a bottleneck, m_parent.filterNames() could be modified to return directly a shared pointer.
+     *  The filter names are not copied, the photometry shares them with the grid.
      */
     explicit operator SourceCatalog::Photometry() const {
-      return {std::make_shared<std::vector<std::string>>(m_parent.filterNames()),
-              std::vector<SourceCatalog::FluxErrorPair>(m_begin, m_end)};
+      return {m_parent.m_filter_names, std::vector<SourceCatalog::FluxErrorPair>(m_begin, m_end)};
     }
 
     /**
@@ -146,11 +145,11 @@ public:
      * @return
      */
     SourceCatalog::FluxErrorPair* find(const std::string& filter) const {
-      auto i = std::find(m_parent.m_filter_names.begin(), m_parent.m_filter_names.end(), filter);
-      if (i == m_parent.m_filter_names.end()) {
+      auto i = std::find(m_parent.m_filter_names->begin(), m_parent.m_filter_names->end(), filter);
+      if (i == m_parent.m_filter_names->end()) {
         throw Elements::Exception() << "Filter " << filter << " not found";
       }
-      auto offset = i - m_parent.m_filter_names.begin();
+      auto offset = i - m_parent.m_filter_names->begin();
       return &(*(m_begin + offset));
     }
 
@@ -236,7 +235,7 @@ public:
     using flux_iterator = std::vector<SourceCatalog::FluxErrorPair>::iterator;
 
     iterator(const PhotometryCellManager& parent, flux_iterator iter)
-        : m_parent(parent), m_position(iter), m_stride(parent.m_filter_names.size()){};
+        : m_parent(parent), m_position(iter), m_stride(parent.m_filter_names->size()){};
 
     const PhotometryCellManager& m_parent;
     flux_iterator                m_position;
@@ -245,8 +244,13 @@ public:
     friend class PhotometryCellManager;
   };
 
+  /// The filter names are shared with the other cell managers with the same ones, through a process-wide registry
   PhotometryCellManager(size_t size, std::vector<std::string> filter_names);
 
+  /// Uses the given filter names, like the filterNamesPtr() of the grid this one is derived from, without the
+  /// registry lookup
+  PhotometryCellManager(size_t size, std::shared_ptr<std::vector<std::string>> filter_names);
+
   PhotometryCellManager(PhotometryCellManager&&) = default;
 
   PhotometryCellManager(const PhotometryCellManager& other);
@@ -274,22 +278,31 @@ public:
   }
 
   PhotometryProxy operator[](size_t i) {
-    auto _begin = m_data.begin() + i * m_filter_names.size();
-    auto _end   = _begin + m_filter_names.size();
+    auto _begin = m_data.begin() + i * m_filter_names->size();
+    auto _end   = _begin + m_filter_names->size();
     return {*this, _begin, _end};
   }
 
   const std::vector<std::string>& filterNames() const {
+    return *m_filter_names;
+  }
+
+  /**
+   * @return
+   *  The filter names, shared by all the cell managers with the same filters in the same order. A photometry built
+   *  with them has the filter order of the grid, which can be checked by comparing the address of the names.
+   */
+  const std::shared_ptr<std::vector<std::string>>& filterNamesPtr() const {
     return m_filter_names;
   }
 
   const std::vector<std::string>& getConstructorParameters() const {
-    return m_filter_names;
+    return *m_filter_names;
   }
 
 private:
   size_t                                    m_size;
-  std::vector<std::string>                  m_filter_names;
+  std::shared_ptr<std::vector<std::string>> m_filter_names;
   std::vector<SourceCatalog::FluxErrorPair> m_data;
   friend class PhotometryCellManager::iterator;
 };
@@ -332,6 +345,13 @@ struct GridCellManagerTraits<PhzDataModel::PhotometryCellManager> {
   static std::unique_ptr<PhzDataModel::PhotometryCellManager>
   factory(size_t size, std::vector<XYDataset::QualifiedName> filter_names);
 
+  /**
+   * @brief Factory sharing the given filter names, for the grids derived from another grid (slices, per
+   * source copies), which are built on the hot path
+   */
+  static std::unique_ptr<PhzDataModel::PhotometryCellManager>
+  factory(size_t size, std::shared_ptr<std::vector<std::string>> filter_names);
+
   /**
    * @brief Initialize from another PhotometryCellManager
    */
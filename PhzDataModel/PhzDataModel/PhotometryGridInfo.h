@@ -46,6 +46,10 @@ public:
   XYDataset::QualifiedName luminosity_filter_name{"NotSet"};
 
   std::vector<XYDataset::QualifiedName> filter_names{};
+
+  /// The settings the grid depends on (for example the cosmology), used for
+  /// refusing to extend a grid computed with a different setup
+  std::map<std::string, std::string> provenance{};
 };
 
 }  // end of namespace PhzDataModel
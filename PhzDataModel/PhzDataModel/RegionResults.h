@@ -87,6 +87,8 @@ enum class RegionResultType {
   NORMALIZATION_LOG,
   /// Do use sampling of the scale factor
   SAMPLE_SCALE_FACTOR,
+  /// Where the samples of the scaling grids are taken, when sampling the scale factor
+  SCALE_FACTOR_SAMPLING,
   /// Computation Flags
   FLAGS
 };
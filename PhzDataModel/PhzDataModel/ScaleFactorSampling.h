@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2022 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file PhzDataModel/ScaleFactorSampling.h
+ * @date 2026/10/18
+ */
+
+#ifndef _PHZDATAMODEL_SCALEFACTORSAMPLING_H
+#define _PHZDATAMODEL_SCALEFACTORSAMPLING_H
+
+#include <cstddef>
+#include <vector>
+
+namespace Euclid {
+namespace PhzDataModel {
+
+/**
+ * @class ScaleFactorSampling
+ * @brief
+ *  Describes where the samples of the scale factor are taken, around the best fitted scale factor alpha
+ * @details
+ *  The sample i of a model is taken at alpha + scale * sigma * node(i), sigma being the uncertainty on alpha.
+ *  The samples come with quadrature weights, so the integral over the scale factor of a function f is
+ *  approximated by scale * sigma * sum_i(weight(i) * f(sample i)).
+ *
+ *  Two methods are available:
+ *  - UNIFORM: the nodes are evenly spaced in [-1, 1] and the scale is the range in sigma. The weights are the
+ *    ones of the trapezoidal rule.
+ *  - GAUSS_HERMITE: the nodes are the ones of the Gauss-Hermite quadrature, scaled by sqrt(2), so the rule is
+ *    exact for a Gaussian likelihood times a polynomial of degree up to 2n-1 in the scale factor. The scale is 1.
+ */
+class ScaleFactorSampling {
+public:
+  enum class Method { UNIFORM, GAUSS_HERMITE };
+
+  /**
+   * @param sample_number
+   *    The number of samples, at least 2
+   * @param range_in_sigma
+   *    The samples cover [alpha - range_in_sigma * sigma, alpha + range_in_sigma * sigma]
+   * @throw Elements::Exception
+   *    If there are less than 2 samples
+   */
+  static ScaleFactorSampling uniform(std::size_t sample_number, double range_in_sigma);
+
+  /**
+   * @param node_number
+   *    The number of nodes of the quadrature, at least 1
+   * @throw Elements::Exception
+   *    If there is no node, or the computation of the nodes does not converge
+   */
+  static ScaleFactorSampling gaussHermite(std::size_t node_number);
+
+  Method getMethod() const;
+
+  std::size_t size() const;
+
+  /// @return The value of the scale factor of the sample sample_index
+  double getPosition(double alpha, double sigma, std::size_t sample_index) const {
+    return alpha + (m_scale * sigma) * m_nodes[sample_index];
+  }
+
+  /// @return The position of the samples, in units of scale * sigma, relative to alpha
+  const std::vector<double>& getNodes() const;
+
+  /// @return The quadrature weights of the samples, in units of scale * sigma
+  const std::vector<double>& getWeights() const;
+
+  /// @return The factor applied to sigma in the sample positions
+  double getScale() const;
+
+private:
+  ScaleFactorSampling(Method method, std::vector<double> nodes, std::vector<double> weights, double scale);
+
+  Method              m_method;
+  std::vector<double> m_nodes;
+  std::vector<double> m_weights;
+  double              m_scale;
+};
+
+}  // namespace PhzDataModel
+}  // namespace Euclid
+
+#endif /* _PHZDATAMODEL_SCALEFACTORSAMPLING_H */
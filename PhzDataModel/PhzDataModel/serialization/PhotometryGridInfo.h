@@ -34,6 +34,7 @@
 #include <boost/serialization/split_free.hpp>
 #include <boost/serialization/string.hpp>
 #include <boost/serialization/vector.hpp>
+#include <boost/serialization/version.hpp>
 
 namespace boost {
 namespace serialization {
@@ -62,10 +63,13 @@ void save(Archive& ar, const Euclid::PhzDataModel::PhotometryGridInfo& t, const
     filter_names_as_strings.push_back(name.qualifiedName());
   }
   ar << filter_names_as_strings;
+
+  // Store the provenance (added in version 1)
+  ar << t.provenance;
 }
 
 template <typename Archive>
-void load(Archive& ar, Euclid::PhzDataModel::PhotometryGridInfo& t, const unsigned int) {
+void load(Archive& ar, Euclid::PhzDataModel::PhotometryGridInfo& t, const unsigned int version) {
   // Read the names of the regions
   std::vector<std::string> region_names{};
   ar >> region_names;
@@ -88,6 +92,10 @@ void load(Archive& ar, Euclid::PhzDataModel::PhotometryGridInfo& t, const unsign
   for (auto& name : names_as_strings) {
     t.filter_names.push_back(name);
   }
+  // Read the provenance, which older files do not have
+  if (version > 0) {
+    ar >> t.provenance;
+  }
 }
 
 template <typename Archive>
@@ -98,4 +106,6 @@ void serialize(Archive& ar, Euclid::PhzDataModel::PhotometryGridInfo& t, const u
 }  // end of namespace serialization
 }  // end of namespace boost
 
+BOOST_CLASS_VERSION(Euclid::PhzDataModel::PhotometryGridInfo, 1)
+
 #endif /* PHZDATAMODEL_SERIALIZATION_PHOTOMETRYGRIDINFO_H */
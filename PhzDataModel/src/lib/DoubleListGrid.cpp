@@ -0,0 +1,58 @@
+/*
+ * Copyright (C) 2022 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file PhzDataModel/DoubleListGrid.cpp
+ * @date 2026/10/18
+ */
+
+#include "PhzDataModel/DoubleListGrid.h"
+#include "AlexandriaKernel/memory_tools.h"
+
+namespace Euclid {
+namespace GridContainer {
+
+std::unique_ptr<PhzDataModel::DoubleListCellManager>
+GridCellManagerTraits<PhzDataModel::DoubleListCellManager>::factory(size_t size, size_t sample_number) {
+  return make_unique<PhzDataModel::DoubleListCellManager>(size, sample_number);
+}
+
+std::unique_ptr<PhzDataModel::DoubleListCellManager>
+GridCellManagerTraits<PhzDataModel::DoubleListCellManager>::factory(size_t                                     size,
+                                                                    const PhzDataModel::DoubleListCellManager& other) {
+  assert(size == other.size());
+  return make_unique<PhzDataModel::DoubleListCellManager>(other);
+}
+
+size_t
+GridCellManagerTraits<PhzDataModel::DoubleListCellManager>::size(const PhzDataModel::DoubleListCellManager& manager) {
+  return manager.size();
+}
+
+PhzDataModel::DoubleListCellManager::iterator
+GridCellManagerTraits<PhzDataModel::DoubleListCellManager>::begin(PhzDataModel::DoubleListCellManager& manager) {
+  return manager.begin();
+}
+
+PhzDataModel::DoubleListCellManager::iterator
+GridCellManagerTraits<PhzDataModel::DoubleListCellManager>::end(PhzDataModel::DoubleListCellManager& manager) {
+  return manager.end();
+}
+
+}  // namespace GridContainer
+}  // namespace Euclid
@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2022 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file src/lib/FilterPlan.cpp
+ * @date 2026/10/18
+ */
+
+#include "PhzDataModel/FilterPlan.h"
+#include "ElementsKernel/Exception.h"
+#include <algorithm>
+#include <cmath>
+
+namespace Euclid {
+namespace PhzDataModel {
+
+FilterPlan::FilterPlan(const std::vector<std::string>&          catalog_filters,
+                       std::shared_ptr<std::vector<std::string>> grid_filters,
+                       const PhotometricCorrectionMap&           phot_corr_map,
+                       const AdjustErrorParamMap&                adjust_error_param_map)
+    : m_grid_filters{std::move(grid_filters)} {
+  for (auto& filter : catalog_filters) {
+    std::size_t grid_index = getGridIndex(filter);
+    auto        pc         = phot_corr_map.find(filter);
+    if (pc == phot_corr_map.end()) {
+      throw Elements::Exception() << "Missing photometric correction value for " << filter << " filter";
+    }
+    auto aep = adjust_error_param_map.find(filter);
+    if (aep == adjust_error_param_map.end()) {
+      throw Elements::Exception() << "Missing error adjustment parameters for " << filter << " filter";
+    }
+    m_grid_indices.push_back(grid_index);
+    m_corrections.push_back(pc->second);
+    m_error_adjustments.push_back(aep->second);
+  }
+}
+
+std::size_t FilterPlan::catalogSize() const {
+  return m_grid_indices.size();
+}
+
+const std::shared_ptr<std::vector<std::string>>& FilterPlan::getFilterNames() const {
+  return m_grid_filters;
+}
+
+const std::vector<std::size_t>& FilterPlan::getGridIndices() const {
+  return m_grid_indices;
+}
+
+std::size_t FilterPlan::getGridIndex(const std::string& filter) const {
+  auto grid_iter = std::find(m_grid_filters->begin(), m_grid_filters->end(), filter);
+  if (grid_iter == m_grid_filters->end()) {
+    throw Elements::Exception() << "Filter " << filter << " missing from the model grid";
+  }
+  return grid_iter - m_grid_filters->begin();
+}
+
+const std::vector<double>& FilterPlan::getCorrections() const {
+  return m_corrections;
+}
+
+const std::vector<std::tuple<double, double, double>>& FilterPlan::getErrorAdjustments() const {
+  return m_error_adjustments;
+}
+
+void FilterPlan::apply(const SourceCatalog::Photometry&           source_photometry,
+                       std::vector<SourceCatalog::FluxErrorPair>& fluxes) const {
+  if (source_photometry.size() != m_grid_indices.size()) {
+    throw Elements::Exception() << "The source photometry has " << source_photometry.size() << " filters instead of "
+                                << m_grid_indices.size();
+  }
+
+  fluxes.assign(m_grid_filters->size(), SourceCatalog::FluxErrorPair{0., 0., true});
+
+  std::size_t i = 0;
+  for (auto iter = source_photometry.begin(); iter != source_photometry.end(); ++iter, ++i) {
+    SourceCatalog::FluxErrorPair new_flux_error{*iter};
+    if (!new_flux_error.missing_photometry_flag) {
+      new_flux_error.flux *= m_corrections[i];
+
+      double alpha = std::get<0>(m_error_adjustments[i]);
+      double beta  = std::get<1>(m_error_adjustments[i]);
+      double gamma = std::get<2>(m_error_adjustments[i]);
+      double flux  = new_flux_error.flux;
+      double error = new_flux_error.error;
+      if (new_flux_error.upper_limit_flag || flux <= 0) {
+        new_flux_error.error = alpha * error;
+      } else {
+        new_flux_error.error = std::sqrt(alpha * alpha * error * error + (beta * beta * flux + gamma) * flux);
+      }
+    }
+    fluxes[m_grid_indices[i]] = new_flux_error;
+  }
+}
+
+}  // namespace PhzDataModel
+}  // namespace Euclid
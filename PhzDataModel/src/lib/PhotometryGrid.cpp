@@ -6,15 +6,45 @@
 
 #include "PhzDataModel/PhotometryGrid.h"
 #include "AlexandriaKernel/memory_tools.h"
+#include <map>
+#include <mutex>
 
 namespace Euclid {
 
 namespace PhzDataModel {
 
+namespace {
+
+/// Returns the instance of the filter names shared by all the grids having the same filters in the same order
+std::shared_ptr<std::vector<std::string>> shareFilterNames(std::vector<std::string> filter_names) {
+  static std::mutex                                                                  mutex;
+  static std::map<std::vector<std::string>, std::weak_ptr<std::vector<std::string>>> instances;
+
+  std::lock_guard<std::mutex> lock(mutex);
+  auto&                       instance = instances[filter_names];
+  auto                        shared   = instance.lock();
+  if (!shared) {
+    shared   = std::make_shared<std::vector<std::string>>(std::move(filter_names));
+    instance = shared;
+    // Forget the names of the grids which do not exist anymore
+    for (auto i = instances.begin(); i != instances.end();) {
+      i = i->second.expired() ? instances.erase(i) : std::next(i);
+    }
+  }
+  return shared;
+}
+
+}  // namespace
+
 PhotometryCellManager::PhotometryCellManager(size_t size, std::vector<std::string> filter_names)
+    : m_size(size)
+    , m_filter_names(shareFilterNames(std::move(filter_names)))
+    , m_data(size * m_filter_names->size(), SourceCatalog::FluxErrorPair(0, 0)) {}
+
+PhotometryCellManager::PhotometryCellManager(size_t size, std::shared_ptr<std::vector<std::string>> filter_names)
     : m_size(size)
     , m_filter_names(std::move(filter_names))
-    , m_data(size * m_filter_names.size(), SourceCatalog::FluxErrorPair(0, 0)) {}
+    , m_data(size * m_filter_names->size(), SourceCatalog::FluxErrorPair(0, 0)) {}
 
 PhotometryCellManager::PhotometryCellManager(const PhotometryCellManager& other)
     : m_size(other.m_size), m_filter_names(other.m_filter_names), m_data(other.m_data) {}
@@ -40,6 +70,12 @@ GridCellManagerTraits<PhzDataModel::PhotometryCellManager>::factory(
   return factory(size, str_filter_names);
 }
 
+std::unique_ptr<PhzDataModel::PhotometryCellManager>
+GridCellManagerTraits<PhzDataModel::PhotometryCellManager>::factory(
+    size_t size, std::shared_ptr<std::vector<std::string>> filter_names) {
+  return make_unique<PhzDataModel::PhotometryCellManager>(size, std::move(filter_names));
+}
+
 std::unique_ptr<PhzDataModel::PhotometryCellManager>
 GridCellManagerTraits<PhzDataModel::PhotometryCellManager>::factory(size_t                                     size,
                                                                     const PhzDataModel::PhotometryCellManager& other) {
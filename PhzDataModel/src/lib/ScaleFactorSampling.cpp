@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2022 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file src/lib/ScaleFactorSampling.cpp
+ * @date 2026/10/18
+ */
+
+#include "PhzDataModel/ScaleFactorSampling.h"
+#include "ElementsKernel/Exception.h"
+#include <algorithm>
+#include <cmath>
+
+namespace Euclid {
+namespace PhzDataModel {
+
+ScaleFactorSampling::ScaleFactorSampling(Method method, std::vector<double> nodes, std::vector<double> weights,
+                                         double scale)
+    : m_method{method}, m_nodes{std::move(nodes)}, m_weights{std::move(weights)}, m_scale{scale} {}
+
+ScaleFactorSampling ScaleFactorSampling::uniform(std::size_t sample_number, double range_in_sigma) {
+  if (sample_number < 2) {
+    throw Elements::Exception() << "The uniform sampling of the scale factor needs at least 2 samples";
+  }
+
+  std::vector<double> nodes(sample_number);
+  std::vector<double> weights(sample_number, 2.0 / static_cast<double>(sample_number - 1));
+  for (std::size_t i = 0; i < sample_number; ++i) {
+    nodes[i] = (2.0 * static_cast<double>(i)) / static_cast<double>(sample_number - 1) - 1.0;
+  }
+  weights.front() /= 2.;
+  weights.back() /= 2.;
+
+  return {Method::UNIFORM, std::move(nodes), std::move(weights), range_in_sigma};
+}
+
+ScaleFactorSampling ScaleFactorSampling::gaussHermite(std::size_t node_number) {
+  if (node_number < 1) {
+    throw Elements::Exception() << "The Gauss-Hermite sampling of the scale factor needs at least 1 node";
+  }
+
+  // Roots of the Hermite polynomial, found with Newton iterations on the normalized polynomials.
+  // The weights are the ones for the weight function exp(-x^2)
+  const double        pi_m4    = std::pow(M_PI, -0.25);
+  const int           max_iter = 100;
+  const double        n        = static_cast<double>(node_number);
+  std::vector<double> roots(node_number);
+  std::vector<double> weights(node_number);
+
+  double z = 0.;
+  for (std::size_t i = 0; i < (node_number + 1) / 2; ++i) {
+    if (i == 0) {
+      z = std::sqrt(2. * n + 1.) - 1.85575 * std::pow(2. * n + 1., -0.16667);
+    } else if (i == 1) {
+      z -= 1.14 * std::pow(n, 0.426) / z;
+    } else if (i == 2) {
+      z = 1.86 * z - 0.86 * roots[0];
+    } else if (i == 3) {
+      z = 1.91 * z - 0.91 * roots[1];
+    } else {
+      z = 2. * z - roots[i - 2];
+    }
+
+    double derivative = 0.;
+    int    iter       = 0;
+    for (; iter < max_iter; ++iter) {
+      double p1 = pi_m4, p2 = 0.;
+      for (std::size_t j = 0; j < node_number; ++j) {
+        double p3 = p2;
+        p2        = p1;
+        p1        = z * std::sqrt(2. / (j + 1.)) * p2 - std::sqrt(j / (j + 1.)) * p3;
+      }
+      derivative = std::sqrt(2. * n) * p2;
+      double z1  = z;
+      z          = z1 - p1 / derivative;
+      if (std::abs(z - z1) <= 3e-14 * std::max(1., std::abs(z))) {
+        break;
+      }
+    }
+    if (iter == max_iter) {
+      throw Elements::Exception() << "The Gauss-Hermite nodes computation did not converge for " << node_number
+                                  << " nodes";
+    }
+
+    roots[i]                   = z;
+    roots[node_number - 1 - i] = -z;
+    weights[i] = weights[node_number - 1 - i] = 2. / (derivative * derivative);
+  }
+
+  // With alpha = alpha_0 + sqrt(2) * sigma * x, the Gaussian likelihood becomes exp(-x^2). As the likelihood is
+  // already part of the integrand, the weight function is divided out from the quadrature weights
+  std::vector<double> nodes(node_number);
+  std::vector<double> scaled_weights(node_number);
+  for (std::size_t i = 0; i < node_number; ++i) {
+    double x          = roots[node_number - 1 - i];
+    nodes[i]          = M_SQRT2 * x;
+    scaled_weights[i] = M_SQRT2 * weights[node_number - 1 - i] * std::exp(x * x);
+  }
+
+  return {Method::GAUSS_HERMITE, std::move(nodes), std::move(scaled_weights), 1.};
+}
+
+auto ScaleFactorSampling::getMethod() const -> Method {
+  return m_method;
+}
+
+std::size_t ScaleFactorSampling::size() const {
+  return m_nodes.size();
+}
+
+const std::vector<double>& ScaleFactorSampling::getNodes() const {
+  return m_nodes;
+}
+
+const std::vector<double>& ScaleFactorSampling::getWeights() const {
+  return m_weights;
+}
+
+double ScaleFactorSampling::getScale() const {
+  return m_scale;
+}
+
+}  // namespace PhzDataModel
+}  // namespace Euclid
@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2022 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file tests/src/DoubleListGrid_test.cpp
+ * @date 2026/10/18
+ */
+
+#include <boost/test/unit_test.hpp>
+#include <vector>
+
+#include "PhzDataModel/DoubleListGrid.h"
+
+using namespace Euclid;
+using namespace Euclid::PhzDataModel;
+
+typedef GridContainer::GridCellManagerTraits<DoubleListCellManager> DoubleListTraits;
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE(DoubleListGrid_test)
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(factory_test) {
+  auto ptr = DoubleListTraits::factory(25, 3);
+
+  BOOST_CHECK(ptr);
+  BOOST_CHECK(!ptr->empty());
+  BOOST_CHECK_EQUAL(25, ptr->size());
+  BOOST_CHECK_EQUAL(3, ptr->sampleNumber());
+  for (auto cell : *ptr) {
+    BOOST_CHECK_EQUAL(3, cell.size());
+    for (double v : cell) {
+      BOOST_CHECK_EQUAL(0., v);
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(dense_storage_test) {
+  auto ptr = DoubleListTraits::factory(4, 2);
+
+  std::size_t i = 0;
+  for (auto cell : *ptr) {
+    cell[0] = i;
+    cell[1] = 10. * i;
+    ++i;
+  }
+  (*ptr)[3] = std::vector<double>{7., 8.};
+
+  std::vector<double> expected{0., 0., 1., 10., 2., 20., 7., 8.};
+  BOOST_CHECK_EQUAL_COLLECTIONS(ptr->data(), ptr->data() + expected.size(), expected.begin(), expected.end());
+  BOOST_CHECK(static_cast<std::vector<double>>((*ptr)[2]) == (std::vector<double>{2., 20.}));
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(copy_factory_test) {
+  auto original = DoubleListTraits::factory(3, 2);
+  (*original)[1] = std::vector<double>{1., 2.};
+
+  auto copy = DoubleListTraits::factory(3, *original);
+  (*original)[1][0] = 5.;
+
+  BOOST_CHECK_EQUAL(2, copy->sampleNumber());
+  BOOST_CHECK_EQUAL(1., (*copy)[1][0]);
+  BOOST_CHECK_EQUAL(2., (*copy)[1][1]);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(no_sample_test) {
+  auto ptr = DoubleListTraits::factory(5, 0);
+
+  std::size_t cells = 0;
+  for (auto cell : *ptr) {
+    BOOST_CHECK_EQUAL(0, cell.size());
+    ++cells;
+  }
+  BOOST_CHECK_EQUAL(5, cells);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2022 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file tests/src/FilterPlan_test.cpp
+ * @date 2026/10/18
+ */
+
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+
+#include "ElementsKernel/Exception.h"
+#include "PhzDataModel/FilterPlan.h"
+
+using namespace Euclid::PhzDataModel;
+using Euclid::SourceCatalog::FluxErrorPair;
+using Euclid::SourceCatalog::Photometry;
+
+struct FilterPlan_Fixture {
+
+  std::vector<std::string>                  catalog_filters{"B", "A", "C"};
+  std::shared_ptr<std::vector<std::string>> grid_filters =
+      std::make_shared<std::vector<std::string>>(std::vector<std::string>{"A", "B", "D", "C"});
+
+  PhotometricCorrectionMap phot_corr_map{{{"A"}, 2.}, {{"B"}, 3.}, {{"C"}, 4.}};
+  AdjustErrorParamMap      adjust_error_param_map{{{"A"}, std::make_tuple(1., 0., 0.)},
+                                                  {{"B"}, std::make_tuple(2., 0.1, 0.2)},
+                                                  {{"C"}, std::make_tuple(1.5, 0., 0.)}};
+
+  Photometry source_photometry{std::make_shared<std::vector<std::string>>(catalog_filters),
+                               {{1., 0.5}, {2., 0.3, false, true}, {0., 0., true}}};
+};
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE(FilterPlan_test)
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(constructor_test, FilterPlan_Fixture) {
+  FilterPlan plan{catalog_filters, grid_filters, phot_corr_map, adjust_error_param_map};
+
+  BOOST_CHECK_EQUAL(3, plan.catalogSize());
+  BOOST_CHECK(plan.getFilterNames() == grid_filters);
+  BOOST_CHECK(plan.getGridIndices() == std::vector<std::size_t>({1, 0, 3}));
+  BOOST_CHECK_EQUAL(2, plan.getGridIndex("D"));
+  BOOST_CHECK_THROW(plan.getGridIndex("E"), Elements::Exception);
+  BOOST_CHECK(plan.getCorrections() == std::vector<double>({3., 2., 4.}));
+  BOOST_CHECK(std::get<0>(plan.getErrorAdjustments()[0]) == 2.);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(constructor_missing_test, FilterPlan_Fixture) {
+  BOOST_CHECK_THROW((FilterPlan{{"A", "E"}, grid_filters, phot_corr_map, adjust_error_param_map}),
+                    Elements::Exception);
+  phot_corr_map.erase({"C"});
+  BOOST_CHECK_THROW((FilterPlan{catalog_filters, grid_filters, phot_corr_map, adjust_error_param_map}),
+                    Elements::Exception);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(apply_test, FilterPlan_Fixture) {
+  FilterPlan                 plan{catalog_filters, grid_filters, phot_corr_map, adjust_error_param_map};
+  std::vector<FluxErrorPair> fluxes;
+  plan.apply(source_photometry, fluxes);
+
+  BOOST_CHECK_EQUAL(4, fluxes.size());
+
+  // A is an upper limit: the error is only scaled by alpha
+  BOOST_CHECK_CLOSE(4., fluxes[0].flux, 1e-8);
+  BOOST_CHECK_CLOSE(0.3, fluxes[0].error, 1e-8);
+  BOOST_CHECK(fluxes[0].upper_limit_flag);
+
+  // B: sqrt(alpha^2 * e^2 + (beta^2 * f + gamma) * f)
+  BOOST_CHECK_CLOSE(3., fluxes[1].flux, 1e-8);
+  BOOST_CHECK_CLOSE(std::sqrt(4. * 0.25 + (0.01 * 3. + 0.2) * 3.), fluxes[1].error, 1e-8);
+  BOOST_CHECK(!fluxes[1].missing_photometry_flag);
+
+  // D is not in the catalog, C is missing for this source
+  BOOST_CHECK(fluxes[2].missing_photometry_flag);
+  BOOST_CHECK(fluxes[3].missing_photometry_flag);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(apply_wrong_size_test, FilterPlan_Fixture) {
+  FilterPlan                 plan{{"A", "B"}, grid_filters, phot_corr_map, adjust_error_param_map};
+  std::vector<FluxErrorPair> fluxes;
+  BOOST_CHECK_THROW(plan.apply(source_photometry, fluxes), Elements::Exception);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END()
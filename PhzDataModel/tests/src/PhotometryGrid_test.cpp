@@ -37,4 +37,33 @@ BOOST_FIXTURE_TEST_CASE(factory_test, PhotometryGrid_Fixture) {
   BOOST_CHECK_EQUAL(25, ptr->capacity());
 }
 
+//-----------------------------------------------------------------------------
+// The cell managers with the same filters, in the same order, share the names
+//-----------------------------------------------------------------------------
+BOOST_FIXTURE_TEST_CASE(shared_filter_names_test, PhotometryGrid_Fixture) {
+  using Euclid::PhzDataModel::PhotometryCellManager;
+
+  PhotometryCellManager first{10, {"euclid/VIS", "lsst/u"}};
+  PhotometryCellManager second{5, {"euclid/VIS", "lsst/u"}};
+  PhotometryCellManager other_order{5, {"lsst/u", "euclid/VIS"}};
+
+  BOOST_CHECK(first.filterNamesPtr() == second.filterNamesPtr());
+  BOOST_CHECK(first.filterNamesPtr() != other_order.filterNamesPtr());
+  BOOST_CHECK(*first.filterNamesPtr() == std::vector<std::string>({"euclid/VIS", "lsst/u"}));
+}
+
+//-----------------------------------------------------------------------------
+// The grids derived from another one reuse its filter names
+//-----------------------------------------------------------------------------
+BOOST_FIXTURE_TEST_CASE(parent_filter_names_test, PhotometryGrid_Fixture) {
+  using Euclid::PhzDataModel::PhotometryCellManager;
+
+  PhotometryCellManager parent{10, {"euclid/VIS", "lsst/u"}};
+
+  auto ptr = Euclid::GridContainer::GridCellManagerTraits<PhotometryCellManager>::factory(3, parent.filterNamesPtr());
+
+  BOOST_CHECK(ptr->filterNamesPtr() == parent.filterNamesPtr());
+  BOOST_CHECK_EQUAL(3, ptr->capacity());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,97 @@
+/*
+ * Copyright (C) 2022 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file tests/src/ScaleFactorSampling_test.cpp
+ * @date 2026/10/18
+ */
+
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+
+#include "ElementsKernel/Exception.h"
+#include "PhzDataModel/ScaleFactorSampling.h"
+
+using namespace Euclid::PhzDataModel;
+
+namespace {
+
+/// Integral over alpha of a Gaussian likelihood times alpha^power, with the quadrature of the sampling
+double integrate(const ScaleFactorSampling& sampling, double alpha, double sigma, int power) {
+  double total = 0.;
+  for (std::size_t i = 0; i < sampling.size(); ++i) {
+    double a = sampling.getPosition(alpha, sigma, i);
+    total += sampling.getWeights()[i] * std::exp(-0.5 * (a - alpha) * (a - alpha) / (sigma * sigma)) *
+             std::pow(a, power);
+  }
+  return total * sampling.getScale() * sigma;
+}
+
+}  // namespace
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE(ScaleFactorSampling_test)
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(uniform_test) {
+  auto sampling = ScaleFactorSampling::uniform(5, 2.);
+
+  BOOST_CHECK(sampling.getMethod() == ScaleFactorSampling::Method::UNIFORM);
+  BOOST_CHECK_EQUAL(5, sampling.size());
+  BOOST_CHECK_CLOSE(-3., sampling.getPosition(1., 2., 0), 1e-8);
+  BOOST_CHECK_CLOSE(1., sampling.getPosition(1., 2., 2), 1e-8);
+  BOOST_CHECK_CLOSE(5., sampling.getPosition(1., 2., 4), 1e-8);
+  BOOST_CHECK_CLOSE(0.25, sampling.getWeights()[0], 1e-8);
+  BOOST_CHECK_CLOSE(0.5, sampling.getWeights()[1], 1e-8);
+  BOOST_CHECK_THROW(ScaleFactorSampling::uniform(1, 2.), Elements::Exception);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(gauss_hermite_nodes_test) {
+  auto sampling = ScaleFactorSampling::gaussHermite(3);
+
+  // The roots of H3 are 0 and +-sqrt(3/2), scaled by sqrt(2)
+  BOOST_CHECK(sampling.getMethod() == ScaleFactorSampling::Method::GAUSS_HERMITE);
+  BOOST_CHECK_EQUAL(3, sampling.size());
+  BOOST_CHECK_CLOSE(-std::sqrt(3.), sampling.getNodes()[0], 1e-8);
+  BOOST_CHECK_SMALL(sampling.getNodes()[1], 1e-12);
+  BOOST_CHECK_CLOSE(std::sqrt(3.), sampling.getNodes()[2], 1e-8);
+  BOOST_CHECK_CLOSE(sampling.getWeights()[0], sampling.getWeights()[2], 1e-8);
+  BOOST_CHECK_THROW(ScaleFactorSampling::gaussHermite(0), Elements::Exception);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(gauss_hermite_moments_test) {
+  double alpha = 3., sigma = 0.5;
+  double norm  = std::sqrt(2 * M_PI) * sigma;
+
+  for (std::size_t n : {8, 12, 16}) {
+    auto sampling = ScaleFactorSampling::gaussHermite(n);
+    BOOST_CHECK_CLOSE(norm, integrate(sampling, alpha, sigma, 0), 1e-8);
+    BOOST_CHECK_CLOSE(norm * alpha, integrate(sampling, alpha, sigma, 1), 1e-8);
+    BOOST_CHECK_CLOSE(norm * (alpha * alpha + sigma * sigma), integrate(sampling, alpha, sigma, 2), 1e-8);
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,152 @@
+/**
+ * Copyright (C) 2022 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file PhzExecutables/CombinedGridCreator.h
+ * @date 2026/10/18
+ */
+
+#ifndef _PHZEXECUTABLES_COMBINEDGRIDCREATOR_H
+#define _PHZEXECUTABLES_COMBINEDGRIDCREATOR_H
+
+#include "PhysicsUtils/CosmologicalParameters.h"
+#include "PhzDataModel/PhotometryGrid.h"
+#include "PhzDataModel/PhzModel.h"
+#include "PhzModeling/ModelDatasetGrid.h"
+#include "XYDataset/QualifiedName.h"
+#include "XYDataset/XYDatasetProvider.h"
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Euclid {
+namespace PhzExecutables {
+
+/**
+ * @class CombinedGridCreator
+ * @brief
+ * Computes in a single pass the photometry grid, the filter variation
+ * coefficient grid and the galactic correction coefficient grid of a parameter
+ * space.
+ * @details
+ * Each redshifted and reddened model SED is generated only once. For each one
+ * the photometry (as the PhotometryGridCreator with the INTERPOLATION flux
+ * algorithm), the filter variation coefficients (as the
+ * FilterVariationSingleGridCreator) and the galactic correction coefficients
+ * (as the GalacticCorrectionSingleGridCreator) are computed, so the three grids
+ * are identical to the ones computed separately.
+ */
+class CombinedGridCreator {
+
+public:
+  typedef PhzModeling::ModelDatasetGrid::IgmAbsorptionFunction      IgmAbsorptionFunction;
+  typedef PhzModeling::ModelDatasetGenerator::NormalizationFunction NormalizationFunction;
+  typedef std::function<void(size_t step, size_t total)>            ProgressListener;
+
+  /// The three grids of a parameter space
+  struct Grids {
+    PhzDataModel::PhotometryGrid photometry;
+    PhzDataModel::PhotometryGrid filter_variation;
+    PhzDataModel::PhotometryGrid galactic_correction;
+  };
+
+  /**
+   * @brief Constructor
+   *
+   * @param sed_provider
+   * The provider of the SEDs
+   *
+   * @param reddening_curve_provider
+   * The provider of the reddening curves, including the Milky Way one
+   *
+   * @param filter_provider
+   * The provider of the filters
+   *
+   * @param igm_absorption_function
+   * The function to use for applying the IGM absorption to the redshifted SED
+   *
+   * @param normalization_function
+   * The function used for normalizing the SEDs
+   *
+   * @param delta_lambda
+   * The filter shifts used for computing the filter variation coefficients
+   *
+   * @param milky_way_reddening
+   * The name of the Milky Way reddening curve
+   */
+  CombinedGridCreator(std::shared_ptr<XYDataset::XYDatasetProvider> sed_provider,
+                      std::shared_ptr<XYDataset::XYDatasetProvider> reddening_curve_provider,
+                      std::shared_ptr<XYDataset::XYDatasetProvider> filter_provider,
+                      IgmAbsorptionFunction igm_absorption_function, NormalizationFunction normalization_function,
+                      std::vector<double> delta_lambda, XYDataset::QualifiedName milky_way_reddening);
+
+  /**
+   * @brief Destructor
+   */
+  virtual ~CombinedGridCreator();
+
+  /**
+   * @brief Creates the three grids of a parameter space
+   *
+   * @param parameter_space
+   * The axes of the grids
+   *
+   * @param filter_name_list
+   * The filters (and their order) of the grids
+   *
+   * @param cosmology
+   * The cosmology used for redshifting the models
+   *
+   * @param progress_listener
+   * Receives the number of models done every 0.1 sec
+   *
+   * @throw Elements::Exception
+   * If a dataset is missing from the providers or if the computation is
+   * stopped by the user
+   */
+  Grids createGrid(const PhzDataModel::ModelAxesTuple&          parameter_space,
+                   const std::vector<XYDataset::QualifiedName>& filter_name_list,
+                   const PhysicsUtils::CosmologicalParameters&  cosmology,
+                   ProgressListener                             progress_listener = ProgressListener{});
+
+  /**
+   * @brief Creates the three grids of all the regions of a parameter space
+   * @details
+   * The progress is reported in terms of the models of all the regions
+   */
+  std::map<std::string, Grids> createGrid(const std::map<std::string, PhzDataModel::ModelAxesTuple>& parameter_space_map,
+                                          const std::vector<XYDataset::QualifiedName>&               filter_name_list,
+                                          const PhysicsUtils::CosmologicalParameters&                cosmology,
+                                          ProgressListener progress_listener = ProgressListener{});
+
+private:
+  std::shared_ptr<XYDataset::XYDatasetProvider> m_sed_provider;
+  std::shared_ptr<XYDataset::XYDatasetProvider> m_reddening_curve_provider;
+  std::shared_ptr<XYDataset::XYDatasetProvider> m_filter_provider;
+  IgmAbsorptionFunction                         m_igm_absorption_function;
+  NormalizationFunction                         m_normalization_function;
+  std::vector<double>                           m_delta_lambda;
+  XYDataset::QualifiedName                      m_milky_way_reddening;
+};
+
+}  // namespace PhzExecutables
+}  // namespace Euclid
+
+#endif  // _PHZEXECUTABLES_COMBINEDGRIDCREATOR_H
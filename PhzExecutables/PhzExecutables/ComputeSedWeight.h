@@ -26,10 +26,12 @@
 #define _PHZEXECUTABLES_COMPUTESEDWEIGHT_H
 
 #include "Configuration/ConfigManager.h"
+#include "PhzDataModel/FilterInfo.h"
 #include "PhzDataModel/PhotometryGridInfo.h"
 #include "PhzLikelihood/ParallelCatalogHandler.h"
 #include "XYDataset/QualifiedName.h"
 #include "XYDataset/XYDatasetProvider.h"
+#include <map>
 #include <set>
 #include <string>
 #include <utility>
@@ -48,9 +50,14 @@ class ComputeSedWeight {
 public:
   using ProgressListener = PhzLikelihood::ParallelCatalogHandler::ProgressListener;
 
-  ComputeSedWeight(long sampling_number = 100000);
+  /**
+   * @brief Constructor
+   * @param sampling_number The number of Monte Carlo draws per SED used for computing the weights
+   * @param seed The seed of the random draws. If negative, a random seed is used.
+   */
+  ComputeSedWeight(long sampling_number = 100000, long seed = -1);
 
-  ComputeSedWeight(ProgressListener progress_listener, long sampling_number = 100000);
+  ComputeSedWeight(ProgressListener progress_listener, long sampling_number = 100000, long seed = -1);
 
   void run(Configuration::ConfigManager& config_manager);
 
@@ -60,6 +67,22 @@ public:
   orderFilters(const std::vector<XYDataset::QualifiedName>&        filter_list,
                const std::shared_ptr<XYDataset::XYDatasetProvider> filter_provider) const;
 
+  /**
+   * @brief
+   * Builds the table of the ordered filters, once for all the SEDs
+   *
+   * @details
+   * The range and the transmission function of each filter are built with the
+   * BuildFilterInfoFunctor. The normalization is the integral of the
+   * transmission over the filter range, which is what the colors are computed
+   * with. The table is only read while computing the colors, so it can be
+   * shared between the threads.
+   */
+  std::vector<PhzDataModel::FilterInfo>
+  buildFilterTable(const std::vector<std::pair<XYDataset::QualifiedName, double>>& ordered_filters,
+                   const std::shared_ptr<XYDataset::XYDatasetProvider>             filter_provider) const;
+
+  /// Computes the colors of the SEDs, in parallel over the SEDs
   std::vector<std::vector<double>>
   computeSedColors(const std::vector<std::pair<XYDataset::QualifiedName, double>>& ordered_filters,
                    const std::set<XYDataset::QualifiedName>&                       sed_list,
@@ -79,13 +102,34 @@ public:
 
   //------------- Computing the weights ----------------------------------------
 
+  /**
+   * @brief
+   * Computes the weights of the SEDs by Monte Carlo sampling of their colors
+   *
+   * @details
+   * The draws of each SED are split in blocks of fixed size, each one using its
+   * own random stream derived from the seed, the SED index and the block index.
+   * The blocks are processed in parallel and their sums are merged in order,
+   * so the weights do not depend on the number of threads.
+   */
   std::vector<double> getWeights(const std::vector<std::vector<double>>& seds_colors, double radius) const;
 
   //------------- handle the different set of SED ----------------------------------------
-  std::string getCellKey(double z_value, double ebv_value, const XYDataset::QualifiedName& curve_value) const;
 
-  std::pair<std::map<std::string, std::set<XYDataset::QualifiedName>>, long>
-  getSedCollection(const Euclid::PhzDataModel::PhotometryGridInfo& grid_info) const;
+  /// The union of the axes of all the regions, which are used for numbering the cells
+  struct CellAxes {
+    std::vector<double>                   z{};
+    std::vector<double>                   ebv{};
+    std::vector<XYDataset::QualifiedName> reddening_curve{};
+  };
+
+  CellAxes getCellAxes(const PhzDataModel::PhotometryGridInfo& grid_info) const;
+
+  std::size_t getCellIndex(const CellAxes& cell_axes, double z_value, double ebv_value,
+                           const XYDataset::QualifiedName& curve_value) const;
+
+  std::pair<std::map<std::size_t, std::set<XYDataset::QualifiedName>>, long>
+  getSedCollection(const PhzDataModel::PhotometryGridInfo& grid_info, const CellAxes& cell_axes) const;
 
   /**
    * @brief Destructor
@@ -94,6 +138,7 @@ public:
 
 private:
   long             m_sampling_number;
+  long             m_seed;
   ProgressListener m_progress_listener;
 }; /* End of ComputeSedWeight class */
 
@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2022 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file PhzExecutables/NearestNeighborIndex.h
+ * @date 2026/10/18
+ */
+
+#ifndef _PHZEXECUTABLES_NEARESTNEIGHBORINDEX_H
+#define _PHZEXECUTABLES_NEARESTNEIGHBORINDEX_H
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace Euclid {
+namespace PhzExecutables {
+
+/**
+ * @class NearestNeighborIndex
+ * @brief
+ *  Kd-tree over a set of points of the same dimension, answering exact k nearest
+ *  neighbour queries with the euclidean distance.
+ * @details
+ *  The tree is built once, by splitting at the median of the widest dimension,
+ *  and is not modified by the queries, so it can be queried from several threads.
+ */
+class NearestNeighborIndex {
+
+public:
+  /**
+   * @brief Constructor
+   * @param dimensions
+   *    The number of coordinates of each point
+   * @param coordinates
+   *    The coordinates of the points, one point after the other. The index of a
+   *    point is its position in this sequence.
+   * @param leaf_size
+   *    The maximum number of points of the leaves, which are searched linearly
+   * @throw Elements::Exception
+   *    If the dimension is zero, or the number of coordinates is not a multiple of it
+   */
+  NearestNeighborIndex(std::size_t dimensions, std::vector<double> coordinates, std::size_t leaf_size = 16);
+
+  /// @return The number of indexed points
+  std::size_t size() const;
+
+  /**
+   * Find the k nearest points of the given point.
+   * @param point
+   *    The coordinates of the point, which must have the dimension of the index
+   * @param k
+   *    The number of neighbours. If there are less points, all of them are returned.
+   * @return The pairs of distance and point index of the neighbours, by increasing distance
+   */
+  std::vector<std::pair<double, std::size_t>> findNearest(const std::vector<double>& point, std::size_t k) const;
+
+private:
+  /// A node covers the points m_order[begin, end). The leaves have no children.
+  struct Node {
+    std::size_t begin, end;
+    std::size_t dimension;
+    double      split;
+    std::size_t left, right;
+  };
+
+  std::size_t              m_dimensions;
+  std::vector<double>      m_coordinates;
+  std::size_t              m_leaf_size;
+  std::vector<std::size_t> m_order;
+  std::vector<Node>        m_nodes;
+
+  std::size_t build(std::size_t begin, std::size_t end);
+
+  double squaredDistance(const std::vector<double>& point, std::size_t index) const;
+
+  void search(std::size_t node_index, const std::vector<double>& point, std::size_t k,
+              std::vector<std::pair<double, std::size_t>>& heap) const;
+};
+
+}  // namespace PhzExecutables
+}  // namespace Euclid
+
+#endif
@@ -0,0 +1,136 @@
+/*
+ * Copyright (C) 2022 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file PhzExecutables/ReferenceSampleKnn.h
+ * @date 2026/10/18
+ */
+
+#ifndef _PHZEXECUTABLES_REFERENCESAMPLEKNN_H
+#define _PHZEXECUTABLES_REFERENCESAMPLEKNN_H
+
+#include "PhzDataModel/Pdf1D.h"
+#include "PhzExecutables/NearestNeighborIndex.h"
+#include "PhzOutput/OutputHandler.h"
+#include "PhzReferenceSample/ReferenceSample.h"
+#include "SourceCatalog/SourceAttributes/Photometry.h"
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Euclid {
+namespace PhzExecutables {
+
+/**
+ * @class ReferenceSampleKnn
+ * @brief
+ *  Quick-look redshift estimator, which combines the PDZs stored in a reference
+ *  sample for the k nearest neighbours of each source in colour space.
+ * @details
+ *  The colours are the magnitude differences of consecutive filters. The
+ *  neighbours are found with a NearestNeighborIndex built once over the reference
+ *  sample photometry, and their PDZs are combined with inverse distance weights. The
+ *  results are passed to a PhzOutput::OutputHandler as a Z_1D_PDF, so the same
+ *  output handlers as for the template fitting can be used.
+ */
+class ReferenceSampleKnn {
+
+public:
+  typedef std::function<void(size_t step, size_t total)> ProgressListener;
+  using Pdz = PhzDataModel::Pdf1DParam<PhzDataModel::ModelParameter::Z>;
+
+  static const std::size_t DEFAULT_NEIGHBOR_NUMBER = 20;
+
+  /**
+   * @brief Constructor
+   * @param reference_sample
+   *    The reference sample with the PDZs. It must not be modified while the
+   *    estimator is in use, as the estimator keeps views over its PDZs.
+   * @param filter_names
+   *    The filters of the photometry, in the order used for the colours
+   * @param reference_fluxes
+   *    The pairs of reference object ID and fluxes, in the order of filter_names.
+   *    The objects without PDZ or with a non positive flux are ignored.
+   * @param neighbor_number
+   *    The number of neighbours combined for each source
+   * @throw Elements::Exception
+   *    If there are less than two filters, no usable reference object, or PDZs
+   *    with different numbers of redshift bins
+   */
+  ReferenceSampleKnn(const ReferenceSample::ReferenceSample& reference_sample, std::vector<std::string> filter_names,
+                     const std::vector<std::pair<int64_t, std::vector<double>>>& reference_fluxes,
+                     std::size_t neighbor_number = DEFAULT_NEIGHBOR_NUMBER);
+
+  /**
+   * @brief Destructor
+   */
+  virtual ~ReferenceSampleKnn() = default;
+
+  /// @return The number of reference objects in the colour space index
+  std::size_t size() const;
+
+  /**
+   * Compute the PDZ of a source from its neighbours in the reference sample.
+   * @param photometry
+   *    The source photometry. It must contain all the filters of the estimator.
+   * @return The weighted mean of the neighbour PDZs, over the reference sample
+   *    redshift bins. If a colour of the source cannot be computed, because of
+   *    a missing, upper limit or non positive flux, the PDZ is flat.
+   * @throw Elements::Exception
+   *    If the photometry does not contain one of the filters
+   */
+  Pdz computePdz(const SourceCatalog::Photometry& photometry) const;
+
+  /**
+   * Compute the PDZs of a set of sources, using all the available threads. The
+   * output handler is called once per source, in the input order, from the
+   * calling thread.
+   *
+   * @tparam SourceIter
+   *    The type of iterator over the sources. It must be an iterator over
+   *    objects of type SourceCatalog::Source with a Photometry attribute.
+   * @param source_begin
+   *    An iterator pointing to the first source
+   * @param source_end
+   *    An iterator pointing to one after the last source
+   * @param out_handler
+   *    The handler which receives the Z_1D_PDF of each source
+   * @param progress_listener
+   *    A function of type ProgressListener which is notified with the progress
+   *    of the catalog handling (defaults to no action)
+   */
+  template <typename SourceIter>
+  void handleSources(SourceIter source_begin, SourceIter source_end, PhzOutput::OutputHandler& out_handler,
+                     ProgressListener progress_listener = ProgressListener{}) const;
+
+private:
+  std::vector<std::string>                  m_filter_names;
+  std::size_t                               m_neighbor_number;
+  std::vector<ReferenceSample::PdzDataView> m_pdzs;
+  std::unique_ptr<NearestNeighborIndex>     m_index;
+  std::vector<double>                       m_bins;
+};
+
+}  // namespace PhzExecutables
+}  // namespace Euclid
+
+#include "PhzExecutables/_impl/ReferenceSampleKnn.icpp"
+
+#endif
@@ -35,7 +35,15 @@
 #include "PhzModeling/RedshiftFunctor.h"
 
 #include "MathUtils/interpolation/interpolation.h"
+#include "PhzUtils/Multithreading.h"
 #include "XYDataset/CachedProvider.h"
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <map>
+#include <memory>
+#include <tuple>
+#include <vector>
 
 namespace Euclid {
 namespace PhzExecutables {
@@ -129,7 +137,8 @@ void BuildReferenceSample::run(Euclid::Configuration::ConfigManager& config_mana
 		  throw Elements::Exception() << "The directory already exists: " << ref_sample_path;
 	  }
   }
-  auto ref_sample = ReferenceSample::create(ref_sample_config.getReferenceSamplePath(), false, ref_sample_config.getMaxSize());
+  auto ref_sample = ReferenceSample::create(ref_sample_config.getReferenceSamplePath(), false,
+                                            ref_sample_config.getMaxSize(), ref_sample_config.getStorageMode());
 
   logger.info() << "Reading the Phosphoros catalog";
   auto phosphoros_readers = ref_sample_config.getPhosphorosCatalogReader();
@@ -173,6 +182,29 @@ void BuildReferenceSample::run(Euclid::Configuration::ConfigManager& config_mana
   ref_sample.optimize();
 }
 
+namespace {
+
+/// The parameters identifying the model of an object: SED, E(B-V), reddening curve and redshift
+using ModelKey = std::tuple<XYDataset::QualifiedName, double, XYDataset::QualifiedName, double>;
+
+/// The number of generated SEDs kept in memory for being reused by the next objects
+constexpr std::size_t MAX_CACHED_MODELS = 100000;
+
+struct ObjectModel {
+  std::shared_ptr<const std::vector<std::pair<double, double>>> sed;
+  double                                                        scale;
+  std::vector<double>                                           pdz;
+};
+
+struct ModelGenerationTask {
+  ModelKey                                                model;
+  std::unique_ptr<XYDataset::XYDataset>                   sed;
+  std::unique_ptr<MathUtils::Function>                    reddening_curve;
+  std::shared_ptr<std::vector<std::pair<double, double>>> result;
+};
+
+}  // namespace
+
 void BuildReferenceSample::processCatalog(Table::TableReader& reader, ReferenceSample& ref_sample,
                                           const PhotometryGridCreator::IgmAbsorptionFunction& igm_function,
                                           const NormalizationFunction&                        normalizer_functor,
@@ -180,52 +212,97 @@ void BuildReferenceSample::processCatalog(Table::TableReader& reader, ReferenceS
                                           XYDataset::XYDatasetProvider&                       sed_provider,
                                           const RedshiftFunctor& redshiftFunctor, const std::vector<double>& pdz_bins,
                                           size_t total, int64_t& i) {
+  // The SEDs of the models shared by several objects are generated only once
+  std::map<ModelKey, std::shared_ptr<std::vector<std::pair<double, double>>>> model_cache;
+
   while (reader.hasMoreRows()) {
     auto phosphoros_table = reader.read(10000);
     logger.info() << phosphoros_table.size() << " entries loaded";
 
+    if (model_cache.size() > MAX_CACHED_MODELS) {
+      model_cache.clear();
+    }
+
+    // Find the models of the objects. The datasets of the models missing from the
+    // cache are read here, as the providers are used by a single thread.
+    std::vector<ObjectModel>         objects;
+    std::vector<ModelGenerationTask> tasks;
+    objects.reserve(phosphoros_table.size());
     for (auto& object : phosphoros_table) {
-      auto                     obj_id = i; // boost::get<int64_t>(object["ID"]);
-      auto                     z      = boost::get<double>(object["Z"]);
-      auto                     ebv    = boost::get<double>(object["E(B-V)"]);
-      auto                     scale  = boost::get<double>(object["Scale"]);
+      auto                     z     = boost::get<double>(object["Z"]);
+      auto                     ebv   = boost::get<double>(object["E(B-V)"]);
+      auto                     scale = boost::get<double>(object["Scale"]);
       XYDataset::QualifiedName red_curve_name{boost::get<std::string>(object["ReddeningCurve"])};
       XYDataset::QualifiedName sed_name{boost::get<std::string>(object["SED"])};
+      ModelKey                 model{sed_name, ebv, red_curve_name, z};
 
-      std::map<XYDataset::QualifiedName, std::unique_ptr<MathUtils::Function>> reddening_curve_map;
-      std::map<XYDataset::QualifiedName, XYDataset::XYDataset>                 sed_map;
-
-      auto sed = sed_provider.getDataset(sed_name);
-      if (!sed) {
-        throw Elements::Exception() << "Could not load the SED " << sed_name;
+      if (model_cache.find(model) == model_cache.end()) {
+        auto sed = sed_provider.getDataset(sed_name);
+        if (!sed) {
+          throw Elements::Exception() << "Could not load the SED " << sed_name;
+        }
+        auto red_curve = reddening_provider.getDataset(red_curve_name);
+        if (!red_curve) {
+          throw Elements::Exception() << "Could not load the reddening curve " << red_curve_name;
+        }
+        auto result        = std::make_shared<std::vector<std::pair<double, double>>>();
+        model_cache[model] = result;
+        tasks.push_back(
+            ModelGenerationTask{model, std::move(sed), interpolatedReddeningCurve(red_curve_name, *red_curve), result});
       }
-      sed_map.emplace(std::make_pair(sed_name, std::move(*sed)));
 
-      auto red_curve = reddening_provider.getDataset(red_curve_name);
-      if (!red_curve) {
-        throw Elements::Exception() << "Could not load the reddening curve " << red_curve_name;
+      std::vector<double> pdz_vals{};
+      if (!pdz_bins.empty()) {
+        pdz_vals = boost::get<std::vector<double>>(object["Z-1D-PDF"]);
       }
+      objects.push_back(ObjectModel{model_cache.at(model), scale, std::move(pdz_vals)});
+    }
 
-      reddening_curve_map.emplace(
-          std::make_pair(red_curve_name, interpolatedReddeningCurve(red_curve_name, *red_curve)));
-
-      ModelAxesTuple   grid_axes{createAxesTuple({z}, {ebv}, {red_curve_name}, {sed_name})};
-      ModelDatasetGrid grid{grid_axes,           std::move(sed_map), std::move(reddening_curve_map),
-                            ExtinctionFunctor{}, redshiftFunctor,    igm_function,
-                            normalizer_functor};
-
-      for (auto& cell : grid) {
-        std::vector<std::pair<double, double>> scaled_data{};
-        for (auto it = cell.begin(); it != cell.end(); ++it) {
-          auto scaled_point = *it;
-          scaled_point.second *= scale;
-          scaled_data.push_back(std::move(scaled_point));
+    // Generate the new models in parallel
+    std::atomic<std::size_t> next_task{0};
+    auto                     generate_models = [&]() {
+      for (std::size_t task_index = next_task++; task_index < tasks.size(); task_index = next_task++) {
+        auto& task           = tasks[task_index];
+        auto& sed_name       = std::get<0>(task.model);
+        auto& red_curve_name = std::get<2>(task.model);
+
+        std::map<XYDataset::QualifiedName, std::unique_ptr<MathUtils::Function>> reddening_curve_map;
+        std::map<XYDataset::QualifiedName, XYDataset::XYDataset>                 sed_map;
+        sed_map.emplace(std::make_pair(sed_name, std::move(*task.sed)));
+        reddening_curve_map.emplace(std::make_pair(red_curve_name, std::move(task.reddening_curve)));
+
+        ModelAxesTuple   grid_axes{createAxesTuple({std::get<3>(task.model)}, {std::get<1>(task.model)},
+                                                   {red_curve_name}, {sed_name})};
+        ModelDatasetGrid grid{grid_axes,           std::move(sed_map), std::move(reddening_curve_map),
+                              ExtinctionFunctor{}, redshiftFunctor,    igm_function,
+                              normalizer_functor};
+
+        for (auto& cell : grid) {
+          for (auto it = cell.begin(); it != cell.end(); ++it) {
+            task.result->push_back(*it);
+          }
         }
-        ref_sample.addSedData(obj_id, XYDataset::XYDataset::factory(std::move(scaled_data)));
       }
+    };
+    std::size_t threads = std::max<std::size_t>(1, std::min<std::size_t>(PhzUtils::getThreadNumber(), tasks.size()));
+    std::vector<std::future<void>> futures;
+    for (std::size_t thread_index = 0; thread_index < threads; ++thread_index) {
+      futures.push_back(std::async(std::launch::async, generate_models));
+    }
+    for (auto& f : futures) {
+      f.get();
+    }
+
+    // Commit the objects in the input order
+    for (auto& object : objects) {
+      auto                                   obj_id = i;
+      std::vector<std::pair<double, double>> scaled_data{*object.sed};
+      for (auto& scaled_point : scaled_data) {
+        scaled_point.second *= object.scale;
+      }
+      ref_sample.addSedData(obj_id, XYDataset::XYDataset::factory(std::move(scaled_data)));
       if (!pdz_bins.empty()) {
-        auto pdz_vals = boost::get<std::vector<double>>(object["Z-1D-PDF"]);
-        ref_sample.addPdzData(obj_id, XYDataset::XYDataset::factory(pdz_bins, pdz_vals));
+        ref_sample.addPdzData(obj_id, XYDataset::XYDataset::factory(pdz_bins, object.pdz));
       }
 
       ++i;
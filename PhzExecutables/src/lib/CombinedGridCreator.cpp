@@ -0,0 +1,268 @@
+/**
+ * Copyright (C) 2022 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file src/lib/CombinedGridCreator.cpp
+ * @date 2026/10/18
+ */
+
+#include "PhzExecutables/CombinedGridCreator.h"
+#include "ElementsKernel/Exception.h"
+#include "ElementsKernel/Logging.h"
+#include "GridContainer/GridIndexHelper.h"
+#include "MathUtils/interpolation/interpolation.h"
+#include "PhzDataModel/FilterInfo.h"
+#include "PhzFilterVariation/FilterVariationCoefficientCalculator.h"
+#include "PhzGalacticCorrection/GalacticCorrectionCalculator.h"
+#include "PhzModeling/ApplyFilterFunctor.h"
+#include "PhzModeling/BuildFilterInfoFunctor.h"
+#include "PhzModeling/ExtinctionFunctor.h"
+#include "PhzModeling/ModelFluxAlgorithm.h"
+#include "PhzModeling/RedshiftFunctor.h"
+#include "PhzUtils/Multithreading.h"
+#include <atomic>
+#include <boost/algorithm/string.hpp>
+#include <chrono>
+#include <future>
+#include <iterator>
+#include <thread>
+
+namespace Euclid {
+namespace PhzExecutables {
+
+static Elements::Logging logger = Elements::Logging::getLogger("CombinedGridCreator");
+
+namespace {
+
+XYDataset::XYDataset getDataset(XYDataset::XYDatasetProvider& provider, const XYDataset::QualifiedName& name) {
+  auto dataset_ptr = provider.getDataset(name);
+  if (!dataset_ptr) {
+    throw Elements::Exception() << "Failed to find dataset: " << name.qualifiedName();
+  }
+  return std::move(*dataset_ptr);
+}
+
+/*
+ * The photometry uses the filters in photon count, so the ones given in energy
+ * are divided by lambda, as in the PhotometryGridCreator. The filter variation
+ * and galactic correction coefficients use the filters as they are.
+ */
+XYDataset::XYDataset toPhotonCount(XYDataset::XYDatasetProvider& provider, const XYDataset::QualifiedName& name,
+                                   const XYDataset::XYDataset& filter) {
+  std::string filter_type = provider.getParameter(name, "FilterType");
+  boost::algorithm::to_lower(filter_type);
+  if (filter_type != "energy") {
+    return XYDataset::XYDataset::factory(std::vector<std::pair<double, double>>(filter.begin(), filter.end()));
+  }
+  std::vector<std::pair<double, double>> values{};
+  for (auto& pair : filter) {
+    values.emplace_back(pair.first, pair.second / pair.first);
+  }
+  return XYDataset::XYDataset::factory(std::move(values));
+}
+
+/// The filter related data shared by all the threads
+struct FilterData {
+  std::shared_ptr<std::vector<std::string>>                             filter_names;
+  std::vector<PhzDataModel::FilterInfo>                                 photometry_filters;
+  std::vector<PhzDataModel::FilterInfo>                                 filters;
+  std::vector<PhzFilterVariation::FilterVariationCoefficientCalculator> variation_calculators;
+  XYDataset::XYDataset                                                  milky_way_reddening;
+};
+
+/*
+ * Computes the three grids of the models in [model_begin, model_end). Each
+ * model is generated once and used for all of them.
+ */
+void computeRange(const FilterData& data, PhzModeling::ModelDatasetGrid::iterator model_begin,
+                  PhzModeling::ModelDatasetGrid::iterator model_end,
+                  PhzDataModel::PhotometryGrid::iterator  photometry_iter,
+                  PhzDataModel::PhotometryGrid::iterator  variation_iter,
+                  PhzDataModel::PhotometryGrid::iterator correction_iter, std::atomic<size_t>& progress) {
+  PhzModeling::ModelFluxAlgorithm                     flux_algorithm{PhzModeling::ApplyFilterFunctor{}};
+  PhzGalacticCorrection::GalacticCorrectionCalculator correction_calculator{data.filters, data.milky_way_reddening};
+  auto                                                variation_calculators = data.variation_calculators;
+
+  size_t              filter_number = data.filter_names->size();
+  std::vector<double> correction_buffer(filter_number);
+  for (; model_begin != model_end; ++model_begin, ++photometry_iter, ++variation_iter, ++correction_iter) {
+    if (PhzUtils::getStopThreadsFlag()) {
+      throw Elements::Exception() << "Stopped by the user";
+    }
+    auto& model = *model_begin;
+
+    std::vector<SourceCatalog::FluxErrorPair> fluxes(filter_number, {0., 0.});
+    flux_algorithm(model, data.photometry_filters.begin(), data.photometry_filters.end(), fluxes.begin());
+    if (!fluxes.empty()) {
+      fluxes[0].error = model.getScaling() / model.getDiffScaling();
+    }
+    *photometry_iter = SourceCatalog::Photometry(data.filter_names, std::move(fluxes));
+
+    std::vector<SourceCatalog::FluxErrorPair> variation(filter_number, {0., 0.});
+    for (size_t i = 0; i < filter_number; ++i) {
+      auto coef          = variation_calculators[i](model);
+      variation[i].flux  = coef.first;
+      variation[i].error = coef.second;
+    }
+    *variation_iter = SourceCatalog::Photometry(data.filter_names, std::move(variation));
+
+    correction_calculator(model, correction_buffer);
+    std::vector<SourceCatalog::FluxErrorPair> correction(filter_number, {0., 0.});
+    for (size_t i = 0; i < filter_number; ++i) {
+      correction[i].flux = correction_buffer[i];
+    }
+    *correction_iter = SourceCatalog::Photometry(data.filter_names, std::move(correction));
+
+    ++progress;
+  }
+}
+
+}  // namespace
+
+CombinedGridCreator::CombinedGridCreator(std::shared_ptr<XYDataset::XYDatasetProvider> sed_provider,
+                                         std::shared_ptr<XYDataset::XYDatasetProvider> reddening_curve_provider,
+                                         std::shared_ptr<XYDataset::XYDatasetProvider> filter_provider,
+                                         IgmAbsorptionFunction                         igm_absorption_function,
+                                         NormalizationFunction normalization_function, std::vector<double> delta_lambda,
+                                         XYDataset::QualifiedName milky_way_reddening)
+    : m_sed_provider{sed_provider}
+    , m_reddening_curve_provider{reddening_curve_provider}
+    , m_filter_provider{filter_provider}
+    , m_igm_absorption_function{igm_absorption_function}
+    , m_normalization_function{normalization_function}
+    , m_delta_lambda{std::move(delta_lambda)}
+    , m_milky_way_reddening{milky_way_reddening} {}
+
+CombinedGridCreator::~CombinedGridCreator() {
+  // The multithreaded job is done, so reset the stop threads flag
+  PhzUtils::getStopThreadsFlag() = false;
+}
+
+CombinedGridCreator::Grids CombinedGridCreator::createGrid(const PhzDataModel::ModelAxesTuple&          parameter_space,
+                                                           const std::vector<XYDataset::QualifiedName>& filter_name_list,
+                                                           const PhysicsUtils::CosmologicalParameters&  cosmology,
+                                                           ProgressListener progress_listener) {
+  // The filters, in photon count for the photometry and as they are for the coefficients
+  PhzModeling::BuildFilterInfoFunctor filter_info_functor{};
+  auto                                milky_way_reddening = m_reddening_curve_provider->getDataset(m_milky_way_reddening);
+  if (milky_way_reddening == nullptr) {
+    throw Elements::Exception() << "The provided Milky Way reddening curve (" << m_milky_way_reddening.qualifiedName()
+                                << ") is not found by the Reddening Curve provider.";
+  }
+  FilterData data{std::make_shared<std::vector<std::string>>(), {}, {}, {}, std::move(*milky_way_reddening)};
+  for (auto& filter_name : filter_name_list) {
+    auto filter = getDataset(*m_filter_provider, filter_name);
+    data.filter_names->emplace_back(filter_name.qualifiedName());
+    data.photometry_filters.emplace_back(filter_info_functor(toPhotonCount(*m_filter_provider, filter_name, filter)));
+    data.filters.emplace_back(filter_info_functor(filter));
+    data.variation_calculators.emplace_back(filter, m_delta_lambda);
+  }
+
+  // The models
+  std::map<XYDataset::QualifiedName, XYDataset::XYDataset> sed_map{};
+  for (auto& sed_name : std::get<PhzDataModel::ModelParameter::SED>(parameter_space)) {
+    sed_map.emplace(sed_name, getDataset(*m_sed_provider, sed_name));
+  }
+  std::map<XYDataset::QualifiedName, std::unique_ptr<MathUtils::Function>> reddening_curve_map{};
+  for (auto& curve_name : std::get<PhzDataModel::ModelParameter::REDDENING_CURVE>(parameter_space)) {
+    reddening_curve_map.emplace(curve_name, MathUtils::interpolate(getDataset(*m_reddening_curve_provider, curve_name),
+                                                                   MathUtils::InterpolationType::LINEAR));
+  }
+  PhzModeling::ModelDatasetGrid model_grid{parameter_space,
+                                           std::move(sed_map),
+                                           std::move(reddening_curve_map),
+                                           PhzModeling::ExtinctionFunctor{},
+                                           PhzModeling::RedshiftFunctor{cosmology},
+                                           m_igm_absorption_function,
+                                           m_normalization_function};
+
+  Grids grids{PhzDataModel::PhotometryGrid{parameter_space, filter_name_list},
+              PhzDataModel::PhotometryGrid{parameter_space, filter_name_list},
+              PhzDataModel::PhotometryGrid{parameter_space, filter_name_list}};
+
+  // Split the models between the threads
+  std::vector<std::future<void>> futures;
+  std::atomic<size_t>            progress{0};
+  size_t                         total_models = model_grid.size();
+  size_t                         threads      = std::max<size_t>(1, PhzUtils::getThreadNumber());
+  if (total_models < threads) {
+    threads = std::max<size_t>(1, total_models);
+  }
+  logger.info() << "Creating the photometry, filter variation and galactic correction grids for " << total_models
+                << " models using " << threads << " threads";
+
+  auto   model_iter      = model_grid.begin();
+  auto   photometry_iter = grids.photometry.begin();
+  auto   variation_iter  = grids.filter_variation.begin();
+  auto   correction_iter = grids.galactic_correction.begin();
+  size_t step            = total_models / threads;
+  for (size_t i = 0; i < threads; ++i) {
+    auto end_model_iter = model_iter;
+    std::advance(end_model_iter, (i + 1 < threads) ? step : total_models - step * i);
+    futures.push_back(std::async(std::launch::async, computeRange, std::cref(data), model_iter, end_model_iter,
+                                 photometry_iter, variation_iter, correction_iter, std::ref(progress)));
+    model_iter = end_model_iter;
+    std::advance(photometry_iter, step);
+    std::advance(variation_iter, step);
+    std::advance(correction_iter, step);
+  }
+
+  // If we have a progress listener we update it every .1 sec
+  if (progress_listener) {
+    for (auto& f : futures) {
+      while (f.wait_for(std::chrono::milliseconds(100)) != std::future_status::ready) {
+        progress_listener(progress, total_models);
+      }
+    }
+    progress_listener(total_models, total_models);
+  }
+  for (auto& f : futures) {
+    f.get();
+  }
+
+  return grids;
+}
+
+std::map<std::string, CombinedGridCreator::Grids>
+CombinedGridCreator::createGrid(const std::map<std::string, PhzDataModel::ModelAxesTuple>& parameter_space_map,
+                                const std::vector<XYDataset::QualifiedName>&               filter_name_list,
+                                const PhysicsUtils::CosmologicalParameters& cosmology, ProgressListener progress_listener) {
+  size_t total = 0;
+  for (auto& pair : parameter_space_map) {
+    total += GridContainer::makeGridIndexHelper(pair.second).m_axes_index_factors.back();
+  }
+
+  std::map<std::string, Grids> result{};
+  size_t                       already_done = 0;
+  for (auto& pair : parameter_space_map) {
+    logger.info() << "Creating the grids for parameter space region : \"" << pair.first << "\"";
+    ProgressListener region_listener{};
+    if (progress_listener) {
+      region_listener = [progress_listener, already_done, total](size_t step, size_t) {
+        progress_listener(already_done + step, total);
+      };
+    }
+    auto grids = createGrid(pair.second, filter_name_list, cosmology, region_listener);
+    already_done += grids.photometry.size();
+    result.emplace(pair.first, std::move(grids));
+  }
+  return result;
+}
+
+}  // namespace PhzExecutables
+}  // namespace Euclid
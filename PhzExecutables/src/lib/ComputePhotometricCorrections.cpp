@@ -31,6 +31,7 @@
 #include "PhzConfiguration/ScaleFactorMarginalizationConfig.h"
 
 #include "PhzConfiguration/ErrorAdjustmentConfig.h"
+#include "PhzPhotometricCorrection/BestFitModelCache.h"
 #include "PhzPhotometricCorrection/CalculateScaleFactorMap.h"
 #include "PhzPhotometricCorrection/FindBestFitModels.h"
 #include "PhzPhotometricCorrection/ParallelSourcesHandler.h"
@@ -88,6 +89,14 @@ void ComputePhotometricCorrections::run(ConfigManager& config_manager) {
 
   ThreadPool thread_pool(threads);
 
+  // When warm starting, the iterations after the first one fit the sources
+  // around their previous best fitted models
+  std::shared_ptr<BestFitModelCache> model_cache{};
+  auto& phot_corr_config = config_manager.getConfiguration<ComputePhotometricCorrectionsConfig>();
+  if (phot_corr_config.isWarmStartEnabled()) {
+    model_cache = std::make_shared<BestFitModelCache>(phot_corr_config.getWarmStartNeighbourhoodSize());
+  }
+
   ParallelIteratorHandler<FindBestFitModels<PhzLikelihood::SourcePhzFunctor>> find_best_fit_models{
       threads,
       thread_pool,
@@ -96,16 +105,30 @@ void ComputePhotometricCorrections::run(ConfigManager& config_manager) {
       sampling_sigma_range,
       priors,
       marginalization_func_list,
-      model_func_list};
+      model_func_list,
+      model_cache};
 
   ParallelIteratorHandler<CalculateScaleFactorMap> calculate_scale_factor_map{threads, thread_pool, scale_factor_func};
   PhotometricCorrectionAlgorithm                   phot_corr_algorithm;
-  auto                                             selector =
-      config_manager.getConfiguration<ComputePhotometricCorrectionsConfig>().getPhotometricCorrectionSelector();
+  auto selector = phot_corr_config.getPhotometricCorrectionSelector(thread_pool);
 
   PhotometricCorrectionCalculator calculator{find_best_fit_models, calculate_scale_factor_map, phot_corr_algorithm};
 
-  auto phot_corr_map = calculator(catalog, model_phot_grid, stop_criteria, selector, m_progress_listener);
+  auto progress_listener = m_progress_listener;
+  if (model_cache != nullptr) {
+    progress_listener = [this, model_cache](size_t iter_no, const PhzDataModel::PhotometricCorrectionMap& phot_corr) {
+      if (iter_no > 1) {
+        logger.info() << "Iteration no: " << iter_no << " fell back to the full model search for "
+                      << model_cache->getFallbackCount() << " sources";
+      }
+      model_cache->resetFallbackCount();
+      if (m_progress_listener) {
+        m_progress_listener(iter_no, phot_corr);
+      }
+    };
+  }
+
+  auto phot_corr_map = calculator(catalog, model_phot_grid, stop_criteria, selector, progress_listener);
 
   output_func(phot_corr_map);
 }
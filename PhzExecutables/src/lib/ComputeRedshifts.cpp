@@ -27,6 +27,7 @@
 #include "ElementsKernel/Logging.h"
 
 #include "Configuration/CatalogConfig.h"
+#include "Configuration/PhotometricBandMappingConfig.h"
 #include "PhzConfiguration/ComputeRedshiftsConfig.h"
 #include "PhzConfiguration/ErrorAdjustmentConfig.h"
 #include "PhzConfiguration/LikelihoodGridFuncConfig.h"
@@ -80,9 +81,15 @@ void ComputeRedshifts::doRun(ConfigManager& config_manager) {
   bool   do_normalize_pdf     = config_manager.getConfiguration<PdfOutputConfig>().doNormalizePDFs();
   double sampling_sigma_range = config_manager.getConfiguration<ScaleFactorMarginalizationConfig>().getSampleNumber();
 
+  // The catalog filters, in the order of the photometry of the sources
+  std::vector<std::string> catalog_filters{};
+  for (auto& pair : config_manager.getConfiguration<PhotometricBandMappingConfig>().getPhotometricBandMapping()) {
+    catalog_filters.push_back(pair.first);
+  }
+
   CatalogHandler handler{
       phot_corr_map, adjust_error_param_map,    model_phot_grid, likelihood_grid_func, sampling_sigma_range,
-      priors,        marginalization_func_list, model_func_list, do_normalize_pdf};
+      priors,        marginalization_func_list, model_func_list, do_normalize_pdf,     catalog_filters};
 
   auto table_reader      = config_manager.getConfiguration<CatalogConfig>().getTableReader();
   auto catalog_converter = config_manager.getConfiguration<CatalogConfig>().getTableToCatalogConverter();
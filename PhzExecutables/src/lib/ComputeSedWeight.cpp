@@ -25,7 +25,12 @@
 #include "ElementsKernel/Logging.h"
 #include "KdTree/KdTree.h"
 #include <boost/filesystem.hpp>
+#include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <cstdint>
+#include <future>
+#include <limits>
 #include <random>
 #include <set>
 #include <vector>
@@ -41,6 +46,7 @@
 #include "PhzDataModel/DoubleGrid.h"
 #include "PhzDataModel/serialization/PhotometryGridInfo.h"
 #include "PhzModeling/ApplyFilterFunctor.h"
+#include "PhzModeling/BuildFilterInfoFunctor.h"
 
 #include "PhzExecutables/ComputeSedWeight.h"
 #include "PhzUtils/Multithreading.h"
@@ -56,6 +62,9 @@ namespace {
 
 Elements::Logging logger = Elements::Logging::getLogger("PhosphorosComputeSedWeight");
 
+// The number of draws sharing the same random stream
+constexpr long SAMPLING_BLOCK_SIZE = 1000;
+
 class DefaultProgressReporter {
 
 public:
@@ -77,14 +86,11 @@ private:
 
 }  // Anonymous namespace
 
-ComputeSedWeight::ComputeSedWeight(long sampling_number) : m_progress_listener(DefaultProgressReporter{}) {
-  m_sampling_number = sampling_number;
-}
+ComputeSedWeight::ComputeSedWeight(long sampling_number, long seed)
+    : m_sampling_number(sampling_number), m_seed(seed), m_progress_listener(DefaultProgressReporter{}) {}
 
-ComputeSedWeight::ComputeSedWeight(ProgressListener progress_listener, long sampling_number)
-    : m_progress_listener(progress_listener) {
-  m_sampling_number = sampling_number;
-}
+ComputeSedWeight::ComputeSedWeight(ProgressListener progress_listener, long sampling_number, long seed)
+    : m_sampling_number(sampling_number), m_seed(seed), m_progress_listener(progress_listener) {}
 
 std::vector<std::pair<XYDataset::QualifiedName, double>>
 ComputeSedWeight::orderFilters(const std::vector<XYDataset::QualifiedName>&        filter_list,
@@ -131,57 +137,77 @@ ComputeSedWeight::orderFilters(const std::vector<XYDataset::QualifiedName>&
   return ordered_filters;
 }
 
+std::vector<PhzDataModel::FilterInfo>
+ComputeSedWeight::buildFilterTable(const std::vector<std::pair<XYDataset::QualifiedName, double>>& ordered_filters,
+                                   const std::shared_ptr<XYDataset::XYDatasetProvider> filter_provider) const {
+  PhzModeling::BuildFilterInfoFunctor   build_filter_info{};
+  std::vector<PhzDataModel::FilterInfo> filter_table{};
+  filter_table.reserve(ordered_filters.size());
+  for (auto& filter_pair : ordered_filters) {
+    auto   filter_info = build_filter_info(*filter_provider->getDataset(filter_pair.first));
+    auto&  range       = filter_info.getRange();
+    double norm        = MathUtils::integrate(filter_info.getFilter(), range.first, range.second);
+    filter_table.emplace_back(range, filter_info.getFilter(), norm);
+  }
+  return filter_table;
+}
+
 std::vector<std::vector<double>>
 ComputeSedWeight::computeSedColors(const std::vector<std::pair<XYDataset::QualifiedName, double>>& ordered_filters,
                                    const std::set<XYDataset::QualifiedName>&                       sed_list,
                                    const std::shared_ptr<XYDataset::XYDatasetProvider>             sed_provider,
                                    const std::shared_ptr<XYDataset::XYDatasetProvider> filter_provider) const {
-  PhzModeling::ApplyFilterFunctor  functor{};
-  std::vector<std::vector<double>> fluxes{};
-
-  size_t progress = 0;
-  fluxes.reserve(sed_list.size());
-  for (auto sed_iter = sed_list.begin(); sed_iter != sed_list.end(); ++sed_iter) {
-    std::vector<double> sed_fluxes{};
-    sed_fluxes.reserve(ordered_filters.size());
-    for (size_t filter_index = 0; filter_index < ordered_filters.size(); ++filter_index) {
-      auto                filterXY = filter_provider->getDataset(ordered_filters[filter_index].first);
-      std::vector<double> x{};
-      std::vector<double> y{};
-
-      x.reserve(filterXY->size());
-      y.reserve(filterXY->size());
-
-      for (const auto& datapoint : *filterXY) {
-        x.emplace_back(datapoint.first);
-        y.emplace_back(datapoint.second);
-      }
-      auto   filter = MathUtils::interpolate(*filterXY, MathUtils::InterpolationType::LINEAR);
-      double norm   = MathUtils::integrate(*(filter.get()), x[0], x[x.size() - 1]);
+  auto filter_table = buildFilterTable(ordered_filters, filter_provider);
 
-      auto sedXY    = sed_provider->getDataset(*sed_iter);
-      auto filtered = functor(*(sedXY.get()), std::make_pair(x[0], x[x.size() - 1]), *(filter.get()));
+  // Each SED is read once, in the calling thread
+  std::vector<std::unique_ptr<XYDataset::XYDataset>> sed_datasets{};
+  sed_datasets.reserve(sed_list.size());
+  for (auto& sed : sed_list) {
+    sed_datasets.emplace_back(sed_provider->getDataset(sed));
+  }
 
-      std::vector<double> x_fil{};
-      std::vector<double> y_fil{};
+  std::vector<std::vector<double>> fluxes(sed_list.size());
+  std::atomic<size_t>              next_sed{0};
+  auto                             compute_fluxes = [&]() {
+    PhzModeling::ApplyFilterFunctor functor{};
+    for (size_t sed_index = next_sed++; sed_index < sed_datasets.size(); sed_index = next_sed++) {
+      if (PhzUtils::getStopThreadsFlag()) {
+        return;
+      }
+      std::vector<double> sed_fluxes{};
+      sed_fluxes.reserve(filter_table.size());
+      for (auto& filter_info : filter_table) {
+        auto filtered = functor(*sed_datasets[sed_index], filter_info.getRange(), filter_info.getFilter());
 
-      x_fil.reserve(filtered.size());
-      y_fil.reserve(filtered.size());
+        std::vector<double> x_fil{};
+        std::vector<double> y_fil{};
 
-      for (const auto& datapoint : filtered) {
-        x_fil.emplace_back(datapoint.first);
-        y_fil.emplace_back(datapoint.second);
-      }
-      auto   filtered_func = MathUtils::interpolate(x_fil, y_fil, MathUtils::InterpolationType::LINEAR);
-      double num           = MathUtils::integrate(*(filtered_func.get()), x_fil[0], x_fil[x_fil.size() - 1]);
-      sed_fluxes.emplace_back(num / norm);
+        x_fil.reserve(filtered.size());
+        y_fil.reserve(filtered.size());
 
-      if (PhzUtils::getStopThreadsFlag()) {
-        throw Elements::Exception() << "Stopped by the user";
+        for (const auto& datapoint : filtered) {
+          x_fil.emplace_back(datapoint.first);
+          y_fil.emplace_back(datapoint.second);
+        }
+        auto   filtered_func = MathUtils::interpolate(x_fil, y_fil, MathUtils::InterpolationType::LINEAR);
+        double num           = MathUtils::integrate(*(filtered_func.get()), x_fil[0], x_fil[x_fil.size() - 1]);
+        sed_fluxes.emplace_back(num / filter_info.getNormalization());
       }
+      fluxes[sed_index] = std::move(sed_fluxes);
     }
-    fluxes.emplace_back(std::move(sed_fluxes));
-    ++progress;
+  };
+
+  size_t threads = std::max<size_t>(1, std::min<size_t>(PhzUtils::getThreadNumber(), sed_datasets.size()));
+  std::vector<std::future<void>> futures;
+  for (size_t thread_index = 0; thread_index < threads; ++thread_index) {
+    futures.push_back(std::async(std::launch::async, compute_fluxes));
+  }
+  for (auto& f : futures) {
+    f.get();
+  }
+
+  if (PhzUtils::getStopThreadsFlag()) {
+    throw Elements::Exception() << "Stopped by the user";
   }
 
   std::vector<std::vector<double>> colors{};
@@ -211,23 +237,35 @@ double ComputeSedWeight::distance(const std::vector<double>& colors_1, const std
 
 std::vector<std::vector<double>>
 ComputeSedWeight::computeSedDistance(const std::vector<std::vector<double>>& seds_colors) const {
-  std::vector<std::vector<double>> results{};
-  results.reserve(seds_colors.size());
-  for (size_t index_i = 0; index_i < seds_colors.size(); ++index_i) {
-    std::vector<double> row{};
-    row.reserve(seds_colors.size());
-    for (size_t index_j = 0; index_j < seds_colors.size(); ++index_j) {
-
-      double max = 0.0;
-      if (index_j == index_i) {
-        max = 0.0;
-      } else {
-        max = distance(seds_colors[index_i], seds_colors[index_j]);
+  size_t                           sed_number = seds_colors.size();
+  std::vector<std::vector<double>> results(sed_number);
+
+  // The rows are interleaved between the threads, so they get a similar amount of work
+  auto compute_rows = [this, &seds_colors, &results, sed_number](size_t first_row, size_t row_step) {
+    for (size_t index_i = first_row; index_i < sed_number; index_i += row_step) {
+      std::vector<double> row{};
+      row.reserve(sed_number);
+      for (size_t index_j = 0; index_j < sed_number; ++index_j) {
+        row.emplace_back(index_j == index_i ? 0.0 : distance(seds_colors[index_i], seds_colors[index_j]));
+      }
+      results[index_i] = std::move(row);
+      if (PhzUtils::getStopThreadsFlag()) {
+        return;
       }
-
-      row.emplace_back(max);
     }
-    results.emplace_back(std::move(row));
+  };
+
+  size_t threads = std::max<size_t>(1, std::min<size_t>(PhzUtils::getThreadNumber(), sed_number));
+  std::vector<std::future<void>> futures;
+  for (size_t thread_index = 0; thread_index < threads; ++thread_index) {
+    futures.push_back(std::async(std::launch::async, compute_rows, thread_index, threads));
+  }
+  for (auto& f : futures) {
+    f.get();
+  }
+
+  if (PhzUtils::getStopThreadsFlag()) {
+    throw Elements::Exception() << "Stopped by the user";
   }
 
   return results;
@@ -249,52 +287,45 @@ double ComputeSedWeight::groupDistance(const std::vector<size_t>& sed_group_1, c
 }
 
 double ComputeSedWeight::maxGap(const std::vector<std::vector<double>>& sed_distances) const {
-  // Create the groups
-  std::vector<std::vector<size_t>> sed_groups{};
-  sed_groups.reserve(sed_distances.size());
-  for (size_t index_sed = 0; index_sed < sed_distances.size(); ++index_sed) {
-    std::vector<size_t> group{index_sed};
-    sed_groups.emplace_back(std::move(group));
+  // Merging the two closest groups until only two are left (single linkage)
+  // ends with the two groups separated by the longest edge of the minimum
+  // spanning tree of the SEDs. We build the tree with the Prim algorithm,
+  // which only needs to update the distance of every SED to the tree once
+  // per added SED.
+  size_t sed_number = sed_distances.size();
+  if (sed_number < 2) {
+    return 0.;
   }
 
-  // Merge the groups
-  while (sed_groups.size() > 2) {
-    logger.info() << "Start merge process with " << sed_groups.size() << " Groups.";
-    double dist_min = std::numeric_limits<double>::infinity();
-    size_t index_1  = -1;
-    size_t index_2  = -1;
-    for (size_t group_index_1 = 0; group_index_1 < sed_groups.size() - 1; ++group_index_1) {
-      for (size_t group_index_2 = group_index_1 + 1; group_index_2 < sed_groups.size(); ++group_index_2) {
-        double dist = groupDistance(sed_groups[group_index_1], sed_groups[group_index_2], sed_distances);
-        if (dist < dist_min) {
-          dist_min = dist;
-          index_1  = group_index_1;
-          index_2  = group_index_2;
-        }
+  std::vector<bool>   in_tree(sed_number, false);
+  std::vector<double> tree_distance(sed_number, std::numeric_limits<double>::infinity());
+  double              max_edge  = 0.;
+  size_t              new_index = 0;
+  in_tree[new_index]            = true;
+  for (size_t tree_size = 1; tree_size < sed_number; ++tree_size) {
+    double dist_min  = std::numeric_limits<double>::infinity();
+    size_t index_min = sed_number;
+    for (size_t sed_index = 0; sed_index < sed_number; ++sed_index) {
+      if (in_tree[sed_index]) {
+        continue;
+      }
+      tree_distance[sed_index] = std::min(tree_distance[sed_index], sed_distances[new_index][sed_index]);
+      if (index_min == sed_number || tree_distance[sed_index] < dist_min) {
+        dist_min  = tree_distance[sed_index];
+        index_min = sed_index;
       }
     }
-
-    logger.info() << "Merging Group " << index_2 << " with Group " << index_1 << " Distance:" << dist_min;
-    sed_groups[index_1].reserve(sed_groups[index_1].size() + sed_groups[index_2].size());
-    for (size_t sed_index = 0; sed_index < sed_groups[index_2].size(); ++sed_index) {
-      sed_groups[index_1].emplace_back(sed_groups[index_2][sed_index]);
-    }
-    auto   iter          = sed_groups.begin();
-    size_t current_index = 0;
-    while (current_index != index_2) {
-      ++current_index;
-      ++iter;
-    }
-
-    sed_groups.erase(iter);
+    new_index          = index_min;
+    in_tree[new_index] = true;
+    max_edge           = std::max(max_edge, dist_min);
 
     if (PhzUtils::getStopThreadsFlag()) {
       throw Elements::Exception() << "Stopped by the user";
     }
   }
 
-  // Only 2 groups left: return the distance in between
-  return groupDistance(sed_groups[0], sed_groups[1], sed_distances);
+  logger.info() << "Built the minimum spanning tree of " << sed_number << " SEDs";
+  return max_edge;
 }
 
 std::vector<double> ComputeSedWeight::getWeights(const std::vector<std::vector<double>>& seds_colors,
@@ -302,64 +333,135 @@ std::vector<double> ComputeSedWeight::getWeights(const std::vector<std::vector<d
 
   std::vector<double> weight(seds_colors.size(), 1.);
 
-  if (m_sampling_number>0) {
-	  size_t sed_number   = seds_colors.size();
-	  size_t color_number = seds_colors[0].size();
-
-	  // Prepare a KDTree with the sed colors so we can do faster lookups
-	  KdTree::KdTree<std::vector<double>, KdTree::ChebyshevDistance<std::vector<double>>> seds_kdtree(seds_colors, 10);
-
-	  // Random sample
-	  std::random_device rd;
-	  std::mt19937       mt(rd());
-	  double             total_weight      = 0;
-	  long               total             = m_sampling_number * sed_number;
-	  int                current_percentil = 0;
-	  for (size_t sed_index = 0; sed_index < sed_number; ++sed_index) {
-		double total_match = 0;
-		for (long draw_index = 0; draw_index < m_sampling_number; ++draw_index) {
-		  std::vector<double> sample_color{};
-		  sample_color.reserve(color_number);
-		  for (size_t color_index = 0; color_index < color_number; ++color_index) {
-			std::uniform_real_distribution<double> dist(seds_colors[sed_index][color_index] - radius,
-														seds_colors[sed_index][color_index] + radius);
-			double                                 draw = dist(mt);
-			sample_color.emplace_back(draw);
-		  }
-
-		  size_t match_number = seds_kdtree.countPointsWithinRadius(sample_color, radius);
-		  total_match += 1.0 / match_number;
-
-		  int percentil = static_cast<int>((100 * (m_sampling_number * sed_index + draw_index + 1)) / total);
-		  if (percentil != current_percentil) {
-			current_percentil = percentil;
-		  }
-		}
-		weight[sed_index] = total_match / (m_sampling_number);
-		total_weight += weight[sed_index];
-		if (PhzUtils::getStopThreadsFlag()) {
-		  throw Elements::Exception() << "Stopped by the user";
-		}
-	  }
-
-	  // Normalization
-	  for (size_t sed_index = 0; sed_index < seds_colors.size(); ++sed_index) {
-		weight[sed_index] /= total_weight;
-	  }
+  if (m_sampling_number > 0) {
+    size_t sed_number   = seds_colors.size();
+    size_t color_number = seds_colors[0].size();
+
+    // Prepare a KDTree with the sed colors so we can do faster lookups
+    KdTree::KdTree<std::vector<double>, KdTree::ChebyshevDistance<std::vector<double>>> seds_kdtree(seds_colors, 10);
+
+    std::uint64_t seed = m_seed;
+    if (m_seed < 0) {
+      std::random_device rd;
+      seed = rd();
+      logger.info() << "Using the random seed " << seed << " for the SED weight sampling";
+    }
+
+    // Every block of draws has its own random stream, so the draws do not depend on
+    // which thread processes the block
+    size_t block_number = (m_sampling_number + SAMPLING_BLOCK_SIZE - 1) / SAMPLING_BLOCK_SIZE;
+    size_t task_number  = sed_number * block_number;
+    std::vector<double> block_matches(task_number, 0.);
+
+    auto compute_block = [&](size_t task_index) {
+      size_t        sed_index   = task_index / block_number;
+      size_t        block_index = task_index % block_number;
+      std::seed_seq seed_sequence{static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32),
+                                  static_cast<std::uint32_t>(sed_index), static_cast<std::uint32_t>(block_index)};
+      std::mt19937  mt(seed_sequence);
+
+      std::vector<std::uniform_real_distribution<double>> distributions{};
+      distributions.reserve(color_number);
+      for (size_t color_index = 0; color_index < color_number; ++color_index) {
+        distributions.emplace_back(seds_colors[sed_index][color_index] - radius,
+                                   seds_colors[sed_index][color_index] + radius);
+      }
+
+      long   first_draw  = block_index * SAMPLING_BLOCK_SIZE;
+      long   end_draw    = std::min<long>(first_draw + SAMPLING_BLOCK_SIZE, m_sampling_number);
+      double total_match = 0;
+      std::vector<double> sample_color(color_number);
+      for (long draw_index = first_draw; draw_index < end_draw; ++draw_index) {
+        for (size_t color_index = 0; color_index < color_number; ++color_index) {
+          sample_color[color_index] = distributions[color_index](mt);
+        }
+        size_t match_number = seds_kdtree.countPointsWithinRadius(sample_color, radius);
+        total_match += 1.0 / match_number;
+      }
+      block_matches[task_index] = total_match;
+    };
+
+    std::atomic<size_t> next_task{0};
+    auto                worker = [&]() {
+      for (size_t task_index = next_task++; task_index < task_number; task_index = next_task++) {
+        if (PhzUtils::getStopThreadsFlag()) {
+          return;
+        }
+        compute_block(task_index);
+      }
+    };
+
+    size_t threads = std::max<size_t>(1, std::min<size_t>(PhzUtils::getThreadNumber(), task_number));
+    std::vector<std::future<void>> futures;
+    for (size_t thread_index = 0; thread_index < threads; ++thread_index) {
+      futures.push_back(std::async(std::launch::async, worker));
+    }
+    for (auto& f : futures) {
+      f.get();
+    }
+
+    if (PhzUtils::getStopThreadsFlag()) {
+      throw Elements::Exception() << "Stopped by the user";
+    }
+
+    // Merge the blocks in order
+    double total_weight = 0;
+    for (size_t sed_index = 0; sed_index < sed_number; ++sed_index) {
+      double total_match = 0;
+      for (size_t block_index = 0; block_index < block_number; ++block_index) {
+        total_match += block_matches[sed_index * block_number + block_index];
+      }
+      weight[sed_index] = total_match / m_sampling_number;
+      total_weight += weight[sed_index];
+    }
+
+    // Normalization
+    for (size_t sed_index = 0; sed_index < seds_colors.size(); ++sed_index) {
+      weight[sed_index] /= total_weight;
+    }
   }
 
   return weight;
 }
 
-std::string ComputeSedWeight::getCellKey(double z_value, double ebv_value,
-                                         const XYDataset::QualifiedName& curve_value) const {
-  return std::to_string(z_value) + "_" + std::to_string(ebv_value) + "_" + curve_value.qualifiedName();
+ComputeSedWeight::CellAxes ComputeSedWeight::getCellAxes(const PhzDataModel::PhotometryGridInfo& grid_info) const {
+  std::set<double>                   z_values{};
+  std::set<double>                   ebv_values{};
+  std::set<XYDataset::QualifiedName> curve_values{};
+  for (auto& region_pair : grid_info.region_axes_map) {
+    auto& z_axis     = std::get<0>(region_pair.second);
+    auto& E_axis     = std::get<1>(region_pair.second);
+    auto& curve_axis = std::get<2>(region_pair.second);
+    z_values.insert(z_axis.begin(), z_axis.end());
+    ebv_values.insert(E_axis.begin(), E_axis.end());
+    curve_values.insert(curve_axis.begin(), curve_axis.end());
+  }
+  return CellAxes{{z_values.begin(), z_values.end()},
+                  {ebv_values.begin(), ebv_values.end()},
+                  {curve_values.begin(), curve_values.end()}};
+}
+
+std::size_t ComputeSedWeight::getCellIndex(const CellAxes& cell_axes, double z_value, double ebv_value,
+                                           const XYDataset::QualifiedName& curve_value) const {
+  auto z_iter     = std::lower_bound(cell_axes.z.begin(), cell_axes.z.end(), z_value);
+  auto ebv_iter   = std::lower_bound(cell_axes.ebv.begin(), cell_axes.ebv.end(), ebv_value);
+  auto curve_iter = std::lower_bound(cell_axes.reddening_curve.begin(), cell_axes.reddening_curve.end(), curve_value);
+  if (z_iter == cell_axes.z.end() || *z_iter != z_value || ebv_iter == cell_axes.ebv.end() || *ebv_iter != ebv_value ||
+      curve_iter == cell_axes.reddening_curve.end() || *curve_iter != curve_value) {
+    throw Elements::Exception() << "The cell (" << z_value << ", " << ebv_value << ", " << curve_value
+                                << ") is not part of the cell axes";
+  }
+  size_t z_index     = z_iter - cell_axes.z.begin();
+  size_t ebv_index   = ebv_iter - cell_axes.ebv.begin();
+  size_t curve_index = curve_iter - cell_axes.reddening_curve.begin();
+  return (z_index * cell_axes.ebv.size() + ebv_index) * cell_axes.reddening_curve.size() + curve_index;
 }
 
-std::pair<std::map<std::string, std::set<XYDataset::QualifiedName>>, long>
-ComputeSedWeight::getSedCollection(const PhzDataModel::PhotometryGridInfo& grid_info) const {
+std::pair<std::map<std::size_t, std::set<XYDataset::QualifiedName>>, long>
+ComputeSedWeight::getSedCollection(const PhzDataModel::PhotometryGridInfo& grid_info,
+                                   const CellAxes&                         cell_axes) const {
   // Get all the SED sets
-  std::map<std::string, std::set<XYDataset::QualifiedName>> cells_sed_collection{};
+  std::map<std::size_t, std::set<XYDataset::QualifiedName>> cells_sed_collection{};
 
   // iter over the regions
   double total      = 0;
@@ -374,18 +476,8 @@ ComputeSedWeight::getSedCollection(const PhzDataModel::PhotometryGridInfo& grid_
     for (auto& z_value : z_axis) {
       for (auto& e_value : E_axis) {
         for (auto& curve_value : curve_axis) {
-
-          std::string key = getCellKey(z_value, e_value, curve_value);
-
-          // Add the key in the map if needed
-          if (cells_sed_collection.find(key) == cells_sed_collection.end()) {
-            cells_sed_collection.insert(std::make_pair(key, std::set<XYDataset::QualifiedName>{}));
-          }
-
-          for (auto& sed_value : sed_axis) {
-            cells_sed_collection[key].insert(sed_value);
-          }
-
+          auto& cell_seds = cells_sed_collection[getCellIndex(cell_axes, z_value, e_value, curve_value)];
+          cell_seds.insert(sed_axis.begin(), sed_axis.end());
           ++total;
         }
 
@@ -397,7 +489,6 @@ ComputeSedWeight::getSedCollection(const PhzDataModel::PhotometryGridInfo& grid_
     ++grid_index;
     m_progress_listener(static_cast<int>((50.0 * grid_index) / grid_info.region_axes_map.size()), 150);
   }
-
   return std::make_pair(std::move(cells_sed_collection), total);
 }
 
@@ -405,10 +496,11 @@ void ComputeSedWeight::run(ConfigManager& config_manager) {
 
   auto& grid_info = config_manager.getConfiguration<PhotometryGridConfig>().getPhotometryGridInfo();
 
-  auto collection_pair = getSedCollection(grid_info);
+  auto cell_axes       = getCellAxes(grid_info);
+  auto collection_pair = getSedCollection(grid_info, cell_axes);
   // Get all the SED sets
   double                                                    total                = collection_pair.second;
-  std::map<std::string, std::set<XYDataset::QualifiedName>> cells_sed_collection = std::move(collection_pair.first);
+  std::map<std::size_t, std::set<XYDataset::QualifiedName>> cells_sed_collection = std::move(collection_pair.first);
 
   // compute filter center wavelength & order filters by center wavelength
   auto filter_list     = config_manager.getConfiguration<FilterConfig>().getFilterList();
@@ -433,12 +525,9 @@ void ComputeSedWeight::run(ConfigManager& config_manager) {
     for (size_t z_index = 0; z_index < z_axis.size(); ++z_index) {
       for (size_t e_index = 0; e_index < E_axis.size(); ++e_index) {
         for (size_t curve_index = 0; curve_index < curve_axis.size(); ++curve_index) {
-          double                   z_value     = z_axis[z_index];
-          double                   e_value     = E_axis[e_index];
-          XYDataset::QualifiedName curve_value = curve_axis[curve_index];
-          std::string              key         = getCellKey(z_value, e_value, curve_value);
+          size_t cell_index = getCellIndex(cell_axes, z_axis[z_index], E_axis[e_index], curve_axis[curve_index]);
 
-          const auto& sed_qualified = cells_sed_collection[key];
+          const auto& sed_qualified = cells_sed_collection[cell_index];
           if (seds_weights_collection.find(sed_qualified) == seds_weights_collection.end()) {
             // compute weights
 
@@ -0,0 +1,158 @@
+/*
+ * Copyright (C) 2022 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file src/lib/NearestNeighborIndex.cpp
+ * @date 2026/10/18
+ */
+
+#include "PhzExecutables/NearestNeighborIndex.h"
+#include "ElementsKernel/Exception.h"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace Euclid {
+namespace PhzExecutables {
+
+NearestNeighborIndex::NearestNeighborIndex(std::size_t dimensions, std::vector<double> coordinates,
+                                           std::size_t leaf_size)
+    : m_dimensions(dimensions)
+    , m_coordinates(std::move(coordinates))
+    , m_leaf_size(std::max<std::size_t>(1, leaf_size)) {
+  if (m_dimensions == 0) {
+    throw Elements::Exception() << "The points of a nearest neighbour index must have at least one dimension";
+  }
+  if (m_coordinates.size() % m_dimensions != 0) {
+    throw Elements::Exception() << "The " << m_coordinates.size() << " coordinates are not a multiple of the "
+                                << m_dimensions << " dimensions";
+  }
+  m_order.resize(m_coordinates.size() / m_dimensions);
+  std::iota(m_order.begin(), m_order.end(), 0);
+  if (!m_order.empty()) {
+    build(0, m_order.size());
+  }
+}
+
+std::size_t NearestNeighborIndex::build(std::size_t begin, std::size_t end) {
+  std::size_t node_index = m_nodes.size();
+  m_nodes.emplace_back(Node{begin, end, 0, 0., 0, 0});
+  if (end - begin <= m_leaf_size) {
+    return node_index;
+  }
+
+  // Split on the dimension with the widest spread of the node points
+  std::size_t dimension = 0;
+  double      max_width = -1.;
+  for (std::size_t d = 0; d < m_dimensions; ++d) {
+    auto minmax = std::minmax_element(
+        m_order.begin() + begin, m_order.begin() + end, [this, d](std::size_t a, std::size_t b) {
+          return m_coordinates[a * m_dimensions + d] < m_coordinates[b * m_dimensions + d];
+        });
+    double width = m_coordinates[*minmax.second * m_dimensions + d] - m_coordinates[*minmax.first * m_dimensions + d];
+    if (width > max_width) {
+      max_width = width;
+      dimension = d;
+    }
+  }
+
+  // The points before the median are not after it on the split dimension, the ones from it not before
+  std::size_t middle = begin + (end - begin) / 2;
+  std::nth_element(m_order.begin() + begin, m_order.begin() + middle, m_order.begin() + end,
+                   [this, dimension](std::size_t a, std::size_t b) {
+                     return m_coordinates[a * m_dimensions + dimension] < m_coordinates[b * m_dimensions + dimension];
+                   });
+
+  // The split is read before the children reorder their points. They are appended after this
+  // node, so it is accessed by index once they are built.
+  double      split = m_coordinates[m_order[middle] * m_dimensions + dimension];
+  std::size_t left  = build(begin, middle);
+  std::size_t right = build(middle, end);
+  auto&       node  = m_nodes[node_index];
+  node.dimension    = dimension;
+  node.split        = split;
+  node.left         = left;
+  node.right        = right;
+  return node_index;
+}
+
+std::size_t NearestNeighborIndex::size() const {
+  return m_order.size();
+}
+
+double NearestNeighborIndex::squaredDistance(const std::vector<double>& point, std::size_t index) const {
+  const double* coords = m_coordinates.data() + index * m_dimensions;
+  double        sum    = 0.;
+  for (std::size_t d = 0; d < m_dimensions; ++d) {
+    sum += (point[d] - coords[d]) * (point[d] - coords[d]);
+  }
+  return sum;
+}
+
+void NearestNeighborIndex::search(std::size_t node_index, const std::vector<double>& point, std::size_t k,
+                                  std::vector<std::pair<double, std::size_t>>& heap) const {
+  auto& node = m_nodes[node_index];
+
+  // The leaves are the only nodes without children, as the root is never a child
+  if (node.left == 0) {
+    for (std::size_t i = node.begin; i < node.end; ++i) {
+      double squared = squaredDistance(point, m_order[i]);
+      if (heap.size() < k) {
+        heap.emplace_back(squared, m_order[i]);
+        std::push_heap(heap.begin(), heap.end());
+      } else if (squared < heap.front().first) {
+        std::pop_heap(heap.begin(), heap.end());
+        heap.back() = std::make_pair(squared, m_order[i]);
+        std::push_heap(heap.begin(), heap.end());
+      }
+    }
+    return;
+  }
+
+  // Search first the side of the point, then the other side only if it can contain a closer point
+  double diff = point[node.dimension] - node.split;
+  search(diff < 0 ? node.left : node.right, point, k, heap);
+  if (heap.size() < k || diff * diff < heap.front().first) {
+    search(diff < 0 ? node.right : node.left, point, k, heap);
+  }
+}
+
+std::vector<std::pair<double, std::size_t>> NearestNeighborIndex::findNearest(const std::vector<double>& point,
+                                                                              std::size_t k) const {
+  if (point.size() != m_dimensions) {
+    throw Elements::Exception() << "The point has " << point.size() << " coordinates, expected " << m_dimensions;
+  }
+
+  // Max heap of the squared distances, so the furthest of the current neighbours is on top
+  std::vector<std::pair<double, std::size_t>> heap{};
+  k = std::min(k, m_order.size());
+  if (k == 0) {
+    return heap;
+  }
+  heap.reserve(k);
+  search(0, point, k, heap);
+
+  std::sort_heap(heap.begin(), heap.end());
+  for (auto& neighbor : heap) {
+    neighbor.first = std::sqrt(neighbor.first);
+  }
+  return heap;
+}
+
+}  // namespace PhzExecutables
+}  // namespace Euclid
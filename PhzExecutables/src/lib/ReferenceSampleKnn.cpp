@@ -0,0 +1,161 @@
+/*
+ * Copyright (C) 2022 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file src/lib/ReferenceSampleKnn.cpp
+ * @date 2026/10/18
+ */
+
+#include "PhzExecutables/ReferenceSampleKnn.h"
+#include "ElementsKernel/Exception.h"
+#include "ElementsKernel/Logging.h"
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
+
+namespace Euclid {
+namespace PhzExecutables {
+
+namespace {
+
+Elements::Logging logger = Elements::Logging::getLogger("ReferenceSampleKnn");
+
+/// The smallest distance used for the weights, so exact matches do not get an infinite weight
+constexpr double MIN_DISTANCE = 1E-6;
+
+/// Compute the colours from the fluxes, or return false if a flux is not positive
+bool computeColors(const std::vector<double>& fluxes, std::vector<double>& colors) {
+  colors.clear();
+  for (std::size_t i = 0; i < fluxes.size(); ++i) {
+    if (!(fluxes[i] > 0.)) {
+      return false;
+    }
+    if (i > 0) {
+      colors.emplace_back(-2.5 * std::log10(fluxes[i - 1] / fluxes[i]));
+    }
+  }
+  return true;
+}
+
+}  // Anonymous namespace
+
+ReferenceSampleKnn::ReferenceSampleKnn(const ReferenceSample::ReferenceSample& reference_sample,
+                                       std::vector<std::string>                filter_names,
+                                       const std::vector<std::pair<int64_t, std::vector<double>>>& reference_fluxes,
+                                       std::size_t                                                 neighbor_number)
+    : m_filter_names(std::move(filter_names)), m_neighbor_number(std::max<std::size_t>(1, neighbor_number)) {
+  if (m_filter_names.size() < 2) {
+    throw Elements::Exception() << "At least two filters are required for computing colours, got "
+                                << m_filter_names.size();
+  }
+
+  std::unordered_map<int64_t, std::vector<double>> colors_per_id{};
+  std::vector<int64_t>                             ids{};
+  std::vector<double>                              colors{};
+  std::size_t                                      skipped = 0;
+  for (auto& id_fluxes : reference_fluxes) {
+    if (id_fluxes.second.size() != m_filter_names.size()) {
+      throw Elements::Exception() << "The reference object " << id_fluxes.first << " has "
+                                  << id_fluxes.second.size() << " fluxes, expected " << m_filter_names.size();
+    }
+    if (computeColors(id_fluxes.second, colors)) {
+      colors_per_id.emplace(id_fluxes.first, colors);
+      ids.emplace_back(id_fluxes.first);
+    } else {
+      ++skipped;
+    }
+  }
+
+  // The views are resolved once here, so the searches do not touch the (not thread
+  // safe) provider state of the reference sample. They come sorted by file and offset,
+  // and the colours are stored in the same order, so a point index is its PDZ index.
+  std::vector<double> coordinates{};
+  for (auto& id_view : reference_sample.getPdzDataViews(ids)) {
+    if (m_pdzs.empty()) {
+      for (std::size_t i = 0; i < id_view.second.size(); ++i) {
+        m_bins.emplace_back(id_view.second.bin(i));
+      }
+    }
+    // The PDZs are combined bin by bin, so they must all have the bins of the first one
+    if (id_view.second.size() != m_bins.size()) {
+      throw Elements::Exception() << "The PDZ of the reference object " << id_view.first << " has "
+                                  << id_view.second.size() << " bins, expected " << m_bins.size();
+    }
+    auto& point_colors = colors_per_id.at(id_view.first);
+    coordinates.insert(coordinates.end(), point_colors.begin(), point_colors.end());
+    m_pdzs.emplace_back(id_view.second);
+  }
+  skipped += ids.size() - m_pdzs.size();
+
+  if (m_pdzs.empty()) {
+    throw Elements::Exception() << "None of the " << reference_fluxes.size()
+                                << " reference objects has both positive fluxes and a PDZ";
+  }
+  if (skipped > 0) {
+    logger.warn() << "Ignoring " << skipped << " reference objects without PDZ or with non positive fluxes";
+  }
+
+  m_index.reset(new NearestNeighborIndex(m_filter_names.size() - 1, std::move(coordinates)));
+  logger.info() << "Indexed " << m_pdzs.size() << " reference objects in a " << m_filter_names.size() - 1
+                << " colour space";
+}
+
+std::size_t ReferenceSampleKnn::size() const {
+  return m_pdzs.size();
+}
+
+auto ReferenceSampleKnn::computePdz(const SourceCatalog::Photometry& photometry) const -> Pdz {
+  Pdz pdz{std::make_tuple(GridContainer::GridAxis<double>{"Z", m_bins})};
+
+  std::vector<double> fluxes{};
+  bool                usable = true;
+  for (auto& filter_name : m_filter_names) {
+    auto flux_ptr = photometry.find(filter_name);
+    if (flux_ptr == nullptr) {
+      throw Elements::Exception() << "Source does not contain photometry for " << filter_name;
+    }
+    usable = usable && !flux_ptr->missing_photometry_flag && !flux_ptr->upper_limit_flag;
+    fluxes.emplace_back(flux_ptr->flux);
+  }
+
+  std::vector<double> colors{};
+  if (!usable || !computeColors(fluxes, colors)) {
+    double range = m_bins.back() - m_bins.front();
+    std::fill(pdz.begin(), pdz.end(), range > 0. ? 1. / range : 1.);
+    return pdz;
+  }
+
+  auto neighbors = m_index->findNearest(colors, m_neighbor_number);
+
+  // The stored PDZs are normalized, so their weighted mean is normalized as well
+  std::vector<double> values(m_bins.size(), 0.);
+  double              total_weight = 0.;
+  for (auto& neighbor : neighbors) {
+    double weight = 1. / std::max(neighbor.first, MIN_DISTANCE);
+    auto&  view   = m_pdzs[neighbor.second];
+    for (std::size_t i = 0; i < values.size(); ++i) {
+      values[i] += weight * view.value(i);
+    }
+    total_weight += weight;
+  }
+  std::transform(values.begin(), values.end(), pdz.begin(), [total_weight](double v) { return v / total_weight; });
+  return pdz;
+}
+
+}  // namespace PhzExecutables
+}  // namespace Euclid
@@ -26,7 +26,7 @@
 #include "PhzConfiguration/MultithreadConfig.h"
 #include "PhzConfiguration/ReddeningProviderConfig.h"
 #include "PhzDataModel/FilterInfo.h"
-#include "PhzFilterVariation/FilterVariationSingleGridCreator.h"
+#include "PhzFilterVariation/FilterVariationCoefficientCalculator.h"
 #include "PhzGalacticCorrection/GalacticCorrectionCalculator.h"
 #include "PhzModeling/ApplyFilterFunctor.h"
 #include "PhzModeling/BuildFilterInfoFunctor.h"
@@ -36,7 +36,6 @@
 #include "SourceCatalog/SourceAttributes/Photometry.h"
 #include "Table/FitsWriter.h"
 #include <ElementsKernel/ProgramHeaders.h>
-#include <MathUtils/regression/LinearRegression.h>
 #include <future>
 #include "ElementsKernel/Exception.h"
 
@@ -81,15 +80,14 @@ public:
   typedef std::vector<int64_t>::const_iterator id_iterator_t;
 
   BuildPhotometryJob(std::shared_ptr<ColumnInfo> col_info, const std::vector<QualifiedName>& filter_list,
-                     const std::vector<FilterInfo>&              filter_transmissions,
-                     const std::vector<std::vector<FilterInfo>>& filter_shifted,
-                     const std::vector<double>& filter_var_sampling, const XYDataset& reddening_curve,
-                     std::unique_ptr<ReferenceSample> ref_sample, id_iterator_t start, id_iterator_t end)
+                     const std::vector<FilterInfo>&                    filter_transmissions,
+                     std::vector<FilterVariationCoefficientCalculator> variation_calculators,
+                     const XYDataset& reddening_curve, std::unique_ptr<ReferenceSample> ref_sample,
+                     id_iterator_t start, id_iterator_t end)
       : m_col_info(std::move(col_info))
       , m_filter_list(filter_list)
       , m_filters_trans(filter_transmissions)
-      , m_filters_shifted(filter_shifted)
-      , m_filter_var_sampling(filter_var_sampling)
+      , m_variation_calculators(std::move(variation_calculators))
       , m_reddening_curve(reddening_curve)
       , m_ref_sample(std::move(ref_sample))
       , m_start(start)
@@ -103,12 +101,9 @@ public:
     using Euclid::SourceCatalog::FluxErrorPair;
     
     ApplyFilterFunctor                apply_filter_functor;
-    IntegrateDatasetFunctor           integrate_functor(Euclid::MathUtils::InterpolationType::LINEAR);
-    IntegrateLambdaTimeDatasetFunctor integrate_lambda_time_functor(Euclid::MathUtils::InterpolationType::LINEAR);
 
     ModelFluxAlgorithm           model_flux(apply_filter_functor);
-    GalacticCorrectionCalculator gal_ebv_corr_calc(m_filters_trans, apply_filter_functor, integrate_functor,
-                                                   m_reddening_curve);
+    GalacticCorrectionCalculator gal_ebv_corr_calc(m_filters_trans, m_reddening_curve);
     std::vector<Row>           results;
     std::vector<FluxErrorPair> fluxes(m_filter_list.size(), {0., 0.});
     std::vector<double>        gal_ebv_corr(m_filter_list.size());
@@ -128,10 +123,7 @@ public:
         values.emplace_back(static_cast<float>(fluxes[j].flux));
         values.emplace_back(static_cast<float>(gal_ebv_corr[j]));
 
-        auto filter_var_corr = FilterVariationSingleGridCreator::compute_tild_coef(
-            sed, m_filters_trans[j], m_filters_shifted[j], m_filter_var_sampling, apply_filter_functor,
-            integrate_lambda_time_functor);
-        auto coef = Euclid::MathUtils::linearRegression(m_filter_var_sampling, filter_var_corr);
+        auto coef = m_variation_calculators[j](sed);
         values.emplace_back(std::vector<float>{static_cast<float>(coef.first), static_cast<float>(coef.second)});
       }
 
@@ -141,14 +133,13 @@ public:
   }
 
 private:
-  std::shared_ptr<ColumnInfo>                 m_col_info;
-  const std::vector<QualifiedName>&           m_filter_list;
-  const std::vector<FilterInfo>&              m_filters_trans;
-  const std::vector<std::vector<FilterInfo>>& m_filters_shifted;
-  const std::vector<double>&                  m_filter_var_sampling;
-  const XYDataset&                            m_reddening_curve;
-  std::unique_ptr<ReferenceSample>            m_ref_sample;
-  id_iterator_t                               m_start, m_end;
+  std::shared_ptr<ColumnInfo>                               m_col_info;
+  const std::vector<QualifiedName>&                         m_filter_list;
+  const std::vector<FilterInfo>&                            m_filters_trans;
+  mutable std::vector<FilterVariationCoefficientCalculator> m_variation_calculators;
+  const XYDataset&                                          m_reddening_curve;
+  std::unique_ptr<ReferenceSample>                          m_ref_sample;
+  id_iterator_t                                             m_start, m_end;
 };
 
 /**
@@ -179,24 +170,19 @@ static void appendTransmissionHDUs(const std::vector<QualifiedName>& filter_list
 }
 
 /**
- * Compute the shifted variations for the configured filters
- * @return A vector with as many entries as filters, and each item is a vector with as many
- *  shifted versions as samples are on the shift range
+ * Create the filter variation coefficient calculators for the configured filters
+ * @return A vector with as many entries as filters, each one integrating all the
+ *  shifts of the shift range
  */
-std::vector<std::vector<FilterInfo>> computeShiftedFilters(const std::vector<XYDataset>& filter_transmissions,
-                                                           const std::vector<double>&    filter_var_sampling) {
-  std::vector<std::vector<FilterInfo>> shifted_filters;
-  BuildFilterInfoFunctor               filter_info_functor;
+std::vector<FilterVariationCoefficientCalculator>
+createVariationCalculators(const std::vector<XYDataset>& filter_transmissions,
+                           const std::vector<double>&    filter_var_sampling) {
+  std::vector<FilterVariationCoefficientCalculator> calculators;
+  calculators.reserve(filter_transmissions.size());
   for (auto& filter : filter_transmissions) {
-    std::vector<FilterInfo> shifted_filter;
-    shifted_filter.reserve(filter_var_sampling.size());
-    for (auto& dl : filter_var_sampling) {
-      auto shifted = filter_info_functor(FilterVariationSingleGridCreator::shiftFilter(filter, dl));
-      shifted_filter.emplace_back(std::move(shifted));
-    }
-    shifted_filters.emplace_back(std::move(shifted_filter));
+    calculators.emplace_back(filter, filter_var_sampling);
   }
-  return shifted_filters;
+  return calculators;
 }
 
 /**
@@ -248,7 +234,7 @@ public:
                      return std::move(*filter_provider->getDataset(filter));
                    });
 
-    auto                    shifted_filters = computeShiftedFilters(filter_transmissions, filter_var_sampling);
+    auto variation_calculators = createVariationCalculators(filter_transmissions, filter_var_sampling);
     std::vector<FilterInfo> filters_info;
     std::transform(filter_transmissions.begin(), filter_transmissions.end(), std::back_inserter(filters_info),
                    BuildFilterInfoFunctor());
@@ -273,8 +259,8 @@ public:
         
 	  
         futures.push_back(std::async(std::launch::async,
-                                     BuildPhotometryJob(col_info, filter_list, filters_info, shifted_filters,
-                                                        filter_var_sampling, *reddening_curve, reference_sample.clone(),
+                                     BuildPhotometryJob(col_info, filter_list, filters_info, variation_calculators,
+                                                        *reddening_curve, reference_sample.clone(),
                                                         start, start + current_chunk_size)));
         std::advance(start, chunk_size);
       }
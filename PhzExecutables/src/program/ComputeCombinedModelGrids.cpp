@@ -0,0 +1,175 @@
+/**
+ * Copyright (C) 2022 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file ComputeCombinedModelGrids.cpp
+ * @date 2026/10/18
+ */
+
+#include "Configuration/ConfigManager.h"
+#include "Configuration/Utils.h"
+#include "ElementsKernel/ProgramHeaders.h"
+#include "PhzConfiguration/ComputeCombinedModelGridsConfig.h"
+#include "PhzConfiguration/CorrectionCoefficientGridOutputConfig.h"
+#include "PhzConfiguration/CosmologicalParameterConfig.h"
+#include "PhzConfiguration/FilterConfig.h"
+#include "PhzConfiguration/FilterProviderConfig.h"
+#include "PhzConfiguration/FilterVariationCoefficientGridOutputConfig.h"
+#include "PhzConfiguration/FilterVariationConfig.h"
+#include "PhzConfiguration/IgmConfig.h"
+#include "PhzConfiguration/IncrementalGridConfig.h"
+#include "PhzConfiguration/MilkyWayReddeningConfig.h"
+#include "PhzConfiguration/ModelGridOutputConfig.h"
+#include "PhzConfiguration/ModelNormalizationConfig.h"
+#include "PhzConfiguration/ParameterSpaceConfig.h"
+#include "PhzConfiguration/ReddeningProviderConfig.h"
+#include "PhzConfiguration/SedProviderConfig.h"
+#include "PhzExecutables/CombinedGridCreator.h"
+#include "PhzExecutables/ProgressReporter.h"
+#include "PhzModeling/IncrementalGridBuilder.h"
+#include "PhzModeling/NormalizationFunctorFactory.h"
+#include <algorithm>
+#include <map>
+#include <memory>
+
+using std::map;
+using std::string;
+using namespace Euclid;
+using namespace Euclid::Configuration;
+using namespace Euclid::PhzConfiguration;
+namespace po = boost::program_options;
+
+typedef std::function<void(size_t step, size_t total)> ProgressListener;
+typedef std::map<std::string, PhzDataModel::ModelAxesTuple> RegionMap;
+typedef std::map<std::string, PhzDataModel::PhotometryGrid> GridMap;
+
+static Elements::Logging logger = Elements::Logging::getLogger("ComputeCombinedModelGrids");
+
+static long config_manager_id = getUniqueManagerId();
+
+template <typename T>
+static bool sameAxis(const GridContainer::GridAxis<T>& first, const GridContainer::GridAxis<T>& second) {
+  return first.size() == second.size() && std::equal(first.begin(), first.end(), second.begin());
+}
+
+static bool sameRegions(const RegionMap& first, const RegionMap& second) {
+  using PhzDataModel::ModelParameter;
+  if (first.size() != second.size()) {
+    return false;
+  }
+  for (auto first_iter = first.begin(), second_iter = second.begin(); first_iter != first.end();
+       ++first_iter, ++second_iter) {
+    auto& a = first_iter->second;
+    auto& b = second_iter->second;
+    if (first_iter->first != second_iter->first ||
+        !sameAxis(std::get<ModelParameter::Z>(a), std::get<ModelParameter::Z>(b)) ||
+        !sameAxis(std::get<ModelParameter::EBV>(a), std::get<ModelParameter::EBV>(b)) ||
+        !sameAxis(std::get<ModelParameter::REDDENING_CURVE>(a), std::get<ModelParameter::REDDENING_CURVE>(b)) ||
+        !sameAxis(std::get<ModelParameter::SED>(a), std::get<ModelParameter::SED>(b))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+class ComputeCombinedModelGrids : public Elements::Program {
+
+  po::options_description defineSpecificProgramOptions() override {
+    auto& config_manager = ConfigManager::getInstance(config_manager_id);
+    config_manager.registerConfiguration<ComputeCombinedModelGridsConfig>();
+    return config_manager.closeRegistration();
+  }
+
+  Elements::ExitCode mainMethod(map<string, po::variable_value>& args) override {
+
+    auto& config_manager = ConfigManager::getInstance(config_manager_id);
+    config_manager.initialize(args);
+
+    auto  filter_list  = config_manager.getConfiguration<FilterConfig>().getFilterList();
+    auto  regions      = config_manager.getConfiguration<ParameterSpaceConfig>().getParameterSpaceRegions();
+    auto& sed_provider = config_manager.getConfiguration<SedProviderConfig>().getSedDatasetProvider();
+    auto& reddening_provider =
+        config_manager.getConfiguration<ReddeningProviderConfig>().getReddeningDatasetProvider();
+    const auto& filter_provider = config_manager.getConfiguration<FilterProviderConfig>().getFilterDatasetProvider();
+    auto& igm_abs_func = config_manager.getConfiguration<IgmConfig>().getIgmAbsorptionFunction();
+    auto  cosmology    = config_manager.getConfiguration<CosmologicalParameterConfig>().getCosmologicalParam();
+    auto  delta_lambda = config_manager.getConfiguration<FilterVariationConfig>().getSampling();
+    auto  milky_way_reddening_curve =
+        config_manager.getConfiguration<MilkyWayReddeningConfig>().getMilkyWayReddeningCurve();
+
+    auto lum_filter_name = config_manager.getConfiguration<ModelNormalizationConfig>().getNormalizationFilter();
+    auto sun_sed_name    = config_manager.getConfiguration<ModelNormalizationConfig>().getReferenceSolarSed();
+    auto normalizer_functor =
+        PhzModeling::NormalizationFunctorFactory::NormalizationFunctorFactory::GetFunction(
+            filter_provider, lum_filter_name, sed_provider, sun_sed_name);
+
+    PhzExecutables::CombinedGridCreator creator{sed_provider,       reddening_provider, filter_provider,
+                                                igm_abs_func,       normalizer_functor, delta_lambda,
+                                                milky_way_reddening_curve};
+
+    // The three grids of the last computed regions. When the three outputs
+    // miss the same models (or are all computed from scratch) they are
+    // computed only once.
+    std::unique_ptr<RegionMap>                                        computed_regions{};
+    std::map<std::string, PhzExecutables::CombinedGridCreator::Grids> computed_grids{};
+    auto grid_function = [&](PhzDataModel::PhotometryGrid PhzExecutables::CombinedGridCreator::Grids::*component) {
+      return [&, component](const RegionMap& region_map, ProgressListener progress_listener) {
+        if (computed_regions == nullptr || !sameRegions(*computed_regions, region_map)) {
+          computed_grids = creator.createGrid(region_map, filter_list, cosmology, progress_listener);
+          computed_regions.reset(new RegionMap(region_map));
+        }
+        GridMap result{};
+        for (auto& pair : computed_grids) {
+          result.emplace(pair.first, std::move(pair.second.*component));
+        }
+        return result;
+      };
+    };
+
+    auto& incremental_config = config_manager.getConfiguration<IncrementalGridConfig>();
+    auto  build = [&](const std::string& filename, const std::map<std::string, std::string>& provenance,
+                     PhzDataModel::PhotometryGrid PhzExecutables::CombinedGridCreator::Grids::*component) {
+      PhzExecutables::ProgressReporter progress_listener{logger, true};
+      auto existing_grids = incremental_config.readExistingGrids(filename, filter_list, provenance);
+      if (existing_grids.empty()) {
+        return grid_function(component)(regions, progress_listener);
+      }
+      PhzModeling::IncrementalGridBuilder builder{grid_function(component)};
+      return builder.createGrid(regions, std::move(existing_grids), progress_listener);
+    };
+
+    auto& model_output      = config_manager.getConfiguration<ModelGridOutputConfig>();
+    auto& variation_output  = config_manager.getConfiguration<FilterVariationCoefficientGridOutputConfig>();
+    auto& correction_output = config_manager.getConfiguration<CorrectionCoefficientGridOutputConfig>();
+
+    logger.info() << "Creating the model grid";
+    model_output.getOutputFunction()(build(model_output.getOutputFilename(), model_output.getProvenance(),
+                                           &PhzExecutables::CombinedGridCreator::Grids::photometry));
+    logger.info() << "Creating the filter variation coefficient grid";
+    variation_output.getOutputFunction()(build(variation_output.getOutputFilename(), variation_output.getProvenance(),
+                                               &PhzExecutables::CombinedGridCreator::Grids::filter_variation));
+    logger.info() << "Creating the galactic correction coefficient grid";
+    correction_output.getOutputFunction()(build(correction_output.getOutputFilename(),
+                                                correction_output.getProvenance(),
+                                                &PhzExecutables::CombinedGridCreator::Grids::galactic_correction));
+
+    return Elements::ExitCode::OK;
+  }
+};
+
+MAIN_FOR(ComputeCombinedModelGrids)
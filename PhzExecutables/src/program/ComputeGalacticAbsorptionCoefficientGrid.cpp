@@ -30,6 +30,7 @@
 #include "PhzConfiguration/CosmologicalParameterConfig.h"
 #include "PhzConfiguration/FilterProviderConfig.h"
 #include "PhzConfiguration/IgmConfig.h"
+#include "PhzConfiguration/IncrementalGridConfig.h"
 #include "PhzConfiguration/MilkyWayReddeningConfig.h"
 #include "PhzConfiguration/ModelNormalizationConfig.h"
 #include "PhzConfiguration/PhotometryGridConfig.h"
@@ -37,6 +38,7 @@
 #include "PhzConfiguration/SedProviderConfig.h"
 #include "PhzExecutables/ProgressReporter.h"
 #include "PhzGalacticCorrection/GalacticCorrectionFactorSingleGridCreator.h"
+#include "PhzModeling/IncrementalGridBuilder.h"
 #include "PhzModeling/NormalizationFunctorFactory.h"
 #include <chrono>
 #include <map>
@@ -105,26 +107,44 @@ class ComputeGalacticAbsorptionCoefficientGrid : public Elements::Program {
         Euclid::PhzModeling::NormalizationFunctorFactory::NormalizationFunctorFactory::GetFunction(
             filter_provider, lum_filter_name, sed_provider, sun_sed_name);
 
-    std::map<std::string, PhzDataModel::PhotometryGrid> result_map{};
-
-    // Compute the total number of models
-    size_t total = 0;
-    for (auto& pair : model_phot_grid.region_axes_map) {
-      total += GridContainer::makeGridIndexHelper(pair.second).m_axes_index_factors.back();
-    }
-
     PhzGalacticCorrection::GalacticCorrectionSingleGridCreator grid_creator{
         sed_provider, reddening_provider, filter_provider, igm_abs_func, normalizer_functor, miky_way_reddening_curve};
-    Euclid::PhzExecutables::ProgressReporter progress_listener{logger, false};
-    size_t                                   already_done = 0;
-    for (auto& grid_pair : model_phot_grid.region_axes_map) {
-      logger.info() << "Correction computation for region '" << grid_pair.first << "'";
-      SparseProgressReporter reporter{progress_listener, already_done, total};
-      result_map.emplace(
-          std::make_pair(grid_pair.first,
-                         grid_creator.createGrid(grid_pair.second, model_phot_grid.filter_names, cosmology, reporter)));
+    auto compute_regions = [&grid_creator, &model_phot_grid, &cosmology](
+                               const std::map<std::string, PhzDataModel::ModelAxesTuple>& region_axes_map,
+                               ProgressListener progress_listener) {
+      std::map<std::string, PhzDataModel::PhotometryGrid> result_map{};
+
+      // Compute the total number of models
+      size_t total = 0;
+      for (auto& pair : region_axes_map) {
+        total += GridContainer::makeGridIndexHelper(pair.second).m_axes_index_factors.back();
+      }
+
+      size_t already_done = 0;
+      for (auto& grid_pair : region_axes_map) {
+        logger.info() << "Correction computation for region '" << grid_pair.first << "'";
+        SparseProgressReporter reporter{progress_listener, already_done, total};
+        result_map.emplace(std::make_pair(
+            grid_pair.first,
+            grid_creator.createGrid(grid_pair.second, model_phot_grid.filter_names, cosmology, reporter)));
+        already_done += result_map.at(grid_pair.first).size();
+      }
+      progress_listener(already_done, total);
+      return result_map;
+    };
+
+    // When building incrementally only the models missing from the existing grid are computed
+    auto& output_config  = config_manager.getConfiguration<CorrectionCoefficientGridOutputConfig>();
+    auto  existing_grids = config_manager.getConfiguration<IncrementalGridConfig>().readExistingGrids(
+        output_config.getOutputFilename(), model_phot_grid.filter_names, output_config.getProvenance());
+    Euclid::PhzExecutables::ProgressReporter            progress_listener{logger, false};
+    std::map<std::string, PhzDataModel::PhotometryGrid> result_map{};
+    if (existing_grids.empty()) {
+      result_map = compute_regions(model_phot_grid.region_axes_map, progress_listener);
+    } else {
+      PhzModeling::IncrementalGridBuilder builder{compute_regions};
+      result_map = builder.createGrid(model_phot_grid.region_axes_map, std::move(existing_grids), progress_listener);
     }
-    progress_listener(already_done, total);
 
     output_function(result_map);
 
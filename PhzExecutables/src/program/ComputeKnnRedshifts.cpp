@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2022 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file ComputeKnnRedshifts.cpp
+ * @date 2026/10/18
+ */
+
+#include "Configuration/CatalogConfig.h"
+#include "Configuration/ConfigManager.h"
+#include "Configuration/Utils.h"
+#include "ElementsKernel/ProgramHeaders.h"
+#include "PhzConfiguration/ReferenceSampleKnnConfig.h"
+#include "PhzExecutables/ReferenceSampleKnn.h"
+#include "PhzUtils/ProgressReporter.h"
+
+using namespace Euclid;
+using namespace Euclid::Configuration;
+using namespace Euclid::PhzConfiguration;
+namespace po = boost::program_options;
+
+static Elements::Logging logger = Elements::Logging::getLogger("PhosphorosComputeKnnRedshifts");
+
+static long config_manager_id = getUniqueManagerId();
+
+/**
+ * PhosphorosComputeKnnRedshifts: quick-look redshift PDZs from the nearest
+ * neighbours of the sources in a reference sample
+ */
+class ComputeKnnRedshifts : public Elements::Program {
+
+  po::options_description defineSpecificProgramOptions() override {
+    auto& config_manager = ConfigManager::getInstance(config_manager_id);
+    config_manager.registerConfiguration<ReferenceSampleKnnConfig>();
+    return config_manager.closeRegistration();
+  }
+
+  Elements::ExitCode mainMethod(std::map<std::string, po::variable_value>& args) override {
+
+    auto& config_manager = ConfigManager::getInstance(config_manager_id);
+    config_manager.initialize(args);
+
+    auto& knn_config = config_manager.getConfiguration<ReferenceSampleKnnConfig>();
+    PhzExecutables::ReferenceSampleKnn knn{knn_config.getReferenceSample(), knn_config.getFilterNames(),
+                                           knn_config.getReferenceFluxes(), knn_config.getNeighborNumber()};
+
+    auto table_reader      = config_manager.getConfiguration<CatalogConfig>().getTableReader();
+    auto catalog_converter = config_manager.getConfiguration<CatalogConfig>().getTableToCatalogConverter();
+    auto out_ptr           = knn_config.getOutputHandler();
+
+    std::size_t chunk_size = knn_config.getInputBufferSize();
+    std::size_t total_size = table_reader->rowsLeft();
+    logger.info() << "Total input catalog size: " << total_size;
+
+    PhzUtils::ProgressReporter progress_reporter{logger};
+    std::size_t                row_to_process = total_size;
+    while (row_to_process > 0) {
+      std::size_t current_chunk_size = std::min(chunk_size, row_to_process);
+      std::size_t done               = total_size - row_to_process;
+      auto        catalog            = catalog_converter(table_reader->read(current_chunk_size));
+      knn.handleSources(catalog.begin(), catalog.end(), *out_ptr,
+                        [&progress_reporter, done, total_size](size_t step, size_t) {
+                          progress_reporter(done + step, total_size);
+                        });
+      row_to_process -= current_chunk_size;
+    }
+
+    return Elements::ExitCode::OK;
+  }
+};
+
+MAIN_FOR(ComputeKnnRedshifts)
@@ -34,11 +34,14 @@
 #include "PhzConfiguration/CosmologicalParameterConfig.h"
 #include "PhzConfiguration/FilterProviderConfig.h"
 #include "PhzConfiguration/IgmConfig.h"
+#include "PhzConfiguration/IncrementalGridConfig.h"
+#include "PhzConfiguration/ModelFluxAlgorithmConfig.h"
 #include "PhzConfiguration/ModelGridOutputConfig.h"
 #include "PhzConfiguration/ModelNormalizationConfig.h"
 #include "PhzConfiguration/ReddeningProviderConfig.h"
 #include "PhzConfiguration/SedProviderConfig.h"
 #include "PhzExecutables/ProgressReporter.h"
+#include "PhzModeling/IncrementalGridBuilder.h"
 #include "PhzModeling/NormalizationFunctorFactory.h"
 #include "PhzModeling/SparseGridCreator.h"
 
@@ -76,15 +79,41 @@ public:
         Euclid::PhzModeling::NormalizationFunctorFactory::NormalizationFunctorFactory::GetFunction(
             filter_provider, lum_filter_name, sed_provider, sun_sed_name);
 
-    Euclid::PhzModeling::SparseGridCreator creator{sed_provider, reddening_provider, filter_provider, igm_abs_func,
-                                                   normalizer_functor};
-
-    auto param_space_map = ComputeModelGridTraits::getParameterSpaceRegions(config_manager);
-    auto results         = creator.createGrid(param_space_map, filter_list, cosmology,
-                                              Euclid::PhzExecutables::ProgressReporter{logger, true});
+    auto& flux_algorithm_config = config_manager.template getConfiguration<ModelFluxAlgorithmConfig>();
+
+    auto& grid_config = config_manager.template getConfiguration<typename ComputeModelGridTraits::ConfigType>();
+
+    Euclid::PhzModeling::SparseGridCreator creator{sed_provider,
+                                                   reddening_provider,
+                                                   filter_provider,
+                                                   igm_abs_func,
+                                                   normalizer_functor,
+                                                   flux_algorithm_config.getFluxAlgorithm(),
+                                                   flux_algorithm_config.getValidationTolerance(),
+                                                   grid_config.getMemoryLimit()};
+
+    auto& output_config   = config_manager.template getConfiguration<ModelGridOutputConfig>();
+    auto  param_space_map = ComputeModelGridTraits::getParameterSpaceRegions(config_manager);
+    auto  existing_grids  = config_manager.template getConfiguration<IncrementalGridConfig>().readExistingGrids(
+        output_config.getOutputFilename(), filter_list, output_config.getProvenance());
+
+    std::map<std::string, Euclid::PhzDataModel::PhotometryGrid> results{};
+    if (existing_grids.empty()) {
+      results = creator.createGrid(param_space_map, filter_list, cosmology,
+                                   Euclid::PhzExecutables::ProgressReporter{logger, true});
+    } else {
+      Euclid::PhzModeling::IncrementalGridBuilder builder{
+          [&creator, &filter_list, &cosmology](
+              const std::map<std::string, Euclid::PhzDataModel::ModelAxesTuple>& missing,
+              Euclid::PhzModeling::IncrementalGridBuilder::ProgressListener       listener) {
+            return creator.createGrid(missing, filter_list, cosmology, listener);
+          }};
+      results = builder.createGrid(param_space_map, std::move(existing_grids),
+                                   Euclid::PhzExecutables::ProgressReporter{logger, true});
+    }
 
     logger.info() << "Creating the output";
-    auto output = config_manager.template getConfiguration<ModelGridOutputConfig>().getOutputFunction();
+    auto output = output_config.getOutputFunction();
     output(results);
 
     return Elements::ExitCode::OK;
@@ -51,7 +51,9 @@ class ComputeSedWeight : public Elements::Program {
     auto& config_manager = ConfigManager::getInstance(config_manager_id);
     config_manager.initialize(args);
 
-    PhzExecutables::ComputeSedWeight{config_manager.getConfiguration<ComputeSedWeightConfig>().getWeightSampling()}.run(config_manager);
+    auto& sed_weight_config = config_manager.getConfiguration<ComputeSedWeightConfig>();
+    PhzExecutables::ComputeSedWeight{sed_weight_config.getWeightSampling(), sed_weight_config.getWeightSamplingSeed()}
+        .run(config_manager);
 
     return Elements::ExitCode::OK;
   }
@@ -0,0 +1,166 @@
+/**
+ * Copyright (C) 2022 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file tests/src/CombinedGridCreator_test.cpp
+ * @date 2026/10/18
+ */
+
+#include "PhzExecutables/CombinedGridCreator.h"
+#include "ElementsKernel/Exception.h"
+#include "PhzFilterVariation/FilterVariationSingleGridCreator.h"
+#include "PhzGalacticCorrection/GalacticCorrectionFactorSingleGridCreator.h"
+#include "PhzModeling/PhotometryGridCreator.h"
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+#include <map>
+#include <memory>
+
+using namespace Euclid;
+using namespace Euclid::PhzDataModel;
+using Euclid::PhzExecutables::CombinedGridCreator;
+using Euclid::XYDataset::QualifiedName;
+
+namespace {
+
+class MockProvider : public Euclid::XYDataset::XYDatasetProvider {
+public:
+  using map_t = std::map<std::string, Euclid::XYDataset::XYDataset>;
+
+  explicit MockProvider(map_t contents) : m_content(std::move(contents)) {}
+
+  std::vector<QualifiedName> listContents(const std::string&) override {
+    return {};
+  }
+
+  std::string getParameter(const QualifiedName&, const std::string&) override {
+    return "";
+  }
+
+  std::unique_ptr<Euclid::XYDataset::XYDataset> getDataset(const QualifiedName& qualified_name) override {
+    auto found = m_content.find(qualified_name.qualifiedName());
+    if (found == m_content.end()) {
+      return nullptr;
+    }
+    return std::unique_ptr<Euclid::XYDataset::XYDataset>{new Euclid::XYDataset::XYDataset(
+        Euclid::XYDataset::XYDataset::factory(std::vector<std::pair<double, double>>(found->second.begin(),
+                                                                                     found->second.end())))};
+  }
+
+private:
+  map_t m_content;
+};
+
+Sed noIgm(const Sed& sed, double) {
+  return sed;
+}
+
+Sed noNormalization(const Sed& sed) {
+  return sed;
+}
+
+void checkSameGrid(PhotometryGrid& actual, PhotometryGrid& expected) {
+  BOOST_CHECK_EQUAL(actual.size(), expected.size());
+  auto expected_iter = expected.begin();
+  for (auto actual_iter = actual.begin(); actual_iter != actual.end(); ++actual_iter, ++expected_iter) {
+    for (auto filter_name : {"F1", "F2"}) {
+      auto a = *actual_iter->find(filter_name);
+      auto e = *expected_iter->find(filter_name);
+      BOOST_CHECK_SMALL(a.flux - e.flux, 1E-10 * std::max(1., std::abs(e.flux)));
+      BOOST_CHECK_SMALL(a.error - e.error, 1E-10 * std::max(1., std::abs(e.error)));
+    }
+  }
+}
+
+}  // namespace
+
+struct CombinedGridCreator_fixture {
+  std::vector<std::pair<double, double>> sed_values{{1000., 1.},  {2000., 2.},  {3000., 1.5}, {4000., 3.},
+                                                    {5000., 2.},  {6000., 2.5}, {7000., 1.},  {8000., 0.5}};
+  std::vector<std::pair<double, double>> red_values{{1000., 5.}, {4000., 3.}, {8000., 1.}};
+  std::vector<std::pair<double, double>> f1_values{{2500., 0.}, {3000., 1.}, {3500., 1.}, {4000., 0.}};
+  std::vector<std::pair<double, double>> f2_values{{4500., 0.}, {5000., 0.8}, {5500., 1.}, {6000., 0.}};
+
+  std::shared_ptr<MockProvider> sed_provider = std::make_shared<MockProvider>(
+      MockProvider::map_t{{"SED1", Euclid::XYDataset::XYDataset::factory(sed_values)}});
+  std::shared_ptr<MockProvider> red_provider =
+      std::make_shared<MockProvider>(MockProvider::map_t{{"RED1", Euclid::XYDataset::XYDataset::factory(red_values)},
+                                                         {"MW", Euclid::XYDataset::XYDataset::factory(red_values)}});
+  std::shared_ptr<MockProvider> filter_provider =
+      std::make_shared<MockProvider>(MockProvider::map_t{{"F1", Euclid::XYDataset::XYDataset::factory(f1_values)},
+                                                         {"F2", Euclid::XYDataset::XYDataset::factory(f2_values)}});
+
+  std::vector<double>        delta_lambda{-20., -10., 10., 20.};
+  std::vector<QualifiedName> filters{QualifiedName{"F1"}, QualifiedName{"F2"}};
+  ModelAxesTuple             axes = createAxesTuple({0., 0.1, 0.3}, {0., 0.2}, {QualifiedName{"RED1"}},
+                                                    {QualifiedName{"SED1"}});
+};
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE(CombinedGridCreator_test)
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(same_as_separate_creators, CombinedGridCreator_fixture) {
+
+  // Given
+  PhysicsUtils::CosmologicalParameters cosmology{};
+  CombinedGridCreator creator{sed_provider,    red_provider, filter_provider,    noIgm,
+                              noNormalization, delta_lambda, QualifiedName{"MW"}};
+  PhzModeling::PhotometryGridCreator photometry_creator{sed_provider, red_provider, filter_provider, noIgm,
+                                                        noNormalization};
+  PhzFilterVariation::FilterVariationSingleGridCreator variation_creator{
+      sed_provider, red_provider, filter_provider, noIgm, noNormalization, delta_lambda};
+  PhzGalacticCorrection::GalacticCorrectionSingleGridCreator correction_creator{
+      sed_provider, red_provider, filter_provider, noIgm, noNormalization, QualifiedName{"MW"}};
+
+  // When
+  std::map<std::string, ModelAxesTuple> regions{{"REGION", axes}};
+  size_t                                last_step = 0;
+  auto grids      = creator.createGrid(regions, filters, cosmology, [&last_step](size_t step, size_t) {
+    last_step = step;
+  });
+  auto photometry = photometry_creator.createGrid(axes, filters, cosmology);
+  auto variation  = variation_creator.createGrid(axes, filters, cosmology);
+  auto correction = correction_creator.createGrid(axes, filters, cosmology);
+
+  // Then
+  BOOST_CHECK_EQUAL(grids.size(), 1);
+  BOOST_CHECK_EQUAL(last_step, 6);
+  auto& region = grids.at("REGION");
+  checkSameGrid(region.photometry, photometry);
+  checkSameGrid(region.filter_variation, variation);
+  checkSameGrid(region.galactic_correction, correction);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(missing_milky_way_curve, CombinedGridCreator_fixture) {
+
+  // Given
+  CombinedGridCreator creator{sed_provider,    red_provider, filter_provider,        noIgm,
+                              noNormalization, delta_lambda, QualifiedName{"OTHER"}};
+
+  // Then
+  BOOST_CHECK_THROW(creator.createGrid(axes, filters, PhysicsUtils::CosmologicalParameters{}), Elements::Exception);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -27,7 +27,9 @@
 #include <boost/test/unit_test.hpp>
 #include <vector>
 
+#include "ElementsKernel/Exception.h"
 #include "PhzDataModel/PhzModel.h"
+#include "PhzUtils/Multithreading.h"
 #include "XYDataset/XYDataset.h"
 
 using namespace Euclid;
@@ -187,6 +189,18 @@ BOOST_AUTO_TEST_CASE(maxGap_test) {
 
   // THEN
   BOOST_CHECK_CLOSE(0.4, computer.maxGap(sed_distances_2), 0.00001);
+
+  // Same seds given in a different order: 3 1 4 0 2
+  std::vector<std::size_t>         order{3, 1, 4, 0, 2};
+  std::vector<std::vector<double>> sed_distances_3(order.size(), std::vector<double>(order.size()));
+  for (std::size_t i = 0; i < order.size(); ++i) {
+    for (std::size_t j = 0; j < order.size(); ++j) {
+      sed_distances_3[i][j] = sed_distances_2[order[i]][order[j]];
+    }
+  }
+
+  // THEN
+  BOOST_CHECK_CLOSE(0.4, computer.maxGap(sed_distances_3), 0.00001);
 }
 
 //-----------------------------------------------------------------------------
@@ -235,6 +249,24 @@ BOOST_AUTO_TEST_CASE(getWeights_test) {
   BOOST_CHECK_CLOSE(1.0 / 6.0, weights[4], 1);
 }
 
+//-----------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(getWeights_reproducible_test) {
+  ComputeSedWeight computer = ComputeSedWeight(2500, 42);
+
+  std::vector<std::vector<double>> seds_colors{{0, 1}, {0.2, 1}, {0.3, 1}, {0.7, 1}, {0.75, 1}};
+
+  // WHEN
+  auto thread_number          = PhzUtils::getThreadNumber().load();
+  PhzUtils::getThreadNumber() = 1;
+  std::vector<double> weights_1 = computer.getWeights(seds_colors, 0.2);
+  PhzUtils::getThreadNumber() = 4;
+  std::vector<double> weights_4 = computer.getWeights(seds_colors, 0.2);
+  PhzUtils::getThreadNumber() = thread_number;
+
+  // THEN
+  BOOST_CHECK_EQUAL_COLLECTIONS(weights_1.begin(), weights_1.end(), weights_4.begin(), weights_4.end());
+}
+
 //-----------------------------------------------------------------------------
 BOOST_AUTO_TEST_CASE(order_filter_test) {
   ComputeSedWeight         computer = ComputeSedWeight();
@@ -273,6 +305,35 @@ BOOST_AUTO_TEST_CASE(order_filter_test) {
   BOOST_CHECK_CLOSE(30, ordered[2].second, 0.5);
 }
 
+//-----------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(buildFilterTable_test) {
+  ComputeSedWeight computer = ComputeSedWeight();
+
+  XYDataset::QualifiedName f1{"filter_1"};
+  XYDataset::QualifiedName f2{"filter_2"};
+
+  XYDataset::XYDataset xyf1 =
+      XYDataset::XYDataset::factory({0.0, 9.0, 9.1, 10.9, 11.0, 40.0}, {0.0, 0.0, 1.0, 1.0, 0.0, 0.0});
+  XYDataset::XYDataset xyf2 = XYDataset::XYDataset::factory({19.0, 19.5, 21.0}, {0.5, 1.0, 0.5});
+
+  std::map<Euclid::XYDataset::QualifiedName, XYDataset::XYDataset> storage;
+  storage.insert(std::make_pair(f1, xyf1));
+  storage.insert(std::make_pair(f2, xyf2));
+  auto filter_provider = std::shared_ptr<XYDataset::XYDatasetProvider>{new MockDatasetProvider{std::move(storage)}};
+
+  // WHEN
+  auto filter_table = computer.buildFilterTable({{f1, 10.0}, {f2, 20.0}}, filter_provider);
+
+  // THEN
+  BOOST_CHECK_EQUAL(filter_table.size(), 2);
+  BOOST_CHECK_EQUAL(filter_table[0].getRange().first, 9.0);
+  BOOST_CHECK_EQUAL(filter_table[0].getRange().second, 11.0);
+  BOOST_CHECK_CLOSE(filter_table[0].getNormalization(), 1.9, 0.01);
+  BOOST_CHECK_EQUAL(filter_table[1].getRange().first, 19.0);
+  BOOST_CHECK_EQUAL(filter_table[1].getRange().second, 21.0);
+  BOOST_CHECK_CLOSE(filter_table[1].getNormalization(), 1.5, 0.01);
+}
+
 //-----------------------------------------------------------------------------
 BOOST_AUTO_TEST_CASE(computeSedColors_test) {
   ComputeSedWeight computer = ComputeSedWeight();
@@ -324,14 +385,16 @@ BOOST_AUTO_TEST_CASE(computeSedColors_test) {
   BOOST_CHECK_CLOSE(0.752575, colors[1][1], 0.05);
 }
 //-----------------------------------------------------------------------------
-BOOST_AUTO_TEST_CASE(getCellKey_test) {
-  ComputeSedWeight         computer = ComputeSedWeight();
-  XYDataset::QualifiedName r1{"red_1"};
-
-  auto        key      = computer.getCellKey(3.0, 0.0, r1);
-  std::string expected = "3.000000_0.000000_red_1";
-
-  BOOST_CHECK_EQUAL(expected, key);
+BOOST_AUTO_TEST_CASE(getCellIndex_test) {
+  ComputeSedWeight           computer = ComputeSedWeight();
+  ComputeSedWeight::CellAxes cell_axes{{0.0, 3.0}, {0.0, 0.1, 0.2}, {{"red_1"}, {"red_2"}}};
+
+  BOOST_CHECK_EQUAL(computer.getCellIndex(cell_axes, 0.0, 0.0, {"red_1"}), 0);
+  BOOST_CHECK_EQUAL(computer.getCellIndex(cell_axes, 0.0, 0.1, {"red_2"}), 3);
+  BOOST_CHECK_EQUAL(computer.getCellIndex(cell_axes, 3.0, 0.0, {"red_1"}), 6);
+  BOOST_CHECK_EQUAL(computer.getCellIndex(cell_axes, 3.0, 0.2, {"red_2"}), 11);
+  BOOST_CHECK_THROW(computer.getCellIndex(cell_axes, 1.0, 0.0, {"red_1"}), Elements::Exception);
+  BOOST_CHECK_THROW(computer.getCellIndex(cell_axes, 0.0, 0.0, {"red_3"}), Elements::Exception);
 }
 //-----------------------------------------------------------------------------
 BOOST_AUTO_TEST_CASE(getSedCollection_test) {
@@ -359,13 +422,18 @@ BOOST_AUTO_TEST_CASE(getSedCollection_test) {
   PhzDataModel::PhotometryGridInfo grid_info{};
   grid_info.region_axes_map = std::move(region_map);
 
-  auto sed_collection = computer.getSedCollection(grid_info);
+  auto cell_axes      = computer.getCellAxes(grid_info);
+  auto sed_collection = computer.getSedCollection(grid_info, cell_axes);
+
+  BOOST_CHECK_EQUAL(cell_axes.z.size(), 4);
+  BOOST_CHECK_EQUAL(cell_axes.ebv.size(), 3);
+  BOOST_CHECK_EQUAL(cell_axes.reddening_curve.size(), 1);
 
   BOOST_CHECK_EQUAL(sed_collection.second, 20);        // 20  nodes in total
   BOOST_CHECK_EQUAL(sed_collection.first.size(), 12);  // 12 different nodes
 
-  BOOST_CHECK_EQUAL(sed_collection.first.at("4.000000_0.200000_red_1").size(), 3);
-  BOOST_CHECK_EQUAL(sed_collection.first.at("4.000000_0.500000_red_1").size(), 2);
+  BOOST_CHECK_EQUAL(sed_collection.first.at(computer.getCellIndex(cell_axes, 4.0, 0.2, {"red_1"})).size(), 3);
+  BOOST_CHECK_EQUAL(sed_collection.first.at(computer.getCellIndex(cell_axes, 4.0, 0.5, {"red_1"})).size(), 2);
 }
 
 //-----------------------------------------------------------------------------
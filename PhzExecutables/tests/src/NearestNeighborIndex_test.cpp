@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2022 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file tests/src/NearestNeighborIndex_test.cpp
+ * @date 2026/10/18
+ */
+
+#include "PhzExecutables/NearestNeighborIndex.h"
+#include "ElementsKernel/Exception.h"
+#include <algorithm>
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+#include <random>
+
+using Euclid::PhzExecutables::NearestNeighborIndex;
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE(NearestNeighborIndex_test)
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(invalid_coordinates_test) {
+  BOOST_CHECK_THROW(NearestNeighborIndex(0, {}), Elements::Exception);
+  BOOST_CHECK_THROW(NearestNeighborIndex(2, {1., 2., 3.}), Elements::Exception);
+
+  NearestNeighborIndex index{2, {1., 2.}};
+  BOOST_CHECK_THROW(index.findNearest({1.}, 1), Elements::Exception);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(fewer_points_than_k_test) {
+  NearestNeighborIndex index{1, {3., 0., 1.}};
+  BOOST_CHECK_EQUAL(index.size(), 3);
+
+  auto neighbors = index.findNearest({0.2}, 10);
+  BOOST_REQUIRE_EQUAL(neighbors.size(), 3);
+  BOOST_CHECK_EQUAL(neighbors[0].second, 1);
+  BOOST_CHECK_EQUAL(neighbors[1].second, 2);
+  BOOST_CHECK_EQUAL(neighbors[2].second, 0);
+  BOOST_CHECK_CLOSE(neighbors[0].first, 0.2, 1E-8);
+  BOOST_CHECK_CLOSE(neighbors[2].first, 2.8, 1E-8);
+
+  BOOST_CHECK(NearestNeighborIndex(1, {}).findNearest({0.}, 3).empty());
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(brute_force_test) {
+  std::mt19937                           generator{42};
+  std::normal_distribution<double>       distribution{0., 1.};
+  const std::size_t                      dimensions = 3, points = 2000, k = 20;
+  std::vector<double>                    coordinates(dimensions * points);
+  std::generate(coordinates.begin(), coordinates.end(), [&]() { return distribution(generator); });
+  // Duplicated points must not be lost by the splits
+  std::copy(coordinates.begin(), coordinates.begin() + 30 * dimensions, coordinates.end() - 30 * dimensions);
+
+  NearestNeighborIndex index{dimensions, coordinates, 8};
+
+  for (int query = 0; query < 50; ++query) {
+    std::vector<double> point(dimensions);
+    std::generate(point.begin(), point.end(), [&]() { return 1.5 * distribution(generator); });
+
+    std::vector<double> expected{};
+    for (std::size_t i = 0; i < points; ++i) {
+      double sum = 0.;
+      for (std::size_t d = 0; d < dimensions; ++d) {
+        sum += (point[d] - coordinates[i * dimensions + d]) * (point[d] - coordinates[i * dimensions + d]);
+      }
+      expected.emplace_back(std::sqrt(sum));
+    }
+    std::sort(expected.begin(), expected.end());
+
+    auto neighbors = index.findNearest(point, k);
+    BOOST_REQUIRE_EQUAL(neighbors.size(), k);
+    for (std::size_t i = 0; i < k; ++i) {
+      BOOST_CHECK_CLOSE(neighbors[i].first, expected[i], 1E-8);
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,190 @@
+/*
+ * Copyright (C) 2022 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file tests/src/ReferenceSampleKnn_test.cpp
+ * @date 2026/10/18
+ */
+
+#include "PhzExecutables/ReferenceSampleKnn.h"
+#include "ElementsKernel/Exception.h"
+#include "ElementsKernel/Temporary.h"
+#include "PhzUtils/Multithreading.h"
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+#include <map>
+
+using namespace Euclid;
+using Euclid::PhzExecutables::ReferenceSampleKnn;
+using Euclid::SourceCatalog::FluxErrorPair;
+using Euclid::SourceCatalog::Photometry;
+
+namespace {
+
+class PdzCollector : public PhzOutput::OutputHandler {
+public:
+  void handleSourceOutput(const SourceCatalog::Source& source, const PhzDataModel::SourceResults& results) override {
+    auto& pdz = results.get<PhzDataModel::SourceResultType::Z_1D_PDF>();
+    ids.emplace_back(boost::get<int64_t>(source.getId()));
+    pdzs.emplace_back(pdz.begin(), pdz.end());
+  }
+
+  std::vector<int64_t>             ids;
+  std::vector<std::vector<double>> pdzs;
+};
+
+/// The fluxes of a source with the colours (color, color)
+std::vector<double> fluxesForColor(double color) {
+  return {1., std::pow(10., 0.4 * color), std::pow(10., 0.8 * color)};
+}
+
+Photometry photometry(const std::vector<double>& fluxes, bool missing = false) {
+  std::vector<FluxErrorPair> values{};
+  for (double flux : fluxes) {
+    values.emplace_back(flux, 0.1 * flux, missing, false);
+  }
+  return Photometry{std::make_shared<std::vector<std::string>>(std::vector<std::string>{"F1", "F2", "F3"}), values};
+}
+
+}  // namespace
+
+struct ReferenceSampleKnn_Fixture {
+  Elements::TempPath                                   m_top_dir;
+  ReferenceSample::ReferenceSample                     m_ref;
+  std::vector<std::string>                             m_filters{"F1", "F2", "F3"};
+  std::vector<std::pair<int64_t, std::vector<double>>> m_fluxes{
+      {1, fluxesForColor(0.)}, {2, fluxesForColor(1.)}, {3, fluxesForColor(0.5)}, {4, {1., 0., 1.}}};
+
+  ReferenceSampleKnn_Fixture() : m_ref{ReferenceSample::ReferenceSample::create(m_top_dir.path())} {
+    // The PDZs are normalized when added, to {2, 0, 0} and {0, 0, 2}. The object 3 has no PDZ.
+    m_ref.addPdzData(1, XYDataset::XYDataset{{{0, 1.}, {1, 0.}, {2, 0.}}});
+    m_ref.addPdzData(2, XYDataset::XYDataset{{{0, 0.}, {1, 0.}, {2, 1.}}});
+    m_ref.addPdzData(4, XYDataset::XYDataset{{{0, 0.}, {1, 1.}, {2, 0.}}});
+  }
+
+  virtual ~ReferenceSampleKnn_Fixture() {
+    boost::filesystem::remove_all(m_top_dir.path());
+  }
+};
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE(ReferenceSampleKnn_test)
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(construction_test, ReferenceSampleKnn_Fixture) {
+  ReferenceSampleKnn knn{m_ref, m_filters, m_fluxes};
+
+  // The object 3 has no PDZ and the object 4 a zero flux
+  BOOST_CHECK_EQUAL(knn.size(), 2);
+  BOOST_CHECK_THROW((ReferenceSampleKnn{m_ref, {"F1"}, m_fluxes}), Elements::Exception);
+  BOOST_CHECK_THROW((ReferenceSampleKnn{m_ref, m_filters, {{3, fluxesForColor(0.)}}}), Elements::Exception);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(different_bins_test) {
+  // Each PDZ goes to its own file, which takes the bins of its first PDZ
+  Elements::TempPath top_dir;
+  auto               ref = ReferenceSample::ReferenceSample::create(top_dir.path(), true, 1);
+  ref.addPdzData(1, XYDataset::XYDataset{{{0, 1.}, {1, 0.}, {2, 0.}}});
+  ref.addPdzData(2, XYDataset::XYDataset{{{0, 0.}, {1, 0.}, {2, 1.}, {3, 0.}}});
+
+  BOOST_CHECK_THROW((ReferenceSampleKnn{ref, {"F1", "F2", "F3"}, {{1, fluxesForColor(0.)}, {2, fluxesForColor(1.)}}}),
+                    Elements::Exception);
+  boost::filesystem::remove_all(top_dir.path());
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(nearest_test, ReferenceSampleKnn_Fixture) {
+  ReferenceSampleKnn knn{m_ref, m_filters, m_fluxes, 1};
+
+  auto near_first  = knn.computePdz(photometry(fluxesForColor(0.1)));
+  auto near_second = knn.computePdz(photometry(fluxesForColor(0.9)));
+
+  BOOST_CHECK_EQUAL(near_first.getAxis<0>()[2], 2.);
+  BOOST_CHECK_CLOSE(near_first(0), 2., 1E-6);
+  BOOST_CHECK_SMALL(near_first(2), 1E-6);
+  BOOST_CHECK_SMALL(near_second(0), 1E-6);
+  BOOST_CHECK_CLOSE(near_second(2), 2., 1E-6);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(weighted_test, ReferenceSampleKnn_Fixture) {
+  ReferenceSampleKnn knn{m_ref, m_filters, m_fluxes, 2};
+
+  // The second neighbour is three times further away, so it gets a quarter of the weight
+  auto pdz = knn.computePdz(photometry(fluxesForColor(0.25)));
+
+  BOOST_CHECK_CLOSE(pdz(0), 1.5, 1E-6);
+  BOOST_CHECK_SMALL(pdz(1), 1E-6);
+  BOOST_CHECK_CLOSE(pdz(2), 0.5, 1E-6);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(unusable_photometry_test, ReferenceSampleKnn_Fixture) {
+  ReferenceSampleKnn knn{m_ref, m_filters, m_fluxes};
+
+  auto missing = knn.computePdz(photometry(fluxesForColor(0.), true));
+  auto zero    = knn.computePdz(photometry({1., 0., 1.}));
+  for (std::size_t i = 0; i < 3; ++i) {
+    BOOST_CHECK_CLOSE(missing(i), 0.5, 1E-6);
+    BOOST_CHECK_CLOSE(zero(i), 0.5, 1E-6);
+  }
+
+  Photometry other_filters{std::make_shared<std::vector<std::string>>(std::vector<std::string>{"F1", "F2"}),
+                           {{1., 0.1, false, false}, {1., 0.1, false, false}}};
+  BOOST_CHECK_THROW(knn.computePdz(other_filters), Elements::Exception);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(handleSources_test, ReferenceSampleKnn_Fixture) {
+  ReferenceSampleKnn knn{m_ref, m_filters, m_fluxes, 1};
+
+  std::vector<SourceCatalog::Source> sources{};
+  for (int64_t i = 0; i < 100; ++i) {
+    double color = (i % 2 == 0) ? 0.1 : 0.9;
+    sources.emplace_back(i, std::vector<std::shared_ptr<SourceCatalog::Attribute>>{
+                                std::make_shared<Photometry>(photometry(fluxesForColor(color)))});
+  }
+
+  auto thread_number          = PhzUtils::getThreadNumber().load();
+  PhzUtils::getThreadNumber() = 4;
+  PdzCollector collector{};
+  std::size_t  last_progress = 0;
+  knn.handleSources(sources.begin(), sources.end(), collector,
+                    [&last_progress](size_t step, size_t) { last_progress = step; });
+  PhzUtils::getThreadNumber() = thread_number;
+
+  // The output handler is called in the input order
+  BOOST_CHECK_EQUAL(last_progress, 100);
+  BOOST_REQUIRE_EQUAL(collector.ids.size(), 100);
+  for (int64_t i = 0; i < 100; ++i) {
+    BOOST_CHECK_EQUAL(collector.ids[i], i);
+    BOOST_CHECK_CLOSE(collector.pdzs[i][(i % 2 == 0) ? 0 : 2], 2., 1E-6);
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END()
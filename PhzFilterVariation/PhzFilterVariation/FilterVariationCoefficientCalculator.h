@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2022 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file PhzFilterVariation/FilterVariationCoefficientCalculator.h
+ * @date 2026/10/18
+ */
+
+#ifndef _PHZFILTERVARIATION_FILTERVARIATIONCOEFFICIENTCALCULATOR_H
+#define _PHZFILTERVARIATION_FILTERVARIATIONCOEFFICIENTCALCULATOR_H
+
+#include "XYDataset/XYDataset.h"
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace Euclid {
+namespace PhzFilterVariation {
+
+/**
+ * @class FilterVariationCoefficientCalculator
+ * @brief
+ * Computes the filter variation coefficients of a SED for one filter
+ * @details
+ * The shifted filters are translations of the same transmission, so instead of
+ * building and integrating each of them separately, the SED is integrated
+ * against the nominal and all the shifted transmissions in a single sweep over
+ * its knots. The integrals are computed with the trapezoidal rule on the merged
+ * knots of the SED and of each (shifted) filter, as the ApplyFilterFunctor and
+ * IntegrateLambdaTimeDatasetFunctor do, and the linear regression of the
+ * reduced coefficients over the shifts is solved in closed form.
+ *
+ * The working buffers are kept between the calls, so an instance must not be
+ * used by more than one thread at a time.
+ */
+class FilterVariationCoefficientCalculator {
+public:
+  /**
+   * @brief Constructor
+   *
+   * @param filter_dataset
+   * The (nominal) filter transmission
+   *
+   * @param delta_lambda
+   * The wavelength shifts of the filter
+   */
+  FilterVariationCoefficientCalculator(const XYDataset::XYDataset& filter_dataset, std::vector<double> delta_lambda);
+
+  /**
+   * @brief
+   * Computes for each shift the coefficient Flux(d_lambda)/Flux(No shift), as
+   * FilterVariationSingleGridCreator::compute_coef does
+   */
+  void computeCoefficients(const XYDataset::XYDataset& sed, std::vector<double>& coefficients);
+
+  /**
+   * @brief
+   * Returns the slope and the intercept of the linear regression of the
+   * reduced coefficients (Flux(d_lambda)/Flux(No shift) - 1)/d_lambda over the
+   * shifts
+   */
+  std::pair<double, double> operator()(const XYDataset::XYDataset& sed);
+
+private:
+  /// Integrates the SED against all the shifted transmissions, filling m_flux
+  void integrate(const XYDataset::XYDataset& sed);
+
+  /// Adds a point of the integrand of the given shift
+  void addPoint(size_t shift, double x, double value);
+
+  // The filter knots within its range and the shifts, the last one being the nominal filter
+  std::vector<double> m_knots;
+  std::vector<double> m_transmission;
+  std::vector<double> m_delta_lambda;
+  std::vector<double> m_offsets;
+  std::vector<double> m_normalization;
+
+  // The constant sums of the regression
+  double m_sum_x;
+  double m_denominator;
+
+  // The working buffers of each shift
+  std::vector<size_t> m_cursor;
+  std::vector<double> m_previous_x;
+  std::vector<double> m_previous_value;
+  std::vector<char>   m_started;
+  std::vector<double> m_flux;
+  std::vector<double> m_coefficients;
+};
+
+}  // namespace PhzFilterVariation
+}  // namespace Euclid
+
+#endif  // _PHZFILTERVARIATION_FILTERVARIATIONCOEFFICIENTCALCULATOR_H
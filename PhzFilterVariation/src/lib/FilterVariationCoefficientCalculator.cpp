@@ -0,0 +1,183 @@
+/*
+ * Copyright (C) 2022 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file src/lib/FilterVariationCoefficientCalculator.cpp
+ * @date 2026/10/18
+ */
+
+#include "PhzFilterVariation/FilterVariationCoefficientCalculator.h"
+#include "PhzFilterVariation/FilterVariationSingleGridCreator.h"
+#include "PhzModeling/BuildFilterInfoFunctor.h"
+#include <algorithm>
+#include <iterator>
+
+namespace Euclid {
+namespace PhzFilterVariation {
+
+FilterVariationCoefficientCalculator::FilterVariationCoefficientCalculator(const XYDataset::XYDataset& filter_dataset,
+                                                                           std::vector<double>         delta_lambda)
+    : m_delta_lambda(std::move(delta_lambda)), m_sum_x{0.}, m_denominator{0.} {
+  PhzModeling::BuildFilterInfoFunctor filter_info_functor;
+
+  // The normalization of the shifted filters, followed by the nominal one
+  for (auto dl : m_delta_lambda) {
+    auto shifted = filter_info_functor(FilterVariationSingleGridCreator::shiftFilter(filter_dataset, dl));
+    m_normalization.emplace_back(shifted.getNormalization());
+  }
+  auto nominal = filter_info_functor(filter_dataset);
+  m_normalization.emplace_back(nominal.getNormalization());
+  m_offsets = m_delta_lambda;
+  m_offsets.emplace_back(0.);
+
+  auto range = nominal.getRange();
+  for (auto& pair : filter_dataset) {
+    if (pair.first >= range.first && pair.first <= range.second) {
+      m_knots.emplace_back(pair.first);
+      m_transmission.emplace_back(pair.second);
+    }
+  }
+
+  double n      = m_delta_lambda.size();
+  double sum_x2 = 0.;
+  for (auto dl : m_delta_lambda) {
+    m_sum_x += dl;
+    sum_x2 += dl * dl;
+  }
+  m_denominator = n * sum_x2 - m_sum_x * m_sum_x;
+
+  m_cursor.resize(m_offsets.size());
+  m_previous_x.resize(m_offsets.size());
+  m_previous_value.resize(m_offsets.size());
+  m_started.resize(m_offsets.size());
+  m_flux.resize(m_offsets.size());
+  m_coefficients.resize(m_delta_lambda.size());
+}
+
+void FilterVariationCoefficientCalculator::addPoint(size_t shift, double x, double value) {
+  if (m_started[shift]) {
+    m_flux[shift] += (x - m_previous_x[shift]) * (value + m_previous_value[shift]) / 2.;
+  }
+  m_started[shift]        = true;
+  m_previous_x[shift]     = x;
+  m_previous_value[shift] = value;
+}
+
+void FilterVariationCoefficientCalculator::integrate(const XYDataset::XYDataset& sed) {
+  std::fill(m_cursor.begin(), m_cursor.end(), 0);
+  std::fill(m_started.begin(), m_started.end(), false);
+  std::fill(m_flux.begin(), m_flux.end(), 0.);
+  if (m_knots.empty()) {
+    return;
+  }
+
+  auto   offset_range = std::minmax_element(m_offsets.begin(), m_offsets.end());
+  double low          = m_knots.front() + *offset_range.first;
+  double high         = m_knots.back() + *offset_range.second;
+
+  // The integrand is lambda * SED * transmission, with the SED interpolated
+  // linearly between its knots and zero outside them
+  auto compare = [](const std::pair<double, double>& pair, double x) {
+    return pair.first < x;
+  };
+  auto                      sed_iter     = std::lower_bound(sed.begin(), sed.end(), low, compare);
+  bool                      has_previous = sed_iter != sed.begin();
+  std::pair<double, double> previous     = has_previous ? *std::prev(sed_iter) : std::make_pair(0., 0.);
+
+  for (; sed_iter != sed.end(); ++sed_iter) {
+    double x = sed_iter->first;
+    double s = sed_iter->second;
+    for (size_t shift = 0; shift < m_offsets.size(); ++shift) {
+      double  offset = m_offsets[shift];
+      size_t& i      = m_cursor[shift];
+
+      // The filter knots before the SED knot
+      for (; i < m_knots.size() && m_knots[i] + offset < x; ++i) {
+        double knot_x = m_knots[i] + offset;
+        double knot_s =
+            has_previous ? previous.second + (s - previous.second) * (knot_x - previous.first) / (x - previous.first)
+                         : 0.;
+        addPoint(shift, knot_x, knot_x * knot_s * m_transmission[i]);
+      }
+
+      // The SED knot, if within the shifted range
+      if (x >= m_knots.front() + offset && x <= m_knots.back() + offset) {
+        double transmission;
+        if (m_knots[i] + offset == x) {
+          transmission = m_transmission[i];
+          ++i;
+        } else {
+          double left  = m_knots[i - 1] + offset;
+          double right = m_knots[i] + offset;
+          double slope = (m_transmission[i] - m_transmission[i - 1]) / (right - left);
+          transmission = m_transmission[i - 1] + slope * (x - left);
+        }
+        addPoint(shift, x, x * s * transmission);
+      }
+    }
+    if (x > high) {
+      break;
+    }
+    has_previous = true;
+    previous     = *sed_iter;
+  }
+
+  // The filter knots after the last SED knot, where the SED is zero
+  for (size_t shift = 0; shift < m_offsets.size(); ++shift) {
+    for (size_t& i = m_cursor[shift]; i < m_knots.size(); ++i) {
+      addPoint(shift, m_knots[i] + m_offsets[shift], 0.);
+    }
+  }
+
+  for (size_t shift = 0; shift < m_offsets.size(); ++shift) {
+    m_flux[shift] /= m_normalization[shift];
+  }
+}
+
+void FilterVariationCoefficientCalculator::computeCoefficients(const XYDataset::XYDataset& sed,
+                                                               std::vector<double>&        coefficients) {
+  integrate(sed);
+  double nominal_flux = m_flux.back();
+  coefficients.resize(m_delta_lambda.size());
+  for (size_t shift = 0; shift < m_delta_lambda.size(); ++shift) {
+    coefficients[shift] = (nominal_flux == 0.) ? 0. : m_flux[shift] / nominal_flux;
+  }
+}
+
+std::pair<double, double> FilterVariationCoefficientCalculator::operator()(const XYDataset::XYDataset& sed) {
+  computeCoefficients(sed, m_coefficients);
+
+  double sum_y  = 0.;
+  double sum_xy = 0.;
+  for (size_t shift = 0; shift < m_delta_lambda.size(); ++shift) {
+    double dl = m_delta_lambda[shift];
+    double y  = (dl != 0) ? (m_coefficients[shift] - 1) / dl : 0.;
+    sum_y += y;
+    sum_xy += dl * y;
+  }
+
+  double n = m_delta_lambda.size();
+  if (m_denominator == 0.) {
+    return {0., n > 0 ? sum_y / n : 0.};
+  }
+  double slope = (n * sum_xy - m_sum_x * sum_y) / m_denominator;
+  return {slope, (sum_y - slope * m_sum_x) / n};
+}
+
+}  // namespace PhzFilterVariation
+}  // namespace Euclid
@@ -25,7 +25,6 @@
 #include "ElementsKernel/Exception.h"
 #include "ElementsKernel/Logging.h"
 #include "MathUtils/interpolation/interpolation.h"
-#include "MathUtils/regression/LinearRegression.h"
 #include <atomic>
 #include <chrono>
 #include <cmath>
@@ -39,6 +38,7 @@
 #include "PhzModeling/ModelDatasetGrid.h"
 #include "PhzModeling/RedshiftFunctor.h"
 
+#include "PhzFilterVariation/FilterVariationCoefficientCalculator.h"
 #include "PhzFilterVariation/FilterVariationSingleGridCreator.h"
 #include "PhzUtils/Multithreading.h"
 
@@ -110,21 +110,13 @@ std::vector<double> FilterVariationSingleGridCreator::compute_tild_coef(
 class ParallelJob {
 
 public:
-  ParallelJob(
-      std::shared_ptr<std::vector<std::string>>                                                filter_name_shared_ptr,
-      const std::map<Euclid::XYDataset::QualifiedName, PhzDataModel::FilterInfo>&              filter_map,
-      const std::map<Euclid::XYDataset::QualifiedName, std::vector<PhzDataModel::FilterInfo>>& shifted_filter_map,
-      const std::vector<double>& delta_lambda, PhzModeling::ApplyFilterFunctor& filter_functor,
-      PhzModeling::IntegrateLambdaTimeDatasetFunctor& integrate_funct,
-      PhzModeling::ModelDatasetGrid::iterator model_begin, PhzModeling::ModelDatasetGrid::iterator model_end,
-      typename PhzDataModel::PhotometryGrid::iterator correction_begin, std::atomic<size_t>& arg_progress,
-      std::atomic<size_t>& done_counter)
+  ParallelJob(std::shared_ptr<std::vector<std::string>>         filter_name_shared_ptr,
+              std::vector<FilterVariationCoefficientCalculator> calculators,
+              PhzModeling::ModelDatasetGrid::iterator model_begin, PhzModeling::ModelDatasetGrid::iterator model_end,
+              typename PhzDataModel::PhotometryGrid::iterator correction_begin, std::atomic<size_t>& arg_progress,
+              std::atomic<size_t>& done_counter)
       : m_filter_name_shared_ptr{filter_name_shared_ptr}
-      , m_filter_map(filter_map)
-      , m_shifted_filter_map(shifted_filter_map)
-      , m_delta_lambda(delta_lambda)
-      , m_filter_functor(filter_functor)
-      , m_integrate_funct(integrate_funct)
+      , m_calculators(std::move(calculators))
       , m_model_begin(model_begin)
       , m_model_end(model_end)
       , m_correction_begin(correction_begin)
@@ -140,19 +132,16 @@ public:
 
       std::vector<SourceCatalog::FluxErrorPair> corr_vertor{m_filter_name_shared_ptr->size(), {0.0, 0.0}};
 
-      auto corr_iter        = corr_vertor.begin();
-      auto filter_name_iter = m_filter_name_shared_ptr->begin();
+      auto corr_iter       = corr_vertor.begin();
+      auto calculator_iter = m_calculators.begin();
       while (corr_iter != corr_vertor.end()) {
 
-        auto tild_coef = FilterVariationSingleGridCreator::compute_tild_coef(
-            *m_model_begin, m_filter_map.at(*filter_name_iter), m_shifted_filter_map.at(*filter_name_iter),
-            m_delta_lambda, m_filter_functor, m_integrate_funct);
-        auto coef = MathUtils::linearRegression(m_delta_lambda, tild_coef);
+        auto coef = (*calculator_iter)(*m_model_begin);
 
         (*corr_iter).flux  = coef.first;
         (*corr_iter).error = coef.second;
         ++corr_iter;
-        ++filter_name_iter;
+        ++calculator_iter;
       }
 
       *m_correction_begin = SourceCatalog::Photometry(m_filter_name_shared_ptr, std::move(corr_vertor));
@@ -175,13 +164,8 @@ private:
     std::atomic<size_t>& m_done_counter;
   };
 
-  std::shared_ptr<std::vector<std::string>>                                                m_filter_name_shared_ptr;
-  const std::map<Euclid::XYDataset::QualifiedName, PhzDataModel::FilterInfo>               m_filter_map;
-  const std::map<Euclid::XYDataset::QualifiedName, std::vector<PhzDataModel::FilterInfo>>& m_shifted_filter_map;
-  const std::vector<double>&                                                               m_delta_lambda;
-
-  PhzModeling::ApplyFilterFunctor&                m_filter_functor;
-  PhzModeling::IntegrateLambdaTimeDatasetFunctor& m_integrate_funct;
+  std::shared_ptr<std::vector<std::string>>         m_filter_name_shared_ptr;
+  std::vector<FilterVariationCoefficientCalculator> m_calculators;
 
   PhzModeling::ModelDatasetGrid::iterator m_model_begin;
   PhzModeling::ModelDatasetGrid::iterator m_model_end;
@@ -254,8 +238,6 @@ FilterVariationSingleGridCreator::createGrid(const PhzDataModel::ModelAxesTuple&
                                              const std::vector<Euclid::XYDataset::QualifiedName>& filter_name_list,
                                              const PhysicsUtils::CosmologicalParameters&          cosmology,
                                              ProgressListener                                     progress_listener) {
-  using PhzDataModel::FilterInfo;
-
   // Create the maps
   auto filter_dataset_map     = buildMap(*m_filter_provider, filter_name_list.begin(), filter_name_list.end());
   auto filter_name_shared_ptr = createSharedPointer(filter_name_list);
@@ -267,19 +249,11 @@ FilterVariationSingleGridCreator::createGrid(const PhzDataModel::ModelAxesTuple&
   auto reddening_curve_map  = convertToFunction(
        buildMap(*m_reddening_curve_provider, reddening_curve_list.begin(), reddening_curve_list.end()));
 
-  // Precompute the shifted transmissions
-  std::map<XYDataset::QualifiedName, FilterInfo>                      filter_map;
-  std::map<Euclid::XYDataset::QualifiedName, std::vector<FilterInfo>> shifted_transmissions;
-  PhzModeling::BuildFilterInfoFunctor                                 filter_info_functor;
+  // The filter variation coefficient calculators, integrating all the shifts at once
+  std::vector<FilterVariationCoefficientCalculator> calculators;
+  calculators.reserve(filter_name_list.size());
   for (auto& filter_name : filter_name_list) {
-    filter_map.emplace(filter_name, filter_info_functor(filter_dataset_map.at(filter_name)));
-
-    auto& precomputed_transmissions = shifted_transmissions[filter_name];
-    precomputed_transmissions.reserve(m_delta_lambda.size());
-    for (auto& dl : m_delta_lambda) {
-      auto shifted = filter_info_functor(shiftFilter(filter_dataset_map.at(filter_name), dl));
-      precomputed_transmissions.emplace_back(std::move(shifted));
-    }
+    calculators.emplace_back(filter_dataset_map.at(filter_name), m_delta_lambda);
   }
 
   // Define the functions and the algorithms based on the Functors
@@ -294,10 +268,6 @@ FilterVariationSingleGridCreator::createGrid(const PhzDataModel::ModelAxesTuple&
   // Create the photometry Grid
   auto correction_grid = PhzDataModel::PhotometryGrid(parameter_space, filter_name_list);
 
-  auto filter_functor = PhzModeling::ApplyFilterFunctor();
-  auto integrate_dataset_function =
-      PhzModeling::IntegrateLambdaTimeDatasetFunctor{MathUtils::InterpolationType::LINEAR};
-
   // Here we keep the futures for the threads we start so we can wait for them
   std::vector<std::future<void>> futures;
   std::atomic<size_t>            progress{0};
@@ -317,17 +287,15 @@ FilterVariationSingleGridCreator::createGrid(const PhzDataModel::ModelAxesTuple&
 
   for (size_t i = 0; i < threads; ++i) {
     std::advance(end_model_iter, step);
-    futures.push_back(std::async(std::launch::async,
-                                 ParallelJob(filter_name_shared_ptr, filter_map, shifted_transmissions, m_delta_lambda,
-                                             filter_functor, integrate_dataset_function, model_iter, end_model_iter,
-                                             correction_iter, progress, done_counter)));
+    futures.push_back(std::async(std::launch::async, ParallelJob(filter_name_shared_ptr, calculators, model_iter,
+                                                                 end_model_iter, correction_iter, progress,
+                                                                 done_counter)));
     model_iter = end_model_iter;
     std::advance(correction_iter, step);
   }
   futures.push_back(
-      std::async(std::launch::async, ParallelJob(filter_name_shared_ptr, filter_map, shifted_transmissions,
-                                                 m_delta_lambda, filter_functor, integrate_dataset_function, model_iter,
-                                                 model_grid.end(), correction_iter, progress, done_counter)));
+      std::async(std::launch::async, ParallelJob(filter_name_shared_ptr, calculators, model_iter, model_grid.end(),
+                                                 correction_iter, progress, done_counter)));
 
   // If we have a progress listener we create a thread to update it every .1 sec
   if (progress_listener) {
@@ -0,0 +1,136 @@
+/*
+ * Copyright (C) 2022 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file tests/src/FilterVariationCoefficientCalculator_test.cpp
+ * @date 2026/10/18
+ */
+
+#include <boost/test/unit_test.hpp>
+#include <vector>
+
+#include "MathUtils/regression/LinearRegression.h"
+#include "PhzFilterVariation/FilterVariationCoefficientCalculator.h"
+#include "PhzFilterVariation/FilterVariationSingleGridCreator.h"
+#include "PhzModeling/ApplyFilterFunctor.h"
+#include "PhzModeling/BuildFilterInfoFunctor.h"
+#include "PhzModeling/IntegrateLambdaTimeDatasetFunctor.h"
+#include "XYDataset/XYDataset.h"
+
+using namespace Euclid;
+using PhzFilterVariation::FilterVariationCoefficientCalculator;
+using PhzFilterVariation::FilterVariationSingleGridCreator;
+
+struct FilterVariationCoefficientCalculator_Fixture {
+  std::vector<double> lambda{};
+  std::vector<double> filter_val{};
+
+  FilterVariationCoefficientCalculator_Fixture() {
+    for (int index = 0; index < 701; ++index) {
+      lambda.push_back(5000 + index);
+      filter_val.push_back((index < 300 || index > 400) ? 0 : 1);
+    }
+  }
+
+  /// The coefficients computed filter by filter
+  std::vector<double> expectedTildCoefficients(const XYDataset::XYDataset& sed,
+                                               const std::vector<double>&  delta_lambda) {
+    PhzModeling::BuildFilterInfoFunctor   filter_info_functor;
+    auto                                  filter_dataset = XYDataset::XYDataset::factory(lambda, filter_val);
+    std::vector<PhzDataModel::FilterInfo> shifted_filter;
+    for (auto dl : delta_lambda) {
+      auto shifted = FilterVariationSingleGridCreator::shiftFilter(filter_dataset, dl);
+      shifted_filter.emplace_back(filter_info_functor(shifted));
+    }
+    return FilterVariationSingleGridCreator::compute_tild_coef(
+        sed, filter_info_functor(filter_dataset), shifted_filter, delta_lambda, PhzModeling::ApplyFilterFunctor{},
+        PhzModeling::IntegrateLambdaTimeDatasetFunctor{MathUtils::InterpolationType::LINEAR});
+  }
+};
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE(FilterVariationCoefficientCalculator_test)
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(coefficients_test, FilterVariationCoefficientCalculator_Fixture) {
+
+  // Given
+  std::vector<double> sed_val{};
+  for (int index = 0; index < 701; ++index) {
+    sed_val.push_back(index);
+  }
+  auto                sed = XYDataset::XYDataset::factory(lambda, sed_val);
+  std::vector<double> delta_lambda{-100, -10, 0, 10, 100};
+  FilterVariationCoefficientCalculator calculator{XYDataset::XYDataset::factory(lambda, filter_val), delta_lambda};
+
+  // When
+  std::vector<double> coefficients{};
+  calculator.computeCoefficients(sed, coefficients);
+
+  // Then
+  std::vector<double> expected{0.68796, 0.96781411, 1, 1.032406, 1.3340858};
+  BOOST_CHECK_EQUAL(coefficients.size(), expected.size());
+  for (size_t i = 0; i < expected.size(); ++i) {
+    BOOST_CHECK_CLOSE(coefficients[i], expected[i], 0.001);
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(sparse_sed_test, FilterVariationCoefficientCalculator_Fixture) {
+
+  // Given
+  auto sed = XYDataset::XYDataset::factory(std::vector<double>{5100, 5333.3, 5350.5, 5600.2},
+                                           std::vector<double>{1, 3, 2, 5});
+  std::vector<double> delta_lambda{-100, -10, -1, 0, 1, 10, 100};
+  FilterVariationCoefficientCalculator calculator{XYDataset::XYDataset::factory(lambda, filter_val), delta_lambda};
+
+  // When
+  auto regression = calculator(sed);
+
+  // Then
+  auto tild_coef = expectedTildCoefficients(sed, delta_lambda);
+  auto expected  = MathUtils::linearRegression(delta_lambda, tild_coef);
+  BOOST_CHECK_CLOSE(regression.first, expected.first, 0.01);
+  BOOST_CHECK_CLOSE(regression.second, expected.second, 0.01);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(sed_outside_filter_test, FilterVariationCoefficientCalculator_Fixture) {
+
+  // Given
+  auto sed = XYDataset::XYDataset::factory(std::vector<double>{1000, 2000}, std::vector<double>{1, 1});
+  std::vector<double> delta_lambda{-10, 0, 10};
+  FilterVariationCoefficientCalculator calculator{XYDataset::XYDataset::factory(lambda, filter_val), delta_lambda};
+
+  // When
+  std::vector<double> coefficients{};
+  calculator.computeCoefficients(sed, coefficients);
+
+  // Then
+  for (auto coef : coefficients) {
+    BOOST_CHECK_EQUAL(coef, 0.);
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END()
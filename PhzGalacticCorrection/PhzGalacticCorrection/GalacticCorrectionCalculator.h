@@ -21,30 +21,57 @@
 
 #include "MathUtils/function/Function.h"
 #include "PhzDataModel/FilterInfo.h"
-#include "PhzModeling/ApplyFilterFunctor.h"
-#include "PhzModeling/IntegrateDatasetFunctor.h"
 #include "SourceCatalog/SourceAttributes/Photometry.h"
 #include "XYDataset/XYDataset.h"
-#include <memory>
+#include <vector>
 
 namespace Euclid {
 namespace PhzGalacticCorrection {
 
+/**
+ * @class GalacticCorrectionCalculator
+ * @brief
+ * Computes for each filter the galactic absorption coefficient of a model,
+ * from its flux with and without the Milky Way reddening
+ * @details
+ * The product of each filter with the Milky Way reddening does not depend on
+ * the model, so it is tabulated once at construction, on the knots of the
+ * filter and of the reddening curve, next to the filter itself. The two fluxes
+ * of a model are then integrated (trapezoidal rule) in a single sweep over the
+ * merged knots of the model and of the tables.
+ */
 class GalacticCorrectionCalculator {
 public:
+  /**
+   * @brief Constructor
+   *
+   * @param filter_info_vector
+   * The filters, in the order of the computed coefficients
+   *
+   * @param red_dataset
+   * The Milky Way reddening curve
+   */
   GalacticCorrectionCalculator(std::vector<PhzDataModel::FilterInfo> const& filter_info_vector,
-                               PhzModeling::ApplyFilterFunctor const&       filter_functor,
-                               PhzModeling::IntegrateDatasetFunctor const&  integrate_functor,
                                XYDataset::XYDataset const&                  red_dataset);
 
+  /**
+   * @brief Computes the coefficients of the given model
+   * @details
+   * The coefficient of a filter where one of the fluxes is not positive is
+   * set to zero
+   */
   void operator()(XYDataset::XYDataset const& model, std::vector<double>& out) const;
 
 private:
-  std::unique_ptr<MathUtils::Function>         m_mw_reddening;
-  std::vector<PhzDataModel::FilterInfo> const& m_filter_info;
-  PhzModeling::ApplyFilterFunctor const&       m_filter_functor;
-  PhzModeling::IntegrateDatasetFunctor const&  m_integrate_functor;
-  std::pair<double, double>                    m_red_range;
+  /// A filter and its product with the Milky Way reddening, tabulated on the same knots
+  struct FilterTable {
+    std::pair<double, double> range;
+    std::vector<double>       knots;
+    std::vector<double>       transmission;
+    std::vector<double>       reddened_transmission;
+  };
+
+  std::vector<FilterTable> m_filter_tables;
 };
 
 }  // namespace PhzGalacticCorrection
@@ -17,9 +17,12 @@
  */
 
 #include "PhzGalacticCorrection/GalacticCorrectionCalculator.h"
+#include "MathUtils/function/Piecewise.h"
 #include "MathUtils/interpolation/interpolation.h"
 #include <ElementsKernel/Logging.h>
+#include <algorithm>
 #include <cmath>
+#include <iterator>
 
 using namespace Euclid::MathUtils;
 
@@ -38,27 +41,113 @@ static Euclid::XYDataset::XYDataset expDataSet(Euclid::XYDataset::XYDataset cons
   return Euclid::XYDataset::XYDataset(std::move(result));
 }
 
+/// Returns the knots of the given function within [min, max], if it is an interpolated one
+static std::vector<double> knotsInRange(const MathUtils::Function& function, double min, double max) {
+  auto piecewise = dynamic_cast<const MathUtils::PiecewiseBase*>(&function);
+  if (piecewise == nullptr) {
+    return {};
+  }
+  auto& knots = piecewise->getKnots();
+  auto  first = std::lower_bound(knots.begin(), knots.end(), min);
+  auto  last  = std::upper_bound(first, knots.end(), max);
+  return {first, last};
+}
+
 GalacticCorrectionCalculator::GalacticCorrectionCalculator(
-    const std::vector<PhzDataModel::FilterInfo>& filter_info_vector,
-    PhzModeling::ApplyFilterFunctor const&       filter_functor,
-    PhzModeling::IntegrateDatasetFunctor const& integrate_functor, XYDataset::XYDataset const& red_dataset)
-    : m_filter_info(filter_info_vector)
-    , m_filter_functor(filter_functor)
-    , m_integrate_functor(integrate_functor)
-    , m_red_range(red_dataset.front().first, red_dataset.back().first) {
-  m_mw_reddening = MathUtils::interpolate(expDataSet(red_dataset, -0.12), MathUtils::InterpolationType::LINEAR);
+    const std::vector<PhzDataModel::FilterInfo>& filter_info_vector, XYDataset::XYDataset const& red_dataset) {
+  auto   mw_reddening = MathUtils::interpolate(expDataSet(red_dataset, -0.12), MathUtils::InterpolationType::LINEAR);
+  double red_min      = red_dataset.front().first;
+  double red_max      = red_dataset.back().first;
+
+  for (auto& filter_info : filter_info_vector) {
+    FilterTable table{};
+    table.range = filter_info.getRange();
+
+    // The knots of the filter, the ones of the reddening curve and the range limits
+    auto filter_knots = knotsInRange(filter_info.getFilter(), table.range.first, table.range.second);
+    auto red_knots    = knotsInRange(*mw_reddening, table.range.first, table.range.second);
+    filter_knots.emplace_back(table.range.first);
+    filter_knots.emplace_back(table.range.second);
+    std::sort(filter_knots.begin(), filter_knots.end());
+    std::merge(filter_knots.begin(), filter_knots.end(), red_knots.begin(), red_knots.end(),
+               std::back_inserter(table.knots));
+    table.knots.erase(std::unique(table.knots.begin(), table.knots.end()), table.knots.end());
+
+    // Outside the reddening curve no flux is observed
+    filter_info.getFilter()(table.knots, table.transmission);
+    (*mw_reddening)(table.knots, table.reddened_transmission);
+    for (size_t i = 0; i < table.knots.size(); ++i) {
+      bool in_red_range = table.knots[i] >= red_min && table.knots[i] <= red_max;
+      table.reddened_transmission[i] = in_red_range ? table.reddened_transmission[i] * table.transmission[i] : 0.;
+    }
+    m_filter_tables.emplace_back(std::move(table));
+  }
 }
 
 void GalacticCorrectionCalculator::operator()(const XYDataset::XYDataset& model, std::vector<double>& out) const {
-  auto filter_iter = m_filter_info.begin();
-  for (auto corr_iter = out.begin(); corr_iter != out.end(); ++corr_iter, ++filter_iter) {
-    auto   x_filterd  = m_filter_functor(model, filter_iter->getRange(), filter_iter->getFilter());
-    double flux_int   = m_integrate_functor(x_filterd, filter_iter->getRange());
-    auto   x_reddened = m_filter_functor(x_filterd, m_red_range, *m_mw_reddening);
-    double flux_obs   = m_integrate_functor(x_reddened, filter_iter->getRange());
+  auto model_begin = model.begin();
+  auto model_end   = model.end();
+  auto compare     = [](const std::pair<double, double>& pair, double x) {
+    return pair.first < x;
+  };
 
-    double a_sed_x = 0.0;
+  auto corr_iter = out.begin();
+  for (auto table = m_filter_tables.begin(); table != m_filter_tables.end(); ++table, ++corr_iter) {
+    auto& knots = table->knots;
 
+    // Sweep the merged knots of the model and the table, accumulating both
+    // integrals with the trapezoidal rule. The model is zero outside its knots.
+    auto   model_iter = std::lower_bound(model_begin, model_end, table->range.first, compare);
+    size_t k          = 0;
+    double flux_int = 0., flux_obs = 0.;
+    double prev_x = 0., prev_int = 0., prev_obs = 0.;
+    bool   first  = true;
+    while (k < knots.size() || (model_iter != model_end && model_iter->first <= table->range.second)) {
+      bool   use_model = k == knots.size() || (model_iter != model_end && model_iter->first <= knots[k]);
+      double x         = use_model ? model_iter->first : knots[k];
+
+      // The model value at x
+      double sed = 0.;
+      if (model_iter != model_end && model_iter->first == x) {
+        sed = model_iter->second;
+      } else if (model_iter != model_begin && model_iter != model_end) {
+        auto prev = std::prev(model_iter);
+        sed       = prev->second +
+              (model_iter->second - prev->second) * (x - prev->first) / (model_iter->first - prev->first);
+      }
+
+      // The filter values at x
+      double transmission = 0., reddened = 0.;
+      if (k < knots.size() && knots[k] == x) {
+        transmission = table->transmission[k];
+        reddened     = table->reddened_transmission[k];
+      } else if (k > 0 && k < knots.size()) {
+        double w     = (x - knots[k - 1]) / (knots[k] - knots[k - 1]);
+        transmission = table->transmission[k - 1] + w * (table->transmission[k] - table->transmission[k - 1]);
+        reddened     = table->reddened_transmission[k - 1] +
+                   w * (table->reddened_transmission[k] - table->reddened_transmission[k - 1]);
+      }
+
+      double value_int = sed * transmission;
+      double value_obs = sed * reddened;
+      if (!first) {
+        flux_int += (x - prev_x) * (value_int + prev_int) / 2.;
+        flux_obs += (x - prev_x) * (value_obs + prev_obs) / 2.;
+      }
+      first    = false;
+      prev_x   = x;
+      prev_int = value_int;
+      prev_obs = value_obs;
+
+      if (model_iter != model_end && model_iter->first == x) {
+        ++model_iter;
+      }
+      if (k < knots.size() && knots[k] == x) {
+        ++k;
+      }
+    }
+
+    double a_sed_x = 0.0;
     // if the flux is not null we can compute the correction coef
     if (flux_obs > 0 && flux_int > 0) {
       a_sed_x = -5. * std::log10(flux_obs / flux_int) / 0.6;
@@ -46,7 +46,6 @@
 #include "PhzGalacticCorrection/GalacticCorrectionCalculator.h"
 #include "PhzModeling/ApplyFilterFunctor.h"
 #include "PhzModeling/BuildFilterInfoFunctor.h"
-#include "PhzModeling/IntegrateDatasetFunctor.h"
 
 namespace Euclid {
 namespace PhzGalacticCorrection {
@@ -141,14 +140,13 @@ class ParallelJob {
 
 public:
   ParallelJob(std::shared_ptr<std::vector<std::string>> filter_name_shared_ptr,
-              std::vector<PhzDataModel::FilterInfo>&    filter_info_vector,
-              PhzModeling::ApplyFilterFunctor& filter_functor, PhzModeling::IntegrateDatasetFunctor& integrate_funct,
-              XYDataset::XYDataset& red_dataset, PhzModeling::ModelDatasetGrid::iterator model_begin,
+              std::vector<PhzDataModel::FilterInfo>& filter_info_vector, XYDataset::XYDataset& red_dataset,
+              PhzModeling::ModelDatasetGrid::iterator         model_begin,
               PhzModeling::ModelDatasetGrid::iterator         model_end,
               typename PhzDataModel::PhotometryGrid::iterator correction_begin, std::atomic<size_t>& arg_progress,
               std::atomic<size_t>& done_counter)
       : m_filter_name_shared_ptr(filter_name_shared_ptr)
-      , m_correction_calculator(filter_info_vector, filter_functor, integrate_funct, red_dataset)
+      , m_correction_calculator(filter_info_vector, red_dataset)
       , m_model_begin(model_begin)
       , m_model_end(model_end)
       , m_correction_begin(correction_begin)
@@ -235,9 +233,6 @@ GalacticCorrectionSingleGridCreator::createGrid(const PhzDataModel::ModelAxesTup
                                 << ") is not found by the Reddening Curve provider.";
   }
 
-  auto filter_functor             = PhzModeling::ApplyFilterFunctor();
-  auto integrate_dataset_function = PhzModeling::IntegrateDatasetFunctor{MathUtils::InterpolationType::LINEAR};
-
   // Here we keep the futures for the threads we start so we can wait for them
   std::vector<std::future<void>> futures;
   std::atomic<size_t>            progress{0};
@@ -258,16 +253,16 @@ GalacticCorrectionSingleGridCreator::createGrid(const PhzDataModel::ModelAxesTup
   for (size_t i = 0; i < threads; ++i) {
     std::advance(end_model_iter, step);
     futures.push_back(
-        std::async(std::launch::async, ParallelJob(filter_name_shared_ptr, filter_info_vector, filter_functor,
-                                                   integrate_dataset_function, *milky_way_reddening, model_iter,
-                                                   end_model_iter, correction_iter, progress, done_counter)));
+        std::async(std::launch::async, ParallelJob(filter_name_shared_ptr, filter_info_vector, *milky_way_reddening,
+                                                   model_iter, end_model_iter, correction_iter, progress,
+                                                   done_counter)));
     model_iter = end_model_iter;
     std::advance(correction_iter, step);
   }
   futures.push_back(
-      std::async(std::launch::async, ParallelJob(filter_name_shared_ptr, filter_info_vector, filter_functor,
-                                                 integrate_dataset_function, *milky_way_reddening, model_iter,
-                                                 model_grid.end(), correction_iter, progress, done_counter)));
+      std::async(std::launch::async, ParallelJob(filter_name_shared_ptr, filter_info_vector, *milky_way_reddening,
+                                                 model_iter, model_grid.end(), correction_iter, progress,
+                                                 done_counter)));
 
   // If we have a progress listener we create a thread to update it every .1 sec
   if (progress_listener) {
@@ -0,0 +1,165 @@
+/*
+ * Copyright (C) 2022 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file tests/src/GalacticCorrectionCalculator_test.cpp
+ * @date 2026/10/18
+ */
+
+#include "PhzGalacticCorrection/GalacticCorrectionCalculator.h"
+#include "MathUtils/interpolation/interpolation.h"
+#include "PhzModeling/ApplyFilterFunctor.h"
+#include "PhzModeling/IntegrateDatasetFunctor.h"
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+
+using namespace Euclid;
+using Euclid::PhzGalacticCorrection::GalacticCorrectionCalculator;
+
+namespace {
+
+/// A filter with the given shape on knots every 10 Angstrom, zero at the range limits
+PhzDataModel::FilterInfo makeFilter(double min, double max, std::function<double(double)> shape) {
+  std::vector<std::pair<double, double>> values{};
+  for (double x = min; x <= max; x += 10.) {
+    values.emplace_back(x, (x == min || x == max) ? 0. : shape((x - min) / (max - min)));
+  }
+  auto filter = MathUtils::interpolate(XYDataset::XYDataset{std::move(values)}, MathUtils::InterpolationType::LINEAR);
+  return PhzDataModel::FilterInfo{{min, max}, *filter, 1.};
+}
+
+/// A model on knots every step Angstrom
+XYDataset::XYDataset makeModel(double step, std::function<double(double)> shape) {
+  std::vector<std::pair<double, double>> values{};
+  for (double x = 1000.; x <= 5000.; x += step) {
+    values.emplace_back(x, shape(x));
+  }
+  return XYDataset::XYDataset{std::move(values)};
+}
+
+/**
+ * The coefficients as they were computed before the reddened filters were
+ * tabulated: the model is filtered and integrated, then reddened and integrated again.
+ */
+std::vector<double> twoPassCoefficients(const std::vector<PhzDataModel::FilterInfo>& filters,
+                                        const XYDataset::XYDataset& reddening, const XYDataset::XYDataset& model) {
+  std::vector<std::pair<double, double>> mw_values{};
+  for (auto& pair : reddening) {
+    mw_values.emplace_back(pair.first, std::pow(10., -0.12 * pair.second));
+  }
+  auto mw_reddening = MathUtils::interpolate(XYDataset::XYDataset{std::move(mw_values)},
+                                             MathUtils::InterpolationType::LINEAR);
+  std::pair<double, double> red_range{reddening.front().first, reddening.back().first};
+
+  PhzModeling::ApplyFilterFunctor      filter_functor{};
+  PhzModeling::IntegrateDatasetFunctor integrate_functor{MathUtils::InterpolationType::LINEAR};
+
+  std::vector<double> coefficients{};
+  for (auto& filter : filters) {
+    auto   filtered = filter_functor(model, filter.getRange(), filter.getFilter());
+    double flux_int = integrate_functor(filtered, filter.getRange());
+    auto   reddened = filter_functor(filtered, red_range, *mw_reddening);
+    double flux_obs = integrate_functor(reddened, filter.getRange());
+    coefficients.emplace_back((flux_obs > 0 && flux_int > 0) ? -5. * std::log10(flux_obs / flux_int) / 0.6 : 0.);
+  }
+  return coefficients;
+}
+
+}  // namespace
+
+struct GalacticCorrectionCalculator_Fixture {
+
+  std::vector<PhzDataModel::FilterInfo> filters{
+      makeFilter(1500., 2500., [](double t) { return std::sin(M_PI * t); }),
+      makeFilter(2800., 3600., [](double t) { return std::min(1., 5. * std::min(t, 1. - t)); }),
+      makeFilter(3800., 4800., [](double) { return 1.; })};
+
+  // A smooth extinction curve, on knots every 50 Angstrom
+  XYDataset::XYDataset reddening{makeModel(50., [](double x) { return 1. + 4000. / x; })};
+
+  GalacticCorrectionCalculator calculator{filters, reddening};
+};
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE(GalacticCorrectionCalculator_test)
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(two_pass_test, GalacticCorrectionCalculator_Fixture) {
+  // Given
+  std::vector<XYDataset::XYDataset> models{
+      makeModel(1., [](double) { return 1.; }), makeModel(1., [](double x) { return std::pow(x / 1000., -2.); }),
+      makeModel(1., [](double x) { return 2. + std::sin(x / 30.); }),
+      makeModel(5., [](double x) { return std::exp(-(x - 3000.) * (x - 3000.) / 2E5); })};
+
+  for (auto& model : models) {
+    // When
+    std::vector<double> coefficients(filters.size());
+    calculator(model, coefficients);
+    auto expected = twoPassCoefficients(filters, reddening, model);
+
+    // Then
+    // The reddened filters are interpolated between the filter and reddening knots
+    // instead of at the model knots, which only changes the result by a small
+    // discretization term
+    for (std::size_t i = 0; i < filters.size(); ++i) {
+      BOOST_CHECK_GT(coefficients[i], 0.);
+      BOOST_CHECK_CLOSE(coefficients[i], expected[i], 1E-2);
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(coarse_model_test, GalacticCorrectionCalculator_Fixture) {
+  // Given
+  // The knots of the model do not match the ones of the filters and of the reddening curve
+  auto model = makeModel(37., [](double x) { return std::pow(x / 1000., -1.5); });
+
+  // When
+  std::vector<double> coefficients(filters.size());
+  calculator(model, coefficients);
+  auto expected = twoPassCoefficients(filters, reddening, model);
+
+  // Then
+  for (std::size_t i = 0; i < filters.size(); ++i) {
+    BOOST_CHECK_CLOSE(coefficients[i], expected[i], 1E-2);
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(outside_model_test, GalacticCorrectionCalculator_Fixture) {
+  // Given
+  XYDataset::XYDataset model{{{1000., 1.}, {1400., 1.}}};
+
+  // When
+  std::vector<double> coefficients(filters.size(), -1.);
+  calculator(model, coefficients);
+
+  // Then
+  for (std::size_t i = 0; i < filters.size(); ++i) {
+    BOOST_CHECK_EQUAL(coefficients[i], 0.);
+    BOOST_CHECK_EQUAL(twoPassCoefficients(filters, reddening, model)[i], 0.);
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END()
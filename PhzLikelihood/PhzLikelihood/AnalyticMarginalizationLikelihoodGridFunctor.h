@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2022 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file PhzLikelihood/AnalyticMarginalizationLikelihoodGridFunctor.h
+ * @date 2026/10/18
+ */
+
+#ifndef PHZLIKELIHOOD_ANALYTICMARGINALIZATIONLIKELIHOODGRIDFUNCTOR_H
+#define PHZLIKELIHOOD_ANALYTICMARGINALIZATIONLIKELIHOODGRIDFUNCTOR_H
+
+#include "PhzDataModel/DoubleGrid.h"
+#include "PhzDataModel/PhotometryGrid.h"
+#include "PhzDataModel/RegionResults.h"
+#include "SourceCatalog/SourceAttributes/Photometry.h"
+#include <functional>
+
+namespace Euclid {
+namespace PhzLikelihood {
+
+/**
+ * @class AnalyticMarginalizationLikelihoodGridFunctor
+ *
+ * @brief
+ * Calculates the grid with the logarithm of the likelihood of a source over a model photometry grid,
+ * marginalized over the scale factor
+ *
+ * @details
+ * As the chi square is quadratic in the scale factor, the likelihood is a Gaussian in alpha, centred on the
+ * best fitted scale factor and with the sigma of the scale factor. Its integral over alpha is then
+ * sqrt(2 pi) * sigma * exp(-chi2_min / 2), which is computed at the cost of a plain fit. For upper limits the
+ * likelihood is not exactly Gaussian and this is the Laplace approximation of the integral.
+ *
+ * The result is only meaningful if none of the priors depends on the scale factor: the priors see
+ * SAMPLE_SCALE_FACTOR set to false and use the best fitted scale factor.
+ */
+class AnalyticMarginalizationLikelihoodGridFunctor {
+
+public:
+  /**
+   * Definition of the STL-like algorithm computing, for every model, the natural logarithm of the likelihood
+   * at the best fitted scale factor, the scale factor and its sigma.
+   */
+  typedef std::function<void(
+      const SourceCatalog::Photometry& source_photometry, PhzDataModel::PhotometryGrid::const_iterator model_begin,
+      PhzDataModel::PhotometryGrid::const_iterator model_end, PhzDataModel::DoubleGrid::iterator likelihood_log_begin,
+      PhzDataModel::DoubleGrid::iterator scale_factor_begin,
+      PhzDataModel::DoubleGrid::iterator sigma_scale_factor_begin)>
+      LikelihoodSigmaLogarithmFunction;
+
+  /**
+   * Constructs a new AnalyticMarginalizationLikelihoodGridFunctor instance.
+   */
+  AnalyticMarginalizationLikelihoodGridFunctor(LikelihoodSigmaLogarithmFunction likelihood_log_func);
+
+  /**
+   * Computes the log likelihood of the given source photometry over the given photometry grid, marginalized
+   * over the scale factor. The given results object must already contain the MODEL_GRID_REFERENCE and
+   * SOURCE_PHOTOMETRY_REFERENCE objects. After the call, the results will contain the LIKELIHOOD_LOG_GRID,
+   * SCALE_FACTOR_GRID, SIGMA_SCALE_FACTOR_GRID and SAMPLE_SCALE_FACTOR (set to false)
+   *
+   * @param results
+   *    The results object to get the input and set the output
+   */
+  void operator()(PhzDataModel::RegionResults& results);
+
+private:
+  LikelihoodSigmaLogarithmFunction m_likelihood_log_func;
+};
+
+}  // end of namespace PhzLikelihood
+}  // end of namespace Euclid
+
+#endif /* PHZLIKELIHOOD_ANALYTICMARGINALIZATIONLIKELIHOODGRIDFUNCTOR_H */
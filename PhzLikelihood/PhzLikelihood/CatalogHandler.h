@@ -63,6 +63,9 @@ public:
    * @param marginalization_func_list
    *    The functions to use for marginalizing the multi-dimensional likelihood
    *    grid to a 1D PDFs
+   * @param catalog_filters
+   *    The filters of the source photometries, in the order of the catalog (see
+   *    SourcePhzFunctor::SourcePhzFunctor)
    * @throws ElementsException
    *    If the phot_corr_map does not contain photometric corrections for all
    *    the filters of the model photometries
@@ -73,7 +76,7 @@ public:
                  LikelihoodGridFunction likelihood_grid_func, double sampling_sigma_range,
                  std::vector<PriorFunction> priors, std::vector<MarginalizationFunction> marginalization_func_list,
                  std::vector<std::shared_ptr<PhzLikelihood::ProcessModelGridFunctor>> model_funct_list,
-                 bool                                                                 doNormalizePdf);
+                 bool doNormalizePdf, const std::vector<std::string>& catalog_filters = {});
 
   /**
    * Iterates through a set of sources and calculates the PHZ parameters for
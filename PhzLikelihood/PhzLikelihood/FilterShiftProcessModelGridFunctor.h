@@ -43,6 +43,10 @@ public:
   void operator()(const std::string& region_name, const SourceCatalog::Source& source,
                   PhzDataModel::PhotometryGrid& model_grid) const override;
 
+  /// Applies the coefficients extracted by the slicer from the ones of the region
+  void processSlice(const std::string& region_name, const SourceCatalog::Source& source,
+                    PhzDataModel::PhotometryGrid& model_slice, const GridSlicer& slicer) const override;
+
   static void computeCorrectedPhotometry(SourceCatalog::Photometry::const_iterator model_begin,
                                          SourceCatalog::Photometry::const_iterator model_end,
                                          SourceCatalog::Photometry::const_iterator corr_begin,
@@ -43,6 +43,10 @@ public:
   void operator()(const std::string& region_name, const SourceCatalog::Source& source,
                   PhzDataModel::PhotometryGrid& model_grid) const override;
 
+  /// Applies the coefficients extracted by the slicer from the ones of the region
+  void processSlice(const std::string& region_name, const SourceCatalog::Source& source,
+                    PhzDataModel::PhotometryGrid& model_slice, const GridSlicer& slicer) const override;
+
 protected:
   const std::map<std::string, PhzDataModel::PhotometryGrid>& m_coefficient_grid;
 
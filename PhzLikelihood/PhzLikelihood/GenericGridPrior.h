@@ -40,6 +40,9 @@ namespace PhzLikelihood {
  * coordinates with the prior grid given by the user. For convenience, the user
  * can give a set of grids to this class, so the class can be reused for many
  * different likelihood grids (in the case of sparse likelihood grid for example).
+ * A posterior grid which is a sub-grid of a prior grid, with each axis a
+ * contiguous range of the prior one (like the redshift slices of a
+ * neighbourhood of models), gets the values of the matching prior cells.
  */
 class GenericGridPrior {
 
@@ -9,6 +9,7 @@
 
 #include "SourceCatalog/SourceAttributes/Photometry.h"
 #include <functional>
+#include <memory>
 
 namespace Euclid {
 namespace PhzLikelihood {
@@ -112,6 +113,25 @@ public:
   void operator()(const SourceCatalog::Photometry& source_photometry, ModelIter model_begin, ModelIter model_end,
                   LikelihoodLogIter likelihood_begin, ScaleFactorIter scale_factor_begin) const;
 
+  /**
+   * Returns the source photometry with the filters in the order of the given model photometry. If the source
+   * photometry is already in this order it is returned as is. This is checked without comparing the names when it
+   * has been corrected with a PhzDataModel::FilterPlan, as it then shares the filter names of the grid. Otherwise a
+   * reordered copy is stored in the buffer and returned, with the filters missing from the source photometry set to
+   * MISSING_DATA.
+   *
+   * @param source_photometry
+   *    The photometry of the source
+   * @param model_photometry
+   *    A photometry of the models
+   * @param buffer
+   *    Where the reordered copy is stored, if there is a need for one
+   */
+  template <typename ModelPhotometry>
+  static const SourceCatalog::Photometry&
+  orderSourcePhotometry(const SourceCatalog::Photometry& source_photometry, const ModelPhotometry& model_photometry,
+                        std::unique_ptr<SourceCatalog::Photometry>& buffer);
+
 private:
   /**
    * @brief
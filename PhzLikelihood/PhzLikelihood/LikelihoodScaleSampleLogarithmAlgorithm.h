@@ -7,9 +7,11 @@
 #ifndef PHZLIKELIHOOD_LIKELIHOODSCALESAMPLELOGARITHMALGORITHM_H
 #define PHZLIKELIHOOD_LIKELIHOODSCALESAMPLELOGARITHMALGORITHM_H
 
+#include "PhzDataModel/ScaleFactorSampling.h"
 #include "PhzLikelihood/LikelihoodLogarithmAlgorithm.h"
 #include "SourceCatalog/SourceAttributes/Photometry.h"
 #include <functional>
+#include <memory>
 
 namespace Euclid {
 namespace PhzLikelihood {
@@ -70,6 +72,24 @@ public:
                                           LikelihoodLogarithmAlgorithm::LikelihoodLogarithmCalc likelihood_log_calc,
                                           size_t scale_sample_number, double scale_sample_range);
 
+  /**
+   * Constructs a new instance of LikelihoodLogarithmAlgorithm, with the samples of the scale factor taken
+   * as described by the given sampling (for example the nodes of a Gauss-Hermite quadrature).
+   */
+  LikelihoodScaleSampleLogarithmAlgorithm(LikelihoodLogarithmAlgorithm::ScaleFactorCalc         scale_factor_calc,
+                                          SigmaScaleFactorCalc                                  sigma_scale_factor_calc,
+                                          LikelihoodLogarithmAlgorithm::LikelihoodLogarithmCalc likelihood_log_calc,
+                                          PhzDataModel::ScaleFactorSampling                     sampling);
+
+  /**
+   * Constructs a new instance of LikelihoodLogarithmAlgorithm, for computing the likelihood, the scale factor
+   * and its sigma only, without the sampling of the scale factor. The sampling is then the single node of the
+   * Gauss-Hermite quadrature, at the best fitted scale factor.
+   */
+  LikelihoodScaleSampleLogarithmAlgorithm(LikelihoodLogarithmAlgorithm::ScaleFactorCalc         scale_factor_calc,
+                                          SigmaScaleFactorCalc                                  sigma_scale_factor_calc,
+                                          LikelihoodLogarithmAlgorithm::LikelihoodLogarithmCalc likelihood_log_calc);
+
   /**
    * Calculates the natural logarithm of the likelihood of a given source to fit
    * a set of models. The models are iterated by using the given iterator. They
@@ -107,7 +127,10 @@ public:
    *    be used as the sigma scale factor output
    * @param likelihood_log_sample_begin
    *    The iterator pointing at the first element of the collection which will
-   *    be used as the likelihood sampling for the different value of the scale parameter output
+   *    be used as the likelihood sampling for the different value of the scale parameter output.
+   *    Each element must already hold getScaleSampleNumber() samples.
+   * @throw Elements::Exception
+   *    If an element of the likelihood sampling output does not have getScaleSampleNumber() samples
    */
   template <typename ModelIter, typename LikelihoodLogIter, typename ScaleFactorIter, typename SigmaScaleFactorIter,
             typename LikelihoodSampleIter>
@@ -116,6 +139,25 @@ public:
                   SigmaScaleFactorIter sigma_scale_factor_begin,
                   LikelihoodSampleIter likelihood_log_sample_begin) const;
 
+  /**
+   * Same as above, without the sampling of the scale factor: only the likelihood logarithm at the best
+   * fitted scale factor, the scale factor and its sigma are computed.
+   */
+  template <typename ModelIter, typename LikelihoodLogIter, typename ScaleFactorIter, typename SigmaScaleFactorIter>
+  void operator()(const SourceCatalog::Photometry& source_photometry, ModelIter model_begin, ModelIter model_end,
+                  LikelihoodLogIter likelihood_log_begin, ScaleFactorIter scale_factor_begin,
+                  SigmaScaleFactorIter sigma_scale_factor_begin) const;
+
+  /**
+   * @return The number of samples in the scale factor dimension, after it has been made odd and at least 3
+   */
+  size_t getScaleSampleNumber() const;
+
+  /**
+   * @return Where the samples of the scale factor are taken
+   */
+  std::shared_ptr<const PhzDataModel::ScaleFactorSampling> getSampling() const;
+
 private:
   /**
    * @brief
@@ -137,15 +179,9 @@ private:
 
   /**
    * @brief
-   * The number of sample in the scale factor dimension.
-   */
-  size_t m_scale_sample_number;
-
-  /**
-   * @brief
-   * Range for the scaling factor sampling in unit of sigma.
+   * The position of the samples in the scale factor dimension.
    */
-  double m_scale_sample_range;
+  std::shared_ptr<const PhzDataModel::ScaleFactorSampling> m_sampling;
 };
 
 }  // end of namespace PhzLikelihood
@@ -49,6 +49,9 @@ public:
    * @param marginalization_func_list
    *    The functions to use for marginalizing the multi-dimensional likelihood
    *    grid to a 1D PDFs
+   * @param catalog_filters
+   *    The filters of the source photometries, in the order of the catalog (see
+   *    SourcePhzFunctor::SourcePhzFunctor)
    * @throws ElementsException
    *    If the phot_corr_map does not contain photometric corrections for all
    *    the filters of the model photometries
@@ -60,7 +63,8 @@ public:
                          std::vector<StaticPriorFunction>                                     static_priors,
                          std::vector<MarginalizationFunction>                                 marginalization_func_list,
                          std::vector<std::shared_ptr<PhzLikelihood::ProcessModelGridFunctor>> model_funct_list,
-                         bool                                                                 doNormalizePdf = true);
+                         bool                                                                 doNormalizePdf = true,
+                         const std::vector<std::string>& catalog_filters = {});
 
   virtual ~ParallelCatalogHandler();
 
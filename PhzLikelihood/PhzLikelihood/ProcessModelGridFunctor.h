@@ -27,6 +27,7 @@
 
 #include "PhzDataModel/PhotometryGrid.h"
 #include "SourceCatalog/Source.h"
+#include <functional>
 #include <map>
 #include <string>
 
@@ -35,8 +36,22 @@ namespace PhzLikelihood {
 
 class ProcessModelGridFunctor {
 public:
+  /// Extracts a subset of the models of a region grid
+  using GridSlicer = std::function<PhzDataModel::PhotometryGrid(const PhzDataModel::PhotometryGrid&)>;
+
   virtual void operator()(const std::string& region_name, const SourceCatalog::Source& source,
                           PhzDataModel::PhotometryGrid& model_grid) const = 0;
+
+  /**
+   * Processes the models extracted by the slicer from the grid of the region.
+   * The functors using per-model data of the region must extract it with the
+   * same slicer. By default the slice is processed as a full grid.
+   */
+  virtual void processSlice(const std::string& region_name, const SourceCatalog::Source& source,
+                            PhzDataModel::PhotometryGrid& model_slice, const GridSlicer&) const {
+    (*this)(region_name, source, model_slice);
+  }
+
   virtual ~ProcessModelGridFunctor() {}
 };
 
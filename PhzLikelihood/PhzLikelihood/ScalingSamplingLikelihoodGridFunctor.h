@@ -11,7 +11,10 @@
 #include "PhzDataModel/DoubleListGrid.h"
 #include "PhzDataModel/PhotometryGrid.h"
 #include "PhzDataModel/RegionResults.h"
+#include "PhzDataModel/ScaleFactorSampling.h"
+#include "PhzLikelihood/LikelihoodScaleSampleLogarithmAlgorithm.h"
 #include "SourceCatalog/SourceAttributes/Photometry.h"
+#include <memory>
 #include <tuple>
 
 namespace Euclid {
@@ -44,15 +47,24 @@ public:
 
   /**
    * Constructs a new LikelihoodGridFunctor instance.
+   * @param sampling
+   *    The sampling of the scale factor used by the function. It gives the number of samples of the
+   *    sampling grid and is stored in the results, for the priors and the scale factor estimation
    */
-  ScalingSamplingLikelihoodGridFunctor(LikelihoodScaleSampleLogarithmFunction likelihood_scale_sample_log_func);
+  ScalingSamplingLikelihoodGridFunctor(LikelihoodScaleSampleLogarithmFunction likelihood_scale_sample_log_func,
+                                       std::shared_ptr<const PhzDataModel::ScaleFactorSampling> sampling);
+
+  /**
+   * Constructs a new instance using a LikelihoodScaleSampleLogarithmAlgorithm, which gives the sampling
+   */
+  explicit ScalingSamplingLikelihoodGridFunctor(const LikelihoodScaleSampleLogarithmAlgorithm& algorithm);
 
   /**
    * Computes the log likelihood of the given source photometry over the given
    * photometry grid. The given results object must already contain the
    * MODEL_GRID_REFERENCE and SOURCE_PHOTOMETRY_REFERENCE objects. After the
    * call, the results will contain the LIKELIHOOD_GRID and SCALE_FACTOR_GRID,
-   * SIGMA_SCALE_FACTOR_GRID,  LIKELIHOOD_LOG_SCALING_GRID
+   * SIGMA_SCALE_FACTOR_GRID,  LIKELIHOOD_LOG_SCALING_GRID, SCALE_FACTOR_SAMPLING
    * and SAMPLE_SCALE_FACTOR (set to true) .
    *
    * @param results
@@ -61,7 +73,8 @@ public:
   void operator()(PhzDataModel::RegionResults& results);
 
 private:
-  LikelihoodScaleSampleLogarithmFunction m_likelihood_scale_sample_log_func;
+  LikelihoodScaleSampleLogarithmFunction                   m_likelihood_scale_sample_log_func;
+  std::shared_ptr<const PhzDataModel::ScaleFactorSampling> m_sampling;
 };
 
 }  // end of namespace PhzLikelihood
@@ -120,6 +120,22 @@ public:
    */
   void operator()(PhzDataModel::RegionResults& results) const;
 
+  /**
+   * Calculates only the likelihood and the posterior grids of a single model
+   * grid and finds their best fitted models, without computing any normalized
+   * grid or 1D PDF. The given results object must have set the same inputs as
+   * for the operator(). The following results are added:
+   * - LIKELIHOOD_LOG_GRID
+   * - POSTERIOR_LOG_GRID
+   * - SCALE_FACTOR_GRID
+   * - BEST_LIKELIHOOD_MODEL_ITERATOR
+   * - BEST_MODEL_ITERATOR
+   *
+   * @param results
+   *    The RegionResults object to add the results
+   */
+  void computeBestFit(PhzDataModel::RegionResults& results) const;
+
 private:
   std::vector<PriorFunction>           m_priors;
   std::vector<MarginalizationFunction> m_marginalization_func_list;
@@ -8,13 +8,16 @@
 #define PHZLIKELIHOOD_SOURCEPHZFUNCTOR_H
 
 #include "PhzDataModel/AdjustErrorParamMap.h"
+#include "PhzDataModel/FilterPlan.h"
 #include "PhzDataModel/PhotometricCorrectionMap.h"
+#include "PhzDataModel/ScaleFactorSampling.h"
 #include "PhzDataModel/SourceResults.h"
 #include "PhzLikelihood/SingleGridPhzFunctor.h"
 #include "SourceCatalog/Source.h"
 #include <map>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "PhzLikelihood/ChiSquareLikelihoodLogarithm.h"
@@ -46,6 +49,15 @@ public:
   using MarginalizationFunction = SingleGridPhzFunctor::MarginalizationFunction;
   using PriorFunction           = SingleGridPhzFunctor::PriorFunction;
 
+  /// A neighbourhood of models of a parameter space region, given as the
+  /// (inclusive) index ranges of its EBV, reddening curve and SED axes
+  struct ModelNeighbourhood {
+    std::string                         region;
+    std::pair<std::size_t, std::size_t> ebv_range;
+    std::pair<std::size_t, std::size_t> reddening_curve_range;
+    std::pair<std::size_t, std::size_t> sed_range;
+  };
+
   /**
    * Constructs a new SourcePhzFunctor instance. It gets as parameters a map
    * containing the photometric corrections,a map with the param for recomputing
@@ -70,6 +82,14 @@ public:
    *    The priors to apply to the likelihood
    * @param marginalization_func_list
    *    The functors to use for performing the PDF marginalizations
+   * @param catalog_filters
+   *    The filters of the source photometries, in the order of the catalog. If given, the correction of the source
+   *    photometries is done with a PhzDataModel::FilterPlan, resolved here, and the corrected photometries are in
+   *    the filter order of the model grids. All the sources must then have these filters, in this order.
+   *    Otherwise the filters are matched by name for each source.
+   * @throws Elements::Exception
+   *    If the catalog filters are given, and one of them is not in the model grids or has no photometric
+   *    correction or error adjustment parameters
    */
   SourcePhzFunctor(
       PhzDataModel::PhotometricCorrectionMap phot_corr_map, PhzDataModel::AdjustErrorParamMap adjust_error_param_map,
@@ -78,7 +98,7 @@ public:
       std::vector<MarginalizationFunction> marginalization_func_list =
           {BayesianMarginalizationFunctor<PhzDataModel::ModelParameter::Z>{PhzDataModel::GridType::POSTERIOR}},
       std::vector<std::shared_ptr<PhzLikelihood::ProcessModelGridFunctor>> model_funct_list = {},
-      bool                                                                 doNormalizePdf   = true);
+      bool doNormalizePdf = true, const std::vector<std::string>& catalog_filters = {});
 
   /**
    * Calculates the PHZ results for the given source photometry. The given
@@ -94,9 +114,73 @@ public:
    */
   PhzDataModel::SourceResults operator()(const SourceCatalog::Source& source) const;
 
+  /**
+   * Finds the best fitted model of a source with a known redshift. Only the
+   * models with the redshift nearest to the given one are fitted, in the
+   * regions covering it, and only their likelihood and posterior are computed.
+   * No PDF is computed and the best model scale factor is the best fitted one,
+   * even when the scale factor is sampled.
+   *
+   * @param source
+   *    The source object
+   * @param redshift
+   *    The redshift of the source
+   *
+   * @return
+   *    The results, containing the REGION_RESULTS_MAP, BEST_REGION,
+   *    BEST_MODEL_ITERATOR, BEST_MODEL_SCALE_FACTOR and BEST_MODEL_POSTERIOR_LOG
+   *
+   * @throws Elements::Exception
+   *    If the redshift is outside all the model grids
+   */
+  PhzDataModel::SourceResults computeBestFitAtRedshift(const SourceCatalog::Source& source, double redshift) const;
+
+  /**
+   * Finds the best fitted model of a source with a known redshift, as the
+   * computeBestFitAtRedshift(source, redshift) does, but fitting only the
+   * models of the given neighbourhood. The axes of the model grid referenced
+   * by the BEST_MODEL_ITERATOR are the ones of the neighbourhood, so its axis
+   * indices are relative to the first indices of the neighbourhood ranges.
+   * The models of the other regions are not fitted, so the results are the
+   * ones of the full fit only when no other region covers the redshift.
+   *
+   * @param source
+   *    The source object
+   * @param redshift
+   *    The redshift of the source
+   * @param neighbourhood
+   *    The models to fit
+   *
+   * @throws Elements::Exception
+   *    If the redshift is outside the model grid of the neighbourhood region
+   */
+  PhzDataModel::SourceResults computeBestFitAtRedshift(const SourceCatalog::Source& source, double redshift,
+                                                       const ModelNeighbourhood& neighbourhood) const;
+
   double computeMeanScaleFactor(double best_alpha, double n_sigma, const std::vector<double>& scale_sample) const;
 
+  /**
+   * Computes the mean of the scale factor with the quadrature weights of the given sampling
+   *
+   * @param best_alpha
+   *    The best fitted scale factor, around which the samples are taken
+   * @param sigma
+   *    The sigma of the scale factor
+   * @param sampling
+   *    Where the samples are taken
+   * @param scale_sample_log
+   *    The logarithm of the posterior for each sample
+   */
+  double computeMeanScaleFactor(double best_alpha, double sigma, const PhzDataModel::ScaleFactorSampling& sampling,
+                                const std::vector<double>& scale_sample_log) const;
+
 private:
+  /// Applies the photometric correction and the error recomputation to the photometry of a source
+  SourceCatalog::Photometry correctPhotometry(const SourceCatalog::Photometry& source_phot) const;
+
+  PhzDataModel::SourceResults fitAtRedshift(const SourceCatalog::Source& source, double redshift,
+                                            const ModelNeighbourhood* neighbourhood) const;
+
   PhzDataModel::PhotometricCorrectionMap                               m_phot_corr_map;
   PhzDataModel::AdjustErrorParamMap                                    m_adjust_error_param_map;
   const std::map<std::string, PhzDataModel::PhotometryGrid>&           m_phot_grid_map;
@@ -104,6 +188,7 @@ private:
   double                                                               m_sampling_sigma_range;
   std::vector<std::shared_ptr<PhzLikelihood::ProcessModelGridFunctor>> m_model_funct_list;
   bool                                                                 m_do_normalize_pdf;
+  std::shared_ptr<const PhzDataModel::FilterPlan>                      m_filter_plan;
 };
 
 }  // end of namespace PhzLikelihood
@@ -0,0 +1,64 @@
+/*
+ * Copyright (C) 2022 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file src/lib/AnalyticMarginalizationLikelihoodGridFunctor.cpp
+ * @date 2026/10/18
+ */
+
+#include "PhzLikelihood/AnalyticMarginalizationLikelihoodGridFunctor.h"
+#include <cmath>
+
+namespace Euclid {
+namespace PhzLikelihood {
+
+AnalyticMarginalizationLikelihoodGridFunctor::AnalyticMarginalizationLikelihoodGridFunctor(
+    LikelihoodSigmaLogarithmFunction likelihood_log_func)
+    : m_likelihood_log_func{std::move(likelihood_log_func)} {}
+
+void AnalyticMarginalizationLikelihoodGridFunctor::operator()(PhzDataModel::RegionResults& results) {
+  using ResType = PhzDataModel::RegionResultType;
+
+  // Get from the results the objects we need
+  auto& model_grid  = results.get<ResType::MODEL_GRID_REFERENCE>().get();
+  auto& source_phot = results.get<ResType::SOURCE_PHOTOMETRY_REFERENCE>().get();
+
+  // Create new likelihood and scale factor grids, with all cells set to 0
+  auto& likelihood_grid         = results.set<ResType::LIKELIHOOD_LOG_GRID>(model_grid.getAxesTuple());
+  auto& scale_factor_grid       = results.set<ResType::SCALE_FACTOR_GRID>(model_grid.getAxesTuple());
+  auto& sigma_scale_factor_grid = results.set<ResType::SIGMA_SCALE_FACTOR_GRID>(model_grid.getAxesTuple());
+  results.set<ResType::SAMPLE_SCALE_FACTOR>(false);
+
+  // Calculate the natural logarithm of the likelihood at the best fitted scale factor over the grid
+  m_likelihood_log_func(source_phot, model_grid.begin(), model_grid.end(), likelihood_grid.begin(),
+                        scale_factor_grid.begin(), sigma_scale_factor_grid.begin());
+
+  // Integrate the Gaussian over the scale factor. A model without a finite sigma (no flux in any of the
+  // observed bands) is left with the likelihood at the best fitted scale factor
+  const double log_sqrt_2_pi = 0.5 * std::log(2. * M_PI);
+  auto         sigma_it      = sigma_scale_factor_grid.begin();
+  for (auto likelihood_it = likelihood_grid.begin(); likelihood_it != likelihood_grid.end();
+       ++likelihood_it, ++sigma_it) {
+    if (std::isfinite(*sigma_it) && *sigma_it > 0) {
+      *likelihood_it += log_sqrt_2_pi + std::log(*sigma_it);
+    }
+  }
+}
+
+}  // end of namespace PhzLikelihood
+}  // end of namespace Euclid
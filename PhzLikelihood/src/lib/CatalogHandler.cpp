@@ -19,7 +19,7 @@ CatalogHandler::CatalogHandler(PhzDataModel::PhotometricCorrectionMap
                                std::vector<PriorFunction>           priors,
                                std::vector<MarginalizationFunction> marginalization_func_list,
                                std::vector<std::shared_ptr<PhzLikelihood::ProcessModelGridFunctor>> model_funct_list,
-                               bool                                                                 doNormalizePdf)
+                               bool doNormalizePdf, const std::vector<std::string>& catalog_filters)
     : m_source_phz_func{std::move(phot_corr_map),
                         std::move(adjust_error_param_map),
                         phot_grid_map,
@@ -28,7 +28,8 @@ CatalogHandler::CatalogHandler(PhzDataModel::PhotometricCorrectionMap
                         std::move(priors),
                         std::move(marginalization_func_list),
                         std::move(model_funct_list),
-                        doNormalizePdf} {}
+                        doNormalizePdf,
+                        catalog_filters} {}
 
 }  // end of namespace PhzLikelihood
 }  // end of namespace Euclid
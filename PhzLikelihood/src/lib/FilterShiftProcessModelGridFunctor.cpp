@@ -61,6 +61,29 @@ __attribute__((optimize("tree-vectorize"))) void FilterShiftProcessModelGridFunc
   }
 }
 
+static void applyCoefficients(const PhzDataModel::PhotometryGrid& coefficient_grid, const std::vector<double>& shifts,
+                              PhzDataModel::PhotometryGrid& model_grid) {
+  auto current_model  = model_grid.begin();
+  auto model_grid_end = model_grid.end();
+  auto current_corr   = coefficient_grid.begin();
+  auto current_result = model_grid.begin();
+  while (current_model != model_grid_end) {
+    FilterShiftProcessModelGridFunctor::computeCorrectedPhotometry(
+        (*current_model).begin(), (*current_model).end(), (*current_corr).begin(), shifts, current_result->begin());
+    ++current_model;
+    ++current_corr;
+    ++current_result;
+  }
+}
+
+static const std::vector<double>& sourceFilterShifts(const SourceCatalog::Source& source) {
+  auto observation_condition_ptr = source.getAttribute<PhzDataModel::ObservationCondition>();
+  if (observation_condition_ptr == NULL) {
+    throw Elements::Exception() << "The ObservationCondition attribute is missing in the source object";
+  }
+  return observation_condition_ptr->getFilterShifts();
+}
+
 FilterShiftProcessModelGridFunctor::FilterShiftProcessModelGridFunctor(
     const std::map<std::string, PhzDataModel::PhotometryGrid>& coefficient_grid)
     : m_coefficient_grid(coefficient_grid) {
@@ -69,24 +92,15 @@ FilterShiftProcessModelGridFunctor::FilterShiftProcessModelGridFunctor(
 
 void FilterShiftProcessModelGridFunctor::operator()(const std::string& region_name, const SourceCatalog::Source& source,
                                                     PhzDataModel::PhotometryGrid& model_grid) const {
-  auto observation_condition_ptr = source.getAttribute<PhzDataModel::ObservationCondition>();
-  if (observation_condition_ptr == NULL) {
-    throw Elements::Exception() << "The ObservationCondition attribute is missing in the source object";
-  }
-
-  const std::vector<double>& shifts = observation_condition_ptr->getFilterShifts();
+  applyCoefficients(m_coefficient_grid.at(region_name), sourceFilterShifts(source), model_grid);
+}
 
-  auto current_model  = model_grid.begin();
-  auto model_grid_end = model_grid.end();
-  auto current_corr   = m_coefficient_grid.at(region_name).begin();
-  auto current_result = model_grid.begin();
-  while (current_model != model_grid_end) {
-    computeCorrectedPhotometry((*current_model).begin(), (*current_model).end(), (*current_corr).begin(), shifts,
-                               current_result->begin());
-    ++current_model;
-    ++current_corr;
-    ++current_result;
-  }
+void FilterShiftProcessModelGridFunctor::processSlice(const std::string&            region_name,
+                                                      const SourceCatalog::Source&  source,
+                                                      PhzDataModel::PhotometryGrid& model_slice,
+                                                      const GridSlicer&             slicer) const {
+  auto& shifts = sourceFilterShifts(source);
+  applyCoefficients(slicer(m_coefficient_grid.at(region_name)), shifts, model_slice);
 }
 
 }  //  end of namespace PhzLikelihood
@@ -60,26 +60,11 @@ static void computeCorrectedPhotometry(SourceCatalog::Photometry::const_iterator
   }
 }
 
-GalacticAbsorptionProcessModelGridFunctor::GalacticAbsorptionProcessModelGridFunctor(
-    const std::map<std::string, PhzDataModel::PhotometryGrid>& coefficient_grid, double dust_map_sed_bpc)
-    : m_coefficient_grid(coefficient_grid), m_dust_map_sed_bpc{dust_map_sed_bpc} {
-  logger.debug() << "A GalacticAbsorptionProcessModelGridFunctor has been instantiated";
-}
-
-void GalacticAbsorptionProcessModelGridFunctor::operator()(const std::string&            region_name,
-                                                           const SourceCatalog::Source&  source,
-                                                           PhzDataModel::PhotometryGrid& model_grid) const {
-  auto dust_ebv_ptr = source.getAttribute<PhzDataModel::ObservationCondition>();
-
-  if (dust_ebv_ptr == NULL) {
-    throw Elements::Exception() << "The ObservationCondition attribute is missing in the source object";
-  }
-
-  double dust_ebv = m_dust_map_sed_bpc * dust_ebv_ptr->getDustColumnDensity();
-
+static void applyCoefficients(const PhzDataModel::PhotometryGrid& coefficient_grid, double dust_ebv,
+                              PhzDataModel::PhotometryGrid& model_grid) {
   auto current_model  = model_grid.begin();
   auto model_grid_end = model_grid.end();
-  auto current_corr   = m_coefficient_grid.at(region_name).begin();
+  auto current_corr   = coefficient_grid.begin();
   auto current_result = model_grid.begin();
   while (current_model != model_grid_end) {
 
@@ -91,5 +76,35 @@ void GalacticAbsorptionProcessModelGridFunctor::operator()(const std::string&
   }
 }
 
+static double sourceDustEbv(const SourceCatalog::Source& source, double dust_map_sed_bpc) {
+  auto dust_ebv_ptr = source.getAttribute<PhzDataModel::ObservationCondition>();
+
+  if (dust_ebv_ptr == NULL) {
+    throw Elements::Exception() << "The ObservationCondition attribute is missing in the source object";
+  }
+
+  return dust_map_sed_bpc * dust_ebv_ptr->getDustColumnDensity();
+}
+
+GalacticAbsorptionProcessModelGridFunctor::GalacticAbsorptionProcessModelGridFunctor(
+    const std::map<std::string, PhzDataModel::PhotometryGrid>& coefficient_grid, double dust_map_sed_bpc)
+    : m_coefficient_grid(coefficient_grid), m_dust_map_sed_bpc{dust_map_sed_bpc} {
+  logger.debug() << "A GalacticAbsorptionProcessModelGridFunctor has been instantiated";
+}
+
+void GalacticAbsorptionProcessModelGridFunctor::operator()(const std::string&            region_name,
+                                                           const SourceCatalog::Source&  source,
+                                                           PhzDataModel::PhotometryGrid& model_grid) const {
+  applyCoefficients(m_coefficient_grid.at(region_name), sourceDustEbv(source, m_dust_map_sed_bpc), model_grid);
+}
+
+void GalacticAbsorptionProcessModelGridFunctor::processSlice(const std::string&            region_name,
+                                                             const SourceCatalog::Source&  source,
+                                                             PhzDataModel::PhotometryGrid& model_slice,
+                                                             const GridSlicer&             slicer) const {
+  double dust_ebv = sourceDustEbv(source, m_dust_map_sed_bpc);
+  applyCoefficients(slicer(m_coefficient_grid.at(region_name)), dust_ebv, model_slice);
+}
+
 }  // end of namespace PhzLikelihood
 }  // end of namespace Euclid
@@ -25,12 +25,92 @@
 #include "PhzLikelihood/GenericGridPrior.h"
 #include "ElementsKernel/Exception.h"
 #include "PhzDataModel/PhzModel.h"
+#include <algorithm>
+#include <array>
 #include <cmath>
 #include <limits>
 
 namespace Euclid {
 namespace PhzLikelihood {
 
+namespace {
+
+/// Returns the index of the first node of the axis in the prior axis, if all
+/// its nodes are a contiguous range of the prior axis, or -1 otherwise
+template <typename Axis>
+int subAxisOffset(const Axis& prior_axis, const Axis& axis) {
+  for (std::size_t offset = 0; offset + axis.size() <= prior_axis.size(); ++offset) {
+    std::size_t i = 0;
+    while (i < axis.size() && prior_axis[offset + i] == axis[i]) {
+      ++i;
+    }
+    if (i == axis.size()) {
+      return static_cast<int>(offset);
+    }
+  }
+  return -1;
+}
+
+/// Returns the value of the prior grid for the cell of the sub-grid with the given offsets
+template <typename Iterator>
+double subGridPrior(const PhzDataModel::DoubleGrid& prior_grid, const std::array<int, 4>& offsets,
+                    const Iterator& iter) {
+  return prior_grid(offsets[0] + iter.template axisIndex<PhzDataModel::ModelParameter::Z>(),
+                    offsets[1] + iter.template axisIndex<PhzDataModel::ModelParameter::EBV>(),
+                    offsets[2] + iter.template axisIndex<PhzDataModel::ModelParameter::REDDENING_CURVE>(),
+                    offsets[3] + iter.template axisIndex<PhzDataModel::ModelParameter::SED>());
+}
+
+/*
+ * Applies the first prior grid of which the posterior grid is a sub-grid, like
+ * the ones of the models in the neighbourhood of a previous best fitted model.
+ * Returns false if there is no such prior grid.
+ */
+bool applySubGridPrior(const std::vector<PhzDataModel::DoubleGrid>& prior_grid_list,
+                       PhzDataModel::RegionResults&                 results) {
+  using PhzDataModel::ModelParameter;
+  auto&  posterior_grid = results.get<PhzDataModel::RegionResultType::POSTERIOR_LOG_GRID>();
+  double min_value      = std::exp(std::numeric_limits<double>::lowest());
+  for (auto& prior_grid : prior_grid_list) {
+    std::array<int, 4> offsets{
+        {subAxisOffset(prior_grid.getAxis<ModelParameter::Z>(), posterior_grid.getAxis<ModelParameter::Z>()),
+         subAxisOffset(prior_grid.getAxis<ModelParameter::EBV>(), posterior_grid.getAxis<ModelParameter::EBV>()),
+         subAxisOffset(prior_grid.getAxis<ModelParameter::REDDENING_CURVE>(),
+                       posterior_grid.getAxis<ModelParameter::REDDENING_CURVE>()),
+         subAxisOffset(prior_grid.getAxis<ModelParameter::SED>(), posterior_grid.getAxis<ModelParameter::SED>())}};
+    if (std::find(offsets.begin(), offsets.end(), -1) != offsets.end()) {
+      continue;
+    }
+
+    for (auto post_it = posterior_grid.begin(); post_it != posterior_grid.end(); ++post_it) {
+      double prior = subGridPrior(prior_grid, offsets, post_it);
+      if (prior <= min_value) {
+        *post_it = std::numeric_limits<double>::lowest();
+      } else {
+        *post_it += std::log(prior);
+      }
+    }
+
+    if (results.get<PhzDataModel::RegionResultType::SAMPLE_SCALE_FACTOR>()) {
+      auto& posterior_sampled_grid = results.get<PhzDataModel::RegionResultType::POSTERIOR_SCALING_LOG_GRID>();
+      for (auto post_it = posterior_sampled_grid.begin(); post_it != posterior_sampled_grid.end(); ++post_it) {
+        double prior = subGridPrior(prior_grid, offsets, post_it);
+        for (auto sample_iter = (*post_it).begin(); sample_iter != (*post_it).end(); ++sample_iter) {
+          if (prior <= min_value) {
+            *sample_iter = std::numeric_limits<double>::lowest();
+          } else {
+            *sample_iter += std::log(prior);
+          }
+        }
+      }
+    }
+    return true;
+  }
+  return false;
+}
+
+}  // namespace
+
 std::pair<bool, int> GenericGridPrior::checkCompatibility(const PhzDataModel::DoubleGrid& prior,
                                                           const PhzDataModel::DoubleGrid& posterior) const {
   if (prior.getAxesTuple() == posterior.getAxesTuple()) {
@@ -113,7 +193,7 @@ void GenericGridPrior::operator()(PhzDataModel::RegionResults& results) const {
         }
       }
     }
-  } else {
+  } else if (!applySubGridPrior(m_prior_grid_list, results)) {
     throw Elements::Exception() << "GenericGridPrior does not contain a prior grid "
                                 << "for handling the given likelihood grid";
   }
@@ -19,18 +19,43 @@ LikelihoodScaleSampleLogarithmAlgorithm::LikelihoodScaleSampleLogarithmAlgorithm
     double scale_sample_range)
     : m_scale_factor_calc{std::move(scale_factor_calc)}
     , m_sigma_scale_factor_calc{std::move(sigma_scale_factor_calc)}
-    , m_likelihood_log_calc{std::move(likelihood_log_calc)}
-    , m_scale_sample_number{scale_sample_number}
-    , m_scale_sample_range{scale_sample_range} {
-  if (m_scale_sample_number < 3) {
+    , m_likelihood_log_calc{std::move(likelihood_log_calc)} {
+  if (scale_sample_number < 3) {
     LikelihoodScaleSampleLogarithmAlgorithmlogger.warn() << "scale_sample_number parameter too small set to 3";
-    m_scale_sample_number = 3;
+    scale_sample_number = 3;
   }
 
-  if (m_scale_sample_number % 2 == 0) {
+  if (scale_sample_number % 2 == 0) {
     LikelihoodScaleSampleLogarithmAlgorithmlogger.warn() << "scale_sample_number parameter is even: raised by 1";
-    ++m_scale_sample_number;
+    ++scale_sample_number;
   }
+
+  m_sampling = std::make_shared<PhzDataModel::ScaleFactorSampling>(
+      PhzDataModel::ScaleFactorSampling::uniform(scale_sample_number, scale_sample_range));
+}
+
+LikelihoodScaleSampleLogarithmAlgorithm::LikelihoodScaleSampleLogarithmAlgorithm(
+    LikelihoodLogarithmAlgorithm::ScaleFactorCalc scale_factor_calc, SigmaScaleFactorCalc sigma_scale_factor_calc,
+    LikelihoodLogarithmAlgorithm::LikelihoodLogarithmCalc likelihood_log_calc,
+    PhzDataModel::ScaleFactorSampling                     sampling)
+    : m_scale_factor_calc{std::move(scale_factor_calc)}
+    , m_sigma_scale_factor_calc{std::move(sigma_scale_factor_calc)}
+    , m_likelihood_log_calc{std::move(likelihood_log_calc)}
+    , m_sampling{std::make_shared<PhzDataModel::ScaleFactorSampling>(std::move(sampling))} {}
+
+LikelihoodScaleSampleLogarithmAlgorithm::LikelihoodScaleSampleLogarithmAlgorithm(
+    LikelihoodLogarithmAlgorithm::ScaleFactorCalc scale_factor_calc, SigmaScaleFactorCalc sigma_scale_factor_calc,
+    LikelihoodLogarithmAlgorithm::LikelihoodLogarithmCalc likelihood_log_calc)
+    : LikelihoodScaleSampleLogarithmAlgorithm(std::move(scale_factor_calc), std::move(sigma_scale_factor_calc),
+                                              std::move(likelihood_log_calc),
+                                              PhzDataModel::ScaleFactorSampling::gaussHermite(1)) {}
+
+size_t LikelihoodScaleSampleLogarithmAlgorithm::getScaleSampleNumber() const {
+  return m_sampling->size();
+}
+
+std::shared_ptr<const PhzDataModel::ScaleFactorSampling> LikelihoodScaleSampleLogarithmAlgorithm::getSampling() const {
+  return m_sampling;
 }
 
 }  // end of namespace PhzLikelihood
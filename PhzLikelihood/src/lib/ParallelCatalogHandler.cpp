@@ -16,7 +16,8 @@ ParallelCatalogHandler::ParallelCatalogHandler(
     const std::map<std::string, PhzDataModel::PhotometryGrid>& phot_grid_map,
     LikelihoodGridFunction likelihood_grid_func, double sampling_sigma_range,
     std::vector<StaticPriorFunction> static_priors, std::vector<MarginalizationFunction> marginalization_func_list,
-    std::vector<std::shared_ptr<PhzLikelihood::ProcessModelGridFunctor>> model_funct_list, bool doNormalizePdf)
+    std::vector<std::shared_ptr<PhzLikelihood::ProcessModelGridFunctor>> model_funct_list, bool doNormalizePdf,
+    const std::vector<std::string>& catalog_filters)
     : m_catalog_handler{phot_corr_map,
                         adjust_error_param_map,
                         phot_grid_map,
@@ -25,7 +26,8 @@ ParallelCatalogHandler::ParallelCatalogHandler(
                         std::move(static_priors),
                         std::move(marginalization_func_list),
                         std::move(model_funct_list),
-                        doNormalizePdf} {}
+                        doNormalizePdf,
+                        catalog_filters} {}
 
 ParallelCatalogHandler::~ParallelCatalogHandler() {
   // The multithreaded job is done, so reset the stop threads flag
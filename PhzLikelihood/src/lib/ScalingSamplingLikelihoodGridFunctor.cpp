@@ -12,8 +12,14 @@ namespace Euclid {
 namespace PhzLikelihood {
 
 ScalingSamplingLikelihoodGridFunctor::ScalingSamplingLikelihoodGridFunctor(
-    LikelihoodScaleSampleLogarithmFunction likelihood_scale_sample_log_func)
-    : m_likelihood_scale_sample_log_func{std::move(likelihood_scale_sample_log_func)} {}
+    LikelihoodScaleSampleLogarithmFunction                   likelihood_scale_sample_log_func,
+    std::shared_ptr<const PhzDataModel::ScaleFactorSampling> sampling)
+    : m_likelihood_scale_sample_log_func{std::move(likelihood_scale_sample_log_func)}
+    , m_sampling{std::move(sampling)} {}
+
+ScalingSamplingLikelihoodGridFunctor::ScalingSamplingLikelihoodGridFunctor(
+    const LikelihoodScaleSampleLogarithmAlgorithm& algorithm)
+    : ScalingSamplingLikelihoodGridFunctor(algorithm, algorithm.getSampling()) {}
 
 void ScalingSamplingLikelihoodGridFunctor::operator()(PhzDataModel::RegionResults& results) {
   using ResType = PhzDataModel::RegionResultType;
@@ -24,10 +30,12 @@ void ScalingSamplingLikelihoodGridFunctor::operator()(PhzDataModel::RegionResult
 
   // Create new likelihood and scale factor grids, with all cells set to 0
   auto& likelihood_grid                = results.set<ResType::LIKELIHOOD_LOG_GRID>(model_grid.getAxesTuple());
-  auto& likelihood_scale_sampling_grid = results.set<ResType::LIKELIHOOD_SCALING_LOG_GRID>(model_grid.getAxesTuple());
+  auto& likelihood_scale_sampling_grid =
+      results.set<ResType::LIKELIHOOD_SCALING_LOG_GRID>(model_grid.getAxesTuple(), m_sampling->size());
   auto& scale_factor_grid              = results.set<ResType::SCALE_FACTOR_GRID>(model_grid.getAxesTuple());
   auto& sigma_scale_factor_grid        = results.set<ResType::SIGMA_SCALE_FACTOR_GRID>(model_grid.getAxesTuple());
   results.set<ResType::SAMPLE_SCALE_FACTOR>(true);
+  results.set<ResType::SCALE_FACTOR_SAMPLING>(m_sampling);
 
   // Calculate the natural logarithm of the likelihood over the grid
   m_likelihood_scale_sample_log_func(source_phot, model_grid.begin(), model_grid.end(), likelihood_grid.begin(),
@@ -18,7 +18,7 @@ SingleGridPhzFunctor::SingleGridPhzFunctor(std::vector<PriorFunction>
     , m_marginalization_func_list{std::move(marginalization_func_list)}
     , m_likelihood_func{std::move(likelihood_func)} {}
 
-void SingleGridPhzFunctor::operator()(PhzDataModel::RegionResults& results) const {
+void SingleGridPhzFunctor::computeBestFit(PhzDataModel::RegionResults& results) const {
 
   using ResType = PhzDataModel::RegionResultType;
 
@@ -32,9 +32,8 @@ void SingleGridPhzFunctor::operator()(PhzDataModel::RegionResults& results) cons
 
   if (results.get<ResType::SAMPLE_SCALE_FACTOR>()) {
     auto& likelihood_sampled_grid = results.get<ResType::LIKELIHOOD_SCALING_LOG_GRID>();
-    auto& posterior_sampled_grid =
-        results.set<ResType::POSTERIOR_SCALING_LOG_GRID>(likelihood_sampled_grid.getAxesTuple());
-    std::copy(likelihood_sampled_grid.begin(), likelihood_sampled_grid.end(), posterior_sampled_grid.begin());
+    results.set<ResType::POSTERIOR_SCALING_LOG_GRID>(likelihood_sampled_grid.getAxesTuple(),
+                                                     likelihood_sampled_grid.getCellManager());
   }
 
   // Find the likelihood best fitted model
@@ -48,6 +47,15 @@ void SingleGridPhzFunctor::operator()(PhzDataModel::RegionResults& results) cons
   // Find the best fitted model
   auto best_fit = std::max_element(posterior_grid.begin(), posterior_grid.end());
   results.set<ResType::BEST_MODEL_ITERATOR>(best_fit);
+}
+
+void SingleGridPhzFunctor::operator()(PhzDataModel::RegionResults& results) const {
+
+  using ResType = PhzDataModel::RegionResultType;
+
+  computeBestFit(results);
+  auto& likelihood_grid = results.get<ResType::LIKELIHOOD_LOG_GRID>();
+  auto& posterior_grid  = results.get<ResType::POSTERIOR_LOG_GRID>();
 
   // Calculate the 1D PDFs
   // First we have to produce a grid with the posterior not in log and
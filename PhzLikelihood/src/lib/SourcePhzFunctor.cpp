@@ -14,6 +14,8 @@
 #include "PhzDataModel/CatalogAttributes/FixedRedshift.h"
 #include "PhzDataModel/DoubleGrid.h"
 #include "PhzDataModel/Pdf1D.h"
+#include "PhzDataModel/PhotometryGrid.h"
+#include "PhzDataModel/ScaleFactorSampling.h"
 #include "PhzLikelihood/LikelihoodPdf1DTraits.h"
 #include "PhzLikelihood/Pdf1DTraits.h"
 #include "PhzLikelihood/ProcessModelGridFunctor.h"
@@ -23,6 +25,7 @@
 #include "SourceCatalog/SourceAttributes/Photometry.h"
 #include "XYDataset/XYDataset.h"
 #include <algorithm>
+#include <cmath>
 #include <limits>
 #include <memory>
 #include <numeric>
@@ -44,7 +47,8 @@ SourcePhzFunctor::SourcePhzFunctor(
     const std::map<std::string, PhzDataModel::PhotometryGrid>& phot_grid_map, LikelihoodGridFunction likelihood_func,
     double sampling_sigma_range, std::vector<PriorFunction> priors,
     std::vector<MarginalizationFunction>                                 marginalization_func_list,
-    std::vector<std::shared_ptr<PhzLikelihood::ProcessModelGridFunctor>> model_funct_list, bool doNormalizePdf)
+    std::vector<std::shared_ptr<PhzLikelihood::ProcessModelGridFunctor>> model_funct_list, bool doNormalizePdf,
+    const std::vector<std::string>& catalog_filters)
     : m_phot_corr_map{std::move(phot_corr_map)}
     , m_adjust_error_param_map{std::move(adjust_error_param_map)}
     , m_phot_grid_map(phot_grid_map)
@@ -57,6 +61,13 @@ SourcePhzFunctor::SourcePhzFunctor(
                                       std::forward_as_tuple(pair.first),
                                       std::forward_as_tuple(priors, marginalization_func_list, likelihood_func));
   }
+  // All the regions have the same filters, so the corrected photometry can be in their order. It shares the filter
+  // names of the grids, which lets the likelihood and the priors skip the filter matching
+  if (!catalog_filters.empty() && !phot_grid_map.empty()) {
+    m_filter_plan = std::make_shared<PhzDataModel::FilterPlan>(
+        catalog_filters, phot_grid_map.begin()->second.getCellManager().filterNamesPtr(), m_phot_corr_map,
+        m_adjust_error_param_map);
+  }
 }
 
 namespace {
@@ -339,6 +350,40 @@ combineLikelihood1DPdfs(const std::map<std::string, PhzDataModel::RegionResults>
   return combined_pdf;
 }
 
+/// Copies the models of the grid with the given redshift index and within the
+/// given EBV, reddening curve and SED index ranges to a grid with a single redshift
+PhzDataModel::PhotometryGrid redshiftSlice(const PhzDataModel::PhotometryGrid& grid, std::size_t z_index,
+                                           const SourcePhzFunctor::ModelNeighbourhood& range) {
+  auto& z_axis     = grid.getAxis<PhzDataModel::ModelParameter::Z>();
+  auto& ebv_axis   = grid.getAxis<PhzDataModel::ModelParameter::EBV>();
+  auto& curve_axis = grid.getAxis<PhzDataModel::ModelParameter::REDDENING_CURVE>();
+  auto& sed_axis   = grid.getAxis<PhzDataModel::ModelParameter::SED>();
+  PhzDataModel::PhotometryGrid slice{
+      PhzDataModel::createAxesTuple(
+          {z_axis[z_index]}, {ebv_axis.begin() + range.ebv_range.first, ebv_axis.begin() + range.ebv_range.second + 1},
+          {curve_axis.begin() + range.reddening_curve_range.first,
+           curve_axis.begin() + range.reddening_curve_range.second + 1},
+          {sed_axis.begin() + range.sed_range.first, sed_axis.begin() + range.sed_range.second + 1}),
+      grid.getCellManager().filterNamesPtr()};
+  for (auto slice_iter = slice.begin(); slice_iter != slice.end(); ++slice_iter) {
+    auto& model = grid(z_index, range.ebv_range.first + slice_iter.axisIndex<PhzDataModel::ModelParameter::EBV>(),
+                       range.reddening_curve_range.first +
+                           slice_iter.axisIndex<PhzDataModel::ModelParameter::REDDENING_CURVE>(),
+                       range.sed_range.first + slice_iter.axisIndex<PhzDataModel::ModelParameter::SED>());
+    *slice_iter = SourceCatalog::Photometry{model};
+  }
+  return slice;
+}
+
+/// Returns the neighbourhood containing all the models of the grid
+SourcePhzFunctor::ModelNeighbourhood fullNeighbourhood(const std::string&                  region,
+                                                       const PhzDataModel::PhotometryGrid& grid) {
+  return {region,
+          {0, grid.getAxis<PhzDataModel::ModelParameter::EBV>().size() - 1},
+          {0, grid.getAxis<PhzDataModel::ModelParameter::REDDENING_CURVE>().size() - 1},
+          {0, grid.getAxis<PhzDataModel::ModelParameter::SED>().size() - 1}};
+}
+
 }  // end of anonymous namespace
 
 double SourcePhzFunctor::computeMeanScaleFactor(double best_alpha, double n_sigma,
@@ -361,15 +406,42 @@ double SourcePhzFunctor::computeMeanScaleFactor(double best_alpha, double n_sigm
   return numerator / denominator;
 }
 
+double SourcePhzFunctor::computeMeanScaleFactor(double best_alpha, double sigma,
+                                                const PhzDataModel::ScaleFactorSampling& sampling,
+                                                const std::vector<double>&               scale_sample_log) const {
+  double max_log = *std::max_element(scale_sample_log.begin(), scale_sample_log.end());
+  if (!std::isfinite(max_log)) {
+    return best_alpha;
+  }
+
+  // The scale * sigma factor of the quadrature cancels out in the ratio
+  double numerator   = 0.;
+  double denominator = 0.;
+  for (size_t index = 0; index < sampling.size(); ++index) {
+    double weight = sampling.getWeights()[index] * std::exp(scale_sample_log[index] - max_log);
+    numerator += weight * sampling.getPosition(best_alpha, sigma, index);
+    denominator += weight;
+  }
+
+  return numerator / denominator;
+}
+
+SourceCatalog::Photometry SourcePhzFunctor::correctPhotometry(const SourceCatalog::Photometry& source_phot) const {
+  if (m_filter_plan != nullptr) {
+    std::vector<SourceCatalog::FluxErrorPair> fluxes{};
+    m_filter_plan->apply(source_phot, fluxes);
+    return {m_filter_plan->getFilterNames(), std::move(fluxes)};
+  }
+  auto cor_source_phot = applyPhotCorr(m_phot_corr_map, source_phot);
+  return adjustErrors(m_adjust_error_param_map, cor_source_phot);
+}
+
 PhzDataModel::SourceResults SourcePhzFunctor::operator()(const SourceCatalog::Source& source) const {
 
   auto source_phot_ptr = source.getAttribute<SourceCatalog::Photometry>();
 
-  // Apply the photometric correction to the given source photometry
-  auto cor_source_phot = applyPhotCorr(m_phot_corr_map, *source_phot_ptr);
-
-  // Apply the photometric error recomputation
-  cor_source_phot = adjustErrors(m_adjust_error_param_map, cor_source_phot);
+  // Apply the photometric correction and the error recomputation to the given source photometry
+  auto cor_source_phot = correctPhotometry(*source_phot_ptr);
 
   // Create a new results object
   PhzDataModel::SourceResults results{};
@@ -519,8 +591,18 @@ PhzDataModel::SourceResults SourcePhzFunctor::operator()(const SourceCatalog::So
     auto cel_sampled_it = best_region_results.get<RegResType::POSTERIOR_SCALING_LOG_GRID>().begin();
     cel_sampled_it.fixAllAxes(post_it);
 
-    results.set<ResType::BEST_MODEL_SCALE_FACTOR>(
-        computeMeanScaleFactor(*scale_it, (*signa_scale_it) * m_sampling_sigma_range, *cel_sampled_it));
+    // The Gauss-Hermite nodes are not evenly spaced, so the mean uses the quadrature weights
+    auto sampling = best_region_results.contains<RegResType::SCALE_FACTOR_SAMPLING>()
+                        ? best_region_results.get<RegResType::SCALE_FACTOR_SAMPLING>()
+                        : nullptr;
+    if (sampling && sampling->getMethod() == PhzDataModel::ScaleFactorSampling::Method::GAUSS_HERMITE) {
+      results.set<ResType::BEST_MODEL_SCALE_FACTOR>(computeMeanScaleFactor(
+          *scale_it, *signa_scale_it, *sampling, static_cast<std::vector<double>>(*cel_sampled_it)));
+    } else {
+      results.set<ResType::BEST_MODEL_SCALE_FACTOR>(
+          computeMeanScaleFactor(*scale_it, (*signa_scale_it) * m_sampling_sigma_range,
+                                 static_cast<std::vector<double>>(*cel_sampled_it)));
+    }
   } else {
     results.set<ResType::BEST_MODEL_SCALE_FACTOR>(*scale_it);
   }
@@ -534,5 +616,93 @@ PhzDataModel::SourceResults SourcePhzFunctor::operator()(const SourceCatalog::So
   return results;
 }
 
+PhzDataModel::SourceResults SourcePhzFunctor::computeBestFitAtRedshift(const SourceCatalog::Source& source,
+                                                                      double                       redshift) const {
+  return fitAtRedshift(source, redshift, nullptr);
+}
+
+PhzDataModel::SourceResults
+SourcePhzFunctor::computeBestFitAtRedshift(const SourceCatalog::Source& source, double redshift,
+                                           const ModelNeighbourhood& neighbourhood) const {
+  return fitAtRedshift(source, redshift, &neighbourhood);
+}
+
+PhzDataModel::SourceResults SourcePhzFunctor::fitAtRedshift(const SourceCatalog::Source& source, double redshift,
+                                                            const ModelNeighbourhood* neighbourhood) const {
+
+  auto source_phot_ptr = source.getAttribute<SourceCatalog::Photometry>();
+
+  // Apply the photometric correction and the error recomputation
+  auto cor_source_phot = correctPhotometry(*source_phot_ptr);
+
+  PhzDataModel::SourceResults results{};
+
+  // Fit only the models with the nearest redshift, of the regions covering it
+  auto& region_results_map = results.set<ResType::REGION_RESULTS_MAP>();
+  for (auto& pair : m_single_grid_functor_map) {
+    if (neighbourhood != nullptr && pair.first != neighbourhood->region) {
+      continue;
+    }
+    auto& model_grid = m_phot_grid_map.at(pair.first);
+    auto& z_axis     = model_grid.getAxis<PhzDataModel::ModelParameter::Z>();
+    if (redshift < z_axis[0] || redshift > z_axis[z_axis.size() - 1]) {
+      continue;
+    }
+    auto z_index = getFixedZIndex(z_axis, redshift);
+
+    auto& region_results = region_results_map[pair.first];
+    region_results.set<RegResType::SOURCE_PHOTOMETRY_REFERENCE>(std::cref(cor_source_phot));
+    region_results.set<RegResType::ORIGINAL_MODEL_GRID_REFERENCE>(model_grid);
+
+    // Only the models of the slice are processed, with the matching slice of
+    // the per-model data of the model grid functors
+    ModelNeighbourhood range = neighbourhood != nullptr ? *neighbourhood : fullNeighbourhood(pair.first, model_grid);
+    ProcessModelGridFunctor::GridSlicer slicer = [z_index, &range](const PhzDataModel::PhotometryGrid& grid) {
+      return redshiftSlice(grid, z_index, range);
+    };
+    auto& fixed_model_grid = region_results.set<RegResType::FIXED_REDSHIFT_MODEL_GRID>(slicer(model_grid));
+    for (auto functor_ptr : m_model_funct_list) {
+      functor_ptr->processSlice(pair.first, source, fixed_model_grid, slicer);
+    }
+    region_results.set<RegResType::MODEL_GRID_REFERENCE>(fixed_model_grid);
+
+    pair.second.computeBestFit(region_results);
+  }
+
+  if (region_results_map.empty()) {
+    throw Elements::Exception() << "The redshift " << redshift << " of the source with ID " << source.getId()
+                                << " is outside the model grids";
+  }
+
+  // Find the region which contains the model with the best posterior
+  std::string best_region       = region_results_map.begin()->first;
+  int         best_region_index = 0;
+  int         index             = 0;
+  double      best_posterior    = std::numeric_limits<double>::lowest();
+  for (auto& pair : region_results_map) {
+    auto& iter = pair.second.get<RegResType::BEST_MODEL_ITERATOR>();
+    if (*iter > best_posterior) {
+      best_region_index = index;
+      best_region       = pair.first;
+      best_posterior    = *iter;
+    }
+    ++index;
+  }
+  results.set<ResType::BEST_REGION>(best_region_index);
+
+  auto& best_region_results = region_results_map.at(best_region);
+  auto  post_it             = best_region_results.get<RegResType::BEST_MODEL_ITERATOR>();
+  auto  model_it            = best_region_results.get<RegResType::MODEL_GRID_REFERENCE>().get().begin();
+  model_it.fixAllAxes(post_it);
+  results.set<ResType::BEST_MODEL_ITERATOR>(model_it);
+
+  auto scale_it = best_region_results.get<RegResType::SCALE_FACTOR_GRID>().begin();
+  scale_it.fixAllAxes(post_it);
+  results.set<ResType::BEST_MODEL_SCALE_FACTOR>(*scale_it);
+  results.set<ResType::BEST_MODEL_POSTERIOR_LOG>(*post_it);
+
+  return results;
+}
+
 }  // end of namespace PhzLikelihood
 }  // end of namespace Euclid
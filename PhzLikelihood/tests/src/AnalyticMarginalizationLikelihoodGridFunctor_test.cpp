@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2022 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file tests/src/AnalyticMarginalizationLikelihoodGridFunctor_test.cpp
+ * @date 2026/10/18
+ */
+
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "PhzDataModel/RegionResults.h"
+#include "PhzLikelihood/AnalyticMarginalizationLikelihoodGridFunctor.h"
+#include "SourceCatalog/SourceAttributes/Photometry.h"
+
+using std::shared_ptr;
+using std::string;
+using std::vector;
+using namespace Euclid;
+using namespace Euclid::PhzLikelihood;
+
+struct AnalyticMarginalizationLikelihoodGridFunctor_Fixture {
+
+  vector<double>                   zs{0.0, 0.1};
+  vector<double>                   ebvs{0.0, 0.001};
+  vector<XYDataset::QualifiedName> reddeing_curves{{"reddeningCurves/Curve1"}};
+  vector<XYDataset::QualifiedName> seds{{"sed/Curve1"}};
+
+  shared_ptr<vector<string>> filters = shared_ptr<vector<string>>(new vector<string>{"filter_1", "filter_2"});
+  vector<SourceCatalog::FluxErrorPair> values_source{{0.1, 0.1}, {0.2, 0.1}};
+  SourceCatalog::Photometry            photometry_source{filters, values_source};
+
+  PhzDataModel::ModelAxesTuple axes = PhzDataModel::createAxesTuple(zs, ebvs, reddeing_curves, seds);
+  PhzDataModel::PhotometryGrid photo_grid{axes, *filters};
+
+  // The sigma of the scale factor of each model, the last two models can not be integrated
+  vector<double> sigmas{0.5, 2., 0., std::numeric_limits<double>::infinity()};
+
+  /// Stub of the algorithm, setting the likelihood to -1, the scale factor to 3 and the sigma from the vector
+  void stubAlgorithm(PhzDataModel::PhotometryGrid::const_iterator model,
+                     PhzDataModel::PhotometryGrid::const_iterator model_end,
+                     PhzDataModel::DoubleGrid::iterator likelihood_log, PhzDataModel::DoubleGrid::iterator scale_factor,
+                     PhzDataModel::DoubleGrid::iterator sigma) {
+    for (std::size_t i = 0; model != model_end; ++model, ++likelihood_log, ++scale_factor, ++sigma, ++i) {
+      *likelihood_log = -1.;
+      *scale_factor   = 3.;
+      *sigma          = sigmas[i];
+    }
+  }
+};
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE(AnalyticMarginalizationLikelihoodGridFunctor_test)
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(nominal_test, AnalyticMarginalizationLikelihoodGridFunctor_Fixture) {
+  using ResType = PhzDataModel::RegionResultType;
+
+  // Given
+  AnalyticMarginalizationLikelihoodGridFunctor functor{
+      [this](const SourceCatalog::Photometry&, PhzDataModel::PhotometryGrid::const_iterator model,
+             PhzDataModel::PhotometryGrid::const_iterator model_end, PhzDataModel::DoubleGrid::iterator likelihood,
+             PhzDataModel::DoubleGrid::iterator scale, PhzDataModel::DoubleGrid::iterator sigma) {
+        stubAlgorithm(model, model_end, likelihood, scale, sigma);
+      }};
+  PhzDataModel::RegionResults results{};
+  results.set<ResType::MODEL_GRID_REFERENCE>(photo_grid);
+  results.set<ResType::SOURCE_PHOTOMETRY_REFERENCE>(photometry_source);
+
+  // When
+  functor(results);
+
+  // Then
+  BOOST_CHECK(!results.get<ResType::SAMPLE_SCALE_FACTOR>());
+  auto& likelihood_grid = results.get<ResType::LIKELIHOOD_LOG_GRID>();
+  auto& scale_grid      = results.get<ResType::SCALE_FACTOR_GRID>();
+  auto& sigma_grid      = results.get<ResType::SIGMA_SCALE_FACTOR_GRID>();
+  BOOST_CHECK_EQUAL(likelihood_grid.size(), photo_grid.size());
+
+  // The integral of exp(-1) * exp(-(a - 3)^2 / (2 sigma^2)) over a is exp(-1) * sqrt(2 pi) * sigma
+  vector<double> expected{-1. + std::log(std::sqrt(2. * M_PI) * 0.5), -1. + std::log(std::sqrt(2. * M_PI) * 2.), -1.,
+                          -1.};
+  auto           sigma_it = sigma_grid.begin();
+  auto           scale_it = scale_grid.begin();
+  std::size_t    i        = 0;
+  for (auto likelihood_it = likelihood_grid.begin(); likelihood_it != likelihood_grid.end();
+       ++likelihood_it, ++sigma_it, ++scale_it, ++i) {
+    BOOST_CHECK_CLOSE(*likelihood_it, expected[i], 1E-8);
+    BOOST_CHECK_EQUAL(*scale_it, 3.);
+    BOOST_CHECK_EQUAL(*sigma_it, sigmas[i]);
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -24,6 +24,7 @@
 
 #include "PhzLikelihood/AxisFunctionPrior.h"
 
+#include <algorithm>
 #include <boost/test/unit_test.hpp>
 
 #include "XYDataset/QualifiedName.h"
@@ -116,14 +117,12 @@ BOOST_FIXTURE_TEST_CASE(sampled_scale_z_axis_prior, AxisFunctionPrior_Fixture) {
   // Given
   results.get<RegionResultType::SAMPLE_SCALE_FACTOR>() = true;
 
-  auto& posterior_sampled_grid = results.set<RegionResultType::POSTERIOR_SCALING_LOG_GRID>(axes);
+  auto& posterior_sampled_grid = results.set<RegionResultType::POSTERIOR_SCALING_LOG_GRID>(axes, 4);
   for (auto& l : posterior_grid) {
     l = 0.01;
   }
-  for (auto& v : posterior_sampled_grid) {
-    for (size_t index = 0; index < 4; ++index) {
-      v.push_back(0.01);
-    }
+  for (auto v : posterior_sampled_grid) {
+    std::fill(v.begin(), v.end(), 0.01);
   }
   AxisFunctionPrior<ModelParameter::Z> prior{std::unique_ptr<Function>{new MirrorFunction{}}};
 
@@ -130,4 +130,47 @@ BOOST_FIXTURE_TEST_CASE(test_nominal, GalacticAbsorptionProcessModelGridFunctor_
   }
 }
 
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(test_slice, GalacticAbsorptionProcessModelGridFunctor_Fixture) {
+  // Given
+  photo_grid.at(1, 1, 0, 0) = photometry_1;
+  corr_grid.at(1, 1, 0, 0) =
+      SourceCatalog::Photometry{filters, vector<SourceCatalog::FluxErrorPair>{{0.2, 0.}, {0.4, 0.}, {0.6, 0.}}};
+  std::map<std::string, PhzDataModel::PhotometryGrid> map_grid{};
+  map_grid.insert(std::pair<std::string, PhzDataModel::PhotometryGrid>("region_1", std::move(corr_grid)));
+
+  GalacticAbsorptionProcessModelGridFunctor functor(map_grid, 1.018);
+  std::string                               region = "region_1";
+
+  // The models with the second redshift
+  auto slicer = [this](const PhzDataModel::PhotometryGrid& grid) {
+    PhzDataModel::PhotometryGrid slice{PhzDataModel::createAxesTuple({zs[1]}, ebvs, reddeing_curves, seds), *filters};
+    for (size_t ebv_index = 0; ebv_index < ebvs.size(); ++ebv_index) {
+      slice.at(0, ebv_index, 0, 0) = SourceCatalog::Photometry{grid.at(1, ebv_index, 0, 0)};
+    }
+    return slice;
+  };
+
+  // When
+  PhzDataModel::PhotometryGrid full_grid(photo_grid.getAxesTuple(), *filters);
+  std::copy(photo_grid.begin(), photo_grid.end(), full_grid.begin());
+  functor(region, source_2, full_grid);
+  auto slice = slicer(photo_grid);
+  functor.processSlice(region, source_2, slice, slicer);
+
+  // Then
+  for (size_t ebv_index = 0; ebv_index < ebvs.size(); ++ebv_index) {
+    auto full_iter = full_grid.at(1, ebv_index, 0, 0).begin();
+    for (auto& iter : slice.at(0, ebv_index, 0, 0)) {
+      BOOST_CHECK_EQUAL(iter.flux, (*full_iter).flux);
+      ++full_iter;
+    }
+  }
+  // 1.1 * 10^(-0.4 * 0.2 * 0.1018)
+  BOOST_CHECK_CLOSE((*slice.at(0, 1, 0, 0).begin()).flux, 1.07955, 0.01);
+}
+
+//-----------------------------------------------------------------------------
+
 BOOST_AUTO_TEST_SUITE_END()
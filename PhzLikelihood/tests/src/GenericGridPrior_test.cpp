@@ -24,6 +24,7 @@
 
 #include "PhzLikelihood/GenericGridPrior.h"
 #include "XYDataset/QualifiedName.h"
+#include <algorithm>
 #include <boost/test/unit_test.hpp>
 #include <cmath>
 
@@ -103,14 +104,12 @@ BOOST_FIXTURE_TEST_CASE(sampled_prior_application, AxisFunctionPrior_Fixture) {
   // Given
   results.get<RegionResultType::SAMPLE_SCALE_FACTOR>() = true;
 
-  auto& posterior_sampled_grid = results.set<RegionResultType::POSTERIOR_SCALING_LOG_GRID>(axes);
+  auto& posterior_sampled_grid = results.set<RegionResultType::POSTERIOR_SCALING_LOG_GRID>(axes, 4);
   for (auto& l : posterior_grid) {
     l = 1.;
   }
-  for (auto& v : posterior_sampled_grid) {
-    for (size_t index = 0; index < 4; ++index) {
-      v.push_back(1.0);
-    }
+  for (auto v : posterior_sampled_grid) {
+    std::fill(v.begin(), v.end(), 1.0);
   }
 
   for (auto it = prior_grid.begin(); it != prior_grid.end(); ++it) {
@@ -164,6 +163,38 @@ BOOST_FIXTURE_TEST_CASE(sampled_prior_application, AxisFunctionPrior_Fixture) {
 
 //-----------------------------------------------------------------------------
 
+BOOST_FIXTURE_TEST_CASE(sub_grid_prior_application, AxisFunctionPrior_Fixture) {
+
+  // Given
+  // A posterior at a single redshift, for a range of the EBV and reddening curve axes
+  RegionResults sub_results{};
+  auto&         sub_posterior_grid = sub_results.set<RegionResultType::POSTERIOR_LOG_GRID>(
+      PhzDataModel::createAxesTuple({0.1}, {0.1, 0.2}, {XYDataset::QualifiedName{"red_curve2"}}, seds));
+  sub_results.set<RegionResultType::SAMPLE_SCALE_FACTOR>(false);
+  for (auto& l : sub_posterior_grid) {
+    l = 1.;
+  }
+  for (auto it = prior_grid.begin(); it != prior_grid.end(); ++it) {
+    *it = it.axisIndex<ModelParameter::SED>() + it.axisIndex<ModelParameter::REDDENING_CURVE>() +
+          it.axisIndex<ModelParameter::EBV>() + it.axisIndex<ModelParameter::Z>();
+  }
+  std::vector<DoubleGrid> prior_grid_list{};
+  prior_grid_list.emplace_back(std::move(dummy_prior_grid_1));
+  prior_grid_list.emplace_back(std::move(prior_grid));
+
+  // When
+  GenericGridPrior prior{std::move(prior_grid_list)};
+  prior(sub_results);
+
+  // Then
+  for (auto it = sub_posterior_grid.begin(); it != sub_posterior_grid.end(); ++it) {
+    double prior_value = it.axisIndex<ModelParameter::SED>() + 1 + it.axisIndex<ModelParameter::EBV>() + 1 + 1;
+    BOOST_CHECK_CLOSE(*it, std::log(prior_value) + 1., 0.0001);
+  }
+}
+
+//-----------------------------------------------------------------------------
+
 BOOST_FIXTURE_TEST_CASE(missing_prior_grid, AxisFunctionPrior_Fixture) {
 
   // Given
@@ -172,4 +172,35 @@ BOOST_FIXTURE_TEST_CASE(MissingSourcePhotometry, LikelihoodAlgorithmFixture) {
   }
 }
 
+//-----------------------------------------------------------------------------
+// Check that a source photometry sharing the filter names of the models, or
+// with the same filters, is used without a copy
+//-----------------------------------------------------------------------------
+BOOST_FIXTURE_TEST_CASE(OrderSourcePhotometry, LikelihoodAlgorithmFixture) {
+
+  // Given
+  SourceCatalog::Photometry source_phot_shared{model_filters, source_fluxes};
+  SourceCatalog::Photometry source_phot_unordered{
+      std::make_shared<std::vector<std::string>>(std::vector<std::string>{"Filter3", "Filter1", "Filter2"}),
+      std::vector<SourceCatalog::FluxErrorPair>{{3., 3.}, {1., 1.}, {2., 2.}}};
+  std::unique_ptr<SourceCatalog::Photometry> buffer;
+
+  // When
+  auto& shared    = PhzLikelihood::LikelihoodLogarithmAlgorithm::orderSourcePhotometry(source_phot_shared,
+                                                                                       model_phot_list[0], buffer);
+  auto& same      = PhzLikelihood::LikelihoodLogarithmAlgorithm::orderSourcePhotometry(source_phot,
+                                                                                       model_phot_list[0], buffer);
+  auto& unordered = PhzLikelihood::LikelihoodLogarithmAlgorithm::orderSourcePhotometry(source_phot_unordered,
+                                                                                       model_phot_list[0], buffer);
+
+  // Then
+  BOOST_CHECK(&shared == &source_phot_shared);
+  BOOST_CHECK(&same == &source_phot);
+  BOOST_CHECK(&unordered == buffer.get());
+  auto expected = source_fluxes.begin();
+  for (auto iter = unordered.begin(); iter != unordered.end(); ++iter, ++expected) {
+    BOOST_CHECK_EQUAL((*iter).flux, expected->flux);
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
@@ -9,6 +9,7 @@
 #include <string>
 #include <vector>
 
+#include "ElementsKernel/Exception.h"
 #include "ElementsKernel/Real.h"
 #include "PhzDataModel/PhotometricCorrectionMap.h"
 #include "PhzLikelihood/SourcePhzFunctor.h"
@@ -190,6 +191,38 @@ BOOST_FIXTURE_TEST_CASE(computeMeanScaleFactor, SourcePhzFunctor_Fixture) {
   BOOST_CHECK_CLOSE(0, functor.computeMeanScaleFactor(0, 3, sampling_1), 1E-3);
   BOOST_CHECK_CLOSE(10, functor.computeMeanScaleFactor(10, 3, sampling_1), 1E-3);
   BOOST_CHECK_CLOSE(10, functor.computeMeanScaleFactor(10, 10, sampling_1), 1E-3);
+
+  // With the nodes of a Gauss-Hermite quadrature, for a Gaussian posterior offset from the best alpha
+  auto                gauss_hermite = PhzDataModel::ScaleFactorSampling::gaussHermite(12);
+  std::vector<double> posterior_log{};
+  for (size_t index = 0; index < gauss_hermite.size(); ++index) {
+    double alpha = gauss_hermite.getPosition(10, 2, index);
+    posterior_log.push_back(-0.5 * (alpha - 11) * (alpha - 11) / 4 - 30);
+  }
+  BOOST_CHECK_CLOSE(11, functor.computeMeanScaleFactor(10, 2, gauss_hermite, posterior_log), 1E-3);
+}
+
+BOOST_FIXTURE_TEST_CASE(computeBestFitAtRedshift_test, SourcePhzFunctor_Fixture) {
+  // Given
+  PhzDataModel::PhotometryGrid slice_grid{PhzDataModel::createAxesTuple({0.1}, ebvs, reddeing_curves, seds),
+                                          *filters};
+  slice_grid(0, 0, 0, 0) = photometry_2;
+  slice_grid(0, 1, 0, 0) = photometry_4;
+  LikelihoodFunctionMock likelihood_function;
+  likelihood_function.expectFunctorCall(photometry_corrected, slice_grid);
+  std::map<std::string, PhzDataModel::PhotometryGrid> photo_grid_map{};
+  photo_grid_map.emplace(std::make_pair(std::string{""}, std::move(photo_grid)));
+  PhzLikelihood::SourcePhzFunctor functor(
+      correctionMap, error_param_null_map, photo_grid_map, likelihood_function.getFunctorObject(), 5, {},
+      {PhzLikelihood::SumMarginalizationFunctor<PhzDataModel::ModelParameter::Z>{PhzDataModel::GridType::POSTERIOR}});
+
+  // When
+  auto results = functor.computeBestFitAtRedshift(source, 0.08);
+
+  // Then
+  auto& best_model = results.get<ResType::BEST_MODEL_ITERATOR>();
+  BOOST_CHECK_CLOSE(best_model.axisValue<PhzDataModel::ModelParameter::Z>(), 0.1, 1E-8);
+  BOOST_CHECK_THROW(functor.computeBestFitAtRedshift(source, 0.5), Elements::Exception);
 }
 
 BOOST_AUTO_TEST_SUITE_END()
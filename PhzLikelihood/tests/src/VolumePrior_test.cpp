@@ -24,6 +24,7 @@
 
 #include "PhzLikelihood/VolumePrior.h"
 #include "XYDataset/QualifiedName.h"
+#include <algorithm>
 #include <boost/test/unit_test.hpp>
 
 using namespace Euclid;
@@ -115,14 +116,12 @@ BOOST_FIXTURE_TEST_CASE(priorSamplingValues, VolumePrior_Fixture) {
   // Given
   results.get<RegionResultType::SAMPLE_SCALE_FACTOR>() = true;
 
-  auto& posterior_sampled_grid = results.set<RegionResultType::POSTERIOR_SCALING_LOG_GRID>(axes);
+  auto& posterior_sampled_grid = results.set<RegionResultType::POSTERIOR_SCALING_LOG_GRID>(axes, 4);
   for (auto& l : posterior_grid) {
     l = 1.;
   }
-  for (auto& v : posterior_sampled_grid) {
-    for (size_t index = 0; index < 4; ++index) {
-      v.push_back(1.0);
-    }
+  for (auto v : posterior_sampled_grid) {
+    std::fill(v.begin(), v.end(), 1.0);
   }
   VolumePrior prior{cosmology, zs};
 
@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2022 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file PhzLuminosity/LuminosityFunctionTable.h
+ * @date 2026/10/18
+ */
+
+#ifndef PHZLUMINOSITY_PHZLUMINOSITY_LUMINOSITYFUNCTIONTABLE_H_
+#define PHZLUMINOSITY_PHZLUMINOSITY_LUMINOSITYFUNCTIONTABLE_H_
+
+#include "PhzDataModel/QualifiedNameGroupManager.h"
+#include "PhzLuminosity/LuminosityFunctionSet.h"
+#include "PhzLuminosity/SchechterLuminosityFunction.h"
+#include "XYDataset/QualifiedName.h"
+#include <algorithm>
+#include <vector>
+
+namespace Euclid {
+namespace PhzLuminosity {
+
+/**
+ * @class Euclid::PhzLuminosity::LuminosityFunctionTable
+ *
+ * @brief The luminosity function of every (SED, redshift) cell of a grid.
+ *
+ * @details The SED group of each SED and the luminosity function of each
+ * (group, redshift) pair are looked up once, when the table is built, so
+ * evaluating the luminosity function of a cell is a direct index. The
+ * Schechter functions are evaluated with SchechterLuminosityFunction::evaluate,
+ * the others value by value.
+ */
+class LuminosityFunctionTable {
+public:
+  /**
+   * @brief Constructor
+   *
+   * @param sed_group_manager
+   * The SED groups
+   *
+   * @param luminosity_function_set
+   * The luminosity functions. It must outlive the table.
+   *
+   * @param seds
+   * The SED axis of the grid
+   *
+   * @param zs
+   * The redshift axis of the grid
+   *
+   * @throw Elements::Exception
+   * If a SED is not in any group, or if a (group, redshift) pair has no luminosity function
+   */
+  LuminosityFunctionTable(const PhzDataModel::QualifiedNameGroupManager& sed_group_manager,
+                          const LuminosityFunctionSet& luminosity_function_set,
+                          std::vector<XYDataset::QualifiedName> seds, std::vector<double> zs);
+
+  /**
+   * @brief Check if the table has been built for the given axes
+   */
+  template <typename Axis_SED, typename Axis_Z>
+  bool matches(const Axis_SED& sed_axis, const Axis_Z& z_axis) const {
+    return sed_axis.size() == m_seds.size() && z_axis.size() == m_zs.size() &&
+           std::equal(z_axis.begin(), z_axis.end(), m_zs.begin()) &&
+           std::equal(sed_axis.begin(), sed_axis.end(), m_seds.begin());
+  }
+
+  /**
+   * @brief Evaluate the luminosity function of a cell on n luminosities
+   */
+  void operator()(size_t sed_index, size_t z_index, const double* luminosities, double* output, size_t n) const;
+
+private:
+  struct Entry {
+    const MathUtils::Function*         function;
+    const SchechterLuminosityFunction* schechter;
+  };
+
+  std::vector<XYDataset::QualifiedName> m_seds;
+  std::vector<double>                   m_zs;
+  std::vector<Entry>                    m_functions;
+  /// Index on m_functions of the function of each cell, with the SED as the slowest axis
+  std::vector<size_t> m_cell_functions;
+};
+
+}  // namespace PhzLuminosity
+}  // namespace Euclid
+
+#endif /* PHZLUMINOSITY_PHZLUMINOSITY_LUMINOSITYFUNCTIONTABLE_H_ */
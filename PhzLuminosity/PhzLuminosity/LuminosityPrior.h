@@ -27,7 +27,10 @@
 #define PHZLUMINOSITY_PHZLUMINOSITY_LUMINOSITYPRIOR_H_
 
 #include <PhzLuminosity/LuminosityFunctionSet.h>
+#include <PhzLuminosity/LuminosityFunctionTable.h>
 #include <memory>
+#include <mutex>
+#include <unordered_map>
 #include <vector>
 
 #include "PhysicsUtils/CosmologicalParameters.h"
@@ -35,6 +38,7 @@
 
 #include "PhzDataModel/DoubleGrid.h"
 #include "PhzDataModel/RegionResults.h"
+#include "PhzDataModel/ScaleFactorSampling.h"
 
 #include "PhzDataModel/QualifiedNameGroupManager.h"
 
@@ -50,19 +54,30 @@ public:
                                     const PhzDataModel::DoubleGrid& sigma_scale_factor_grid, bool in_mag,
                                     double solar_mag, double caling_sigma_range, const size_t sample_number);
 
+    /// Same as above, with the samples taken as described by the given sampling
+    LuminosityGroupSampledProcessor(PhzDataModel::DoubleListGrid&   prior_scal_grid,
+                                    const PhzDataModel::DoubleGrid& scale_factor_grid,
+                                    const PhzDataModel::DoubleGrid& sigma_scale_factor_grid, bool in_mag,
+                                    double solar_mag, PhzDataModel::ScaleFactorSampling sampling);
+
     void operator()(const std::function<double(double)>& luminosity_funct, size_t sed_index, size_t z_index);
 
+    /// Same as above, with all the samples of the cell evaluated at once
+    void operator()(const LuminosityFunctionTable& table, size_t sed_index, size_t z_index);
+
     double getMaxPrior() const;
 
   private:
-    PhzDataModel::DoubleListGrid&   m_prior_scal_grid;
-    const PhzDataModel::DoubleGrid& m_scale_factor_grid;
-    const PhzDataModel::DoubleGrid& m_sigma_scale_factor_grid;
-    const bool                      m_in_mag;
-    const double                    m_solar_mag;
-    const double                    m_scaling_sigma_range;
-    const size_t                    m_sample_number;
-    double                          m_max = 0.0;
+    PhzDataModel::DoubleListGrid&     m_prior_scal_grid;
+    const PhzDataModel::DoubleGrid&   m_scale_factor_grid;
+    const PhzDataModel::DoubleGrid&   m_sigma_scale_factor_grid;
+    const bool                        m_in_mag;
+    const double                      m_solar_mag;
+    PhzDataModel::ScaleFactorSampling m_sampling;
+    double                            m_max = 0.0;
+    std::vector<double>               m_luminosities{};
+    std::vector<double>               m_values{};
+    std::vector<double*>              m_cells{};
   };
 
   class LuminosityGroupdProcessor {
@@ -72,6 +87,9 @@ public:
 
     void operator()(const std::function<double(double)>& luminosity_funct, size_t sed_index, size_t z_index);
 
+    /// Same as above, with all the models of the cell evaluated at once
+    void operator()(const LuminosityFunctionTable& table, size_t sed_index, size_t z_index);
+
     double getMaxPrior() const;
 
   private:
@@ -80,6 +98,9 @@ public:
     const bool                      m_in_mag;
     const double                    m_solar_mag;
     double                          m_max = 0.0;
+    std::vector<double>             m_luminosities{};
+    std::vector<double>             m_values{};
+    std::vector<double*>            m_cells{};
   };
 
   LuminosityPrior(PhzDataModel::QualifiedNameGroupManager sedGroupManager, LuminosityFunctionSet luminosityFunctionSet,
@@ -111,6 +132,16 @@ private:
   const double                            m_scaling_sigma_range;
   const double                            m_solar_mag;
   const double                            m_effectiveness;
+
+  /// The tables are built for the first source of each region (or slice), and shared by all the threads.
+  /// They are keyed by the hash of their axes, and dropped when there are more than MAX_TABLES.
+  static constexpr size_t MAX_TABLES = 256;
+  mutable std::unordered_multimap<size_t, std::shared_ptr<const LuminosityFunctionTable>> m_tables{};
+  mutable std::mutex                                                                      m_tables_mutex{};
+
+  template <typename Axis_SED, typename Axis_Z>
+  std::shared_ptr<const LuminosityFunctionTable> getLuminosityFunctionTable(const Axis_SED& sed_axis,
+                                                                            const Axis_Z&   z_axis) const;
 };
 
 }  // namespace PhzLuminosity
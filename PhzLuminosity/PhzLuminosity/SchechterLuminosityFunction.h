@@ -52,6 +52,21 @@ public:
 
   void operator()(const std::vector<double>& xs, std::vector<double>& output) const override;
 
+  /**
+   * @brief Evaluate the function on an array of luminosities.
+   *
+   * @details The function is computed in log space, with a single exponential per value
+   * on top of the one for the magnitude (or the logarithm for the flux), and gives the
+   * same values as the functional call.
+   *
+   * @param luminosities
+   * The n Absolute Magnitudes/Fluxes
+   *
+   * @param output
+   * Where to write the n densities
+   */
+  void evaluate(const double* luminosities, double* output, std::size_t n) const;
+
   /**
    * Calculates the integral of the function in the range [a,b].
    * @param a The lower bound of the integration
@@ -0,0 +1,62 @@
+/*
+ * Copyright (C) 2022 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file src/lib/LuminosityFunctionTable.cpp
+ * @date 2026/10/18
+ */
+
+#include "PhzLuminosity/LuminosityFunctionTable.h"
+
+namespace Euclid {
+namespace PhzLuminosity {
+
+LuminosityFunctionTable::LuminosityFunctionTable(const PhzDataModel::QualifiedNameGroupManager& sed_group_manager,
+                                                 const LuminosityFunctionSet&                   luminosity_function_set,
+                                                 std::vector<XYDataset::QualifiedName> seds, std::vector<double> zs)
+    : m_seds(std::move(seds)), m_zs(std::move(zs)) {
+  auto& functions = luminosity_function_set.getFunctions();
+  for (auto& function : functions) {
+    m_functions.push_back(
+        Entry{function.second.get(), dynamic_cast<const SchechterLuminosityFunction*>(function.second.get())});
+  }
+
+  m_cell_functions.reserve(m_seds.size() * m_zs.size());
+  for (auto& sed : m_seds) {
+    auto& group_name = sed_group_manager.findGroupContaining(sed).first;
+    for (double z : m_zs) {
+      auto& function = luminosity_function_set.getLuminosityFunction(group_name, z);
+      m_cell_functions.push_back(&function - functions.data());
+    }
+  }
+}
+
+void LuminosityFunctionTable::operator()(size_t sed_index, size_t z_index, const double* luminosities, double* output,
+                                         size_t n) const {
+  auto& entry = m_functions[m_cell_functions[sed_index * m_zs.size() + z_index]];
+  if (entry.schechter) {
+    entry.schechter->evaluate(luminosities, output, n);
+  } else {
+    for (size_t i = 0; i < n; ++i) {
+      output[i] = (*entry.function)(luminosities[i]);
+    }
+  }
+}
+
+}  // namespace PhzLuminosity
+}  // namespace Euclid
@@ -30,6 +30,7 @@
 #include "PhzDataModel/RegionResults.h"
 #include <cmath>
 #include <functional>
+#include <string>
 #include <math.h>
 
 namespace Euclid {
@@ -37,6 +38,22 @@ namespace PhzLuminosity {
 
 static Elements::Logging logger = Elements::Logging::getLogger("LuminosityPrior");
 
+/// Returns a hash of the SED and redshift axes, which identifies the luminosity function table they need
+template <typename Axis_SED, typename Axis_Z>
+static size_t axesHash(const Axis_SED& sed_axis, const Axis_Z& z_axis) {
+  size_t hash    = 0;
+  auto   combine = [&hash](size_t value) {
+    hash ^= value + 0x9e3779b97f4a7c15 + (hash << 6) + (hash >> 2);
+  };
+  for (auto& sed : sed_axis) {
+    combine(std::hash<std::string>{}(sed.qualifiedName()));
+  }
+  for (double z : z_axis) {
+    combine(std::hash<double>{}(z));
+  }
+  return hash;
+}
+
 LuminosityPrior::LuminosityPrior(PhzDataModel::QualifiedNameGroupManager sedGroupManager,
                                  LuminosityFunctionSet luminosityFunctionSet, bool in_mag, double scaling_sigma_range,
                                  double solar_mag, double effectiveness)
@@ -51,13 +68,19 @@ LuminosityPrior::LuminosityGroupSampledProcessor::LuminosityGroupSampledProcesso
     PhzDataModel::DoubleListGrid& prior_scal_grid, const PhzDataModel::DoubleGrid& scale_factor_grid,
     const PhzDataModel::DoubleGrid& sigma_scale_factor_grid, bool in_mag, double solar_mag, double scaling_sigma_range,
     const size_t sample_number)
+    : LuminosityGroupSampledProcessor(prior_scal_grid, scale_factor_grid, sigma_scale_factor_grid, in_mag, solar_mag,
+                                      PhzDataModel::ScaleFactorSampling::uniform(sample_number, scaling_sigma_range)) {}
+
+LuminosityPrior::LuminosityGroupSampledProcessor::LuminosityGroupSampledProcessor(
+    PhzDataModel::DoubleListGrid& prior_scal_grid, const PhzDataModel::DoubleGrid& scale_factor_grid,
+    const PhzDataModel::DoubleGrid& sigma_scale_factor_grid, bool in_mag, double solar_mag,
+    PhzDataModel::ScaleFactorSampling sampling)
     : m_prior_scal_grid(prior_scal_grid)
     , m_scale_factor_grid(scale_factor_grid)
     , m_sigma_scale_factor_grid(sigma_scale_factor_grid)
     , m_in_mag(in_mag)
     , m_solar_mag(solar_mag)
-    , m_scaling_sigma_range(scaling_sigma_range)
-    , m_sample_number(sample_number) {}
+    , m_sampling(std::move(sampling)) {}
 
 double LuminosityPrior::LuminosityGroupSampledProcessor::getMaxPrior() const {
   return m_max;
@@ -78,10 +101,8 @@ void LuminosityPrior::LuminosityGroupSampledProcessor::operator()(const std::fun
   sigma_scal_iter.fixAxisByIndex<PhzDataModel::ModelParameter::Z>(z_index);
 
   while (prior_sample_iter != m_prior_scal_grid.end()) {
-    for (size_t lum_iter = 0; lum_iter < m_sample_number; ++lum_iter) {
-      double alpha      = *scal_iter;
-      double n_sigma    = m_scaling_sigma_range * (*sigma_scal_iter);
-      double luminosity = getLuminosityInSample(alpha, n_sigma, m_sample_number, lum_iter);
+    for (size_t lum_iter = 0; lum_iter < m_sampling.size(); ++lum_iter) {
+      double luminosity = m_sampling.getPosition(*scal_iter, *sigma_scal_iter, lum_iter);
       if (m_in_mag) {
         double ref = m_solar_mag;
         luminosity = getMagFromSolarLum(luminosity, ref);
@@ -103,6 +124,53 @@ void LuminosityPrior::LuminosityGroupSampledProcessor::operator()(const std::fun
   }
 }
 
+void LuminosityPrior::LuminosityGroupSampledProcessor::operator()(const LuminosityFunctionTable& table,
+                                                                  size_t sed_index, size_t z_index) {
+  auto prior_sample_iter = m_prior_scal_grid.begin();
+  prior_sample_iter.fixAxisByIndex<PhzDataModel::ModelParameter::SED>(sed_index);
+  prior_sample_iter.fixAxisByIndex<PhzDataModel::ModelParameter::Z>(z_index);
+
+  auto scal_iter = m_scale_factor_grid.begin();
+  scal_iter.fixAxisByIndex<PhzDataModel::ModelParameter::SED>(sed_index);
+  scal_iter.fixAxisByIndex<PhzDataModel::ModelParameter::Z>(z_index);
+
+  auto sigma_scal_iter = m_sigma_scale_factor_grid.begin();
+  sigma_scal_iter.fixAxisByIndex<PhzDataModel::ModelParameter::SED>(sed_index);
+  sigma_scal_iter.fixAxisByIndex<PhzDataModel::ModelParameter::Z>(z_index);
+
+  // Gather the luminosities of all the samples of the cell, so the function is evaluated on a dense array
+  m_luminosities.clear();
+  m_cells.clear();
+  while (prior_sample_iter != m_prior_scal_grid.end()) {
+    for (size_t lum_iter = 0; lum_iter < m_sampling.size(); ++lum_iter) {
+      double luminosity = m_sampling.getPosition(*scal_iter, *sigma_scal_iter, lum_iter);
+      if (m_in_mag) {
+        luminosity = getMagFromSolarLum(luminosity, m_solar_mag);
+      }
+
+      if (!std::isfinite(luminosity)) {
+        logger.debug() << "Undefined luminosity in the prior computation.";
+      } else {
+        m_luminosities.push_back(luminosity);
+        m_cells.push_back(&(*prior_sample_iter)[lum_iter]);
+      }
+    }
+
+    ++prior_sample_iter;
+    ++scal_iter;
+    ++sigma_scal_iter;
+  }
+
+  m_values.resize(m_luminosities.size());
+  table(sed_index, z_index, m_luminosities.data(), m_values.data(), m_values.size());
+  for (size_t i = 0; i < m_values.size(); ++i) {
+    *m_cells[i] = m_values[i];
+    if (m_values[i] > m_max) {
+      m_max = m_values[i];
+    }
+  }
+}
+
 LuminosityPrior::LuminosityGroupdProcessor::LuminosityGroupdProcessor(PhzDataModel::DoubleGrid&       prior_grid,
                                                                       const PhzDataModel::DoubleGrid& scale_factor_grid,
                                                                       bool in_mag, double solar_mag)
@@ -143,35 +211,77 @@ void LuminosityPrior::LuminosityGroupdProcessor::operator()(const std::function<
   }
 }
 
-template <typename Processor, typename Axis_SED, typename Axis_Z>
-double LuminosityPrior::fillTheGrid(Processor& processor, Axis_SED& sed_axis, Axis_Z& z_axis) const {
-  std::function<double(double)> luminosity_function{};
-  std::string                   current_sed_group{};
-  double                        current_min_z{};
-  double                        current_max_z{};
+void LuminosityPrior::LuminosityGroupdProcessor::operator()(const LuminosityFunctionTable& table, size_t sed_index,
+                                                            size_t z_index) {
+  auto prior_iter = m_prior_grid.begin();
+  prior_iter.fixAxisByIndex<PhzDataModel::ModelParameter::SED>(sed_index);
+  prior_iter.fixAxisByIndex<PhzDataModel::ModelParameter::Z>(z_index);
 
-  for (size_t sed_index = 0; sed_index < sed_axis.size(); ++sed_index) {
-    auto& sed = sed_axis[sed_index];
+  auto scal_iter = m_scale_factor_grid.begin();
+  scal_iter.fixAxisByIndex<PhzDataModel::ModelParameter::SED>(sed_index);
+  scal_iter.fixAxisByIndex<PhzDataModel::ModelParameter::Z>(z_index);
 
-    if (current_sed_group != m_sed_group_manager.findGroupContaining(sed).first) {
-      current_sed_group   = m_sed_group_manager.findGroupContaining(sed).first;
-      luminosity_function = std::function<double(double)>{};
+  // Gather the luminosities of all the models of the cell, so the function is evaluated on a dense array
+  m_luminosities.clear();
+  m_cells.clear();
+  while (prior_iter != m_prior_grid.end()) {
+    double luminosity = *scal_iter;
+    if (m_in_mag) {
+      luminosity = getMagFromSolarLum(luminosity, m_solar_mag);
     }
 
-    for (size_t z_index = 0; z_index < z_axis.size(); ++z_index) {
-      double z = z_axis[z_index];
+    if (!std::isfinite(luminosity)) {
+      logger.debug() << "Undefined luminosity in the prior computation.";
+    } else {
+      m_luminosities.push_back(luminosity);
+      m_cells.push_back(&(*prior_iter));
+    }
 
-      if (z < current_min_z || z >= current_max_z) {
-        luminosity_function = std::function<double(double)>{};
-      }
-      if (!luminosity_function) {
-        double (MathUtils::Function::*fptr)(double) const = &MathUtils::Function::operator();
-        luminosity_function =
-            std::bind(fptr, m_luminosity_function_set.getLuminosityFunction(current_sed_group, z).second.get(),
-                      std::placeholders::_1);
-      }
+    ++prior_iter;
+    ++scal_iter;
+  }
+
+  m_values.resize(m_luminosities.size());
+  table(sed_index, z_index, m_luminosities.data(), m_values.data(), m_values.size());
+  for (size_t i = 0; i < m_values.size(); ++i) {
+    *m_cells[i] = m_values[i];
+    if (m_values[i] > m_max) {
+      m_max = m_values[i];
+    }
+  }
+}
 
-      processor(luminosity_function, sed_index, z_index);
+template <typename Axis_SED, typename Axis_Z>
+std::shared_ptr<const LuminosityFunctionTable>
+LuminosityPrior::getLuminosityFunctionTable(const Axis_SED& sed_axis, const Axis_Z& z_axis) const {
+  size_t                      hash = axesHash(sed_axis, z_axis);
+  std::lock_guard<std::mutex> lock(m_tables_mutex);
+  auto                        candidates = m_tables.equal_range(hash);
+  for (auto i = candidates.first; i != candidates.second; ++i) {
+    if (i->second->matches(sed_axis, z_axis)) {
+      return i->second;
+    }
+  }
+  // The tables still used by other threads are kept alive by their shared pointers
+  if (m_tables.size() >= MAX_TABLES) {
+    m_tables.clear();
+  }
+  auto table = std::make_shared<const LuminosityFunctionTable>(
+      m_sed_group_manager, m_luminosity_function_set,
+      std::vector<XYDataset::QualifiedName>(sed_axis.begin(), sed_axis.end()),
+      std::vector<double>(z_axis.begin(), z_axis.end()));
+  m_tables.emplace(hash, table);
+  return table;
+}
+
+template <typename Processor, typename Axis_SED, typename Axis_Z>
+double LuminosityPrior::fillTheGrid(Processor& processor, Axis_SED& sed_axis, Axis_Z& z_axis) const {
+  // The SED groups and the luminosity functions are looked up once per region
+  auto table = getLuminosityFunctionTable(sed_axis, z_axis);
+
+  for (size_t sed_index = 0; sed_index < sed_axis.size(); ++sed_index) {
+    for (size_t z_index = 0; z_index < z_axis.size(); ++z_index) {
+      processor(*table, sed_index, z_index);
     }
   }
 
@@ -188,15 +298,8 @@ double LuminosityPrior::getLuminosityInSample(double alpha, double n_sigma, size
 
 PhzDataModel::DoubleListGrid
 LuminosityPrior::createListPriorGrid(const PhzDataModel::DoubleListGrid& posterior_grid) const {
-  PhzDataModel::DoubleListGrid prior_scal_grid{posterior_grid.getAxesTuple()};
-  size_t                       sample_number = (*(posterior_grid.begin())).size();
-  for (auto& cell_list : prior_scal_grid) {
-    for (size_t index = 0; index < sample_number; ++index) {
-      cell_list.push_back(0.0);
-    }
-  }
-
-  return prior_scal_grid;
+  // All the samples are initialized to 0
+  return PhzDataModel::DoubleListGrid{posterior_grid.getAxesTuple(), posterior_grid.getCellManager().sampleNumber()};
 }
 
 PhzDataModel::DoubleGrid LuminosityPrior::createPriorGrid(const PhzDataModel::DoubleGrid& posterior_grid) const {
@@ -215,8 +318,8 @@ void LuminosityPrior::applyEffectiveness(PhzDataModel::DoubleGrid& prior_grid, d
 }
 
 void LuminosityPrior::applySampleEffectiveness(PhzDataModel::DoubleListGrid& prior_grid, double max) const {
-  size_t sample_number = (*(prior_grid.begin())).size();
-  for (auto& v : prior_grid) {
+  size_t sample_number = prior_grid.getCellManager().sampleNumber();
+  for (auto v : prior_grid) {
     for (size_t cell_iter = 0; cell_iter < sample_number; ++cell_iter) {
       v[cell_iter] = max * (1 - m_effectiveness) + m_effectiveness * v[cell_iter];
     }
@@ -236,7 +339,7 @@ void LuminosityPrior::applyPrior(PhzDataModel::DoubleGrid& prior_grid, PhzDataMo
 
 void LuminosityPrior::applySamplePrior(PhzDataModel::DoubleListGrid& prior_grid,
                                        PhzDataModel::DoubleListGrid& posterior_grid) const {
-  size_t sample_number = (*(prior_grid.begin())).size();
+  size_t sample_number = prior_grid.getCellManager().sampleNumber();
   double min_value     = std::numeric_limits<double>::lowest();
   for (auto l_it = posterior_grid.begin(), p_it = prior_grid.begin(); l_it != posterior_grid.end(); ++l_it, ++p_it) {
     for (size_t cell_iter = 0; cell_iter < sample_number; ++cell_iter) {
@@ -260,12 +363,17 @@ void LuminosityPrior::operator()(PhzDataModel::RegionResults& results) const {
     auto&       sampled_posterior_grid  = results.get<PhzDataModel::RegionResultType::POSTERIOR_SCALING_LOG_GRID>();
     const auto& sigma_scale_factor_grid = results.get<PhzDataModel::RegionResultType::SIGMA_SCALE_FACTOR_GRID>();
 
-    size_t sample_number = (*(sampled_posterior_grid.begin())).size();
+    // The samples are taken where the likelihood function did. If it did not tell, they are evenly spaced
+    // in the configured range
+    size_t sample_number = sampled_posterior_grid.getCellManager().sampleNumber();
+    auto   sampling      = results.contains<PhzDataModel::RegionResultType::SCALE_FACTOR_SAMPLING>()
+                               ? *results.get<PhzDataModel::RegionResultType::SCALE_FACTOR_SAMPLING>()
+                               : PhzDataModel::ScaleFactorSampling::uniform(sample_number, m_scaling_sigma_range);
 
     // Create & fill the prior grid
     auto   prior_scal_grid = createListPriorGrid(sampled_posterior_grid);
     auto   sample_proc = LuminosityGroupSampledProcessor(prior_scal_grid, scale_factor_grid, sigma_scale_factor_grid,
-                                                         m_in_mag, m_solar_mag, m_scaling_sigma_range, sample_number);
+                                                         m_in_mag, m_solar_mag, std::move(sampling));
     auto&  z_axis      = sampled_posterior_grid.getAxis<PhzDataModel::ModelParameter::Z>();
     auto&  sed_axis    = sampled_posterior_grid.getAxis<PhzDataModel::ModelParameter::SED>();
     double max         = fillTheGrid(sample_proc, sed_axis, z_axis);
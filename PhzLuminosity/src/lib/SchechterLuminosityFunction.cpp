@@ -10,6 +10,7 @@
 #include "MathUtils/numericalIntegration/AdaptativeIntegration.h"
 #include "MathUtils/numericalIntegration/SimpsonsRule.h"
 #include <boost/math/special_functions/gamma.hpp>
+#include <algorithm>
 #include <cmath>
 
 using boost::math::tgamma;
@@ -80,6 +81,37 @@ void SchechterLuminosityFunction::operator()(const std::vector<double>& xs, std:
   std::transform(xs.begin(), xs.end(), output.begin(), std::cref(*this));
 }
 
+void SchechterLuminosityFunction::evaluate(const double* luminosities, double* output, std::size_t n) const {
+  // The logarithm of the normalization is only defined for a positive phi_star
+  if (!(m_phi_star > 0)) {
+    std::transform(luminosities, luminosities + n, output, std::cref(*this));
+    return;
+  }
+
+  if (m_in_mag) {
+    // phi(M) = 0.4 ln(10) phi_star exp((alpha + 1) u - exp(u)), with u = 0.4 ln(10) (M_star - M)
+    double log_norm = std::log(0.4 * std::log(10.) * m_phi_star);
+    double u_factor = 0.4 * std::log(10.);
+    for (std::size_t i = 0; i < n; ++i) {
+      double u  = u_factor * (m_mag_L_star - luminosities[i]);
+      output[i] = std::exp(log_norm + (m_alpha + 1) * u - std::exp(u));
+    }
+  } else {
+    // phi(L) = phi_star exp((alpha + 1) log(x) - x), with x = L / L_star
+    double log_norm = std::log(m_phi_star);
+    for (std::size_t i = 0; i < n; ++i) {
+      double x  = luminosities[i] / m_mag_L_star;
+      output[i] = (x > 0) ? std::exp(log_norm + (m_alpha + 1) * std::log(x) - x) : (*this)(luminosities[i]);
+    }
+  }
+
+  for (std::size_t i = 0; i < n; ++i) {
+    if (output[i] > 100) {
+      output[i] = 100;
+    }
+  }
+}
+
 std::unique_ptr<MathUtils::Function> SchechterLuminosityFunction::clone() const {
   return std::unique_ptr<MathUtils::Function>{
       new SchechterLuminosityFunction(this->m_phi_star, this->m_mag_L_star, this->m_alpha, this->m_in_mag)};
@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2022 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file tests/src/LuminosityFunctionTable_test.cpp
+ * @date 2026/10/18
+ */
+
+#include "PhzLuminosity/LuminosityFunctionTable.h"
+#include "ElementsKernel/Exception.h"
+#include "MathUtils/function/FunctionAdapter.h"
+#include <boost/test/unit_test.hpp>
+#include <memory>
+#include <utility>
+#include <vector>
+
+using namespace Euclid;
+
+struct LuminosityFunctionTable_Fixture {
+  PhzDataModel::QualifiedNameGroupManager::group_list_type groups{{"group_a", {{"sed_1"}, {"sed_2"}}},
+                                                                  {"group_b", {{"sed_3"}}}};
+  PhzDataModel::QualifiedNameGroupManager                  group_manager{groups};
+  PhzLuminosity::LuminosityFunctionSet                     function_set{createFunctions()};
+
+  static std::vector<std::pair<PhzLuminosity::LuminosityFunctionValidityDomain, std::unique_ptr<MathUtils::Function>>>
+  createFunctions() {
+    std::vector<std::pair<PhzLuminosity::LuminosityFunctionValidityDomain, std::unique_ptr<MathUtils::Function>>>
+        functions{};
+    functions.emplace_back(PhzLuminosity::LuminosityFunctionValidityDomain{"group_a", 0., 1.},
+                           std::unique_ptr<MathUtils::Function>{
+                               new PhzLuminosity::SchechterLuminosityFunction{0.5, -20., -1.2, true}});
+    functions.emplace_back(PhzLuminosity::LuminosityFunctionValidityDomain{"group_a", 1., 2.},
+                           std::unique_ptr<MathUtils::Function>{new MathUtils::FunctionAdapter{[](double x) {
+                             return 2. * x;
+                           }}});
+    functions.emplace_back(PhzLuminosity::LuminosityFunctionValidityDomain{"group_b", 0., 2.},
+                           std::unique_ptr<MathUtils::Function>{
+                               new PhzLuminosity::SchechterLuminosityFunction{0.1, -21., -0.5, true}});
+    return functions;
+  }
+};
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE(LuminosityFunctionTable_test)
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(evaluate_test, LuminosityFunctionTable_Fixture) {
+  std::vector<XYDataset::QualifiedName> seds{{"sed_1"}, {"sed_3"}, {"sed_2"}};
+  std::vector<double>                   zs{0.5, 1.5};
+  PhzLuminosity::LuminosityFunctionTable table{group_manager, function_set, seds, zs};
+
+  std::vector<double> mags{-22., -20., -18.};
+  std::vector<double> output(mags.size());
+  for (size_t sed_index = 0; sed_index < seds.size(); ++sed_index) {
+    auto& group = group_manager.findGroupContaining(seds[sed_index]).first;
+    for (size_t z_index = 0; z_index < zs.size(); ++z_index) {
+      auto& function = *function_set.getLuminosityFunction(group, zs[z_index]).second;
+      table(sed_index, z_index, mags.data(), output.data(), mags.size());
+      for (size_t i = 0; i < mags.size(); ++i) {
+        BOOST_CHECK_CLOSE(output[i], function(mags[i]), 1e-8);
+      }
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(matches_test, LuminosityFunctionTable_Fixture) {
+  std::vector<XYDataset::QualifiedName> seds{{"sed_1"}, {"sed_3"}};
+  std::vector<double>                   zs{0.5, 1.5};
+  PhzLuminosity::LuminosityFunctionTable table{group_manager, function_set, seds, zs};
+
+  BOOST_CHECK(table.matches(seds, zs));
+  BOOST_CHECK(!table.matches(std::vector<XYDataset::QualifiedName>{{"sed_1"}, {"sed_2"}}, zs));
+  BOOST_CHECK(!table.matches(seds, std::vector<double>{0.5, 1.}));
+  BOOST_CHECK(!table.matches(seds, std::vector<double>{0.5}));
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(missing_function_test, LuminosityFunctionTable_Fixture) {
+  std::vector<XYDataset::QualifiedName> seds{{"sed_1"}};
+  std::vector<XYDataset::QualifiedName> unknown_seds{{"sed_4"}};
+
+  // No function for this redshift, and no group for this SED
+  BOOST_CHECK_THROW((PhzLuminosity::LuminosityFunctionTable{group_manager, function_set, seds, {2.5}}),
+                    Elements::Exception);
+  BOOST_CHECK_THROW((PhzLuminosity::LuminosityFunctionTable{group_manager, function_set, unknown_seds, {0.5}}),
+                    Elements::Exception);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END()
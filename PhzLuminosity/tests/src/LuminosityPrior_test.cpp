@@ -14,6 +14,7 @@
 #include "MathUtils/function/Polynomial.h"
 #include "PhzLuminosity/LuminosityFunctionSet.h"
 #include "PhzLuminosity/LuminosityFunctionValidityDomain.h"
+#include <algorithm>
 #include <map>
 #include <memory>
 #include <set>
@@ -175,12 +176,7 @@ BOOST_AUTO_TEST_CASE(constructor) {
   std::vector<XYDataset::QualifiedName> seds{{"sed1"}};
   PhzDataModel::ModelAxesTuple          axes = PhzDataModel::createAxesTuple(zs, ebvs, reddeing_curves, seds);
 
-  PhzDataModel::DoubleListGrid posterior_grid{axes};
-  for (auto iter = posterior_grid.begin(); iter != posterior_grid.end(); ++iter) {
-    for (size_t index = 0; index < 4; ++index) {
-      (*iter).push_back(0.0);
-    }
-  }
+  PhzDataModel::DoubleListGrid posterior_grid{axes, 4};
   PhzDataModel::DoubleGrid scale_factor_grid{axes};
   PhzDataModel::DoubleGrid sigma_scale_factor_grid{axes};
 
@@ -200,12 +196,7 @@ BOOST_AUTO_TEST_CASE(operator_function) {
   std::vector<XYDataset::QualifiedName> seds{{"sed1"}, {"sed2"}};
   PhzDataModel::ModelAxesTuple          axes = PhzDataModel::createAxesTuple(zs, ebvs, reddeing_curves, seds);
 
-  PhzDataModel::DoubleListGrid prior_grid{axes};
-  for (auto iter = prior_grid.begin(); iter != prior_grid.end(); ++iter) {
-    for (size_t index = 0; index < 4; ++index) {
-      (*iter).push_back(0.0);
-    }
-  }
+  PhzDataModel::DoubleListGrid prior_grid{axes, 4};
   PhzDataModel::DoubleGrid scale_factor_grid{axes};
   PhzDataModel::DoubleGrid sigma_scale_factor_grid{axes};
 
@@ -235,12 +226,7 @@ BOOST_AUTO_TEST_CASE(operator_function_flux) {
   std::vector<XYDataset::QualifiedName> seds{{"sed1"}, {"sed2"}};
   PhzDataModel::ModelAxesTuple          axes = PhzDataModel::createAxesTuple(zs, ebvs, reddeing_curves, seds);
 
-  PhzDataModel::DoubleListGrid prior_grid{axes};
-  for (auto iter = prior_grid.begin(); iter != prior_grid.end(); ++iter) {
-    for (size_t index = 0; index < 4; ++index) {
-      (*iter).push_back(0.0);
-    }
-  }
+  PhzDataModel::DoubleListGrid prior_grid{axes, 4};
   PhzDataModel::DoubleGrid scale_factor_grid{axes};
 
   auto scale_iter = scale_factor_grid.begin();
@@ -298,12 +284,7 @@ BOOST_AUTO_TEST_CASE(operator_function_mag) {
   std::vector<XYDataset::QualifiedName> seds{{"sed1"}, {"sed2"}};
   PhzDataModel::ModelAxesTuple          axes = PhzDataModel::createAxesTuple(zs, ebvs, reddeing_curves, seds);
 
-  PhzDataModel::DoubleListGrid prior_grid{axes};
-  for (auto iter = prior_grid.begin(); iter != prior_grid.end(); ++iter) {
-    for (size_t index = 0; index < 4; ++index) {
-      (*iter).push_back(0.0);
-    }
-  }
+  PhzDataModel::DoubleListGrid prior_grid{axes, 4};
   PhzDataModel::DoubleGrid scale_factor_grid{axes};
 
   auto scale_iter = scale_factor_grid.begin();
@@ -429,11 +410,9 @@ BOOST_AUTO_TEST_CASE(createListPriorGrid) {
   std::vector<XYDataset::QualifiedName> seds{{"sed1"}, {"sed2"}};
   PhzDataModel::ModelAxesTuple          axes = PhzDataModel::createAxesTuple(zs, ebvs, reddeing_curves, seds);
 
-  PhzDataModel::DoubleListGrid posterior_grid{axes};
-  for (auto iter = posterior_grid.begin(); iter != posterior_grid.end(); ++iter) {
-    for (size_t index = 0; index < 4; ++index) {
-      (*iter).push_back(1.1);
-    }
+  PhzDataModel::DoubleListGrid posterior_grid{axes, 4};
+  for (auto cell : posterior_grid) {
+    std::fill(cell.begin(), cell.end(), 1.1);
   }
 
   PhzDataModel::QualifiedNameGroupManager::set_type        sed_tp{{"sed1"}, {"sed2"}};
@@ -514,11 +493,9 @@ BOOST_AUTO_TEST_CASE(applySampleEffectiveness) {
   std::vector<XYDataset::QualifiedName> seds{{"sed1"}};
   PhzDataModel::ModelAxesTuple          axes = PhzDataModel::createAxesTuple(zs, ebvs, reddeing_curves, seds);
 
-  PhzDataModel::DoubleListGrid posterior_grid{axes};
-  for (auto iter = posterior_grid.begin(); iter != posterior_grid.end(); ++iter) {
-    for (size_t index = 0; index < 2; ++index) {
-      (*iter).push_back(1.1);
-    }
+  PhzDataModel::DoubleListGrid posterior_grid{axes, 2};
+  for (auto cell : posterior_grid) {
+    std::fill(cell.begin(), cell.end(), 1.1);
   }
 
   PhzDataModel::QualifiedNameGroupManager::set_type        sed_tp{{"sed1"}, {"sed2"}};
@@ -627,10 +604,10 @@ BOOST_AUTO_TEST_CASE(applySamplePrior) {
   std::vector<XYDataset::QualifiedName> seds{{"sed1"}};
   PhzDataModel::ModelAxesTuple          axes = PhzDataModel::createAxesTuple(zs, ebvs, reddeing_curves, seds);
 
-  PhzDataModel::DoubleListGrid posterior_grid{axes};
+  PhzDataModel::DoubleListGrid posterior_grid{axes, 2};
   for (auto iter = posterior_grid.begin(); iter != posterior_grid.end(); ++iter) {
     for (size_t index = 0; index < 2; ++index) {
-      (*iter).push_back(index);
+      (*iter)[index] = index;
     }
   }
 
@@ -7,6 +7,7 @@
 
 #include "ElementsKernel/Exception.h"
 #include "ElementsKernel/Real.h"
+#include <algorithm>
 #include <boost/test/unit_test.hpp>
 #include <memory>
 #include <utility>
@@ -680,4 +681,31 @@ BOOST_FIXTURE_TEST_CASE(test_functional_integrate_mag, SchechterLuminosityFuncti
 
 //-----------------------------------------------------------------------------
 
+BOOST_FIXTURE_TEST_CASE(test_evaluate, SchechterLuminosityFunction_Fixture) {
+  // Includes values where the function is clamped to 100
+  std::vector<double> mags{-10., -1., 0., 0.3, 1., 10., 25.};
+  std::vector<double> fluxes{1e-3, 0.1, 1., 3., 10., 100.};
+  std::vector<double> output(std::max(mags.size(), fluxes.size()));
+
+  for (double p : phi) {
+    for (size_t j = 0; j < mo.size(); ++j) {
+      for (double a : alpha) {
+        auto function_mag = PhzLuminosity::SchechterLuminosityFunction{p, mo[j], a, true};
+        function_mag.evaluate(mags.data(), output.data(), mags.size());
+        for (size_t i = 0; i < mags.size(); ++i) {
+          BOOST_CHECK_CLOSE(output[i], function_mag(mags[i]), 1e-8);
+        }
+
+        auto function_flux = PhzLuminosity::SchechterLuminosityFunction{p, lo[j], a, false};
+        function_flux.evaluate(fluxes.data(), output.data(), fluxes.size());
+        for (size_t i = 0; i < fluxes.size(); ++i) {
+          BOOST_CHECK_CLOSE(output[i], function_flux(fluxes[i]), 1e-8);
+        }
+      }
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,107 @@
+/**
+ * Copyright (C) 2022 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file PhzModeling/IncrementalGridBuilder.h
+ * @date 2026/10/18
+ */
+
+#ifndef PHZMODELING_INCREMENTALGRIDBUILDER_H
+#define PHZMODELING_INCREMENTALGRIDBUILDER_H
+
+#include "PhzDataModel/PhotometryGrid.h"
+#include "PhzDataModel/PhzModel.h"
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace Euclid {
+namespace PhzModeling {
+
+/**
+ * @class PhzModeling::IncrementalGridBuilder
+ * @brief
+ * Extends previously computed grids to a new parameter space, computing only
+ * the missing cells
+ * @details
+ * For each requested region, the cells whose redshift, E(B-V), reddening curve
+ * and SED all exist in the axes of the region with the same name of the
+ * existing grids are copied. The remaining cells are split in (at most four)
+ * rectangular sub-spaces, which are all computed with a single call to the
+ * grid function. The existing regions which are not requested are dropped.
+ */
+class IncrementalGridBuilder {
+
+public:
+  typedef std::function<void(size_t step, size_t total)> ProgressListener;
+
+  /// Computes the grids of a set of named parameter space regions
+  typedef std::function<std::map<std::string, PhzDataModel::PhotometryGrid>(
+      const std::map<std::string, PhzDataModel::ModelAxesTuple>&, ProgressListener)>
+      GridFunction;
+
+  /**
+   * @brief Constructor
+   * @param grid_function
+   * The function used for computing the missing cells, for example a wrapper
+   * around the SparseGridCreator
+   */
+  explicit IncrementalGridBuilder(GridFunction grid_function);
+
+  /**
+   * @brief Returns the rectangular sub-spaces covering the cells of the
+   * requested space which are not in the existing one
+   * @details
+   * The sub-spaces are disjoint: the new SEDs, then the new reddening curves
+   * of the existing SEDs, then the new E(B-V) values of the existing SEDs and
+   * curves and finally the new redshifts of all the existing values.
+   */
+  static std::vector<PhzDataModel::ModelAxesTuple> missingSubspaces(const PhzDataModel::ModelAxesTuple& requested,
+                                                                    const PhzDataModel::ModelAxesTuple& existing);
+
+  /**
+   * @brief Creates the grids of the requested regions
+   *
+   * @param parameter_space_map
+   * The requested regions
+   *
+   * @param existing_grids
+   * The previously computed grids. They must have the same filters as the
+   * ones computed by the grid function. A requested region identical to an
+   * existing one reuses its grid without any copy.
+   *
+   * @param progress_listener
+   * Receives the progress of the computation of the missing cells
+   *
+   * @throw Elements::Exception
+   * If the filters of an existing grid differ from the computed ones
+   */
+  std::map<std::string, PhzDataModel::PhotometryGrid>
+  createGrid(const std::map<std::string, PhzDataModel::ModelAxesTuple>& parameter_space_map,
+             std::map<std::string, PhzDataModel::PhotometryGrid>        existing_grids,
+             ProgressListener                                           progress_listener = ProgressListener{}) const;
+
+private:
+  GridFunction m_grid_function;
+};
+
+}  // end of namespace PhzModeling
+}  // end of namespace Euclid
+
+#endif /* PHZMODELING_INCREMENTALGRIDBUILDER_H */
@@ -57,6 +57,15 @@ public:
    */
   typedef std::function<void(size_t step, size_t total)> ProgressListener;
 
+  /// The algorithms which can be used for computing the model fluxes
+  enum class FluxAlgorithm {
+    /// Apply every filter on every redshifted model (ModelFluxAlgorithm)
+    INTERPOLATION,
+    /// Compute all the redshifts of a rest-frame model from its cumulative integrals
+    /// (PrefixIntegralFluxAlgorithm)
+    PREFIX_INTEGRAL
+  };
+
   /**
    * @brief constructor
    *
@@ -75,20 +84,44 @@ public:
    * @param igm_absorption_function
    * The function to use for applying the IGM absorption to the redshifted SED
    *
+   * @param normalization_function
+   * The function to use for normalizing the reddened SEDs
+   *
+   * @param flux_algorithm
+   * The algorithm to use for computing the model fluxes
+   *
+   * @param validation_tolerance
+   * Used only with the PREFIX_INTEGRAL algorithm. If positive, the fluxes of
+   * the first, middle and last redshift of every rest-frame model are
+   * recomputed with the INTERPOLATION algorithm and an exception is thrown if
+   * they differ by more than this tolerance, relative to the brightest band.
    */
   PhotometryGridCreator(std::shared_ptr<Euclid::XYDataset::XYDatasetProvider> sed_provider,
                         std::shared_ptr<Euclid::XYDataset::XYDatasetProvider> reddening_curve_provider,
                         std::shared_ptr<Euclid::XYDataset::XYDatasetProvider> filter_provider,
-                        IgmAbsorptionFunction igm_absorption_function, NormalizationFunction normalization_function);
+                        IgmAbsorptionFunction igm_absorption_function, NormalizationFunction normalization_function,
+                        FluxAlgorithm flux_algorithm = FluxAlgorithm::INTERPOLATION, double validation_tolerance = 0.);
   /**
    * @brief destructor.
    */
   virtual ~PhotometryGridCreator();
 
+  /**
+   * @brief Sets the number of threads used by createGrid
+   * @details
+   * The default (zero) uses the global PhzUtils::getThreadNumber(). It allows
+   * callers building several grids concurrently to share the thread budget.
+   * With a single thread the grid is computed in the calling thread.
+   */
+  void setThreadNumber(unsigned int thread_number);
+
   /**
    * @brief Creates a photometry grid
    * @details
-   * Build a photometry grid. If the parameter space requires
+   * Build a photometry grid. The models which are identical by construction
+   * (the ones with E(B-V)=0, which do not depend on the reddening curve) are
+   * computed only once and copied to all the degenerate cells.
+   * If the parameter space requires
    * a SED or a reddening curve that the corresponding provider are unable to returns
    * an exception will be throw an Euclid Exception. An exception is also throw if the
    * filter provider cannot provide the requested filters.
@@ -102,8 +135,10 @@ public:
    *
    * @param progress_listener
    * A function of type ProgressListener which will be updated with the progress
-   * of the grid creation. It will be called every 0.1 sec. The default is an
-   * empty function, which means no action is taken.
+   * of the grid creation. It will be called every 0.1 sec, or after every model
+   * (SED for the prefix integral algorithm) when the grid is computed in the
+   * calling thread. The default is an empty function, which means no action is
+   * taken.
    *
    */
   PhzDataModel::PhotometryGrid createGrid(const PhzDataModel::ModelAxesTuple&                  parameter_space,
@@ -112,11 +147,24 @@ public:
                                           ProgressListener progress_listener = ProgressListener{});
 
 private:
+  PhzDataModel::PhotometryGrid computeGrid(const PhzDataModel::ModelAxesTuple&                  parameter_space,
+                                           const std::vector<Euclid::XYDataset::QualifiedName>& filter_name_list,
+                                           const PhysicsUtils::CosmologicalParameters&          cosmology,
+                                           ProgressListener                                     progress_listener);
+
+  PhzDataModel::PhotometryGrid createPrefixIntegralGrid(const PhzDataModel::ModelAxesTuple&                  parameter_space,
+                                                        const std::vector<Euclid::XYDataset::QualifiedName>& filter_name_list,
+                                                        const PhysicsUtils::CosmologicalParameters&          cosmology,
+                                                        ProgressListener progress_listener);
+
   std::shared_ptr<Euclid::XYDataset::XYDatasetProvider> m_sed_provider;
   std::shared_ptr<Euclid::XYDataset::XYDatasetProvider> m_reddening_curve_provider;
   std::shared_ptr<Euclid::XYDataset::XYDatasetProvider> m_filter_provider;
   IgmAbsorptionFunction                                 m_igm_absorption_function;
   NormalizationFunction                                 m_normalization_function;
+  FluxAlgorithm                                         m_flux_algorithm;
+  double                                                m_validation_tolerance;
+  unsigned int                                          m_thread_number = 0;
 };
 
 }  // namespace PhzModeling
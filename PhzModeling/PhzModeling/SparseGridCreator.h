@@ -30,6 +30,7 @@
 #include "PhzDataModel/PhotometryGrid.h"
 #include "PhzDataModel/PhzModel.h"
 #include "PhzModeling/ModelDatasetGrid.h"
+#include "PhzModeling/PhotometryGridCreator.h"
 #include "XYDataset/XYDatasetProvider.h"
 #include <functional>
 
@@ -75,11 +76,18 @@ public:
    * @param igm_absorption_function
    * The function to use for applying the IGM absorption to the redshifted SED
    *
+   * @param memory_limit
+   * The maximum memory (in bytes) used by the grids of the regions which are
+   * built concurrently. Zero means no limit. A region bigger than the limit is
+   * still built, but alone.
    */
   SparseGridCreator(std::shared_ptr<Euclid::XYDataset::XYDatasetProvider> sed_provider,
                     std::shared_ptr<Euclid::XYDataset::XYDatasetProvider> reddening_curve_provider,
                     std::shared_ptr<Euclid::XYDataset::XYDatasetProvider> filter_provider,
-                    IgmAbsorptionFunction igm_absorption_function, NormalizationFunction normalization_function);
+                    IgmAbsorptionFunction igm_absorption_function, NormalizationFunction normalization_function,
+                    PhotometryGridCreator::FluxAlgorithm flux_algorithm = PhotometryGridCreator::FluxAlgorithm::INTERPOLATION,
+                    double                               validation_tolerance = 0.,
+                    size_t                               memory_limit         = 0);
   /**
    * @brief destructor.
    */
@@ -93,6 +101,18 @@ public:
    * an exception will be throw an Euclid Exception. An exception is also throw if the
    * filter provider cannot provide the requested filters.
    *
+   * The models of a SED which has already been computed in a previous region,
+   * with axes covering its redshifts, E(B-V) values and reddening curves, are
+   * copied from that region instead of being recomputed.
+   *
+   * The SEDs of each region are split in chunks, which are computed by a
+   * single pool of threads, starting from the biggest regions. The threads
+   * move to the chunks of the next region when the previous ones have no
+   * chunk left, so several regions are built concurrently. A region starts
+   * only when the memory it needs is available and the regions it copies
+   * SEDs from are started. The datasets are loaded before starting the
+   * threads, so the providers do not need to be thread-safe.
+   *
    * @param parameter_space
    * A ModelAxesTuple defining the SEDs, the redshifts, the reddening curves and the EVB values
    * for which the photometry will be computed.
@@ -118,6 +138,9 @@ private:
   std::shared_ptr<Euclid::XYDataset::XYDatasetProvider> m_filter_provider;
   IgmAbsorptionFunction                                 m_igm_absorption_function;
   NormalizationFunction                                 m_normalization_function;
+  PhotometryGridCreator::FluxAlgorithm                  m_flux_algorithm;
+  double                                                m_validation_tolerance;
+  size_t                                                m_memory_limit;
 };
 
 }  // namespace PhzModeling
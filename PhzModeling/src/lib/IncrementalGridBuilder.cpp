@@ -0,0 +1,242 @@
+/**
+ * Copyright (C) 2022 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file src/lib/IncrementalGridBuilder.cpp
+ * @date 2026/10/18
+ */
+
+#include "PhzModeling/IncrementalGridBuilder.h"
+#include "ElementsKernel/Exception.h"
+#include "ElementsKernel/Logging.h"
+#include "GridContainer/GridIndexHelper.h"
+#include <algorithm>
+
+namespace Euclid {
+namespace PhzModeling {
+
+static Elements::Logging logger = Elements::Logging::getLogger("IncrementalGridBuilder");
+
+namespace {
+
+/*
+ * Splits the values of a requested axis in the ones which exist in the
+ * existing axis and the new ones. For each requested value it keeps its index
+ * in the existing axis (if any) and its position in the old or new list.
+ */
+template <typename T>
+struct AxisSplit {
+  std::vector<T>      old_values{};
+  std::vector<T>      new_values{};
+  std::vector<bool>   is_new{};
+  std::vector<size_t> position{};
+  std::vector<size_t> existing_index{};
+
+  AxisSplit(const GridContainer::GridAxis<T>& requested, const GridContainer::GridAxis<T>& existing) {
+    for (auto& value : requested) {
+      auto found = std::find(existing.begin(), existing.end(), value);
+      if (found == existing.end()) {
+        is_new.emplace_back(true);
+        position.emplace_back(new_values.size());
+        existing_index.emplace_back(0);
+        new_values.emplace_back(value);
+      } else {
+        is_new.emplace_back(false);
+        position.emplace_back(old_values.size());
+        existing_index.emplace_back(found - existing.begin());
+        old_values.emplace_back(value);
+      }
+    }
+  }
+};
+
+template <typename T>
+std::vector<T> axisValues(const GridContainer::GridAxis<T>& axis) {
+  return {axis.begin(), axis.end()};
+}
+
+template <typename T>
+bool sameAxis(const GridContainer::GridAxis<T>& first, const GridContainer::GridAxis<T>& second) {
+  return first.size() == second.size() && std::equal(first.begin(), first.end(), second.begin());
+}
+
+bool sameAxes(const PhzDataModel::ModelAxesTuple& first, const PhzDataModel::ModelAxesTuple& second) {
+  using PhzDataModel::ModelParameter;
+  return sameAxis(std::get<ModelParameter::Z>(first), std::get<ModelParameter::Z>(second)) &&
+         sameAxis(std::get<ModelParameter::EBV>(first), std::get<ModelParameter::EBV>(second)) &&
+         sameAxis(std::get<ModelParameter::REDDENING_CURVE>(first),
+                  std::get<ModelParameter::REDDENING_CURVE>(second)) &&
+         sameAxis(std::get<ModelParameter::SED>(first), std::get<ModelParameter::SED>(second));
+}
+
+std::string subspaceName(const std::string& region, size_t index) {
+  return region + "#" + std::to_string(index);
+}
+
+}  // namespace
+
+IncrementalGridBuilder::IncrementalGridBuilder(GridFunction grid_function)
+    : m_grid_function{std::move(grid_function)} {}
+
+std::vector<PhzDataModel::ModelAxesTuple>
+IncrementalGridBuilder::missingSubspaces(const PhzDataModel::ModelAxesTuple& requested,
+                                         const PhzDataModel::ModelAxesTuple& existing) {
+  using PhzDataModel::ModelParameter;
+  AxisSplit<double> z{std::get<ModelParameter::Z>(requested), std::get<ModelParameter::Z>(existing)};
+  AxisSplit<double> ebv{std::get<ModelParameter::EBV>(requested), std::get<ModelParameter::EBV>(existing)};
+  AxisSplit<XYDataset::QualifiedName> curve{std::get<ModelParameter::REDDENING_CURVE>(requested),
+                                            std::get<ModelParameter::REDDENING_CURVE>(existing)};
+  AxisSplit<XYDataset::QualifiedName> sed{std::get<ModelParameter::SED>(requested),
+                                          std::get<ModelParameter::SED>(existing)};
+
+  auto all_z     = axisValues(std::get<ModelParameter::Z>(requested));
+  auto all_ebv   = axisValues(std::get<ModelParameter::EBV>(requested));
+  auto all_curve = axisValues(std::get<ModelParameter::REDDENING_CURVE>(requested));
+
+  std::vector<PhzDataModel::ModelAxesTuple> result{};
+  auto add = [&result](const std::vector<double>& zs, const std::vector<double>& ebvs,
+                       const std::vector<XYDataset::QualifiedName>& curves,
+                       const std::vector<XYDataset::QualifiedName>& seds) {
+    if (!zs.empty() && !ebvs.empty() && !curves.empty() && !seds.empty()) {
+      result.emplace_back(PhzDataModel::createAxesTuple(zs, ebvs, curves, seds));
+    }
+  };
+  add(all_z, all_ebv, all_curve, sed.new_values);
+  add(all_z, all_ebv, curve.new_values, sed.old_values);
+  add(all_z, ebv.new_values, curve.old_values, sed.old_values);
+  add(z.new_values, ebv.old_values, curve.old_values, sed.old_values);
+  return result;
+}
+
+std::map<std::string, PhzDataModel::PhotometryGrid>
+IncrementalGridBuilder::createGrid(const std::map<std::string, PhzDataModel::ModelAxesTuple>& parameter_space_map,
+                                   std::map<std::string, PhzDataModel::PhotometryGrid>        existing_grids,
+                                   ProgressListener                                           progress_listener) const {
+  using PhzDataModel::ModelParameter;
+
+  // Collect all the missing sub-spaces, so they are computed in a single call
+  std::map<std::string, PhzDataModel::ModelAxesTuple> missing_map{};
+  size_t                                              total_cells   = 0;
+  size_t                                              missing_cells = 0;
+  for (auto& pair : parameter_space_map) {
+    total_cells += GridContainer::makeGridIndexHelper(pair.second).m_axes_index_factors.back();
+    auto existing = existing_grids.find(pair.first);
+    if (existing == existing_grids.end()) {
+      missing_map.emplace(subspaceName(pair.first, 0), pair.second);
+      missing_cells += GridContainer::makeGridIndexHelper(pair.second).m_axes_index_factors.back();
+      continue;
+    }
+    auto subspaces = missingSubspaces(pair.second, existing->second.getAxesTuple());
+    for (size_t i = 0; i < subspaces.size(); ++i) {
+      missing_cells += GridContainer::makeGridIndexHelper(subspaces[i]).m_axes_index_factors.back();
+      missing_map.emplace(subspaceName(pair.first, i), std::move(subspaces[i]));
+    }
+  }
+  logger.info() << "Computing " << missing_cells << " of " << total_cells << " models, the rest is reused";
+
+  auto computed_map = missing_map.empty() ? std::map<std::string, PhzDataModel::PhotometryGrid>{}
+                                          : m_grid_function(missing_map, progress_listener);
+
+  // All the grids must have the same filters
+  std::vector<std::string> filter_names{};
+  auto check_filters = [&filter_names](const PhzDataModel::PhotometryGrid& grid, const std::string& name) {
+    auto& names = grid.getCellManager().filterNames();
+    if (filter_names.empty()) {
+      filter_names = names;
+    } else if (names != filter_names) {
+      throw Elements::Exception() << "The filters of the existing grid for region " << name
+                                  << " differ from the requested ones";
+    }
+  };
+  for (auto& pair : computed_map) {
+    check_filters(pair.second, pair.first);
+  }
+  for (auto& pair : parameter_space_map) {
+    auto existing = existing_grids.find(pair.first);
+    if (existing != existing_grids.end()) {
+      check_filters(existing->second, pair.first);
+    }
+  }
+
+  std::map<std::string, PhzDataModel::PhotometryGrid> result{};
+  for (auto& pair : parameter_space_map) {
+    auto existing = existing_grids.find(pair.first);
+    if (existing == existing_grids.end()) {
+      result.emplace(pair.first, std::move(computed_map.at(subspaceName(pair.first, 0))));
+      continue;
+    }
+    if (sameAxes(pair.second, existing->second.getAxesTuple())) {
+      result.emplace(pair.first, std::move(existing->second));
+      continue;
+    }
+
+    auto&                               existing_axes = existing->second.getAxesTuple();
+    AxisSplit<double>                   z{std::get<ModelParameter::Z>(pair.second),
+                        std::get<ModelParameter::Z>(existing_axes)};
+    AxisSplit<double>                   ebv{std::get<ModelParameter::EBV>(pair.second),
+                          std::get<ModelParameter::EBV>(existing_axes)};
+    AxisSplit<XYDataset::QualifiedName> curve{std::get<ModelParameter::REDDENING_CURVE>(pair.second),
+                                              std::get<ModelParameter::REDDENING_CURVE>(existing_axes)};
+    AxisSplit<XYDataset::QualifiedName> sed{std::get<ModelParameter::SED>(pair.second),
+                                            std::get<ModelParameter::SED>(existing_axes)};
+
+    // The sub-spaces in the same order as created by missingSubspaces(). The
+    // empty ones are skipped, so the names are assigned in the same way.
+    std::vector<PhzDataModel::PhotometryGrid*> subspace_grids(4, nullptr);
+    bool has_subspace[4] = {!sed.new_values.empty(), !curve.new_values.empty() && !sed.old_values.empty(),
+                            !ebv.new_values.empty() && !curve.old_values.empty() && !sed.old_values.empty(),
+                            !z.new_values.empty() && !ebv.old_values.empty() && !curve.old_values.empty() &&
+                                !sed.old_values.empty()};
+    size_t name_index = 0;
+    for (size_t i = 0; i < 4; ++i) {
+      if (has_subspace[i]) {
+        subspace_grids[i] = &computed_map.at(subspaceName(pair.first, name_index++));
+      }
+    }
+
+    PhzDataModel::PhotometryGrid grid{pair.second, filter_names};
+    auto&                        old_grid = existing->second;
+    for (size_t s = 0; s < sed.is_new.size(); ++s) {
+      for (size_t c = 0; c < curve.is_new.size(); ++c) {
+        for (size_t e = 0; e < ebv.is_new.size(); ++e) {
+          for (size_t i = 0; i < z.is_new.size(); ++i) {
+            if (sed.is_new[s]) {
+              grid(i, e, c, s) = (*subspace_grids[0])(i, e, c, sed.position[s]);
+            } else if (curve.is_new[c]) {
+              grid(i, e, c, s) = (*subspace_grids[1])(i, e, curve.position[c], sed.position[s]);
+            } else if (ebv.is_new[e]) {
+              grid(i, e, c, s) = (*subspace_grids[2])(i, ebv.position[e], curve.position[c], sed.position[s]);
+            } else if (z.is_new[i]) {
+              grid(i, e, c, s) =
+                  (*subspace_grids[3])(z.position[i], ebv.position[e], curve.position[c], sed.position[s]);
+            } else {
+              grid(i, e, c, s) =
+                  old_grid(z.existing_index[i], ebv.existing_index[e], curve.existing_index[c], sed.existing_index[s]);
+            }
+          }
+        }
+      }
+    }
+    result.emplace(pair.first, std::move(grid));
+  }
+
+  return result;
+}
+
+}  // end of namespace PhzModeling
+}  // end of namespace Euclid
@@ -22,15 +22,20 @@
  * @author Florian Dubath
  */
 
+#include <algorithm>
 #include <atomic>
 #include <boost/algorithm/string.hpp>
 #include <chrono>
+#include <cmath>
 #include <future>
 #include <iterator>
+#include <memory>
+#include <set>
 #include <string>
 #include <thread>
 
 #include "ElementsKernel/Logging.h"
+#include "GridContainer/GridIndexHelper.h"
 #include "MathUtils/interpolation/interpolation.h"
 
 #include "PhysicsUtils/CosmologicalParameters.h"
@@ -38,11 +43,13 @@
 #include "PhzDataModel/PhzModel.h"
 
 #include "PhzModeling/ApplyFilterFunctor.h"
+#include "PhzModeling/BuildFilterInfoFunctor.h"
 #include "PhzModeling/ExtinctionFunctor.h"
 #include "PhzModeling/MadauIgmFunctor.h"
 #include "PhzModeling/ModelDatasetGrid.h"
 #include "PhzModeling/ModelFluxAlgorithm.h"
 #include "PhzModeling/PhotometryAlgorithm.h"
+#include "PhzModeling/PrefixIntegralFluxAlgorithm.h"
 #include "PhzModeling/RedshiftFunctor.h"
 
 #include "PhzModeling/PhotometryGridCreator.h"
@@ -119,12 +126,19 @@ PhotometryGridCreator::PhotometryGridCreator(std::shared_ptr<XYDataset::XYDatase
                                              std::shared_ptr<XYDataset::XYDatasetProvider> reddening_curve_provider,
                                              std::shared_ptr<XYDataset::XYDatasetProvider> filter_provider,
                                              IgmAbsorptionFunction                         igm_absorption_function,
-                                             NormalizationFunction                         normalization_function)
+                                             NormalizationFunction                         normalization_function,
+                                             FluxAlgorithm flux_algorithm, double validation_tolerance)
     : m_sed_provider{sed_provider}
     , m_reddening_curve_provider{reddening_curve_provider}
     , m_filter_provider(filter_provider)
     , m_igm_absorption_function{igm_absorption_function}
-    , m_normalization_function{normalization_function} {}
+    , m_normalization_function{normalization_function}
+    , m_flux_algorithm{flux_algorithm}
+    , m_validation_tolerance{validation_tolerance} {}
+
+void PhotometryGridCreator::setThreadNumber(unsigned int thread_number) {
+  m_thread_number = thread_number;
+}
 
 PhotometryGridCreator::~PhotometryGridCreator() {
   // The multithreaded job is done, so reset the stop threads flag
@@ -169,12 +183,110 @@ private:
   std::atomic<uint>&                       m_done_counter;
 };
 
+/// Reports to the listener the progress of a job running in the calling thread
+class ListenerMonitor {
+
+public:
+  ListenerMonitor(const PhotometryGridCreator::ProgressListener& listener, size_t total)
+      : m_listener(listener), m_total(total) {}
+
+  ListenerMonitor& operator++() {
+    ++m_done;
+    if (m_listener) {
+      m_listener(m_done, m_total);
+    }
+    return *this;
+  }
+
+private:
+  const PhotometryGridCreator::ProgressListener& m_listener;
+  size_t                                         m_total;
+  size_t                                         m_done = 0;
+};
+
 PhzDataModel::PhotometryGrid
 PhotometryGridCreator::createGrid(const PhzDataModel::ModelAxesTuple&                  parameter_space,
                                   const std::vector<Euclid::XYDataset::QualifiedName>& filter_name_list,
                                   const PhysicsUtils::CosmologicalParameters&          cosmology,
                                   ProgressListener                                     progress_listener) {
 
+  // At E(B-V)=0 all the reddening curves produce the same model, so this slice
+  // is computed only for the first curve and copied to the others
+  auto& z_axis     = std::get<PhzDataModel::ModelParameter::Z>(parameter_space);
+  auto& ebv_axis   = std::get<PhzDataModel::ModelParameter::EBV>(parameter_space);
+  auto& curve_axis = std::get<PhzDataModel::ModelParameter::REDDENING_CURVE>(parameter_space);
+  auto& sed_axis   = std::get<PhzDataModel::ModelParameter::SED>(parameter_space);
+  auto  zero_ebv   = std::find(ebv_axis.begin(), ebv_axis.end(), 0.);
+  if (curve_axis.size() < 2 || zero_ebv == ebv_axis.end()) {
+    return computeGrid(parameter_space, filter_name_list, cosmology, progress_listener);
+  }
+
+  size_t                                zero_index = zero_ebv - ebv_axis.begin();
+  std::vector<double>                   zs(z_axis.begin(), z_axis.end());
+  std::vector<XYDataset::QualifiedName> curves(curve_axis.begin(), curve_axis.end());
+  std::vector<XYDataset::QualifiedName> seds(sed_axis.begin(), sed_axis.end());
+  std::vector<double>                   non_zero_ebvs{};
+  for (size_t ebv_index = 0; ebv_index < ebv_axis.size(); ++ebv_index) {
+    if (ebv_index != zero_index) {
+      non_zero_ebvs.emplace_back(ebv_axis[ebv_index]);
+    }
+  }
+  auto zero_space = PhzDataModel::createAxesTuple(zs, {0.}, {curves.front()}, seds);
+
+  size_t total      = GridContainer::makeGridIndexHelper(parameter_space).m_axes_index_factors.back();
+  size_t zero_total = zs.size() * seds.size();
+  size_t unique     = zero_total + zs.size() * non_zero_ebvs.size() * curves.size() * seds.size();
+  logger.info() << "Skipping " << total - unique << " models which are identical at E(B-V)=0";
+
+  // The progress is reported in terms of the full grid
+  auto scaled_listener = [progress_listener, total, unique](size_t already_done) -> ProgressListener {
+    if (!progress_listener) {
+      return ProgressListener{};
+    }
+    return [progress_listener, total, unique, already_done](size_t step, size_t) {
+      progress_listener((already_done + step) * total / unique, total);
+    };
+  };
+
+  auto zero_grid = computeGrid(zero_space, filter_name_list, cosmology, scaled_listener(0));
+  std::unique_ptr<PhzDataModel::PhotometryGrid> non_zero_grid{};
+  if (!non_zero_ebvs.empty()) {
+    auto non_zero_space = PhzDataModel::createAxesTuple(zs, non_zero_ebvs, curves, seds);
+    non_zero_grid.reset(new PhzDataModel::PhotometryGrid(
+        computeGrid(non_zero_space, filter_name_list, cosmology, scaled_listener(zero_total))));
+  }
+
+  // Fan out the unique models to the full grid
+  auto photometry_grid = PhzDataModel::PhotometryGrid(parameter_space, filter_name_list);
+  for (size_t sed_index = 0; sed_index < seds.size(); ++sed_index) {
+    for (size_t curve_index = 0; curve_index < curves.size(); ++curve_index) {
+      for (size_t ebv_index = 0; ebv_index < ebv_axis.size(); ++ebv_index) {
+        for (size_t z_index = 0; z_index < zs.size(); ++z_index) {
+          if (ebv_index == zero_index) {
+            photometry_grid(z_index, ebv_index, curve_index, sed_index) = zero_grid(z_index, 0, 0, sed_index);
+          } else {
+            size_t non_zero_index = (ebv_index < zero_index) ? ebv_index : ebv_index - 1;
+            photometry_grid(z_index, ebv_index, curve_index, sed_index) =
+                (*non_zero_grid)(z_index, non_zero_index, curve_index, sed_index);
+          }
+        }
+      }
+    }
+  }
+
+  return photometry_grid;
+}
+
+PhzDataModel::PhotometryGrid
+PhotometryGridCreator::computeGrid(const PhzDataModel::ModelAxesTuple&                  parameter_space,
+                                   const std::vector<Euclid::XYDataset::QualifiedName>& filter_name_list,
+                                   const PhysicsUtils::CosmologicalParameters&          cosmology,
+                                   ProgressListener                                     progress_listener) {
+
+  if (m_flux_algorithm == FluxAlgorithm::PREFIX_INTEGRAL) {
+    return createPrefixIntegralGrid(parameter_space, filter_name_list, cosmology, progress_listener);
+  }
+
   // Create the maps
   auto filter_map           = buildFilterMap(*m_filter_provider, filter_name_list.begin(), filter_name_list.end());
   auto sed_name_list        = std::get<PhzDataModel::ModelParameter::SED>(parameter_space);
@@ -205,7 +317,7 @@ PhotometryGridCreator::createGrid(const PhzDataModel::ModelAxesTuple&
   std::vector<std::future<void>> futures;
   std::atomic<size_t>            progress{0};
   std::atomic<uint>              done_counter{0};
-  uint                           threads      = PhzUtils::getThreadNumber();
+  uint                           threads      = (m_thread_number > 0) ? m_thread_number : PhzUtils::getThreadNumber();
   size_t                         total_models = model_grid.size();
   logger.info() << "Creating photometries for " << total_models << " models";
   if (total_models < threads) {
@@ -213,6 +325,16 @@ PhotometryGridCreator::createGrid(const PhzDataModel::ModelAxesTuple&
   }
   logger.info() << "Using " << threads << " threads";
 
+  // A single thread does the work in the calling one, which reports the progress itself
+  if (threads <= 1) {
+    if (progress_listener) {
+      progress_listener(0, total_models);
+    }
+    ListenerMonitor monitor{progress_listener, total_models};
+    photometry_algo(model_grid.begin(), model_grid.end(), photometry_grid.begin(), monitor);
+    return photometry_grid;
+  }
+
   auto        model_iter      = model_grid.begin();
   auto        end_model_iter  = model_grid.begin();
   auto        photometry_iter = photometry_grid.begin();
@@ -244,5 +366,201 @@ PhotometryGridCreator::createGrid(const PhzDataModel::ModelAxesTuple&
   return photometry_grid;
 }
 
+/*
+ * Returns the IGM transmission of the given SED knots when redshifted at z, up
+ * to the last knot with a transmission different than one.
+ */
+static std::vector<double> computeIgmTransmission(const XYDataset::XYDataset&                         rest_frame_sed,
+                                                  const PhotometryGridCreator::IgmAbsorptionFunction& igm_function,
+                                                  double                                              z) {
+  std::vector<std::pair<double, double>> unit_sed{};
+  unit_sed.reserve(rest_frame_sed.size());
+  for (auto& sed_pair : rest_frame_sed) {
+    unit_sed.emplace_back(sed_pair.first * (1 + z), 1.);
+  }
+  auto absorbed = igm_function(PhzDataModel::Sed(std::move(unit_sed)), z);
+  if (absorbed.size() != rest_frame_sed.size()) {
+    throw Elements::Exception() << "The prefix integral algorithm requires an IGM absorption "
+                                << "function which preserves the SED knots";
+  }
+  std::vector<double> transmission{};
+  transmission.reserve(absorbed.size());
+  for (auto& absorbed_pair : absorbed) {
+    transmission.emplace_back(absorbed_pair.second);
+  }
+  while (!transmission.empty() && transmission.back() == 1.) {
+    transmission.pop_back();
+  }
+  return transmission;
+}
+
+PhzDataModel::PhotometryGrid
+PhotometryGridCreator::createPrefixIntegralGrid(const PhzDataModel::ModelAxesTuple&                  parameter_space,
+                                                const std::vector<Euclid::XYDataset::QualifiedName>& filter_name_list,
+                                                const PhysicsUtils::CosmologicalParameters&          cosmology,
+                                                ProgressListener progress_listener) {
+
+  // Create the maps
+  auto filter_map           = buildFilterMap(*m_filter_provider, filter_name_list.begin(), filter_name_list.end());
+  auto sed_name_list        = std::get<PhzDataModel::ModelParameter::SED>(parameter_space);
+  auto sed_map              = buildMap(*m_sed_provider, sed_name_list.begin(), sed_name_list.end());
+  auto reddening_curve_list = std::get<PhzDataModel::ModelParameter::REDDENING_CURVE>(parameter_space);
+  auto reddening_curve_map  = convertToFunction(
+       buildMap(*m_reddening_curve_provider, reddening_curve_list.begin(), reddening_curve_list.end()));
+  auto& z_axis   = std::get<PhzDataModel::ModelParameter::Z>(parameter_space);
+  auto& ebv_axis = std::get<PhzDataModel::ModelParameter::EBV>(parameter_space);
+
+  ModelDatasetGrid::ReddeningFunction reddening_function{ExtinctionFunctor{}};
+  ModelDatasetGrid::RedshiftFunction  redshift_function{RedshiftFunctor{cosmology}};
+
+  // The filter information, in the order of the photometry
+  std::vector<PhzDataModel::FilterInfo>  filter_info_vector{};
+  std::vector<XYDataset::XYDataset>      filters{};
+  std::vector<std::pair<double, double>> ranges{};
+  std::vector<double>                    normalizations{};
+  for (auto& name : filter_name_list) {
+    auto& filter = filter_map.at(name);
+    filter_info_vector.emplace_back(BuildFilterInfoFunctor{}(filter));
+    filters.emplace_back(filter);
+    ranges.emplace_back(filter_info_vector.back().getRange());
+    normalizations.emplace_back(filter_info_vector.back().getNormalization());
+  }
+  PrefixIntegralFluxAlgorithm prefix_algo{filters, ranges, normalizations};
+  ModelFluxAlgorithm          reference_algo{ApplyFilterFunctor{}};
+  auto                        filter_names_ptr = createSharedPointer(filter_name_list);
+
+  // The redshift dimming factor, obtained by redshifting a unit SED
+  std::vector<double> flux_factors{};
+  for (double z : z_axis) {
+    auto unit = redshift_function(PhzDataModel::Sed(std::vector<std::pair<double, double>>{{1., 1.}}), z);
+    flux_factors.emplace_back(unit.begin()->second);
+  }
+
+  // The redshifts for which the fluxes are checked against the interpolation algorithm
+  std::set<size_t> validated_z_indices{};
+  if (m_validation_tolerance > 0 && z_axis.size() > 0) {
+    validated_z_indices = {0, z_axis.size() / 2, z_axis.size() - 1};
+  }
+
+  auto photometry_grid = PhzDataModel::PhotometryGrid(parameter_space, filter_name_list);
+
+  // Each thread handles full SEDs, so the IGM transmission table of the SED is
+  // shared by all its reddening curves and E(B-V) values
+  auto sed_job = [&](size_t sed_index) {
+    auto&             sed = sed_map.at(sed_name_list[sed_index]);
+    PhzDataModel::Sed rest_frame_sed{sed};
+    auto              norm_sed = m_normalization_function(rest_frame_sed);
+
+    std::vector<std::vector<double>> igm_table{};
+    for (double z : z_axis) {
+      igm_table.emplace_back(computeIgmTransmission(sed, m_igm_absorption_function, z));
+    }
+
+    std::vector<SourceCatalog::FluxErrorPair> fluxes(filter_name_list.size(), {0., 0.});
+    std::vector<SourceCatalog::FluxErrorPair> reference_fluxes(filter_name_list.size(), {0., 0.});
+    for (size_t red_index = 0; red_index < reddening_curve_list.size(); ++red_index) {
+      auto& reddening_curve = *reddening_curve_map.at(reddening_curve_list[red_index]);
+      for (size_t ebv_index = 0; ebv_index < ebv_axis.size(); ++ebv_index) {
+        if (PhzUtils::getStopThreadsFlag()) {
+          throw Elements::Exception() << "Stopped by the user";
+        }
+
+        auto reddened   = reddening_function(rest_frame_sed, reddening_curve, ebv_axis[ebv_index]);
+        auto normalized = m_normalization_function(reddened);
+        PrefixIntegralFluxAlgorithm::RestFrameTable table{normalized};
+        if (table.getKnots().size() != sed.size()) {
+          throw Elements::Exception() << "The prefix integral algorithm requires reddening and normalization "
+                                      << "functions which preserve the SED knots";
+        }
+        double diff_scaling = normalized.getScaling() / norm_sed.getScaling();
+
+        for (size_t z_index = 0; z_index < z_axis.size(); ++z_index) {
+          prefix_algo(table, 1 + z_axis[z_index], flux_factors[z_index], igm_table[z_index], fluxes);
+
+          if (validated_z_indices.count(z_index) > 0) {
+            auto redshifted = redshift_function(normalized, z_axis[z_index]);
+            auto model      = m_igm_absorption_function(redshifted, z_axis[z_index]);
+            reference_algo(model, filter_info_vector.begin(), filter_info_vector.end(), reference_fluxes.begin());
+            double scale = 0.;
+            for (auto& reference : reference_fluxes) {
+              scale = std::max(scale, std::abs(reference.flux));
+            }
+            for (size_t i = 0; i < fluxes.size(); ++i) {
+              if (std::abs(fluxes[i].flux - reference_fluxes[i].flux) > m_validation_tolerance * scale) {
+                throw Elements::Exception() << "Prefix integral flux " << fluxes[i].flux << " of model ("
+                                            << sed_name_list[sed_index].qualifiedName() << ", "
+                                            << reddening_curve_list[red_index].qualifiedName() << ", "
+                                            << ebv_axis[ebv_index] << ", " << z_axis[z_index] << ") in filter "
+                                            << filter_name_list[i].qualifiedName() << " differs from the "
+                                            << "interpolated flux " << reference_fluxes[i].flux
+                                            << " more than the tolerance " << m_validation_tolerance;
+              }
+            }
+          }
+
+          // Store the differential scaling of the model in the first error
+          if (!fluxes.empty()) {
+            fluxes[0].error = diff_scaling;
+          }
+          photometry_grid(z_index, ebv_index, red_index, sed_index) =
+              SourceCatalog::Photometry(filter_names_ptr, fluxes);
+        }
+      }
+    }
+  };
+
+  std::vector<std::future<void>> futures;
+  std::atomic<size_t>            next_sed{0};
+  std::atomic<size_t>            progress{0};
+  std::atomic<uint>              done_counter{0};
+  uint                           threads      = (m_thread_number > 0) ? m_thread_number : PhzUtils::getThreadNumber();
+  size_t                         total_models = photometry_grid.size();
+  size_t models_per_sed = z_axis.size() * ebv_axis.size() * reddening_curve_list.size();
+  logger.info() << "Creating photometries for " << total_models << " models using the prefix integral algorithm";
+  if (sed_name_list.size() < threads) {
+    threads = sed_name_list.size();
+  }
+  logger.info() << "Using " << threads << " threads";
+
+  if (threads <= 1) {
+    for (size_t sed_index = 0; sed_index < sed_name_list.size(); ++sed_index) {
+      sed_job(sed_index);
+      if (progress_listener) {
+        progress_listener((sed_index + 1) * models_per_sed, total_models);
+      }
+    }
+    return photometry_grid;
+  }
+
+  for (uint i = 0; i < threads; ++i) {
+    futures.push_back(std::async(std::launch::async, [&]() {
+      try {
+        for (size_t sed_index = next_sed++; sed_index < sed_name_list.size(); sed_index = next_sed++) {
+          sed_job(sed_index);
+          progress += models_per_sed;
+        }
+      } catch (...) {
+        ++done_counter;
+        throw;
+      }
+      ++done_counter;
+    }));
+  }
+
+  if (progress_listener) {
+    progress_listener(0, total_models);
+    while (done_counter < threads) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(100));
+      progress_listener(progress, total_models);
+    }
+    progress_listener(total_models, total_models);
+  }
+  for (auto& f : futures) {
+    f.get();
+  }
+
+  return photometry_grid;
+}
+
 }  // namespace PhzModeling
 }  // namespace Euclid
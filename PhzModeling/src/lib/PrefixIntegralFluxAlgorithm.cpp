@@ -0,0 +1,191 @@
+/**
+ * Copyright (C) 2022 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file src/lib/PrefixIntegralFluxAlgorithm.cpp
+ * @date 2026/10/18
+ */
+
+#include "PhzModeling/PrefixIntegralFluxAlgorithm.h"
+#include "ElementsKernel/Exception.h"
+#include <algorithm>
+#include <limits>
+
+namespace Euclid {
+namespace PhzModeling {
+
+namespace {
+
+/// Simpson's rule, which is exact for polynomials up to the third degree
+inline double simpson(double a, double b, double fa, double fm, double fb) {
+  return (b - a) * (fa + 4. * fm + fb) / 6.;
+}
+
+/*
+ * Returns the integral in [a, b] of (A + B * x) * L(x), where L is the line
+ * going through (x0, l0) and (x1, l1). The integrand is a second degree
+ * polynomial, so Simpson's rule is exact.
+ */
+double segmentIntegral(double a, double b, double A, double B, double x0, double l0, double x1, double l1) {
+  double slope = (l1 - l0) / (x1 - x0);
+  auto   f     = [&](double x) {
+    return (A + B * x) * (l0 + slope * (x - x0));
+  };
+  return simpson(a, b, f(a), f((a + b) / 2.), f(b));
+}
+
+}  // namespace
+
+PrefixIntegralFluxAlgorithm::RestFrameTable::RestFrameTable(const XYDataset::XYDataset& rest_frame_sed) {
+  m_knots.reserve(rest_frame_sed.size());
+  m_values.reserve(rest_frame_sed.size());
+  for (auto& sed_pair : rest_frame_sed) {
+    m_knots.emplace_back(sed_pair.first);
+    m_values.emplace_back(sed_pair.second);
+  }
+
+  m_zeroth_moment.resize(m_knots.size(), 0.);
+  m_first_moment.resize(m_knots.size(), 0.);
+  for (size_t k = 1; k < m_knots.size(); ++k) {
+    double a  = m_knots[k - 1];
+    double b  = m_knots[k];
+    double m  = (a + b) / 2.;
+    double sa = m_values[k - 1];
+    double sb = m_values[k];
+    double sm = (sa + sb) / 2.;
+    m_zeroth_moment[k] = m_zeroth_moment[k - 1] + simpson(a, b, sa, sm, sb);
+    m_first_moment[k]  = m_first_moment[k - 1] + simpson(a, b, a * sa, m * sm, b * sb);
+  }
+}
+
+const std::vector<double>& PrefixIntegralFluxAlgorithm::RestFrameTable::getKnots() const {
+  return m_knots;
+}
+
+const std::vector<double>& PrefixIntegralFluxAlgorithm::RestFrameTable::getValues() const {
+  return m_values;
+}
+
+double PrefixIntegralFluxAlgorithm::RestFrameTable::cumulative(double x, int order) const {
+  if (m_knots.empty() || x <= m_knots.front()) {
+    return 0.;
+  }
+  auto& moment = (order == 0) ? m_zeroth_moment : m_first_moment;
+  if (x >= m_knots.back()) {
+    return moment.back();
+  }
+
+  // Find the segment x_k <= x < x_k+1 and add its partial integral
+  size_t k     = std::upper_bound(m_knots.begin(), m_knots.end(), x) - m_knots.begin() - 1;
+  double a     = m_knots[k];
+  double sa    = m_values[k];
+  double slope = (m_values[k + 1] - sa) / (m_knots[k + 1] - a);
+  double m     = (a + x) / 2.;
+  double sm    = sa + slope * (m - a);
+  double sx    = sa + slope * (x - a);
+  if (order == 0) {
+    return moment[k] + simpson(a, x, sa, sm, sx);
+  }
+  return moment[k] + simpson(a, x, a * sa, m * sm, x * sx);
+}
+
+PrefixIntegralFluxAlgorithm::PrefixIntegralFluxAlgorithm(const std::vector<XYDataset::XYDataset>&       filters,
+                                                         const std::vector<std::pair<double, double>>& ranges,
+                                                         const std::vector<double>& normalizations) {
+  if (filters.size() != ranges.size() || filters.size() != normalizations.size()) {
+    throw Elements::Exception() << "Inconsistent number of filters (" << filters.size() << "), ranges ("
+                                << ranges.size() << ") and normalizations (" << normalizations.size() << ")";
+  }
+  for (size_t i = 0; i < filters.size(); ++i) {
+    FilterSegments segments{};
+    for (auto& filter_pair : filters[i]) {
+      if (filter_pair.first >= ranges[i].first && filter_pair.first <= ranges[i].second) {
+        segments.knots.emplace_back(filter_pair.first);
+        segments.values.emplace_back(filter_pair.second);
+      }
+    }
+    segments.normalization = normalizations[i];
+    m_filters.emplace_back(std::move(segments));
+  }
+}
+
+void PrefixIntegralFluxAlgorithm::operator()(const RestFrameTable& table, double one_plus_z, double flux_factor,
+                                             const std::vector<double>&                 igm_transmission,
+                                             std::vector<SourceCatalog::FluxErrorPair>& fluxes) const {
+  auto&  sed_knots  = table.getKnots();
+  auto&  sed_values = table.getValues();
+  size_t absorbed   = std::min(igm_transmission.size(), sed_knots.size());
+
+  // The SED segments below the cut have at least one absorbed knot and are
+  // integrated directly. The ones above use the cumulative tables.
+  double cut          = (absorbed == 0) ? std::numeric_limits<double>::lowest()
+                                        : sed_knots[std::min(absorbed, sed_knots.size() - 1)];
+  auto   transmission = [&](size_t k) {
+    return (k < absorbed) ? igm_transmission[k] : 1.;
+  };
+
+  for (size_t f = 0; f < m_filters.size(); ++f) {
+    auto&  filter = m_filters[f];
+    double total  = 0.;
+
+    for (size_t j = 0; j + 1 < filter.knots.size(); ++j) {
+      double ta = filter.values[j];
+      double tb = filter.values[j + 1];
+      if (ta == 0. && tb == 0.) {
+        continue;
+      }
+
+      // On this segment the transmission is T((1+z) x) = A + B x
+      double slope = (tb - ta) / (filter.knots[j + 1] - filter.knots[j]);
+      double A     = ta - slope * filter.knots[j];
+      double B     = slope * one_plus_z;
+      double a     = filter.knots[j] / one_plus_z;
+      double b     = filter.knots[j + 1] / one_plus_z;
+
+      // The part affected by the IGM absorption
+      if (a < cut) {
+        double end = std::min(b, cut);
+        size_t k   = std::upper_bound(sed_knots.begin(), sed_knots.end(), a) - sed_knots.begin();
+        k          = (k == 0) ? 0 : k - 1;
+        for (; k + 1 < sed_knots.size() && sed_knots[k] < end; ++k) {
+          double lo = std::max(a, sed_knots[k]);
+          double hi = std::min(end, sed_knots[k + 1]);
+          if (lo < hi) {
+            total += segmentIntegral(lo, hi, A, B, sed_knots[k], sed_values[k] * transmission(k), sed_knots[k + 1],
+                                     sed_values[k + 1] * transmission(k + 1));
+          }
+        }
+      }
+
+      // The unabsorbed part, from the cumulative tables
+      double lo = std::max(a, cut);
+      if (lo < b) {
+        total += A * (table.cumulative(b, 0) - table.cumulative(lo, 0)) +
+                 B * (table.cumulative(b, 1) - table.cumulative(lo, 1));
+      }
+    }
+
+    // The change of variable x = lambda / (1+z) adds a (1+z) factor
+    fluxes[f].flux = flux_factor * one_plus_z * total / filter.normalization;
+    fluxes[f].flux *= 1E29;  // convert erg/s/cm^2/Hz to micro-Jansky
+    fluxes[f].error = 0.;
+  }
+}
+
+}  // end of namespace PhzModeling
+}  // end of namespace Euclid
@@ -23,41 +23,198 @@
  */
 
 #include "PhzModeling/SparseGridCreator.h"
+#include "AlexandriaKernel/ThreadPool.h"
 #include "ElementsKernel/Logging.h"
 #include "GridContainer/GridIndexHelper.h"
 #include "PhzModeling/PhotometryGridCreator.h"
+#include "PhzUtils/Multithreading.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <set>
+#include <thread>
 
 namespace Euclid {
 namespace PhzModeling {
 
 static Elements::Logging logger = Elements::Logging::getLogger("SparseGridCreator");
 
-class SparseProgressReporter {
+/// The location of the models of a SED in the grid of a previous region
+struct ReusedSed {
+  size_t                        source_region = 0;
+  PhzDataModel::PhotometryGrid* grid          = nullptr;
+  std::vector<size_t>           z_map{};
+  std::vector<size_t>           ebv_map{};
+  std::vector<size_t>           curve_map{};
+  size_t                        sed_index = 0;
+};
+
+/// The plan for building one region of the parameter space
+struct RegionJob {
+  const std::string*                                 name   = nullptr;
+  const PhzDataModel::ModelAxesTuple*                axes   = nullptr;
+  size_t                                             size   = 0;
+  size_t                                             memory = 0;
+  std::map<size_t, ReusedSed>                        reused_seds{};
+  std::vector<XYDataset::QualifiedName>              computed_seds{};
+  std::set<size_t>                                   source_regions{};
+  std::vector<std::vector<XYDataset::QualifiedName>> chunks{};
+  size_t                                             first_chunk = 0;
+};
+
+/*
+ * A read-only copy of the datasets of a provider, which the threads building
+ * the chunks can access concurrently, as the providers are not thread-safe.
+ * The FilterType parameter of the datasets is copied as well.
+ */
+class PreloadedProvider : public XYDataset::XYDatasetProvider {
 
 public:
-  SparseProgressReporter(SparseGridCreator::ProgressListener parent_listener, size_t already_done, size_t total)
-      : m_parent_listener{parent_listener}, m_already_done{already_done}, m_total{total} {}
+  PreloadedProvider(XYDataset::XYDatasetProvider& provider, const std::set<XYDataset::QualifiedName>& names,
+                    bool with_filter_type) {
+    for (auto& name : names) {
+      auto dataset = provider.getDataset(name);
+      if (dataset) {
+        m_datasets.emplace(name, std::move(*dataset));
+      }
+      if (with_filter_type) {
+        m_filter_types.emplace(name, provider.getParameter(name, "FilterType"));
+      }
+    }
+  }
 
-  void operator()(size_t step, size_t) {
-    m_parent_listener(m_already_done + step, m_total);
+  std::unique_ptr<XYDataset::XYDataset> getDataset(const XYDataset::QualifiedName& qualified_name) override {
+    auto found = m_datasets.find(qualified_name);
+    if (found == m_datasets.end()) {
+      return nullptr;
+    }
+    return std::unique_ptr<XYDataset::XYDataset>{new XYDataset::XYDataset(found->second)};
+  }
+
+  std::string getParameter(const XYDataset::QualifiedName& qualified_name, const std::string& key_word) override {
+    auto found = m_filter_types.find(qualified_name);
+    if (key_word != "FilterType" || found == m_filter_types.end()) {
+      return "";
+    }
+    return found->second;
+  }
+
+  std::vector<XYDataset::QualifiedName> listContents(const std::string& group) override {
+    std::vector<XYDataset::QualifiedName> result{};
+    for (auto& pair : m_datasets) {
+      if (pair.first.qualifiedName().compare(0, group.size(), group) == 0) {
+        result.emplace_back(pair.first);
+      }
+    }
+    return result;
   }
 
 private:
-  SparseGridCreator::ProgressListener m_parent_listener;
-  size_t                              m_already_done;
-  size_t                              m_total;
+  std::map<XYDataset::QualifiedName, XYDataset::XYDataset> m_datasets{};
+  std::map<XYDataset::QualifiedName, std::string>          m_filter_types{};
 };
 
+/*
+ * Sets the index in the source axis of each value of the target axis. Returns
+ * false if some of the values are missing from the source axis.
+ */
+template <typename T>
+static bool mapAxis(const GridContainer::GridAxis<T>& target, const GridContainer::GridAxis<T>& source,
+                    std::vector<size_t>& index_map) {
+  index_map.clear();
+  for (auto& value : target) {
+    auto found = std::find(source.begin(), source.end(), value);
+    if (found == source.end()) {
+      return false;
+    }
+    index_map.emplace_back(found - source.begin());
+  }
+  return true;
+}
+
+/// Returns the axes of the region restricted to the given SEDs
+static PhzDataModel::ModelAxesTuple chunkAxes(const PhzDataModel::ModelAxesTuple&          axes,
+                                              const std::vector<XYDataset::QualifiedName>& seds) {
+  auto& z_axis     = std::get<PhzDataModel::ModelParameter::Z>(axes);
+  auto& ebv_axis   = std::get<PhzDataModel::ModelParameter::EBV>(axes);
+  auto& curve_axis = std::get<PhzDataModel::ModelParameter::REDDENING_CURVE>(axes);
+  return PhzDataModel::createAxesTuple(std::vector<double>(z_axis.begin(), z_axis.end()),
+                                       std::vector<double>(ebv_axis.begin(), ebv_axis.end()),
+                                       std::vector<XYDataset::QualifiedName>(curve_axis.begin(), curve_axis.end()),
+                                       seds);
+}
+
+/*
+ * Builds the grid of a region from the grids of its chunks. The SEDs already
+ * computed in a previous region are copied from its grid.
+ */
+static PhzDataModel::PhotometryGrid
+assembleRegion(const RegionJob& job, std::vector<std::unique_ptr<PhzDataModel::PhotometryGrid>>& chunk_grids,
+               const std::vector<XYDataset::QualifiedName>& filter_name_list) {
+  if (job.reused_seds.empty() && job.chunks.size() == 1) {
+    return std::move(*chunk_grids[job.first_chunk]);
+  }
+
+  auto& z_axis     = std::get<PhzDataModel::ModelParameter::Z>(*job.axes);
+  auto& ebv_axis   = std::get<PhzDataModel::ModelParameter::EBV>(*job.axes);
+  auto& curve_axis = std::get<PhzDataModel::ModelParameter::REDDENING_CURVE>(*job.axes);
+  auto& sed_axis   = std::get<PhzDataModel::ModelParameter::SED>(*job.axes);
+
+  if (!job.reused_seds.empty()) {
+    logger.info() << "Reusing " << job.reused_seds.size() << " SEDs of region \"" << *job.name
+                  << "\" already computed in previous regions";
+  }
+  PhzDataModel::PhotometryGrid grid{*job.axes, filter_name_list};
+
+  // The computed SEDs are split in consecutive chunks
+  size_t chunk          = job.first_chunk;
+  size_t computed_index = 0;
+  for (size_t sed_index = 0; sed_index < sed_axis.size(); ++sed_index) {
+    auto reused = job.reused_seds.find(sed_index);
+    for (size_t curve_index = 0; curve_index < curve_axis.size(); ++curve_index) {
+      for (size_t ebv_index = 0; ebv_index < ebv_axis.size(); ++ebv_index) {
+        for (size_t z_index = 0; z_index < z_axis.size(); ++z_index) {
+          if (reused != job.reused_seds.end()) {
+            auto& r = reused->second;
+            grid(z_index, ebv_index, curve_index, sed_index) =
+                (*r.grid)(r.z_map[z_index], r.ebv_map[ebv_index], r.curve_map[curve_index], r.sed_index);
+          } else {
+            grid(z_index, ebv_index, curve_index, sed_index) =
+                (*chunk_grids[chunk])(z_index, ebv_index, curve_index, computed_index);
+          }
+        }
+      }
+    }
+    if (reused == job.reused_seds.end() &&
+        ++computed_index == chunk_grids[chunk]->getAxis<PhzDataModel::ModelParameter::SED>().size()) {
+      ++chunk;
+      computed_index = 0;
+    }
+  }
+
+  return grid;
+}
+
 SparseGridCreator::SparseGridCreator(std::shared_ptr<XYDataset::XYDatasetProvider> sed_provider,
                                      std::shared_ptr<XYDataset::XYDatasetProvider> reddening_curve_provider,
                                      std::shared_ptr<XYDataset::XYDatasetProvider> filter_provider,
                                      IgmAbsorptionFunction                         igm_absorption_function,
-                                     NormalizationFunction                         normalization_function)
+                                     NormalizationFunction                         normalization_function,
+                                     PhotometryGridCreator::FluxAlgorithm flux_algorithm, double validation_tolerance,
+                                     size_t memory_limit)
     : m_sed_provider{sed_provider}
     , m_reddening_curve_provider{reddening_curve_provider}
     , m_filter_provider(filter_provider)
     , m_igm_absorption_function{igm_absorption_function}
-    , m_normalization_function{normalization_function} {}
+    , m_normalization_function{normalization_function}
+    , m_flux_algorithm{flux_algorithm}
+    , m_validation_tolerance{validation_tolerance}
+    , m_memory_limit{memory_limit} {}
 
 std::map<std::string, PhzDataModel::PhotometryGrid>
 SparseGridCreator::createGrid(const std::map<std::string, PhzDataModel::ModelAxesTuple>& parameter_space_map,
@@ -65,26 +222,216 @@ SparseGridCreator::createGrid(const std::map<std::string, PhzDataModel::ModelAxe
                               const PhysicsUtils::CosmologicalParameters&                cosmology,
                               ProgressListener                                           progress_listener) {
 
-  std::map<std::string, PhzDataModel::PhotometryGrid> results{};
-
-  PhzModeling::PhotometryGridCreator creator{std::move(m_sed_provider), std::move(m_reddening_curve_provider),
-                                             std::move(m_filter_provider), std::move(m_igm_absorption_function),
-                                             std::move(m_normalization_function)};
-
   // Compute the total number of models
   size_t total = 0;
   for (auto& pair : parameter_space_map) {
     total += GridContainer::makeGridIndexHelper(pair.second).m_axes_index_factors.back();
   }
+  unsigned int thread_budget = std::max(1u, PhzUtils::getThreadNumber().load());
 
-  size_t already_done = 0;
+  // Plan the regions. The SEDs which are computed in a previous region for all
+  // the redshifts, E(B-V) values and reddening curves of a region are copied,
+  // so the region has to wait for that one.
+  std::vector<RegionJob> jobs{};
+  size_t                 chunk_count = 0;
   for (auto& pair : parameter_space_map) {
-    logger.info() << "Creating grid for parameter space region : \"" << pair.first << '\"';
-    SparseProgressReporter reporter{progress_listener, already_done, total};
-    results.emplace(make_pair(pair.first, creator.createGrid(pair.second, filter_name_list, cosmology, reporter)));
-    already_done += results.at(pair.first).size();
+    RegionJob job{};
+    job.name   = &pair.first;
+    job.axes   = &pair.second;
+    job.size   = GridContainer::makeGridIndexHelper(pair.second).m_axes_index_factors.back();
+    job.memory = 2 * job.size * filter_name_list.size() * sizeof(SourceCatalog::FluxErrorPair);
+
+    auto& z_axis     = std::get<PhzDataModel::ModelParameter::Z>(pair.second);
+    auto& ebv_axis   = std::get<PhzDataModel::ModelParameter::EBV>(pair.second);
+    auto& curve_axis = std::get<PhzDataModel::ModelParameter::REDDENING_CURVE>(pair.second);
+    auto& sed_axis   = std::get<PhzDataModel::ModelParameter::SED>(pair.second);
+    for (size_t sed_index = 0; sed_index < sed_axis.size(); ++sed_index) {
+      ReusedSed reused{};
+      bool      found = false;
+      for (size_t done = 0; done < jobs.size() && !found; ++done) {
+        auto& done_axes = *jobs[done].axes;
+        auto& done_seds = std::get<PhzDataModel::ModelParameter::SED>(done_axes);
+        auto  done_sed  = std::find(done_seds.begin(), done_seds.end(), sed_axis[sed_index]);
+        found           = done_sed != done_seds.end() &&
+                mapAxis(z_axis, std::get<PhzDataModel::ModelParameter::Z>(done_axes), reused.z_map) &&
+                mapAxis(ebv_axis, std::get<PhzDataModel::ModelParameter::EBV>(done_axes), reused.ebv_map) &&
+                mapAxis(curve_axis, std::get<PhzDataModel::ModelParameter::REDDENING_CURVE>(done_axes),
+                        reused.curve_map);
+        if (found) {
+          reused.source_region = done;
+          reused.sed_index     = done_sed - done_seds.begin();
+        }
+      }
+      if (found) {
+        job.source_regions.insert(reused.source_region);
+        job.reused_seds.emplace(sed_index, std::move(reused));
+      } else {
+        job.computed_seds.emplace_back(sed_axis[sed_index]);
+      }
+    }
+
+    // The computed SEDs are split in a chunk per thread, so all the threads can
+    // work on a single region
+    size_t chunks = std::min<size_t>(thread_budget, job.computed_seds.size());
+    for (size_t chunk = 0; chunk < chunks; ++chunk) {
+      job.chunks.emplace_back(job.computed_seds.begin() + chunk * job.computed_seds.size() / chunks,
+                              job.computed_seds.begin() + (chunk + 1) * job.computed_seds.size() / chunks);
+    }
+    job.first_chunk = chunk_count;
+    chunk_count += chunks;
+    jobs.emplace_back(std::move(job));
   }
 
+  // The biggest regions are started first
+  std::vector<size_t> order(jobs.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&jobs](size_t a, size_t b) {
+    return jobs[a].size > jobs[b].size;
+  });
+
+  // The datasets are loaded before starting the threads, which only read them
+  std::set<XYDataset::QualifiedName> sed_names{};
+  std::set<XYDataset::QualifiedName> curve_names{};
+  for (auto& job : jobs) {
+    if (!job.computed_seds.empty()) {
+      auto& curve_axis = std::get<PhzDataModel::ModelParameter::REDDENING_CURVE>(*job.axes);
+      sed_names.insert(job.computed_seds.begin(), job.computed_seds.end());
+      curve_names.insert(curve_axis.begin(), curve_axis.end());
+    }
+  }
+  std::set<XYDataset::QualifiedName> filter_names(filter_name_list.begin(), filter_name_list.end());
+  auto sed_provider    = std::make_shared<PreloadedProvider>(*m_sed_provider, sed_names, false);
+  auto curve_provider  = std::make_shared<PreloadedProvider>(*m_reddening_curve_provider, curve_names, false);
+  auto filter_provider = std::make_shared<PreloadedProvider>(*m_filter_provider, filter_names, true);
+
+  // The chunks of the started regions are queued to a single pool of threads,
+  // so the threads move to the next region as soon as there is no chunk left
+  // in the previous ones. A region is started when the regions it copies SEDs
+  // from are started and its working memory fits in the limit. Each chunk is
+  // computed in its pool thread, which updates the chunk progress counter.
+  PhotometryGridCreator creator{sed_provider,
+                                curve_provider,
+                                filter_provider,
+                                m_igm_absorption_function,
+                                m_normalization_function,
+                                m_flux_algorithm,
+                                m_validation_tolerance};
+  creator.setThreadNumber(1);
+  std::vector<std::unique_ptr<PhzDataModel::PhotometryGrid>> chunk_grids(chunk_count);
+  std::vector<std::atomic<size_t>>                           chunk_progress(chunk_count);
+  std::vector<std::atomic<size_t>>                           remaining(jobs.size());
+  std::vector<std::unique_ptr<PhzDataModel::PhotometryGrid>> grids(jobs.size());
+  std::vector<bool>                                          started(jobs.size(), false);
+  std::atomic<bool>                                          failed{false};
+  std::exception_ptr                                         failure{};
+  std::mutex                                                 failure_mutex{};
+  size_t                                                     used_memory = 0;
+  size_t                                                     open        = 0;
+  size_t                                                     finished    = 0;
+  for (auto& p : chunk_progress) {
+    p = 0;
+  }
+  ThreadPool thread_pool{thread_budget};
+
+  auto can_start = [&](size_t index) {
+    auto& job = jobs[index];
+    if (started[index]) {
+      return false;
+    }
+    for (auto source : job.source_regions) {
+      if (!started[source]) {
+        return false;
+      }
+    }
+    return open == 0 || m_memory_limit == 0 || used_memory + job.memory <= m_memory_limit;
+  };
+
+  while (finished < jobs.size()) {
+    for (auto index : order) {
+      if (!can_start(index)) {
+        continue;
+      }
+      auto& job = jobs[index];
+      logger.info() << "Creating grid for parameter space region : \"" << *job.name << "\"";
+      if (m_memory_limit > 0 && job.memory > m_memory_limit) {
+        logger.warn() << "The region \"" << *job.name << "\" needs more memory than the limit";
+      }
+      started[index]   = true;
+      remaining[index] = job.chunks.size();
+      used_memory += job.memory;
+      ++open;
+      for (size_t chunk = 0; chunk < job.chunks.size(); ++chunk) {
+        size_t chunk_index = job.first_chunk + chunk;
+        thread_pool.submit([&, index, chunk, chunk_index]() {
+          try {
+            if (!failed) {
+              auto& job_progress = chunk_progress[chunk_index];
+              chunk_grids[chunk_index].reset(new PhzDataModel::PhotometryGrid(creator.createGrid(
+                  chunkAxes(*jobs[index].axes, jobs[index].chunks[chunk]), filter_name_list, cosmology,
+                  PhotometryGridCreator::ProgressListener{[&job_progress](size_t step, size_t) {
+                    job_progress = step;
+                  }})));
+            }
+          } catch (...) {
+            std::lock_guard<std::mutex> lock(failure_mutex);
+            if (!failed) {
+              failure = std::current_exception();
+              failed  = true;
+            }
+          }
+          --remaining[index];
+        });
+      }
+    }
+
+    // Wait for some region to finish, updating the progress every .1 sec
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    if (failed) {
+      thread_pool.block();
+      std::rethrow_exception(failure);
+    }
+    for (auto index : order) {
+      auto& job = jobs[index];
+      if (!started[index] || grids[index] != nullptr || remaining[index] > 0) {
+        continue;
+      }
+      bool sources_finished = true;
+      for (auto source : job.source_regions) {
+        sources_finished = sources_finished && grids[source] != nullptr;
+      }
+      if (!sources_finished) {
+        continue;
+      }
+      for (auto& reused : job.reused_seds) {
+        reused.second.grid = grids[reused.second.source_region].get();
+      }
+      grids[index].reset(new PhzDataModel::PhotometryGrid(assembleRegion(job, chunk_grids, filter_name_list)));
+      for (size_t chunk = 0; chunk < job.chunks.size(); ++chunk) {
+        chunk_grids[job.first_chunk + chunk].reset();
+      }
+      used_memory -= job.memory;
+      --open;
+      ++finished;
+    }
+    if (progress_listener) {
+      size_t done = 0;
+      for (size_t index = 0; index < jobs.size(); ++index) {
+        if (grids[index] != nullptr) {
+          done += jobs[index].size;
+          continue;
+        }
+        for (size_t chunk = 0; chunk < jobs[index].chunks.size(); ++chunk) {
+          done += chunk_progress[jobs[index].first_chunk + chunk];
+        }
+      }
+      progress_listener(done, total);
+    }
+  }
+
+  std::map<std::string, PhzDataModel::PhotometryGrid> results{};
+  for (size_t index = 0; index < jobs.size(); ++index) {
+    results.emplace(*jobs[index].name, std::move(*grids[index]));
+  }
   return results;
 }
 
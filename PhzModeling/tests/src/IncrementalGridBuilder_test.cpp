@@ -0,0 +1,161 @@
+/**
+ * Copyright (C) 2022 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file tests/src/IncrementalGridBuilder_test.cpp
+ * @date 2026/10/18
+ */
+
+#include "ElementsKernel/Exception.h"
+#include "PhzModeling/IncrementalGridBuilder.h"
+#include <boost/test/unit_test.hpp>
+
+using namespace Euclid::PhzDataModel;
+using Euclid::PhzModeling::IncrementalGridBuilder;
+using Euclid::XYDataset::QualifiedName;
+
+struct IncrementalGridBuilder_Fixture {
+
+  std::vector<std::string> filters{"F1", "F2"};
+  size_t                   computed_cells = 0;
+
+  // A model flux which identifies the cell parameters
+  static double modelFlux(double z, double ebv, const QualifiedName& curve, const QualifiedName& sed) {
+    return z + 10 * ebv + 100 * std::stod(curve.datasetName()) + 1000 * std::stod(sed.datasetName());
+  }
+
+  PhotometryGrid computeGrid(const ModelAxesTuple& axes) {
+    PhotometryGrid grid{axes, filters};
+    for (auto iter = grid.begin(); iter != grid.end(); ++iter) {
+      double flux = modelFlux(iter.axisValue<ModelParameter::Z>(), iter.axisValue<ModelParameter::EBV>(),
+                              iter.axisValue<ModelParameter::REDDENING_CURVE>(),
+                              iter.axisValue<ModelParameter::SED>());
+      for (auto& value : *iter) {
+        value.flux = flux;
+      }
+      ++computed_cells;
+    }
+    return grid;
+  }
+
+  IncrementalGridBuilder::GridFunction grid_function =
+      [this](const std::map<std::string, ModelAxesTuple>& region_axes_map, IncrementalGridBuilder::ProgressListener) {
+        std::map<std::string, PhotometryGrid> result{};
+        for (auto& pair : region_axes_map) {
+          result.emplace(pair.first, computeGrid(pair.second));
+        }
+        return result;
+      };
+
+  ModelAxesTuple existing_axes = createAxesTuple({0., 1.}, {0., 0.1}, {{"1"}}, {{"1"}, {"2"}});
+  ModelAxesTuple requested_axes =
+      createAxesTuple({2., 0., 1.}, {0.1, 0., 0.2}, {{"1"}, {"2"}}, {{"3"}, {"1"}, {"2"}});
+
+  void checkGrid(PhotometryGrid& grid) {
+    for (auto iter = grid.begin(); iter != grid.end(); ++iter) {
+      double expected = modelFlux(iter.axisValue<ModelParameter::Z>(), iter.axisValue<ModelParameter::EBV>(),
+                                  iter.axisValue<ModelParameter::REDDENING_CURVE>(),
+                                  iter.axisValue<ModelParameter::SED>());
+      for (auto& value : *iter) {
+        BOOST_CHECK_EQUAL(value.flux, expected);
+      }
+    }
+  }
+};
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE(IncrementalGridBuilder_test)
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(missingSubspaces_test, IncrementalGridBuilder_Fixture) {
+
+  // When
+  auto subspaces = IncrementalGridBuilder::missingSubspaces(requested_axes, existing_axes);
+
+  // Then
+  BOOST_CHECK_EQUAL(subspaces.size(), 4);
+  size_t missing = 0;
+  for (auto& axes : subspaces) {
+    missing += std::get<0>(axes).size() * std::get<1>(axes).size() * std::get<2>(axes).size() *
+               std::get<3>(axes).size();
+  }
+  // All the cells but the 2x2x1x2 existing ones
+  BOOST_CHECK_EQUAL(missing, 3 * 3 * 2 * 3 - 8);
+  BOOST_CHECK(IncrementalGridBuilder::missingSubspaces(existing_axes, existing_axes).empty());
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(createGrid_test, IncrementalGridBuilder_Fixture) {
+
+  // Given
+  std::map<std::string, PhotometryGrid> existing{};
+  existing.emplace("REGION1", computeGrid(existing_axes));
+  existing.emplace("DROPPED", computeGrid(existing_axes));
+  computed_cells = 0;
+  IncrementalGridBuilder builder{grid_function};
+
+  // When
+  auto result = builder.createGrid({{"REGION1", requested_axes}, {"REGION2", existing_axes}}, std::move(existing));
+
+  // Then
+  BOOST_CHECK_EQUAL(result.size(), 2);
+  BOOST_CHECK_EQUAL(computed_cells, 3 * 3 * 2 * 3 - 8 + 8);
+  BOOST_CHECK_EQUAL(result.at("REGION1").size(), 3 * 3 * 2 * 3);
+  checkGrid(result.at("REGION1"));
+  checkGrid(result.at("REGION2"));
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(reuse_test, IncrementalGridBuilder_Fixture) {
+
+  // Given
+  std::map<std::string, PhotometryGrid> existing{};
+  existing.emplace("REGION1", computeGrid(requested_axes));
+  computed_cells = 0;
+  IncrementalGridBuilder builder{grid_function};
+
+  // When
+  auto result = builder.createGrid({{"REGION1", existing_axes}}, std::move(existing));
+
+  // Then
+  BOOST_CHECK_EQUAL(computed_cells, 0);
+  BOOST_CHECK_EQUAL(result.at("REGION1").size(), 8);
+  checkGrid(result.at("REGION1"));
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(filterMismatch_test, IncrementalGridBuilder_Fixture) {
+
+  // Given
+  std::map<std::string, PhotometryGrid> existing{};
+  existing.emplace("REGION1", computeGrid(existing_axes));
+  filters = {"F1", "F3"};
+  IncrementalGridBuilder builder{grid_function};
+
+  // Then
+  BOOST_CHECK_THROW(builder.createGrid({{"REGION1", requested_axes}}, std::move(existing)), Elements::Exception);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END()
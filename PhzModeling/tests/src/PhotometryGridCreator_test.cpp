@@ -7,9 +7,11 @@
 #include "PhzModeling/PhotometryGridCreator.h"
 
 #include <boost/test/unit_test.hpp>
+#include <cmath>
 #include <map>
 #include <set>
 #include <string>
+#include <thread>
 
 #include "PhzModeling/NoIgmFunctor.h"
 
@@ -261,4 +263,179 @@ BOOST_FIXTURE_TEST_CASE(execution_test, PhotometryGridCreator_Fixture) {
   BOOST_CHECK(sum_filter_1 > 0.);
 }
 
+BOOST_FIXTURE_TEST_CASE(single_thread_test, PhotometryGridCreator_Fixture) {
+  BOOST_TEST_MESSAGE(" ");
+  BOOST_TEST_MESSAGE("--> Testing a single thread computes the grid in the calling one");
+  BOOST_TEST_MESSAGE(" ");
+
+  // Given
+  std::vector<double>                           zs{0.0, 0.1, 0.2};
+  std::vector<double>                           ebvs{0.0, 0.001};
+  std::vector<Euclid::XYDataset::QualifiedName> reddeing_curves{{"extinction/curve_1"}};
+  std::vector<Euclid::XYDataset::QualifiedName> seds{{"sed/sed_1"}, {"sed/sed_2"}};
+  auto axes = Euclid::PhzDataModel::createAxesTuple(zs, ebvs, reddeing_curves, seds);
+  std::vector<Euclid::XYDataset::QualifiedName> filter_name_list{Euclid::XYDataset::QualifiedName{"filter/filter_1"},
+                                                                 Euclid::XYDataset::QualifiedName{"filter/filter_2"}};
+
+  std::shared_ptr<Euclid::XYDataset::XYDatasetProvider> shared_sed_provider{std::move(sed_provider)};
+  std::shared_ptr<Euclid::XYDataset::XYDatasetProvider> shared_reddening_provider{std::move(reddening_provider)};
+  std::shared_ptr<Euclid::XYDataset::XYDatasetProvider> shared_filter_provider{std::move(filter_provider)};
+  Euclid::PhzModeling::PhotometryGridCreator            gridCreator{shared_sed_provider, shared_reddening_provider,
+                                                         shared_filter_provider, Euclid::PhzModeling::NoIgmFunctor{},
+                                                         m_norm_function};
+  auto expected = gridCreator.createGrid(axes, filter_name_list, {});
+
+  auto   caller      = std::this_thread::get_id();
+  size_t calls       = 0;
+  size_t last_step   = 0;
+  bool   same_thread = true;
+  auto   progress    = [&](size_t step, size_t) {
+    same_thread = same_thread && std::this_thread::get_id() == caller;
+    last_step   = step;
+    ++calls;
+  };
+  gridCreator.setThreadNumber(1);
+
+  // When
+  auto photometry_grid = gridCreator.createGrid(axes, filter_name_list, {}, progress);
+
+  // Then
+  BOOST_CHECK(same_thread);
+  BOOST_CHECK_EQUAL(last_step, photometry_grid.size());
+  BOOST_CHECK_EQUAL(calls, photometry_grid.size() + 1);
+  auto expected_iter = expected.begin();
+  for (auto photometry : photometry_grid) {
+    auto expected_photometry = *expected_iter;
+    auto expected_flux       = expected_photometry.begin();
+    for (auto& flux : photometry) {
+      BOOST_CHECK_EQUAL(flux.flux, (*expected_flux).flux);
+      ++expected_flux;
+    }
+    ++expected_iter;
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(prefix_integral_test, PhotometryGridCreator_Fixture) {
+  BOOST_TEST_MESSAGE(" ");
+  BOOST_TEST_MESSAGE("--> Testing the prefix integral algorithm");
+  BOOST_TEST_MESSAGE(" ");
+
+  // Finely sampled datasets, so both algorithms converge to the same fluxes
+  std::vector<std::pair<double, double>> sed_values{}, curve_values{}, filter_1_values{}, filter_2_values{};
+  for (double l = 1000.; l <= 30000.; l += 10.) {
+    sed_values.emplace_back(l, 1. + 0.5 * std::sin(l / 1000.));
+    curve_values.emplace_back(l, 1E4 / l);
+  }
+  for (double l = 9000.; l <= 15000.; l += 10.) {
+    filter_1_values.emplace_back(l, std::sin((l - 9000.) / 6000. * M_PI));
+    filter_2_values.emplace_back(l + 4000., (l < 12000.) ? 0.5 : 1.);
+  }
+  std::map<Euclid::XYDataset::QualifiedName, Euclid::XYDataset::XYDataset> seds{}, curves{}, filters{};
+  seds.emplace(Euclid::XYDataset::QualifiedName{"sed/sed_1"}, sed_values);
+  curves.emplace(Euclid::XYDataset::QualifiedName{"extinction/curve_1"}, curve_values);
+  filters.emplace(Euclid::XYDataset::QualifiedName{"filter/filter_1"}, filter_1_values);
+  filters.emplace(Euclid::XYDataset::QualifiedName{"filter/filter_2"}, filter_2_values);
+  std::shared_ptr<Euclid::XYDataset::XYDatasetProvider> dense_sed_provider{new DatasetProvider{std::move(seds)}};
+  std::shared_ptr<Euclid::XYDataset::XYDatasetProvider> dense_reddening_provider{new DatasetProvider{std::move(curves)}};
+  std::shared_ptr<Euclid::XYDataset::XYDatasetProvider> dense_filter_provider{new DatasetProvider{std::move(filters)}};
+
+  std::vector<double>                           zs{0.0, 0.3, 0.6, 0.9};
+  std::vector<double>                           ebvs{0.0, 0.1, 0.5};
+  std::vector<Euclid::XYDataset::QualifiedName> reddeing_curves{{"extinction/curve_1"}};
+  std::vector<Euclid::XYDataset::QualifiedName> sed_names{{"sed/sed_1"}};
+  auto axes = Euclid::PhzDataModel::createAxesTuple(zs, ebvs, reddeing_curves, sed_names);
+  std::vector<Euclid::XYDataset::QualifiedName> filter_name_list{Euclid::XYDataset::QualifiedName{"filter/filter_1"},
+                                                                 Euclid::XYDataset::QualifiedName{"filter/filter_2"}};
+
+  using FluxAlgorithm = Euclid::PhzModeling::PhotometryGridCreator::FluxAlgorithm;
+  Euclid::PhzModeling::PhotometryGridCreator interpolation_creator{dense_sed_provider, dense_reddening_provider,
+                                                                   dense_filter_provider,
+                                                                   Euclid::PhzModeling::NoIgmFunctor{}, m_norm_function};
+  Euclid::PhzModeling::PhotometryGridCreator prefix_creator{dense_sed_provider,
+                                                            dense_reddening_provider,
+                                                            dense_filter_provider,
+                                                            Euclid::PhzModeling::NoIgmFunctor{},
+                                                            m_norm_function,
+                                                            FluxAlgorithm::PREFIX_INTEGRAL,
+                                                            1E-3};
+
+  // When
+  auto expected = interpolation_creator.createGrid(axes, filter_name_list, {});
+  auto result   = prefix_creator.createGrid(axes, filter_name_list, {});
+
+  // Then
+  auto expected_iter = expected.begin();
+  for (auto photometry : result) {
+    auto expected_photometry = *expected_iter;
+    auto expected_flux       = expected_photometry.begin();
+    for (auto& flux : photometry) {
+      BOOST_CHECK_CLOSE(flux.flux, (*expected_flux).flux, 0.1);
+      BOOST_CHECK_EQUAL(flux.error, (*expected_flux).error);
+      ++expected_flux;
+    }
+    ++expected_iter;
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(zero_ebv_deduplication_test, PhotometryGridCreator_Fixture) {
+  BOOST_TEST_MESSAGE(" ");
+  BOOST_TEST_MESSAGE("--> Testing the models at E(B-V)=0 are shared by all the curves");
+  BOOST_TEST_MESSAGE(" ");
+
+  // Given
+  std::vector<double>                           zs{0.0, 0.1, 0.2};
+  std::vector<double>                           ebvs{0.1, 0.0, 0.2};
+  std::vector<Euclid::XYDataset::QualifiedName> reddeing_curves{{"extinction/curve_1"}, {"extinction/curve_2"}};
+  std::vector<Euclid::XYDataset::QualifiedName> seds{{"sed/sed_1"}, {"sed/sed_3"}};
+  auto axes = Euclid::PhzDataModel::createAxesTuple(zs, ebvs, reddeing_curves, seds);
+  std::vector<Euclid::XYDataset::QualifiedName> filter_name_list{Euclid::XYDataset::QualifiedName{"filter/filter_1"},
+                                                                 Euclid::XYDataset::QualifiedName{"filter/filter_2"}};
+
+  std::shared_ptr<Euclid::XYDataset::XYDatasetProvider> shared_sed_provider{std::move(sed_provider)};
+  std::shared_ptr<Euclid::XYDataset::XYDatasetProvider> shared_reddening_provider{std::move(reddening_provider)};
+  std::shared_ptr<Euclid::XYDataset::XYDatasetProvider> shared_filter_provider{std::move(filter_provider)};
+  Euclid::PhzModeling::PhotometryGridCreator            gridCreator{shared_sed_provider, shared_reddening_provider,
+                                                         shared_filter_provider, Euclid::PhzModeling::NoIgmFunctor{},
+                                                         m_norm_function};
+
+  size_t last_step  = 0;
+  size_t last_total = 0;
+  auto   progress   = [&last_step, &last_total](size_t step, size_t total) {
+    last_step  = step;
+    last_total = total;
+  };
+
+  // When
+  auto photometry_grid = gridCreator.createGrid(axes, filter_name_list, {}, progress);
+
+  // Then
+  BOOST_CHECK_EQUAL(last_total, photometry_grid.size());
+  BOOST_CHECK_EQUAL(last_step, last_total);
+  for (size_t curve_index = 0; curve_index < reddeing_curves.size(); ++curve_index) {
+    auto single_axes = Euclid::PhzDataModel::createAxesTuple(zs, ebvs, {reddeing_curves[curve_index]}, seds);
+    auto expected = gridCreator.createGrid(single_axes, filter_name_list, {});
+    for (size_t sed_index = 0; sed_index < seds.size(); ++sed_index) {
+      for (size_t ebv_index = 0; ebv_index < ebvs.size(); ++ebv_index) {
+        for (size_t z_index = 0; z_index < zs.size(); ++z_index) {
+          auto photometry = photometry_grid(z_index, ebv_index, curve_index, sed_index);
+          auto reference  = expected(z_index, ebv_index, 0, sed_index);
+          auto zero_curve = photometry_grid(z_index, 1, 0, sed_index);
+          for (auto& filter_name : filter_name_list) {
+            BOOST_CHECK_CLOSE(photometry.find(filter_name.qualifiedName())->flux,
+                              reference.find(filter_name.qualifiedName())->flux, 1E-8);
+            if (ebv_index == 1) {
+              BOOST_CHECK_EQUAL(photometry.find(filter_name.qualifiedName())->flux,
+                                zero_curve.find(filter_name.qualifiedName())->flux);
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,120 @@
+/**
+ * Copyright (C) 2022 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file tests/src/PrefixIntegralFluxAlgorithm_test.cpp
+ * @date 2026/10/18
+ */
+
+#include "ElementsKernel/Exception.h"
+#include "PhzModeling/PrefixIntegralFluxAlgorithm.h"
+#include <boost/test/unit_test.hpp>
+
+using Euclid::PhzModeling::PrefixIntegralFluxAlgorithm;
+using Euclid::SourceCatalog::FluxErrorPair;
+using Euclid::XYDataset::XYDataset;
+
+struct PrefixIntegralFluxAlgorithm_Fixture {
+  // A SED with S(x) = x in [1000, 3000]
+  XYDataset sed = XYDataset::factory({1000., 2000., 3000.}, {1000., 2000., 3000.});
+
+  // A top-hat filter in [2000, 4000]
+  XYDataset filter = XYDataset::factory({2000., 2000.001, 3999.999, 4000.}, {0., 1., 1., 0.});
+
+  PrefixIntegralFluxAlgorithm algorithm{{filter}, {{2000., 4000.}}, {1E29}};
+};
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE(PrefixIntegralFluxAlgorithm_test)
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(cumulative_test, PrefixIntegralFluxAlgorithm_Fixture) {
+
+  // Given
+  PrefixIntegralFluxAlgorithm::RestFrameTable table{sed};
+
+  // Then
+  BOOST_CHECK_EQUAL(table.cumulative(500., 0), 0.);
+  BOOST_CHECK_CLOSE(table.cumulative(2500., 0), (2500. * 2500. - 1E6) / 2., 1E-10);
+  BOOST_CHECK_CLOSE(table.cumulative(2500., 1), (2500. * 2500. * 2500. - 1E9) / 3., 1E-10);
+  BOOST_CHECK_CLOSE(table.cumulative(5000., 0), (9E6 - 1E6) / 2., 1E-10);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(redshift_test, PrefixIntegralFluxAlgorithm_Fixture) {
+
+  // Given
+  PrefixIntegralFluxAlgorithm::RestFrameTable table{sed};
+  std::vector<FluxErrorPair>                  fluxes(1, {0., 0.});
+
+  // When
+  algorithm(table, 2., 1., {}, fluxes);
+
+  // Then
+  // The observed SED is S(l) = l / 2 in [2000, 6000], so the flux is the
+  // integral of l / 2 in [2000, 4000]
+  double expected = (16E6 - 4E6) / 4.;
+  BOOST_CHECK_CLOSE(fluxes[0].flux, expected, 1E-3);
+  BOOST_CHECK_EQUAL(fluxes[0].error, 0.);
+
+  // When
+  algorithm(table, 2., 3., {}, fluxes);
+
+  // Then
+  BOOST_CHECK_CLOSE(fluxes[0].flux, 3. * expected, 1E-3);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(igm_test, PrefixIntegralFluxAlgorithm_Fixture) {
+
+  // Given
+  PrefixIntegralFluxAlgorithm::RestFrameTable table{sed};
+  std::vector<FluxErrorPair>                  fluxes(1, {0., 0.});
+
+  // When
+  // The whole SED is fully absorbed
+  algorithm(table, 1., 1., {0., 0., 0.}, fluxes);
+
+  // Then
+  BOOST_CHECK_EQUAL(fluxes[0].flux, 0.);
+
+  // When
+  // The two first knots are half absorbed, so in [2000, 3000] the absorbed SED
+  // goes linearly from 1000 to 3000
+  algorithm(table, 1., 1., {0.5, 0.5}, fluxes);
+
+  // Then
+  // The integral of 2 * x - 3000 in [2000, 3000]
+  double expected = (9E6 - 4E6) - 3000. * 1000.;
+  BOOST_CHECK_CLOSE(fluxes[0].flux, expected, 1E-3);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(wrong_sizes_test) {
+  XYDataset filter = XYDataset::factory({1., 2.}, {1., 1.});
+  BOOST_CHECK_THROW(PrefixIntegralFluxAlgorithm({filter}, {}, {1.}), Elements::Exception);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -17,6 +17,7 @@
  */
 
 #include "PhzModeling/SparseGridCreator.h"
+#include "PhzUtils/Multithreading.h"
 #include <AlexandriaKernel/memory_tools.h>
 #include <boost/test/unit_test.hpp>
 #include <cfenv>
@@ -123,6 +124,119 @@ BOOST_FIXTURE_TEST_CASE(createGrid_test, SparseGridCreatorFixture) {
 
 //----------------------------------------------------------------------------
 
+BOOST_FIXTURE_TEST_CASE(reuseSed_test, SparseGridCreatorFixture) {
+  auto sed_provider    = std::make_shared<MockProvider>(MockProvider::map_t{{"SED1", sed}, {"SED2", sed}});
+  auto red_provider    = std::make_shared<MockProvider>(MockProvider::map_t{{"RED1", red}, {"RED2", red}});
+  auto filter_provider = std::make_shared<MockProvider>(MockProvider::map_t{{"F1", filter}, {"F2", filter}});
+
+  GridAxis<double>        z_axis{"Z", {0., 1., 2.}};
+  GridAxis<double>        ebv_axis{"EBV", {0., 0.5, 0.7}};
+  GridAxis<QualifiedName> red_axis{"RED", {QualifiedName{"RED1"}, QualifiedName{"RED2"}}};
+  GridAxis<QualifiedName> sed_axis_1{"SED", {QualifiedName{"SED1"}}};
+  GridAxis<QualifiedName> sed_axis_2{"SED", {QualifiedName{"SED2"}, QualifiedName{"SED1"}}};
+  GridAxis<double>        sub_z_axis{"Z", {2., 0.}};
+  GridAxis<double>        sub_ebv_axis{"EBV", {0.7}};
+  GridAxis<QualifiedName> sub_red_axis{"RED", {QualifiedName{"RED2"}}};
+  ModelAxesTuple          axes_1{z_axis, ebv_axis, red_axis, sed_axis_1};
+  ModelAxesTuple          axes_2{sub_z_axis, sub_ebv_axis, sub_red_axis, sed_axis_2};
+
+  size_t last_step  = 0;
+  size_t last_total = 0;
+  auto   progress   = [&last_step, &last_total](size_t step, size_t total) {
+    last_step  = step;
+    last_total = total;
+  };
+
+  SparseGridCreator grid_creator(sed_provider, red_provider, filter_provider, MockIGM, MockNorm);
+  auto              grid_map =
+      grid_creator.createGrid({{"REGION1", axes_1}, {"REGION2", axes_2}}, {QualifiedName{"F1"}, QualifiedName{"F2"}},
+                              Euclid::PhysicsUtils::CosmologicalParameters{}, progress);
+
+  BOOST_CHECK_EQUAL(grid_map.size(), 2);
+  BOOST_CHECK_EQUAL(last_total, 22);
+  BOOST_CHECK_EQUAL(last_step, last_total);
+
+  // SED1 of the second region is copied from the first one
+  auto& grid_1 = grid_map.at("REGION1");
+  auto& grid_2 = grid_map.at("REGION2");
+  for (size_t z_index = 0; z_index < sub_z_axis.size(); ++z_index) {
+    auto reused   = grid_2(z_index, 0, 0, 1);
+    auto original = grid_1(2 - 2 * z_index, 2, 1, 0);
+    auto computed = grid_2(z_index, 0, 0, 0);
+    for (auto filter_name : {"F1", "F2"}) {
+      BOOST_CHECK_EQUAL(reused.find(filter_name)->flux, original.find(filter_name)->flux);
+      BOOST_CHECK_EQUAL(reused.find(filter_name)->error, original.find(filter_name)->error);
+      BOOST_CHECK_GT(computed.find(filter_name)->flux, 0.);
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(parallelRegions_test, SparseGridCreatorFixture) {
+  XYDataset other_sed    = XYDataset::factory({1, 10, 20}, {0.5, 1.0, 0.2});
+  auto      sed_provider = std::make_shared<MockProvider>(MockProvider::map_t{
+      {"SED1", sed}, {"SED2", sed}, {"SED3", sed}, {"SED4", other_sed}, {"SED5", sed}, {"SED6", other_sed}});
+  auto red_provider    = std::make_shared<MockProvider>(MockProvider::map_t{{"RED1", red}, {"RED2", red}});
+  auto filter_provider = std::make_shared<MockProvider>(MockProvider::map_t{{"F1", filter}, {"F2", filter}});
+
+  GridAxis<double>        z_axis{"Z", {0., 1., 2.}};
+  GridAxis<double>        ebv_axis{"EBV", {0., 0.5, 0.7}};
+  GridAxis<QualifiedName> red_axis{"RED", {QualifiedName{"RED1"}, QualifiedName{"RED2"}}};
+  std::map<std::string, ModelAxesTuple> regions{
+      {"REGION1", ModelAxesTuple{z_axis, ebv_axis, red_axis, GridAxis<QualifiedName>{"SED", {QualifiedName{"SED1"}}}}},
+      {"REGION2", ModelAxesTuple{z_axis, ebv_axis, red_axis, GridAxis<QualifiedName>{"SED", {QualifiedName{"SED2"}}}}},
+      {"REGION3", ModelAxesTuple{z_axis, ebv_axis, red_axis,
+                                 GridAxis<QualifiedName>{"SED", {QualifiedName{"SED3"}, QualifiedName{"SED1"}}}}},
+      // The computed SEDs of this region are split in chunks around the copied one
+      {"REGION4", ModelAxesTuple{z_axis, ebv_axis, red_axis,
+                                 GridAxis<QualifiedName>{"SED", {QualifiedName{"SED4"}, QualifiedName{"SED1"},
+                                                                 QualifiedName{"SED5"}, QualifiedName{"SED6"}}}}}};
+  std::vector<QualifiedName> filters{QualifiedName{"F1"}, QualifiedName{"F2"}};
+
+  size_t last_step  = 0;
+  size_t last_total = 0;
+  auto   progress   = [&last_step, &last_total](size_t step, size_t total) {
+    BOOST_CHECK_LE(step, total);
+    last_step  = step;
+    last_total = total;
+  };
+
+  auto thread_number                  = Euclid::PhzUtils::getThreadNumber().load();
+  Euclid::PhzUtils::getThreadNumber() = 4;
+  SparseGridCreator parallel_creator(sed_provider, red_provider, filter_provider, MockIGM, MockNorm);
+  auto              parallel_map = parallel_creator.createGrid(regions, filters, {}, progress);
+  BOOST_CHECK_EQUAL(last_total, 144);
+  BOOST_CHECK_EQUAL(last_step, last_total);
+
+  // With a memory limit of one byte and a single thread the regions are built
+  // one at a time, each in a single chunk
+  Euclid::PhzUtils::getThreadNumber() = 1;
+  SparseGridCreator serial_creator(sed_provider, red_provider, filter_provider, MockIGM, MockNorm,
+                                   Euclid::PhzModeling::PhotometryGridCreator::FluxAlgorithm::INTERPOLATION, 0., 1);
+  auto              serial_map = serial_creator.createGrid(regions, filters, {}, progress);
+  Euclid::PhzUtils::getThreadNumber() = thread_number;
+  BOOST_CHECK_EQUAL(last_step, last_total);
+
+  BOOST_CHECK_EQUAL(parallel_map.size(), 4);
+  BOOST_CHECK_EQUAL(serial_map.size(), 4);
+  for (auto& pair : regions) {
+    auto& parallel_grid = parallel_map.at(pair.first);
+    auto& serial_grid   = serial_map.at(pair.first);
+    BOOST_CHECK_EQUAL(parallel_grid.size(), serial_grid.size());
+    auto serial_iter = serial_grid.begin();
+    for (auto parallel_iter = parallel_grid.begin(); parallel_iter != parallel_grid.end();
+         ++parallel_iter, ++serial_iter) {
+      for (auto filter_name : {"F1", "F2"}) {
+        BOOST_CHECK_EQUAL(parallel_iter->find(filter_name)->flux, serial_iter->find(filter_name)->flux);
+        BOOST_CHECK_EQUAL(parallel_iter->find(filter_name)->error, serial_iter->find(filter_name)->error);
+      }
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+
 BOOST_AUTO_TEST_SUITE_END()
 
 //----------------------------------------------------------------------------
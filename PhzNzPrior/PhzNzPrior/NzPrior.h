@@ -11,22 +11,55 @@
 #include "PhzDataModel/RegionResults.h"
 #include "PhzNzPrior/NzPriorParam.h"
 #include "XYDataset/QualifiedName.h"
+#include <memory>
+#include <string>
+#include <vector>
 
 namespace Euclid {
 namespace PhzNzPrior {
 
 class NzPrior {
 public:
+  /**
+   * @param magnitude_step
+   *    If positive, the log-priors of a region are computed once per magnitude bin of this width, and the sources
+   *    use the ones of the closest bin. If zero, they are computed for the exact magnitude of each source.
+   * @param interpolate
+   *    If true, the log-priors of a source are linearly interpolated between the two bins around its magnitude
+   * @param grid_filter_names
+   *    The filter names of the model grid (see PhotometryCellManager::filterNamesPtr). The source photometries
+   *    sharing them, as the ones corrected with a PhzDataModel::FilterPlan, have the I filter at its position in
+   *    the grid, so it is not looked up by name. If null, it is always looked up by name.
+   */
   NzPrior(const PhzDataModel::QualifiedNameGroupManager& sedGroupManager, const XYDataset::QualifiedName& i_filter_name,
-          const NzPriorParam& prior_param, double effectiveness = 1.0);
+          const NzPriorParam& prior_param, double effectiveness = 1.0, double magnitude_step = 0.,
+          bool interpolate = false, std::shared_ptr<std::vector<std::string>> grid_filter_names = nullptr);
 
   void operator()(PhzDataModel::RegionResults& results);
 
 private:
+  struct RegionCache;
+  struct Cache;
+
   PhzDataModel::QualifiedNameGroupManager m_sedGroupManager;
   XYDataset::QualifiedName                m_i_filter_name;
   NzPriorParam                            m_prior_param;
-  double                                  m_effectiveness = 1.0;
+  double                                  m_effectiveness  = 1.0;
+  double                                  m_magnitude_step = 0.;
+  bool                                    m_interpolate    = false;
+  /// The filter names of the model grid, and the position of the I filter in them
+  std::shared_ptr<std::vector<std::string>> m_grid_filter_names;
+  std::size_t                               m_i_filter_grid_index = 0;
+  /// The per region caches, shared by the copies of the prior
+  std::shared_ptr<Cache> m_cache;
+
+  std::shared_ptr<RegionCache> getRegionCache(const PhzDataModel::DoubleGrid& posterior_grid) const;
+
+  std::shared_ptr<const std::vector<double>> getLogPriors(RegionCache& region, long bin) const;
+
+  void computeLogPriors(const RegionCache& region, double mag_Iab, std::vector<double>& log_priors) const;
+
+  const SourceCatalog::FluxErrorPair* findIFlux(const SourceCatalog::Photometry& photometry) const;
 };
 
 }  // namespace PhzNzPrior
@@ -8,8 +8,16 @@
 
 #include "PhzNzPrior/NzPrior.h"
 
+#include <algorithm>
+#include <array>
 #include <cmath>
+#include <functional>
 #include <iterator>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
 
 #include "ElementsKernel/Exception.h"
 #include "ElementsKernel/Logging.h"
@@ -21,13 +29,6 @@ static Elements::Logging logger = Elements::Logging::getLogger("NzPrior");
 
 static const std::string MISSING_FLUX_FOR_NZ_FLAG{"MISSING_FLUX_FOR_NZ_FLAG"};
 
-NzPrior::NzPrior(const PhzDataModel::QualifiedNameGroupManager& sedGroupManager,
-                 const XYDataset::QualifiedName& i_filter_name, const NzPriorParam& prior_param, double effectiveness)
-    : m_sedGroupManager{sedGroupManager}
-    , m_i_filter_name{i_filter_name}
-    , m_prior_param{prior_param}
-    , m_effectiveness{effectiveness} {}
-
 double pt__m0(double ft, double kt, double m0) {
   return ft * std::exp(-kt * (m0 - 20));
 }
@@ -75,26 +76,206 @@ struct PriorCoefficients {
   }
 };
 
-static void computeP_T_z__m0(std::array<PriorCoefficients, 3>& coeffs, std::vector<int> coeff_index,
-                             PhzDataModel::DoubleGrid& grid) {
-  for (auto grid_iter = grid.begin(); grid_iter != grid.end(); ++grid_iter) {
-    auto z       = grid_iter.axisValue<PhzDataModel::ModelParameter::Z>();
-    auto sed_idx = grid_iter.axisIndex<PhzDataModel::ModelParameter::SED>();
+/// Key of the log-priors of the sources brighter than magnitude 20, which do not depend on the magnitude
+static constexpr long BRIGHT_BIN = -1;
+
+struct NzPrior::RegionCache {
+  std::vector<double>                   zs;
+  std::vector<XYDataset::QualifiedName> seds;
+  /// Index of the set of coefficients of each SED
+  std::vector<int> coeff_index;
+  /// For each cell of the grid, in iteration order, its index on the log-prior tables, which have the SED as
+  /// the slowest axis
+  std::vector<size_t> cells;
+
+  std::mutex                                                 mutex;
+  std::map<long, std::shared_ptr<const std::vector<double>>> bins;
+
+  bool matches(const PhzDataModel::DoubleGrid& grid) const {
+    auto& z_axis   = grid.getAxis<PhzDataModel::ModelParameter::Z>();
+    auto& sed_axis = grid.getAxis<PhzDataModel::ModelParameter::SED>();
+    return cells.size() == grid.size() && z_axis.size() == zs.size() && sed_axis.size() == seds.size() &&
+           std::equal(z_axis.begin(), z_axis.end(), zs.begin()) &&
+           std::equal(sed_axis.begin(), sed_axis.end(), seds.begin());
+  }
+};
+
+/// The region caches, keyed by the hash of their grid axes. They are dropped when there are more than MAX_REGIONS.
+struct NzPrior::Cache {
+  static constexpr size_t                                       MAX_REGIONS = 256;
+  std::mutex                                                    mutex;
+  std::unordered_multimap<size_t, std::shared_ptr<RegionCache>> regions;
+
+  std::shared_ptr<RegionCache> find(size_t hash, const PhzDataModel::DoubleGrid& grid) const {
+    auto candidates = regions.equal_range(hash);
+    for (auto i = candidates.first; i != candidates.second; ++i) {
+      if (i->second->matches(grid)) {
+        return i->second;
+      }
+    }
+    return nullptr;
+  }
+};
+
+/// Returns a hash of the size, and the redshift and SED axes of the grid, which identify its region cache
+static size_t gridHash(const PhzDataModel::DoubleGrid& grid) {
+  size_t hash    = grid.size();
+  auto   combine = [&hash](size_t value) {
+    hash ^= value + 0x9e3779b97f4a7c15 + (hash << 6) + (hash >> 2);
+  };
+  for (auto& sed : grid.getAxis<PhzDataModel::ModelParameter::SED>()) {
+    combine(std::hash<std::string>{}(sed.qualifiedName()));
+  }
+  for (double z : grid.getAxis<PhzDataModel::ModelParameter::Z>()) {
+    combine(std::hash<double>{}(z));
+  }
+  return hash;
+}
+
+NzPrior::NzPrior(const PhzDataModel::QualifiedNameGroupManager& sedGroupManager,
+                 const XYDataset::QualifiedName& i_filter_name, const NzPriorParam& prior_param, double effectiveness,
+                 double magnitude_step, bool interpolate, std::shared_ptr<std::vector<std::string>> grid_filter_names)
+    : m_sedGroupManager{sedGroupManager}
+    , m_i_filter_name{i_filter_name}
+    , m_prior_param{prior_param}
+    , m_effectiveness{effectiveness}
+    , m_magnitude_step{magnitude_step}
+    , m_interpolate{interpolate}
+    , m_grid_filter_names{std::move(grid_filter_names)}
+    , m_cache{std::make_shared<Cache>()} {
+  if (m_magnitude_step < 0) {
+    throw Elements::Exception() << "NzPrior: the magnitude step must not be negative (" << m_magnitude_step << ")";
+  }
+  if (m_grid_filter_names) {
+    auto i_filter = std::find(m_grid_filter_names->begin(), m_grid_filter_names->end(), i_filter_name.qualifiedName());
+    if (i_filter == m_grid_filter_names->end()) {
+      // The photometries with the grid filters do not have the I filter, so they can not take the fast path
+      m_grid_filter_names.reset();
+    } else {
+      m_i_filter_grid_index = i_filter - m_grid_filter_names->begin();
+    }
+  }
+}
+
+std::shared_ptr<NzPrior::RegionCache> NzPrior::getRegionCache(const PhzDataModel::DoubleGrid& posterior_grid) const {
+  size_t hash = gridHash(posterior_grid);
+  {
+    std::lock_guard<std::mutex> lock(m_cache->mutex);
+    auto                        cached = m_cache->find(hash, posterior_grid);
+    if (cached) {
+      return cached;
+    }
+  }
+
+  // The cache is built without holding the lock, so the other regions are not blocked
+  auto  region   = std::make_shared<RegionCache>();
+  auto& z_axis   = posterior_grid.getAxis<PhzDataModel::ModelParameter::Z>();
+  auto& sed_axis = posterior_grid.getAxis<PhzDataModel::ModelParameter::SED>();
+  region->zs.assign(z_axis.begin(), z_axis.end());
+  region->seds.assign(sed_axis.begin(), sed_axis.end());
+
+  // Resolve the group of each SED only once, to know which set of coefficients to use
+  region->coeff_index.resize(region->seds.size());
+  for (size_t i = 0; i < region->seds.size(); ++i) {
+    const auto& group_name = m_sedGroupManager.findGroupContaining(region->seds[i]).first;
+    if (group_name == "T1") {
+      region->coeff_index[i] = 0;
+    } else if (group_name == "T2") {
+      region->coeff_index[i] = 1;
+    } else {
+      region->coeff_index[i] = 2;
+    }
+  }
+
+  // The prior depends only on the redshift and the SED, so the tables do not need the other axes
+  region->cells.reserve(posterior_grid.size());
+  for (auto grid_iter = posterior_grid.begin(); grid_iter != posterior_grid.end(); ++grid_iter) {
+    region->cells.emplace_back(grid_iter.axisIndex<PhzDataModel::ModelParameter::SED>() * region->zs.size() +
+                               grid_iter.axisIndex<PhzDataModel::ModelParameter::Z>());
+  }
+
+  std::lock_guard<std::mutex> lock(m_cache->mutex);
+  auto                        cached = m_cache->find(hash, posterior_grid);
+  if (cached) {
+    return cached;
+  }
+  // The caches still used by other threads are kept alive by their shared pointers
+  if (m_cache->regions.size() >= Cache::MAX_REGIONS) {
+    m_cache->regions.clear();
+  }
+  m_cache->regions.emplace(hash, region);
+  return region;
+}
+
+void NzPrior::computeLogPriors(const RegionCache& region, double mag_Iab, std::vector<double>& log_priors) const {
+  constexpr double min_value = std::numeric_limits<double>::lowest();
+
+  // Precompute the coefficients for the three group of seds
+  std::array<PriorCoefficients, 3> coeffs{PriorCoefficients::T1(mag_Iab, m_prior_param),
+                                          PriorCoefficients::T2(mag_Iab, m_prior_param),
+                                          PriorCoefficients::T3(mag_Iab, m_prior_param)};
+
+  log_priors.resize(region.seds.size() * region.zs.size());
+  auto out = log_priors.begin();
+  for (size_t sed_idx = 0; sed_idx < region.seds.size(); ++sed_idx) {
+    const auto& coeff = coeffs[region.coeff_index[sed_idx]];
+    for (double z : region.zs) {
+      double prior;
+      // For bright sources, set z > 1 prior to 0, leave the values for z < 1
+      if (mag_Iab < 20) {
+        prior = (z > 1) ? 0. : 1.;
+      } else {
+        if (z <= 0.0) {
+          z = 1e-4;
+        }
+        double z_pow = std::pow(z, coeff.m_alpt);
+        prior        = (coeff.m_pt_m0 / coeff.m_A) * z_pow * std::exp(-z_pow * coeff.m_inv_zmt_pow);
+      }
 
-    if (z <= 0.0) {
-      z = 1e-4;
+      // Apply the effectiveness to the prior.
+      prior  = (1 - m_effectiveness) + m_effectiveness * prior;
+      *out++ = (prior <= 0) ? min_value : std::log(prior);
     }
+  }
+}
 
-    const auto& coeff = coeffs[coeff_index[sed_idx]];
-    double      z_pow = std::pow(z, coeff.m_alpt);
-    *grid_iter        = (coeff.m_pt_m0 / coeff.m_A) * z_pow * std::exp(-z_pow * coeff.m_inv_zmt_pow);
+std::shared_ptr<const std::vector<double>> NzPrior::getLogPriors(RegionCache& region, long bin) const {
+  std::lock_guard<std::mutex> lock(region.mutex);
+  auto                        found = region.bins.find(bin);
+  if (found != region.bins.end()) {
+    return found->second;
   }
+  double mag_Iab    = (bin == BRIGHT_BIN) ? 0. : 20 + static_cast<double>(bin) * m_magnitude_step;
+  auto   log_priors = std::make_shared<std::vector<double>>();
+  computeLogPriors(region, mag_Iab, *log_priors);
+  region.bins.emplace(bin, log_priors);
+  return log_priors;
+}
+
+const SourceCatalog::FluxErrorPair* NzPrior::findIFlux(const SourceCatalog::Photometry& photometry) const {
+  // The photometries sharing the filter names of the grid have the I filter at its position in the grid
+  if (m_grid_filter_names && photometry.size() == m_grid_filter_names->size() &&
+      &photometry.begin().filterName() == m_grid_filter_names->data()) {
+    auto iter = photometry.begin();
+    for (std::size_t i = 0; i < m_i_filter_grid_index; ++i) {
+      ++iter;
+    }
+    return &(*iter);
+  }
+
+  auto& filter_name = m_i_filter_name.qualifiedName();
+  for (auto iter = photometry.begin(); iter != photometry.end(); ++iter) {
+    if (iter.filterName() == filter_name) {
+      return &(*iter);
+    }
+  }
+  return nullptr;
 }
 
 void NzPrior::operator()(PhzDataModel::RegionResults& results) {
   // 1. get the I magnitude
   auto& photometry = results.get<PhzDataModel::RegionResultType::SOURCE_PHOTOMETRY_REFERENCE>();
-  auto  flux_ptr   = photometry.get().find(m_i_filter_name.qualifiedName());
+  auto  flux_ptr   = findIFlux(photometry.get());
   if (flux_ptr == nullptr) {
     throw Elements::Exception() << "NzPrior: Missing filter:" << m_i_filter_name.qualifiedName()
                                 << " in the source Photometry";
@@ -102,81 +283,69 @@ void NzPrior::operator()(PhzDataModel::RegionResults& results) {
 
   auto& posterior_grid = results.get<PhzDataModel::RegionResultType::POSTERIOR_LOG_GRID>();
 
-  PhzDataModel::DoubleGrid prior_grid{posterior_grid.getAxesTuple()};
-  std::fill(prior_grid.begin(), prior_grid.end(), 1.);
-
   // Check if the FLAGS are already inserted, if not add it
   if (!results.contains<PhzDataModel::RegionResultType::FLAGS>()) {
     results.set<PhzDataModel::RegionResultType::FLAGS>(std::map<std::string, bool>{});
   }
 
-  if (!flux_ptr->missing_photometry_flag) {
-    // flux is in micro Jy the AB mag factor is then 3613E6
-    double mag_Iab = -2.5 * std::log10(flux_ptr->flux / 3.631E9);
-
-    // Precompute the coefficients for the three group of seds
-    std::array<PriorCoefficients, 3> coeffs{PriorCoefficients::T1(mag_Iab, m_prior_param),
-                                            PriorCoefficients::T2(mag_Iab, m_prior_param),
-                                            PriorCoefficients::T3(mag_Iab, m_prior_param)};
-
-    // The Z axis changes more slowly than the SED axis, so it is interesting to have the inner loop
-    // iterate over the SEDs for memory locality, but we need to know to which group the SED correspond
-    // to know which set of coefficients to use. To avoid a map lookup, we populate a vector with the coefficient
-    // index corresponding to each SED.
-    auto&            seds = prior_grid.getAxis<PhzDataModel::ModelParameter::SED>();
-    std::vector<int> coeff_index(seds.size());
-    for (size_t i = 0; i < seds.size(); ++i) {
-      const auto& group_name = m_sedGroupManager.findGroupContaining(seds[i]).first;
-      if (group_name == "T1") {
-        coeff_index[i] = 0;
-      } else if (group_name == "T2") {
-        coeff_index[i] = 1;
-      } else {
-        coeff_index[i] = 2;
-      }
-    }
+  if (flux_ptr->missing_photometry_flag) {
+    // The flux needed for computing the N(Z) prior is missing => use a flat prior and flag the source
+    results.get<PhzDataModel::RegionResultType::FLAGS>().insert({MISSING_FLUX_FOR_NZ_FLAG, true});
+    return;
+  }
 
-    // For bright sources, set z > 1 prior to 0, leave the values for z < 1
-    if (mag_Iab < 20) {
-      for (auto grid_iter = prior_grid.begin(); grid_iter != prior_grid.end(); ++grid_iter) {
-        double z = grid_iter.axisValue<PhzDataModel::ModelParameter::Z>();
-        if (z > 1) {
-          *grid_iter = 0;
-        }
+  constexpr double min_value = std::numeric_limits<double>::lowest();
+
+  // flux is in micro Jy the AB mag factor is then 3613E6
+  double mag_Iab = -2.5 * std::log10(flux_ptr->flux / 3.631E9);
+
+  // Get the log-priors of the source on a (SED, Z) table
+  auto                                       region = getRegionCache(posterior_grid);
+  std::shared_ptr<const std::vector<double>> log_priors;
+  if (mag_Iab < 20) {
+    log_priors = getLogPriors(*region, BRIGHT_BIN);
+  } else if (m_magnitude_step > 0 && std::isfinite(mag_Iab)) {
+    double position = (mag_Iab - 20) / m_magnitude_step;
+    if (m_interpolate) {
+      long   bin    = static_cast<long>(std::floor(position));
+      double weight = position - static_cast<double>(bin);
+      auto   lower  = getLogPriors(*region, bin);
+      auto   upper  = getLogPriors(*region, bin + 1);
+
+      auto interpolated = std::make_shared<std::vector<double>>(lower->size());
+      for (size_t i = 0; i < interpolated->size(); ++i) {
+        double l           = (*lower)[i];
+        double u           = (*upper)[i];
+        (*interpolated)[i] = (l == min_value || u == min_value) ? min_value : l + weight * (u - l);
       }
+      log_priors = interpolated;
     } else {
-      computeP_T_z__m0(coeffs, coeff_index, prior_grid);
+      log_priors = getLogPriors(*region, std::lround(position));
     }
-
-    // Apply the effectiveness to the prior.
-    std::transform(prior_grid.begin(), prior_grid.end(), prior_grid.begin(), [this](double v) {
-      return (1 - m_effectiveness) + m_effectiveness * v;
-    });
   } else {
-    // The flux needed for computing the N(Z) prior is missing => use a flat prior and flag the source
-    results.get<PhzDataModel::RegionResultType::FLAGS>().insert({MISSING_FLUX_FOR_NZ_FLAG, true});
+    auto exact = std::make_shared<std::vector<double>>();
+    computeLogPriors(*region, mag_Iab, *exact);
+    log_priors = exact;
   }
 
-  constexpr double min_value = std::numeric_limits<double>::lowest();
   // Apply the prior to the likelihood
-  for (auto l_it = posterior_grid.begin(), p_it = prior_grid.begin(); l_it != posterior_grid.end(); ++l_it, ++p_it) {
-    if (*p_it <= 0) {
-      *l_it = min_value;
-    } else {
-      double prior = std::log(*p_it);
-      *l_it += prior;
-    }
+  const auto& table = *log_priors;
+  const auto& cells = region->cells;
+  size_t      i     = 0;
+  for (auto& l : posterior_grid) {
+    double prior = table[cells[i++]];
+    l            = (prior == min_value) ? min_value : l + prior;
   }
 
   if (results.get<PhzDataModel::RegionResultType::SAMPLE_SCALE_FACTOR>()) {
     auto& posterior_sampled_grid = results.get<PhzDataModel::RegionResultType::POSTERIOR_SCALING_LOG_GRID>();
-    auto  p_it                   = prior_grid.begin();
-    for (auto l_s_it = posterior_sampled_grid.begin(); l_s_it != posterior_sampled_grid.end(); ++l_s_it, ++p_it) {
-      if (*p_it <= 0) {
-        std::fill(l_s_it->begin(), l_s_it->end(), min_value);
+    i                            = 0;
+    for (auto samples : posterior_sampled_grid) {
+      double prior = table[cells[i++]];
+      if (prior == min_value) {
+        std::fill(samples.begin(), samples.end(), min_value);
       } else {
-        double prior = std::log(*p_it);
-        for (auto& sample : *l_s_it) {
+        for (auto& sample : samples) {
           sample += prior;
         }
       }
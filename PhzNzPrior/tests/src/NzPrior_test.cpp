@@ -26,7 +26,10 @@
 #include "PhzNzPrior/NzPriorParam.h"
 #include "SourceCatalog/SourceAttributes/Photometry.h"
 #include "XYDataset/QualifiedName.h"
+#include "ElementsKernel/Exception.h"
+#include <algorithm>
 #include <boost/test/unit_test.hpp>
+#include <cmath>
 
 #include "PhzNzPrior/NzPrior.h"
 
@@ -67,6 +70,25 @@ struct NzPrior_Fixture {
   SourceCatalog::Photometry photometry_missing{filter_vector, photometry_vector_missing};
 
   // PhzDataModel::RegionResultType::SOURCE_PHOTOMETRY_REFERENCE
+
+  /// Apply the prior on a posterior grid set to 1, and return its values
+  std::vector<double> applyPrior(PhzNzPrior::NzPrior& prior, const SourceCatalog::Photometry& photometry,
+                                 const PhzDataModel::ModelAxesTuple& grid_axes) {
+    PhzDataModel::RegionResults region_results{};
+    auto& grid = region_results.set<PhzDataModel::RegionResultType::POSTERIOR_LOG_GRID>(grid_axes);
+    region_results.set<PhzDataModel::RegionResultType::SAMPLE_SCALE_FACTOR>(false);
+    region_results.set<PhzDataModel::RegionResultType::SOURCE_PHOTOMETRY_REFERENCE>(photometry);
+    std::fill(grid.begin(), grid.end(), 1.);
+    prior(region_results);
+    return {grid.begin(), grid.end()};
+  }
+
+  /// A photometry with a flux of exactly the given magnitude
+  SourceCatalog::Photometry photometryForMagnitude(double mag) {
+    double flux = 3.631E9 * std::pow(10., -mag / 2.5);
+    return SourceCatalog::Photometry{filter_vector,
+                                     std::vector<SourceCatalog::FluxErrorPair>{SourceCatalog::FluxErrorPair(flux, 1)}};
+  }
 };
 
 //-----------------------------------------------------------------------------
@@ -152,14 +174,12 @@ BOOST_FIXTURE_TEST_CASE(priorValues_scale_sampled_test, NzPrior_Fixture) {
   results.set<PhzDataModel::RegionResultType::SOURCE_PHOTOMETRY_REFERENCE>(photometry_low);
   results.get<PhzDataModel::RegionResultType::SAMPLE_SCALE_FACTOR>() = true;
 
-  auto& posterior_sampled_grid = results.set<PhzDataModel::RegionResultType::POSTERIOR_SCALING_LOG_GRID>(axes);
+  auto& posterior_sampled_grid = results.set<PhzDataModel::RegionResultType::POSTERIOR_SCALING_LOG_GRID>(axes, 4);
   for (auto& l : posterior_grid) {
     l = 1.;
   }
-  for (auto& v : posterior_sampled_grid) {
-    for (size_t index = 0; index < 4; ++index) {
-      v.push_back(1.0);
-    }
+  for (auto v : posterior_sampled_grid) {
+    std::fill(v.begin(), v.end(), 1.0);
   }
 
   auto prior = PhzNzPrior::NzPrior(group_manager, fliter, PhzNzPrior::NzPriorParam::defaultParam());
@@ -237,6 +257,124 @@ BOOST_FIXTURE_TEST_CASE(priorValues_missing_flux_test, NzPrior_Fixture) {
   }
 }
 
+BOOST_FIXTURE_TEST_CASE(magnitude_cache_on_node_test, NzPrior_Fixture) {
+  // Given
+  auto param        = PhzNzPrior::NzPriorParam::defaultParam();
+  auto exact        = PhzNzPrior::NzPrior(group_manager, fliter, param);
+  auto nearest      = PhzNzPrior::NzPrior(group_manager, fliter, param, 1.0, 0.5);
+  auto interpolated = PhzNzPrior::NzPrior(group_manager, fliter, param, 1.0, 0.5, true);
+  auto photometry   = photometryForMagnitude(21.5);
+
+  // When
+  auto expected            = applyPrior(exact, photometry, axes);
+  auto nearest_values      = applyPrior(nearest, photometry, axes);
+  auto interpolated_values = applyPrior(interpolated, photometry, axes);
+
+  // Then
+  for (size_t i = 0; i < expected.size(); ++i) {
+    BOOST_CHECK_CLOSE_FRACTION(nearest_values[i], expected[i], 1E-8);
+    BOOST_CHECK_CLOSE_FRACTION(interpolated_values[i], expected[i], 1E-8);
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE(magnitude_cache_interpolation_test, NzPrior_Fixture) {
+  // Given
+  auto param        = PhzNzPrior::NzPriorParam::defaultParam();
+  auto exact        = PhzNzPrior::NzPrior(group_manager, fliter, param);
+  auto nearest      = PhzNzPrior::NzPrior(group_manager, fliter, param, 1.0, 0.5);
+  auto interpolated = PhzNzPrior::NzPrior(group_manager, fliter, param, 1.0, 0.5, true);
+
+  // When
+  auto expected            = applyPrior(exact, photometry_low, axes);
+  auto nearest_values      = applyPrior(nearest, photometry_low, axes);
+  auto interpolated_values = applyPrior(interpolated, photometry_low, axes);
+
+  // Then
+  double nearest_error = 0, interpolated_error = 0;
+  for (size_t i = 0; i < expected.size(); ++i) {
+    nearest_error += std::abs(nearest_values[i] - expected[i]);
+    interpolated_error += std::abs(interpolated_values[i] - expected[i]);
+  }
+  BOOST_CHECK_GT(nearest_error, 0.);
+  BOOST_CHECK_LT(interpolated_error, nearest_error);
+}
+
+BOOST_FIXTURE_TEST_CASE(magnitude_cache_bright_test, NzPrior_Fixture) {
+  // Given
+  auto param  = PhzNzPrior::NzPriorParam::defaultParam();
+  auto exact  = PhzNzPrior::NzPrior(group_manager, fliter, param, 0.8);
+  auto cached = PhzNzPrior::NzPrior(group_manager, fliter, param, 0.8, 0.1, true);
+
+  // When
+  auto expected = applyPrior(exact, photometry_high, axes);
+  auto values   = applyPrior(cached, photometry_high, axes);
+
+  // Then
+  for (size_t i = 0; i < expected.size(); ++i) {
+    BOOST_CHECK_EQUAL(values[i], expected[i]);
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE(magnitude_cache_regions_test, NzPrior_Fixture) {
+  // Given
+  auto param       = PhzNzPrior::NzPriorParam::defaultParam();
+  auto exact       = PhzNzPrior::NzPrior(group_manager, fliter, param);
+  auto cached      = PhzNzPrior::NzPrior(group_manager, fliter, param, 1.0, 0.5);
+  auto cached_copy = cached;
+  auto other_axes  = PhzDataModel::createAxesTuple(std::vector<double>{0.2, 1.5}, ebvs, reddeing_curves,
+                                                   std::vector<XYDataset::QualifiedName>{{"sed3"}, {"sed1"}});
+  auto photometry  = photometryForMagnitude(22.);
+
+  // When
+  auto first        = applyPrior(cached, photometry, axes);
+  auto second       = applyPrior(cached_copy, photometry, other_axes);
+  auto first_again  = applyPrior(cached_copy, photometry, axes);
+  auto expected     = applyPrior(exact, photometry, axes);
+  auto expected_2nd = applyPrior(exact, photometry, other_axes);
+
+  // Then
+  BOOST_REQUIRE_EQUAL(second.size(), expected_2nd.size());
+  for (size_t i = 0; i < expected.size(); ++i) {
+    BOOST_CHECK_CLOSE_FRACTION(first[i], expected[i], 1E-8);
+    BOOST_CHECK_EQUAL(first_again[i], first[i]);
+  }
+  for (size_t i = 0; i < expected_2nd.size(); ++i) {
+    BOOST_CHECK_CLOSE_FRACTION(second[i], expected_2nd[i], 1E-8);
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE(magnitude_cache_negative_step_test, NzPrior_Fixture) {
+  BOOST_CHECK_THROW(PhzNzPrior::NzPrior(group_manager, fliter, PhzNzPrior::NzPriorParam::defaultParam(), 1.0, -0.1),
+                    Elements::Exception);
+}
+
+BOOST_FIXTURE_TEST_CASE(grid_filter_names_test, NzPrior_Fixture) {
+  // Given
+  auto param       = PhzNzPrior::NzPriorParam::defaultParam();
+  auto grid_names  = std::make_shared<std::vector<std::string>>(std::vector<std::string>{"FB", "FI"});
+  auto exact       = PhzNzPrior::NzPrior(group_manager, fliter, param);
+  auto grid_prior  = PhzNzPrior::NzPrior(group_manager, fliter, param, 1.0, 0., false, grid_names);
+  auto fluxes      = std::vector<SourceCatalog::FluxErrorPair>{{1., 1.}, {100., 1.}};
+  auto shared      = SourceCatalog::Photometry{grid_names, fluxes};
+  auto not_shared  = SourceCatalog::Photometry{std::make_shared<std::vector<std::string>>(*grid_names), fluxes};
+  auto other_order = SourceCatalog::Photometry{
+      std::make_shared<std::vector<std::string>>(std::vector<std::string>{"FI", "FB"}),
+      std::vector<SourceCatalog::FluxErrorPair>{{100., 1.}, {1., 1.}}};
+
+  // When
+  auto expected           = applyPrior(exact, photometry_high, axes);
+  auto shared_values      = applyPrior(grid_prior, shared, axes);
+  auto not_shared_values  = applyPrior(grid_prior, not_shared, axes);
+  auto other_order_values = applyPrior(grid_prior, other_order, axes);
+
+  // Then
+  for (size_t i = 0; i < expected.size(); ++i) {
+    BOOST_CHECK_EQUAL(shared_values[i], expected[i]);
+    BOOST_CHECK_EQUAL(not_shared_values[i], expected[i]);
+    BOOST_CHECK_EQUAL(other_order_values[i], expected[i]);
+  }
+}
+
 //-----------------------------------------------------------------------------
 
 BOOST_AUTO_TEST_SUITE_END()
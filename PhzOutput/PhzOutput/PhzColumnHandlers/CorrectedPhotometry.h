@@ -27,6 +27,7 @@
 #include "PhzDataModel/PhotometryGrid.h"
 #include "PhzOutput/PhzColumnHandlers/ColumnHandler.h"
 #include <string>
+#include <vector>
 
 namespace Euclid {
 namespace PhzOutput {
@@ -64,6 +65,9 @@ public:
   static std::vector<double> multVector(double m1, std::vector<double> v1);
 
 private:
+  /// For each region of the coefficient grids, the position in the source photometry of each grid filter
+  typedef std::vector<std::vector<std::size_t>> RegionFilterIndices;
+
   std::vector<Table::ColumnInfo::info_type>                  m_columnInfo{};
   bool                                                       m_do_marginalize;
   bool                                                       m_correct_filter;
@@ -71,6 +75,14 @@ private:
   double                                                     m_dust_map_sed_bpc;
   const std::map<std::string, PhzDataModel::PhotometryGrid>& m_filter_shift_coef_grid;
   const std::map<std::string, PhzDataModel::PhotometryGrid>& m_galactic_correction_coef_grid;
+  std::vector<const PhzDataModel::PhotometryGrid*>           m_filter_shift_grids;
+  std::vector<const PhzDataModel::PhotometryGrid*>           m_galactic_grids;
+  RegionFilterIndices                                        m_filter_shift_indices;
+  RegionFilterIndices                                        m_galactic_indices;
+
+  static void indexGrids(const std::map<std::string, PhzDataModel::PhotometryGrid>& coef_grid_map,
+                         const Configuration::PhotometricBandMappingConfig::MappingMap& mapping,
+                         std::vector<const PhzDataModel::PhotometryGrid*>& grids, RegionFilterIndices& indices);
 
   static constexpr double l10 = 2.302585092994046;  // std::log(10.);
 };                                                  /* End of Id class */
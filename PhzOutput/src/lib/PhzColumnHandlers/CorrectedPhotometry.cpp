@@ -68,10 +68,40 @@ CorrectedPhotometry::CorrectedPhotometry(
     m_columnInfo.push_back(info);
   }
 
+  // The filters are matched by name once, so the corrections of a model are computed by position only
+  if (m_correct_filter) {
+    indexGrids(m_filter_shift_coef_grid, mapping, m_filter_shift_grids, m_filter_shift_indices);
+  }
+  if (m_correct_galactic) {
+    indexGrids(m_galactic_correction_coef_grid, mapping, m_galactic_grids, m_galactic_indices);
+  }
+
   logger.info() << "Output corrected photometry = " << m_do_marginalize << " with filter_shift :" << m_correct_filter
                 << " and galactic correction :" << m_correct_galactic;
 }
 
+void CorrectedPhotometry::indexGrids(const std::map<std::string, PhzDataModel::PhotometryGrid>& coef_grid_map,
+                                     const Configuration::PhotometricBandMappingConfig::MappingMap&  mapping,
+                                     std::vector<const PhzDataModel::PhotometryGrid*>& grids,
+                                     RegionFilterIndices&                              indices) {
+  for (auto& region : coef_grid_map) {
+    grids.emplace_back(&region.second);
+    auto& grid_filters = region.second.getCellManager().filterNames();
+
+    // The grid filters which are not in the source photometry get an out of range index, and are skipped
+    std::vector<std::size_t> region_indices(grid_filters.size(), mapping.size());
+    for (std::size_t i = 0; i < grid_filters.size(); ++i) {
+      for (std::size_t j = 0; j < mapping.size(); ++j) {
+        if (mapping[j].first == grid_filters[i]) {
+          region_indices[i] = j;
+          break;
+        }
+      }
+    }
+    indices.emplace_back(std::move(region_indices));
+  }
+}
+
 std::vector<Table::ColumnInfo::info_type> CorrectedPhotometry::getColumnInfoList() const {
   return m_columnInfo;
 }
@@ -79,111 +109,43 @@ std::vector<Table::ColumnInfo::info_type> CorrectedPhotometry::getColumnInfoList
 std::vector<double>
 CorrectedPhotometry::computeCorrectionFactorForModel(const SourceCatalog::Source& source, size_t region_index,
                                                      const PhzDataModel::PhotometryGrid::const_iterator model) const {
-	auto                photometry                = source.getAttribute<SourceCatalog::Photometry>();
-	auto                observation_condition_ptr = source.getAttribute<PhzDataModel::ObservationCondition>();
-	std::vector<double> full_correction(photometry->size(), 1.0);
-
-	size_t full_index = 0 ;
-	for (auto iter = photometry->begin(); iter != photometry->end(); ++iter) {
-		double corr_value = 1;
-		auto filter_name = iter.filterName();
-		if (m_correct_filter) {
-			auto filter_map_iter = m_filter_shift_coef_grid.cbegin();
-			for (size_t i = 0; i < region_index; ++i) {
-				++filter_map_iter;
-			}
-
-			auto filter_coeff_iter = (*filter_map_iter).second.begin();
-			filter_coeff_iter.fixAllAxes(model);
-			const std::vector<double>& shifts = observation_condition_ptr->getFilterShifts();
-			size_t index=0;
-			for(auto coef_iter = filter_coeff_iter->begin(); coef_iter != filter_coeff_iter->end(); ++coef_iter){
-				if (coef_iter.filterName()==filter_name){
-					double corr = 1.0 + shifts[index] * shifts[index] * (*coef_iter).flux + shifts[index] * (*coef_iter).error;
-					corr_value /= corr;
-					break;
-				}
-				++index;
-			}
-
-
-		  }
-
-
-		 // Galactic reddening
-		  if (m_correct_galactic) {
-		    auto gal_map_iter = m_galactic_correction_coef_grid.cbegin();
-		    for (size_t i = 0; i < region_index; ++i) {
-		      ++gal_map_iter;
-		    }
-
-		    auto galactic_coeff_iter = (*gal_map_iter).second.begin();
-		    galactic_coeff_iter.fixAllAxes(model);
-
-		    double dust_density  = m_dust_map_sed_bpc * observation_condition_ptr->getDustColumnDensity();
-		    double flux = galactic_coeff_iter->find(filter_name)->getFlux();
-		    double corr = std::exp(l10 * -0.4 * flux * dust_density);
-		    corr_value /= corr;
-		  }
-
-		  full_correction[full_index] = corr_value;
-		  ++full_index;
-	}
+  auto                photometry                = source.getAttribute<SourceCatalog::Photometry>();
+  auto                observation_condition_ptr = source.getAttribute<PhzDataModel::ObservationCondition>();
+  std::vector<double> full_correction(photometry->size(), 1.0);
 
-
-
-
-  /*
-
-  // Filter shift
+  // Filter shift. The coefficients of a filter are matched with the shift at the same position of the grid
   if (m_correct_filter) {
-    auto filter_map_iter = m_filter_shift_coef_grid.cbegin();
-    for (size_t i = 0; i < region_index; ++i) {
-      ++filter_map_iter;
-    }
-
-    auto filter_coeff_iter = (*filter_map_iter).second.begin();
+    auto filter_coeff_iter = m_filter_shift_grids.at(region_index)->begin();
     filter_coeff_iter.fixAllAxes(model);
-    const std::vector<double>& shifts    = observation_condition_ptr->getFilterShifts();
-    auto                       coef_iter = filter_coeff_iter->begin();
-
-    logger.info() << "Actual shifts size" << shifts.size();
-    logger.info() << "Actual filter_coeff_iter size" << filter_coeff_iter->size();
-    logger.info() << "Actual Photometry size" << photometry->size();
-
-    for (size_t index = 0; index < shifts.size(); ++index) {
-      double corr = 1.0 + shifts[index] * shifts[index] * (*coef_iter).flux + shifts[index] * (*coef_iter).error;
-      full_correction[index] /= corr;
-      ++coef_iter;
+    const std::vector<double>&      shifts  = observation_condition_ptr->getFilterShifts();
+    const std::vector<std::size_t>& indices = m_filter_shift_indices[region_index];
+
+    std::size_t index = 0;
+    for (auto coef_iter = filter_coeff_iter->begin(); coef_iter != filter_coeff_iter->end(); ++coef_iter, ++index) {
+      std::size_t source_index = indices[index];
+      if (source_index < full_correction.size()) {
+        double corr = 1.0 + shifts[index] * shifts[index] * (*coef_iter).flux + shifts[index] * (*coef_iter).error;
+        full_correction[source_index] /= corr;
+      }
     }
   }
 
   // Galactic reddening
   if (m_correct_galactic) {
-    auto gal_map_iter = m_galactic_correction_coef_grid.cbegin();
-    for (size_t i = 0; i < region_index; ++i) {
-      ++gal_map_iter;
-    }
-
-
-
-
-    auto galactic_coeff_iter = (*gal_map_iter).second.begin();
+    auto galactic_coeff_iter = m_galactic_grids.at(region_index)->begin();
     galactic_coeff_iter.fixAllAxes(model);
-
-    logger.info() << "Actual gal_coef_iter size" << galactic_coeff_iter->size();
-    logger.info() << "Actual Photometry size" << photometry->size();
-
-
-    double dust_density  = m_dust_map_sed_bpc * observation_condition_ptr->getDustColumnDensity();
-    auto   gal_coef_iter = galactic_coeff_iter->begin();
-    for (size_t index = 0; index < galactic_coeff_iter->size(); ++index) {
-      double corr = std::exp(l10 * -0.4 * (*gal_coef_iter).flux * dust_density);
-      full_correction[index] /= corr;
-      ++gal_coef_iter;
+    const std::vector<std::size_t>& indices = m_galactic_indices[region_index];
+
+    double      dust_density = m_dust_map_sed_bpc * observation_condition_ptr->getDustColumnDensity();
+    std::size_t index        = 0;
+    for (auto coef_iter = galactic_coeff_iter->begin(); coef_iter != galactic_coeff_iter->end(); ++coef_iter, ++index) {
+      std::size_t source_index = indices[index];
+      if (source_index < full_correction.size()) {
+        double corr = std::exp(l10 * -0.4 * (*coef_iter).flux * dust_density);
+        full_correction[source_index] /= corr;
+      }
     }
   }
-  */
 
   return full_correction;
 }
@@ -126,7 +126,8 @@ BOOST_FIXTURE_TEST_CASE(test_computeEnclosingVolumeOfCells, GridSamplerScale_fix
   GridContainer::GridAxis<double>                   ebv_axis_1{"E(B-V)", {0.0}};
   GridContainer::GridAxis<XYDataset::QualifiedName> red_axis_1{"Reddening Curve", {{"Curve1"}}};
   GridContainer::GridAxis<XYDataset::QualifiedName> sed_axis_1{"SED", {{"SED_1"}, {"SED_2"}}};
-  PhzDataModel::DoubleListGrid                      grid_likelihood_1{z_axis_1, ebv_axis_1, red_axis_1, sed_axis_1};
+  PhzDataModel::DoubleListGrid                      grid_likelihood_1{
+      std::make_tuple(z_axis_1, ebv_axis_1, red_axis_1, sed_axis_1), 2};
   auto                                              iter_grid_1 = grid_likelihood_1.begin();
   *iter_grid_1                                                  = std::vector<double>{0.5, 0.7};
   ++iter_grid_1;
@@ -145,7 +146,8 @@ BOOST_FIXTURE_TEST_CASE(test_computeEnclosingVolumeOfCells, GridSamplerScale_fix
   GridContainer::GridAxis<double>                   ebv_axis_2{"E(B-V)", {0.0}};
   GridContainer::GridAxis<XYDataset::QualifiedName> red_axis_2{"Reddening Curve", {{"Curve1"}}};
   GridContainer::GridAxis<XYDataset::QualifiedName> sed_axis_2{"SED", {{"SED_1"}}};
-  PhzDataModel::DoubleListGrid                      grid_likelihood_2{z_axis_2, ebv_axis_2, red_axis_2, sed_axis_2};
+  PhzDataModel::DoubleListGrid                      grid_likelihood_2{
+      std::make_tuple(z_axis_2, ebv_axis_2, red_axis_2, sed_axis_2), 2};
   auto                                              iter_grid_2 = grid_likelihood_2.begin();
   *iter_grid_2                                                  = std::vector<double>{0.1, 0.2};
   ++iter_grid_2;
@@ -165,7 +167,8 @@ BOOST_FIXTURE_TEST_CASE(test_computeEnclosingVolumeOfCells, GridSamplerScale_fix
   GridContainer::GridAxis<double>                   ebv_axis_3{"E(B-V)", {0.0, 0.7, 1.0}};
   GridContainer::GridAxis<XYDataset::QualifiedName> red_axis_3{"Reddening Curve", {{"Curve1"}}};
   GridContainer::GridAxis<XYDataset::QualifiedName> sed_axis_3{"SED", {{"SED_1"}}};
-  PhzDataModel::DoubleListGrid                      grid_likelihood_3{z_axis_3, ebv_axis_3, red_axis_3, sed_axis_3};
+  PhzDataModel::DoubleListGrid                      grid_likelihood_3{
+      std::make_tuple(z_axis_3, ebv_axis_3, red_axis_3, sed_axis_3), 2};
   auto                                              iter_grid_3 = grid_likelihood_3.begin();
   *iter_grid_3                                                  = std::vector<double>{0.1, 0.2};
   ++iter_grid_3;
@@ -185,7 +188,8 @@ BOOST_FIXTURE_TEST_CASE(test_computeEnclosingVolumeOfCells, GridSamplerScale_fix
   GridContainer::GridAxis<double>                   ebv_axis_4{"E(B-V)", {0.0, 0.7, 1.0}};
   GridContainer::GridAxis<XYDataset::QualifiedName> red_axis_4{"Reddening Curve", {{"Curve1"}}};
   GridContainer::GridAxis<XYDataset::QualifiedName> sed_axis_4{"SED", {{"SED_1"}}};
-  PhzDataModel::DoubleListGrid                      grid_likelihood_4{z_axis_4, ebv_axis_4, red_axis_4, sed_axis_4};
+  PhzDataModel::DoubleListGrid                      grid_likelihood_4{
+      std::make_tuple(z_axis_4, ebv_axis_4, red_axis_4, sed_axis_4), 2};
 
   auto iter_grid_4 = grid_likelihood_4.begin();
   *iter_grid_4     = std::vector<double>{0.3, 0.4};
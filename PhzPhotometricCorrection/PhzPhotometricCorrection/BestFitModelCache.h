@@ -0,0 +1,143 @@
+/*
+ * Copyright (C) 2022 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file PhzPhotometricCorrection/BestFitModelCache.h
+ * @date 2026/10/18
+ */
+
+#ifndef PHZPHOTOMETRICCORRECTION_BESTFITMODELCACHE_H
+#define PHZPHOTOMETRICCORRECTION_BESTFITMODELCACHE_H
+
+#include "PhzDataModel/PhotometryGrid.h"
+#include "PhzLikelihood/SourcePhzFunctor.h"
+#include "SourceCatalog/Source.h"
+#include <atomic>
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace Euclid {
+namespace PhzPhotometricCorrection {
+
+/**
+ * @class BestFitModelCache
+ *
+ * @brief
+ * Keeps the best fitted model of each calibration source between the
+ * iterations of the photometric correction calculation
+ *
+ * @details
+ * The photometric corrections change only slightly between two iterations, so
+ * the best fitted model of a source is expected to be close to the one of the
+ * previous iteration. The cache provides the neighbourhood of the previous best
+ * fitted model (in the EBV, reddening curve and SED axes of its region) to be
+ * searched instead of the full model grid. If the best model of the
+ * neighbourhood is on one of its boundaries which is not also a boundary of the
+ * grid, a better model might exist outside of it and a full search must be
+ * performed instead. The cache counts these fallbacks.
+ *
+ * The cache is shared by the threads fitting the sources, so all its methods
+ * are thread safe.
+ */
+class BestFitModelCache {
+
+public:
+  /// The number of axis knots of the neighbourhood at each side of the best fitted model
+  struct NeighbourhoodSize {
+    std::size_t ebv;
+    std::size_t reddening_curve;
+    std::size_t sed;
+  };
+
+  /**
+   * @brief Constructs a new BestFitModelCache
+   * @param size The size of the neighbourhoods around the best fitted models
+   */
+  explicit BestFitModelCache(NeighbourhoodSize size);
+
+  /**
+   * @brief
+   * Returns the neighbourhood of the best fitted model of the given source
+   *
+   * @param source_id The ID of the source
+   * @param model_grid_map The model grids of all the parameter space regions
+   * @param neighbourhood The neighbourhood, set only if the source has a cached model
+   * @return true if the source has a cached model, false otherwise
+   */
+  bool getNeighbourhood(SourceCatalog::Source::id_type                             source_id,
+                        const std::map<std::string, PhzDataModel::PhotometryGrid>& model_grid_map,
+                        PhzLikelihood::SourcePhzFunctor::ModelNeighbourhood&       neighbourhood) const;
+
+  /**
+   * @brief
+   * Sets the best fitted model of a source
+   *
+   * @param source_id The ID of the source
+   * @param region The parameter space region of the model
+   * @param ebv_index The index of the model in the EBV axis of the region grid
+   * @param reddening_curve_index The index of the model in the reddening curve axis of the region grid
+   * @param sed_index The index of the model in the SED axis of the region grid
+   */
+  void setBestFitModel(SourceCatalog::Source::id_type source_id, const std::string& region, std::size_t ebv_index,
+                       std::size_t reddening_curve_index, std::size_t sed_index);
+
+  /**
+   * @brief
+   * Checks if a model found in a neighbourhood is on one of the neighbourhood
+   * boundaries which are not also boundaries of the model grid
+   *
+   * @param neighbourhood The searched neighbourhood
+   * @param model_grid The model grid of the neighbourhood region
+   * @param ebv_index The index of the model in the EBV axis of the region grid
+   * @param reddening_curve_index The index of the model in the reddening curve axis of the region grid
+   * @param sed_index The index of the model in the SED axis of the region grid
+   * @return true if a full search must be performed
+   */
+  static bool isOnInnerBoundary(const PhzLikelihood::SourcePhzFunctor::ModelNeighbourhood& neighbourhood,
+                                const PhzDataModel::PhotometryGrid& model_grid, std::size_t ebv_index,
+                                std::size_t reddening_curve_index, std::size_t sed_index);
+
+  /// Counts a full search performed because the neighbourhood boundary won
+  void addFallback();
+
+  /// Returns the number of fallbacks since the last reset
+  std::size_t getFallbackCount() const;
+
+  /// Resets the number of fallbacks to zero
+  void resetFallbackCount();
+
+private:
+  struct Model {
+    std::string region;
+    std::size_t ebv_index;
+    std::size_t reddening_curve_index;
+    std::size_t sed_index;
+  };
+
+  NeighbourhoodSize                               m_size;
+  std::map<SourceCatalog::Source::id_type, Model> m_models{};
+  mutable std::mutex                              m_mutex{};
+  std::atomic<std::size_t>                        m_fallbacks{0};
+};
+
+}  // end of namespace PhzPhotometricCorrection
+}  // end of namespace Euclid
+
+#endif /* PHZPHOTOMETRICCORRECTION_BESTFITMODELCACHE_H */
@@ -12,6 +12,7 @@
 #include "PhzDataModel/PhotometryGrid.h"
 #include "PhzLikelihood/ProcessModelGridFunctor.h"
 #include "PhzLikelihood/SourcePhzFunctor.h"
+#include "PhzPhotometricCorrection/BestFitModelCache.h"
 #include "SourceCatalog/Catalog.h"
 #include <map>
 #include <memory>
@@ -28,9 +29,21 @@ namespace PhzPhotometricCorrection {
  * The redshift to be chosen is provided for each sources by the
  * catalog along with the photometry.
  *
+ * The calculator of the best fitted models is built once for all the sources
+ * and only fits the models at their spectroscopic redshift, without computing
+ * any PDF.
+ *
+ * When a BestFitModelCache is given, the sources with a cached best fitted
+ * model (from a previous call) are fitted only in the neighbourhood of that
+ * model, falling back to the full search when the best model is on the inner
+ * boundary of the neighbourhood. The sources with a redshift covered by more
+ * than one parameter space region are always fully searched. The cache is
+ * updated with the new best fitted models.
+ *
  * @tparam SourceCalculatorFunctor A type of functor encoding the algorithm for
  * finding the best fitted model.
- * See SourcePhzFunctor::SourcePhzFunctor for the signatures.
+ * See SourcePhzFunctor::SourcePhzFunctor and
+ * SourcePhzFunctor::computeBestFitAtRedshift for the signatures.
  */
 template <typename SourceCalculatorFunctor>
 class FindBestFitModels {
@@ -45,7 +58,8 @@ public:
                     std::vector<PhzLikelihood::SourcePhzFunctor::MarginalizationFunction> marginalization_func_list =
                         {PhzLikelihood::BayesianMarginalizationFunctor<PhzDataModel::ModelParameter::Z>{
                             PhzDataModel::GridType::POSTERIOR}},
-                    std::vector<std::shared_ptr<PhzLikelihood::ProcessModelGridFunctor>> model_funct_list = {});
+                    std::vector<std::shared_ptr<PhzLikelihood::ProcessModelGridFunctor>> model_funct_list = {},
+                    std::shared_ptr<BestFitModelCache>                                    model_cache      = nullptr);
 
   /**
    * @brief Map each input source to the model which is the best match,
@@ -86,6 +100,7 @@ private:
   std::vector<PriorFunction>                                            m_priors;
   std::vector<PhzLikelihood::SourcePhzFunctor::MarginalizationFunction> m_marginalization_func_list;
   std::vector<std::shared_ptr<PhzLikelihood::ProcessModelGridFunctor>>  m_model_funct_list;
+  std::shared_ptr<BestFitModelCache>                                    m_model_cache;
 };
 
 }  // end of namespace PhzPhotometricCorrection
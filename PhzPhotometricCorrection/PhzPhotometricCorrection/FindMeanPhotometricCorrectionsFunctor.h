@@ -7,6 +7,7 @@
 #ifndef PHOTOMETRICCORRECTION_FINDMEANPHOTOMETRICCORRECTIONSFUNCTOR_H
 #define PHOTOMETRICCORRECTION_FINDMEANPHOTOMETRICCORRECTIONSFUNCTOR_H
 
+#include "AlexandriaKernel/ThreadPool.h"
 #include "PhzDataModel/PhotometricCorrectionMap.h"
 #include "PhzUtils/SourceTraits.h"
 
@@ -23,6 +24,12 @@ namespace PhzPhotometricCorrection {
 class FindMeanPhotometricCorrectionsFunctor {
 
 public:
+  /// Constructs a functor which computes the corrections of all the filters in the calling thread
+  FindMeanPhotometricCorrectionsFunctor() = default;
+
+  /// Constructs a functor which computes the corrections of the filters in parallel, using the given thread pool
+  explicit FindMeanPhotometricCorrectionsFunctor(ThreadPool& thread_pool) : m_thread_pool{&thread_pool} {}
+
   /**
    * @brief Compute the global photometric corrections by taking the mean over the sources.
    *
@@ -41,6 +48,9 @@ public:
   operator()(const std::map<typename PhzUtils::SourceIterTraits<SourceIter>::id_type,
                             PhzDataModel::PhotometricCorrectionMap>& source_phot_corr_map,
              SourceIter source_begin, SourceIter source_end);
+
+private:
+  ThreadPool* m_thread_pool = nullptr;
 };
 
 }  // end of namespace PhzPhotometricCorrection
@@ -8,6 +8,7 @@
 #ifndef FINDMEDIANPHOTOMETRICCORRECTIONSFUNCTOR_H_
 #define FINDMEDIANPHOTOMETRICCORRECTIONSFUNCTOR_H_
 
+#include "AlexandriaKernel/ThreadPool.h"
 #include "PhzDataModel/PhotometricCorrectionMap.h"
 #include "PhzUtils/SourceTraits.h"
 #include "SourceCatalog/SourceAttributes/Photometry.h"
@@ -24,6 +25,12 @@ namespace PhzPhotometricCorrection {
  */
 class FindMedianPhotometricCorrectionsFunctor {
 public:
+  /// Constructs a functor which computes the corrections of all the filters in the calling thread
+  FindMedianPhotometricCorrectionsFunctor() = default;
+
+  /// Constructs a functor which computes the corrections of the filters in parallel, using the given thread pool
+  explicit FindMedianPhotometricCorrectionsFunctor(ThreadPool& thread_pool) : m_thread_pool{&thread_pool} {}
+
   /**
    * @brief Compute the global photometric corrections by taking the median over the sources.
    *
@@ -42,6 +49,9 @@ public:
   operator()(const std::map<typename PhzUtils::SourceIterTraits<SourceIter>::id_type,
                             PhzDataModel::PhotometricCorrectionMap>& source_phot_corr_map,
              SourceIter source_begin, SourceIter source_end);
+
+private:
+  ThreadPool* m_thread_pool = nullptr;
 };
 
 }  // end of namespace PhzPhotometricCorrection
@@ -7,6 +7,7 @@
 #ifndef PHZPHOTOMETRICCORRECTION_FINDWEIGHTEDMEDIANPHOTOMETRICCORRECTIONSFUNCTOR_H
 #define PHZPHOTOMETRICCORRECTION_FINDWEIGHTEDMEDIANPHOTOMETRICCORRECTIONSFUNCTOR_H
 
+#include "AlexandriaKernel/ThreadPool.h"
 #include "PhzDataModel/PhotometricCorrectionMap.h"
 #include "PhzUtils/SourceTraits.h"
 
@@ -23,6 +24,12 @@ namespace PhzPhotometricCorrection {
 class FindWeightedMedianPhotometricCorrectionsFunctor {
 
 public:
+  /// Constructs a functor which computes the corrections of all the filters in the calling thread
+  FindWeightedMedianPhotometricCorrectionsFunctor() = default;
+
+  /// Constructs a functor which computes the corrections of the filters in parallel, using the given thread pool
+  explicit FindWeightedMedianPhotometricCorrectionsFunctor(ThreadPool& thread_pool) : m_thread_pool{&thread_pool} {}
+
   /**
    * @brief Compute the global photometric corrections by taking the  weighted
    * median over the sources.
@@ -44,6 +51,9 @@ public:
   operator()(const std::map<typename PhzUtils::SourceIterTraits<SourceIter>::id_type,
                             PhzDataModel::PhotometricCorrectionMap>& source_phot_corr_map,
              SourceIter source_begin, SourceIter source_end);
+
+private:
+  ThreadPool* m_thread_pool = nullptr;
 };
 
 }  // end of namespace PhzPhotometricCorrection
@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2022 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file PhzPhotometricCorrection/PhotometricCorrectionStatistics.h
+ * @date 2026/10/18
+ */
+
+#ifndef PHZPHOTOMETRICCORRECTION_PHOTOMETRICCORRECTIONSTATISTICS_H
+#define PHZPHOTOMETRICCORRECTION_PHOTOMETRICCORRECTIONSTATISTICS_H
+
+#include "AlexandriaKernel/ThreadPool.h"
+#include "PhzDataModel/PhotometricCorrectionMap.h"
+#include "PhzUtils/SourceTraits.h"
+#include <map>
+#include <vector>
+
+namespace Euclid {
+namespace PhzPhotometricCorrection {
+
+/**
+ * @class PhotometricCorrectionStatistics
+ *
+ * @brief
+ * Reduces the optimal photometric corrections of the sources to a single
+ * correction per filter
+ *
+ * @details
+ * The corrections (and weights) of each filter are given in contiguous buffers.
+ * The medians are computed by selection (std::nth_element) instead of sorting,
+ * so the cost is linear with the number of sources. When a thread pool is
+ * given, the filters are reduced in parallel.
+ */
+class PhotometricCorrectionStatistics {
+
+public:
+  /// The statistic used for reducing the corrections of a filter
+  enum class Method { MEAN, MEDIAN, WEIGHTED_MEAN, WEIGHTED_MEDIAN };
+
+  /// The corrections of the sources for a single filter and their weights. The
+  /// weights are ignored by the unweighted methods.
+  struct FilterSample {
+    std::vector<double> corrections{};
+    std::vector<double> weights{};
+  };
+
+  /**
+   * @brief Constructs a new PhotometricCorrectionStatistics
+   * @param method The statistic to compute
+   * @param thread_pool The thread pool to use for reducing the filters in
+   *    parallel, or nullptr for reducing them in the calling thread
+   */
+  explicit PhotometricCorrectionStatistics(Method method, ThreadPool* thread_pool = nullptr);
+
+  /**
+   * @brief
+   * Reduces the samples of all the filters. The correction buffers may be
+   * reordered. The filters without any source (or with zero total weight for
+   * the weighted methods) get a correction of 1.
+   *
+   * @param samples The corrections and weights of each filter
+   * @return The photometric correction of each filter
+   */
+  PhzDataModel::PhotometricCorrectionMap operator()(std::map<XYDataset::QualifiedName, FilterSample>& samples) const;
+
+  /// Returns the mean of the values, which must not be empty
+  static double mean(const std::vector<double>& values);
+
+  /// Returns the median of the values, which must not be empty. The values are reordered.
+  static double median(std::vector<double>& values);
+
+  /// Returns the weighted mean of the values. The total weight must not be zero.
+  static double weightedMean(const std::vector<double>& values, const std::vector<double>& weights);
+
+  /**
+   * @brief
+   * Returns the weighted median of the values, which is the smallest value for
+   * which the total weight of the values up to it reaches half of the total
+   * weight. The total weight must not be zero.
+   */
+  static double weightedMedian(const std::vector<double>& values, const std::vector<double>& weights);
+
+  /**
+   * @brief
+   * Collects the corrections of the sources in a sample per filter, skipping
+   * the NaN corrections of the missing photometries
+   *
+   * @param source_phot_corr_map A map associating the source id to the
+   *    photometric correction map for this source
+   * @return The corrections of each filter, without weights
+   */
+  template <typename SourceIdType>
+  static std::map<XYDataset::QualifiedName, FilterSample>
+  collectCorrections(const std::map<SourceIdType, PhzDataModel::PhotometricCorrectionMap>& source_phot_corr_map);
+
+  /**
+   * @brief
+   * Collects the corrections of the sources in a sample per filter, weighted
+   * with the inverse of the relative error of the source photometry. The
+   * missing photometries and the upper limits are skipped.
+   *
+   * @param source_phot_corr_map A map associating the source id to the
+   *    photometric correction map for this source
+   * @param source_begin An iterator to the first of the sources
+   * @param source_end An iterator to one after the last of the sources
+   * @return The corrections of each filter and their weights
+   */
+  template <typename SourceIter>
+  static std::map<XYDataset::QualifiedName, FilterSample> collectWeightedCorrections(
+      const std::map<typename PhzUtils::SourceIterTraits<SourceIter>::id_type, PhzDataModel::PhotometricCorrectionMap>&
+                 source_phot_corr_map,
+      SourceIter source_begin, SourceIter source_end);
+
+private:
+  Method      m_method;
+  ThreadPool* m_thread_pool;
+};
+
+}  // end of namespace PhzPhotometricCorrection
+}  // end of namespace Euclid
+
+#include "PhzPhotometricCorrection/_impl/PhotometricCorrectionStatistics.icpp"
+
+#endif /* PHZPHOTOMETRICCORRECTION_PHOTOMETRICCORRECTIONSTATISTICS_H */
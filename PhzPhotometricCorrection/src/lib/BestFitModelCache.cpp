@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2022 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file src/lib/BestFitModelCache.cpp
+ * @date 2026/10/18
+ */
+
+#include "PhzPhotometricCorrection/BestFitModelCache.h"
+#include <algorithm>
+
+namespace Euclid {
+namespace PhzPhotometricCorrection {
+
+namespace {
+
+std::pair<std::size_t, std::size_t> indexRange(std::size_t index, std::size_t size, std::size_t axis_size) {
+  return {index > size ? index - size : 0, std::min(index + size, axis_size - 1)};
+}
+
+bool isAxisOnInnerBoundary(const std::pair<std::size_t, std::size_t>& range, std::size_t index, std::size_t axis_size) {
+  return (index == range.first && range.first > 0) || (index == range.second && range.second < axis_size - 1);
+}
+
+}  // end of anonymous namespace
+
+BestFitModelCache::BestFitModelCache(NeighbourhoodSize size) : m_size(size) {}
+
+bool BestFitModelCache::getNeighbourhood(SourceCatalog::Source::id_type                             source_id,
+                                         const std::map<std::string, PhzDataModel::PhotometryGrid>& model_grid_map,
+                                         PhzLikelihood::SourcePhzFunctor::ModelNeighbourhood& neighbourhood) const {
+  Model model;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto                        found = m_models.find(source_id);
+    if (found == m_models.end()) {
+      return false;
+    }
+    model = found->second;
+  }
+  auto& grid       = model_grid_map.at(model.region);
+  auto& ebv_axis   = grid.getAxis<PhzDataModel::ModelParameter::EBV>();
+  auto& curve_axis = grid.getAxis<PhzDataModel::ModelParameter::REDDENING_CURVE>();
+  auto& sed_axis   = grid.getAxis<PhzDataModel::ModelParameter::SED>();
+  neighbourhood.region    = model.region;
+  neighbourhood.ebv_range = indexRange(model.ebv_index, m_size.ebv, ebv_axis.size());
+  neighbourhood.reddening_curve_range =
+      indexRange(model.reddening_curve_index, m_size.reddening_curve, curve_axis.size());
+  neighbourhood.sed_range = indexRange(model.sed_index, m_size.sed, sed_axis.size());
+  return true;
+}
+
+void BestFitModelCache::setBestFitModel(SourceCatalog::Source::id_type source_id, const std::string& region,
+                                        std::size_t ebv_index, std::size_t reddening_curve_index,
+                                        std::size_t sed_index) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_models[source_id] = Model{region, ebv_index, reddening_curve_index, sed_index};
+}
+
+bool BestFitModelCache::isOnInnerBoundary(const PhzLikelihood::SourcePhzFunctor::ModelNeighbourhood& neighbourhood,
+                                          const PhzDataModel::PhotometryGrid& model_grid, std::size_t ebv_index,
+                                          std::size_t reddening_curve_index, std::size_t sed_index) {
+  auto& ebv_axis   = model_grid.getAxis<PhzDataModel::ModelParameter::EBV>();
+  auto& curve_axis = model_grid.getAxis<PhzDataModel::ModelParameter::REDDENING_CURVE>();
+  auto& sed_axis   = model_grid.getAxis<PhzDataModel::ModelParameter::SED>();
+  return isAxisOnInnerBoundary(neighbourhood.ebv_range, ebv_index, ebv_axis.size()) ||
+         isAxisOnInnerBoundary(neighbourhood.reddening_curve_range, reddening_curve_index, curve_axis.size()) ||
+         isAxisOnInnerBoundary(neighbourhood.sed_range, sed_index, sed_axis.size());
+}
+
+void BestFitModelCache::addFallback() {
+  ++m_fallbacks;
+}
+
+std::size_t BestFitModelCache::getFallbackCount() const {
+  return m_fallbacks;
+}
+
+void BestFitModelCache::resetFallbackCount() {
+  m_fallbacks = 0;
+}
+
+}  // end of namespace PhzPhotometricCorrection
+}  // end of namespace Euclid
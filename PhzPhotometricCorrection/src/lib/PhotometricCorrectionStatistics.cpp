@@ -0,0 +1,181 @@
+/*
+ * Copyright (C) 2022 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file src/lib/PhotometricCorrectionStatistics.cpp
+ * @date 2026/10/18
+ */
+
+#include "PhzPhotometricCorrection/PhotometricCorrectionStatistics.h"
+#include "ElementsKernel/Logging.h"
+#include <algorithm>
+#include <numeric>
+#include <utility>
+
+namespace Euclid {
+namespace PhzPhotometricCorrection {
+
+static Elements::Logging logger = Elements::Logging::getLogger("PhotometricCorrectionStatistics");
+
+PhotometricCorrectionStatistics::PhotometricCorrectionStatistics(Method method, ThreadPool* thread_pool)
+    : m_method{method}, m_thread_pool{thread_pool} {}
+
+double PhotometricCorrectionStatistics::mean(const std::vector<double>& values) {
+  double sum = 0.;
+  for (double value : values) {
+    sum += value;
+  }
+  return sum / values.size();
+}
+
+double PhotometricCorrectionStatistics::median(std::vector<double>& values) {
+  auto middle = values.begin() + values.size() / 2;
+  std::nth_element(values.begin(), middle, values.end());
+  if (values.size() % 2 == 1) {
+    return *middle;
+  }
+  // The lower middle value is the largest of the values before the middle
+  return (*std::max_element(values.begin(), middle) + *middle) / 2;
+}
+
+double PhotometricCorrectionStatistics::weightedMean(const std::vector<double>& values,
+                                                     const std::vector<double>& weights) {
+  double sum          = 0.;
+  double total_weight = 0.;
+  for (std::size_t i = 0; i < values.size(); ++i) {
+    sum += values[i] * weights[i];
+    total_weight += weights[i];
+  }
+  return sum / total_weight;
+}
+
+double PhotometricCorrectionStatistics::weightedMedian(const std::vector<double>& values,
+                                                       const std::vector<double>& weights) {
+  std::vector<std::pair<double, double>> pairs(values.size());
+  double                                 total_weight = 0.;
+  bool                                   negative     = false;
+  for (std::size_t i = 0; i < values.size(); ++i) {
+    pairs[i] = {values[i], weights[i]};
+    total_weight += weights[i];
+    negative = negative || weights[i] < 0;
+  }
+  double half    = total_weight / 2.;
+  auto   compare = [](const std::pair<double, double>& a, const std::pair<double, double>& b) {
+    return a.first < b.first;
+  };
+
+  // With negative weights the cumulative weight is not monotonic, so the values
+  // must be walked in order
+  if (negative) {
+    std::stable_sort(pairs.begin(), pairs.end(), compare);
+    std::size_t i       = 0;
+    double      current = 0.;
+    for (; i + 1 < pairs.size() && current + pairs[i].second < half; ++i) {
+      current += pairs[i].second;
+    }
+    return pairs[i].first;
+  }
+
+  // Otherwise the range containing the weighted median is narrowed by
+  // partitioning it around its middle element
+  auto   begin  = pairs.begin();
+  auto   end    = pairs.end();
+  double before = 0.;
+  while (begin != end) {
+    auto middle = begin + (end - begin) / 2;
+    std::nth_element(begin, middle, end, compare);
+    double left = 0.;
+    for (auto iter = begin; iter != middle; ++iter) {
+      left += iter->second;
+    }
+    if (before + left >= half) {
+      end = middle;
+    } else if (before + left + middle->second >= half) {
+      return middle->first;
+    } else {
+      before += left + middle->second;
+      begin = middle + 1;
+    }
+  }
+
+  // Reached only due to rounding errors of the total weight
+  return std::max_element(pairs.begin(), pairs.end(), compare)->first;
+}
+
+PhzDataModel::PhotometricCorrectionMap
+PhotometricCorrectionStatistics::operator()(std::map<XYDataset::QualifiedName, FilterSample>& samples) const {
+  std::vector<FilterSample*> sample_list{};
+  for (auto& pair : samples) {
+    sample_list.emplace_back(&pair.second);
+  }
+
+  // Each position of these vectors is used by a single thread, so we do not need locking
+  std::vector<double> corrections(sample_list.size(), 1.);
+  std::vector<char>   reliable(sample_list.size(), true);
+
+  auto reduce = [this, &sample_list, &corrections, &reliable](std::size_t i) {
+    auto& sample   = *sample_list[i];
+    bool  weighted = m_method == Method::WEIGHTED_MEAN || m_method == Method::WEIGHTED_MEDIAN;
+    if (sample.corrections.empty() ||
+        (weighted && std::accumulate(sample.weights.begin(), sample.weights.end(), 0.) == 0)) {
+      reliable[i] = false;
+      return;
+    }
+    switch (m_method) {
+    case Method::MEAN:
+      corrections[i] = mean(sample.corrections);
+      break;
+    case Method::MEDIAN:
+      corrections[i] = median(sample.corrections);
+      break;
+    case Method::WEIGHTED_MEAN:
+      corrections[i] = weightedMean(sample.corrections, sample.weights);
+      break;
+    case Method::WEIGHTED_MEDIAN:
+      corrections[i] = weightedMedian(sample.corrections, sample.weights);
+      break;
+    }
+  };
+
+  if (m_thread_pool != nullptr && sample_list.size() > 1) {
+    for (std::size_t i = 0; i < sample_list.size(); ++i) {
+      m_thread_pool->submit([&reduce, i]() {
+        reduce(i);
+      });
+    }
+    m_thread_pool->block();
+  } else {
+    for (std::size_t i = 0; i < sample_list.size(); ++i) {
+      reduce(i);
+    }
+  }
+
+  PhzDataModel::PhotometricCorrectionMap result{};
+  std::size_t                            i = 0;
+  for (auto& pair : samples) {
+    if (!reliable[i]) {
+      logger.warn() << "The photometry band " << pair.first << " has no reliable source. It will not be fitted.";
+    }
+    result[pair.first] = corrections[i];
+    ++i;
+  }
+  return result;
+}
+
+}  // end of namespace PhzPhotometricCorrection
+}  // end of namespace Euclid
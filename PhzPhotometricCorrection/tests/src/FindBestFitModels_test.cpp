@@ -31,6 +31,8 @@
 
 #include "ElementsKernel/Exception.h"
 #include "ElementsKernel/Real.h"
+#include "PhzLikelihood/GenericGridPrior.h"
+#include "PhzLikelihood/SharedPriorAdapter.h"
 #include "PhzLikelihood/SourcePhzFunctor.h"
 #include "PhzPhotometricCorrection/FindBestFitModels.h"
 #include "SourceCatalog/Catalog.h"
@@ -176,6 +178,124 @@ BOOST_FIXTURE_TEST_CASE(Functional_call_throw_test, FindBestFitModels_Fixture) {
       Elements::Exception);
 }
 
+BOOST_FIXTURE_TEST_CASE(Warm_start_test, FindBestFitModels_Fixture) {
+  std::map<std::string, Euclid::PhzDataModel::PhotometryGrid> model_grid_map{};
+  model_grid_map.emplace(std::make_pair(std::string{""}, std::move(photo_grid)));
+  auto full_object = FindBestFitModels<PhzLikelihood::SourcePhzFunctor>(likelihood_func, error_adjust_param_map, 5.);
+  auto expected    = full_object(sources.begin(), sources.end(), model_grid_map, correctionMap);
+
+  // A neighbourhood covering the whole EBV axis never falls back
+  auto wide_cache  = make_shared<BestFitModelCache>(BestFitModelCache::NeighbourhoodSize{1, 0, 0});
+  auto wide_object = FindBestFitModels<PhzLikelihood::SourcePhzFunctor>(
+      likelihood_func, error_adjust_param_map, 5., {}, {}, {}, wide_cache);
+  wide_object(sources.begin(), sources.end(), model_grid_map, correctionMap);
+  auto wide_result = wide_object(sources.begin(), sources.end(), model_grid_map, correctionMap);
+  BOOST_CHECK_EQUAL(wide_cache->getFallbackCount(), 0);
+
+  // A single model neighbourhood is always on an inner boundary
+  auto narrow_cache  = make_shared<BestFitModelCache>(BestFitModelCache::NeighbourhoodSize{0, 0, 0});
+  auto narrow_object = FindBestFitModels<PhzLikelihood::SourcePhzFunctor>(
+      likelihood_func, error_adjust_param_map, 5., {}, {}, {}, narrow_cache);
+  narrow_object(sources.begin(), sources.end(), model_grid_map, correctionMap);
+  auto narrow_result = narrow_object(sources.begin(), sources.end(), model_grid_map, correctionMap);
+  BOOST_CHECK_EQUAL(narrow_cache->getFallbackCount(), expected.size());
+
+  for (auto& result : {wide_result, narrow_result}) {
+    BOOST_CHECK_EQUAL(result.size(), expected.size());
+    for (auto& pair : expected) {
+      auto& photometry = result.at(pair.first);
+      for (auto iter = pair.second.begin(), result_iter = photometry.begin(); iter != pair.second.end();
+           ++iter, ++result_iter) {
+        BOOST_CHECK(Elements::isEqual((*iter).flux, (*result_iter).flux));
+      }
+    }
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE(Warm_start_overlapping_regions_test, FindBestFitModels_Fixture) {
+  // The models of the second region fit the sources with the fixture correction
+  // best, and the ones of the first region without correction
+  SourceCatalog::Photometry corrected_1{filters, vector<SourceCatalog::FluxErrorPair>{{1.1, 0.}, {2.4, 0.}}};
+  for (auto iter = ref_photo_grid.begin(); iter != ref_photo_grid.end(); ++iter) {
+    *iter = corrected_1;
+  }
+  std::map<std::string, Euclid::PhzDataModel::PhotometryGrid> model_grid_map{};
+  model_grid_map.emplace(std::make_pair(std::string{"first"}, std::move(photo_grid)));
+  model_grid_map.emplace(std::make_pair(std::string{"second"}, std::move(ref_photo_grid)));
+  PhzDataModel::PhotometricCorrectionMap no_correction{{XYDataset::QualifiedName{"Filter1"}, 1.0},
+                                                       {XYDataset::QualifiedName{"Filter2"}, 1.0}};
+  auto full_object = FindBestFitModels<PhzLikelihood::SourcePhzFunctor>(likelihood_func, error_adjust_param_map, 5.);
+  auto expected    = full_object(sources.begin(), sources.end(), model_grid_map, no_correction);
+
+  // The cached models of the first call are in the second region
+  auto cache  = make_shared<BestFitModelCache>(BestFitModelCache::NeighbourhoodSize{1, 0, 0});
+  auto object = FindBestFitModels<PhzLikelihood::SourcePhzFunctor>(likelihood_func, error_adjust_param_map, 5., {},
+                                                                   {}, {}, cache);
+  auto first_result = object(sources.begin(), sources.end(), model_grid_map, correctionMap);
+  auto first_iter   = first_result.at(1).begin();
+  BOOST_CHECK(Elements::isEqual((*first_iter).flux, 1.1));
+  BOOST_CHECK(Elements::isEqual((*++first_iter).flux, 2.4));
+  auto result = object(sources.begin(), sources.end(), model_grid_map, no_correction);
+
+  BOOST_CHECK_EQUAL(result.size(), expected.size());
+  for (auto& pair : expected) {
+    auto& photometry = result.at(pair.first);
+    for (auto iter = pair.second.begin(), result_iter = photometry.begin(); iter != pair.second.end();
+         ++iter, ++result_iter) {
+      BOOST_CHECK(Elements::isEqual((*iter).flux, (*result_iter).flux));
+    }
+  }
+  auto result_iter = result.at(1).begin();
+  BOOST_CHECK(Elements::isEqual((*result_iter).flux, 1.1));
+  BOOST_CHECK(Elements::isEqual((*++result_iter).flux, 1.2));
+}
+
+BOOST_FIXTURE_TEST_CASE(Warm_start_grid_prior_test, FindBestFitModels_Fixture) {
+  // The neighbourhood of the models at the first EBV does not cover the full EBV axis
+  vector<double>               wide_ebvs{0.0, 0.001, 0.002, 0.003};
+  auto                         wide_axes = PhzDataModel::createAxesTuple(zs, wide_ebvs, reddeing_curves, seds);
+  PhzDataModel::PhotometryGrid wide_grid{wide_axes, *filters};
+  vector<SourceCatalog::Photometry> photometries{photometry_1, photometry_2, photometry_3, photometry_4};
+  for (auto iter = wide_grid.begin(); iter != wide_grid.end(); ++iter) {
+    *iter = photometries[(iter.axisIndex<PhzDataModel::ModelParameter::Z>() +
+                          iter.axisIndex<PhzDataModel::ModelParameter::EBV>()) %
+                         photometries.size()];
+  }
+  std::map<std::string, Euclid::PhzDataModel::PhotometryGrid> model_grid_map{};
+  model_grid_map.emplace(std::make_pair(std::string{""}, std::move(wide_grid)));
+
+  // The prior excludes all the models but the ones at the first EBV
+  PhzDataModel::DoubleGrid prior_grid{wide_axes};
+  for (auto iter = prior_grid.begin(); iter != prior_grid.end(); ++iter) {
+    *iter = (iter.axisIndex<PhzDataModel::ModelParameter::EBV>() == 0) ? 1. : 0.;
+  }
+  vector<PhzDataModel::DoubleGrid> prior_grid_list{};
+  prior_grid_list.emplace_back(std::move(prior_grid));
+  vector<PhzLikelihood::SourcePhzFunctor::PriorFunction> priors{
+      PhzLikelihood::SharedPriorAdapter<PhzLikelihood::GenericGridPrior>::factory(std::move(prior_grid_list))};
+
+  auto full_object =
+      FindBestFitModels<PhzLikelihood::SourcePhzFunctor>(likelihood_func, error_adjust_param_map, 5., priors);
+  auto expected = full_object(sources.begin(), sources.end(), model_grid_map, correctionMap);
+
+  auto cache  = make_shared<BestFitModelCache>(BestFitModelCache::NeighbourhoodSize{1, 0, 0});
+  auto object = FindBestFitModels<PhzLikelihood::SourcePhzFunctor>(likelihood_func, error_adjust_param_map, 5.,
+                                                                   priors, {}, {}, cache);
+  object(sources.begin(), sources.end(), model_grid_map, correctionMap);
+  std::map<SourceCatalog::Source::id_type, SourceCatalog::Photometry> result{};
+  BOOST_CHECK_NO_THROW(result = object(sources.begin(), sources.end(), model_grid_map, correctionMap));
+  BOOST_CHECK_EQUAL(cache->getFallbackCount(), 0);
+
+  BOOST_CHECK_EQUAL(result.size(), expected.size());
+  for (auto& pair : expected) {
+    auto& photometry = result.at(pair.first);
+    for (auto iter = pair.second.begin(), result_iter = photometry.begin(); iter != pair.second.end();
+         ++iter, ++result_iter) {
+      BOOST_CHECK(Elements::isEqual((*iter).flux, (*result_iter).flux));
+    }
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }  // end of namespace PhzPhotometricCorrection
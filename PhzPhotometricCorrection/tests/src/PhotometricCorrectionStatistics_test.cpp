@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) 2022 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file tests/src/PhotometricCorrectionStatistics_test.cpp
+ * @date 2026/10/18
+ */
+
+#include "PhzPhotometricCorrection/PhotometricCorrectionStatistics.h"
+#include <algorithm>
+#include <boost/test/unit_test.hpp>
+#include <random>
+
+using namespace Euclid;
+using namespace Euclid::PhzPhotometricCorrection;
+
+namespace {
+
+/// The weighted median, computed by walking the sorted values
+double sortedWeightedMedian(const std::vector<double>& values, const std::vector<double>& weights) {
+  std::vector<std::pair<double, double>> pairs{};
+  double                                 total_weight = 0.;
+  for (std::size_t i = 0; i < values.size(); ++i) {
+    pairs.emplace_back(values[i], weights[i]);
+    total_weight += weights[i];
+  }
+  std::sort(pairs.begin(), pairs.end());
+  std::size_t i       = 0;
+  double      current = 0.;
+  for (; current + pairs[i].second < total_weight / 2.; ++i) {
+    current += pairs[i].second;
+  }
+  return pairs[i].first;
+}
+
+}  // namespace
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE(PhotometricCorrectionStatistics_test)
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(median_test) {
+  std::vector<double> odd{5., 1., 4., 2., 3.};
+  std::vector<double> even{6., 1., 5., 2., 4., 3.};
+
+  BOOST_CHECK_EQUAL(PhotometricCorrectionStatistics::median(odd), 3.);
+  BOOST_CHECK_EQUAL(PhotometricCorrectionStatistics::median(even), 3.5);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(mean_test) {
+  BOOST_CHECK_CLOSE(PhotometricCorrectionStatistics::mean({1., 2., 6.}), 3., 1E-10);
+  BOOST_CHECK_CLOSE(PhotometricCorrectionStatistics::weightedMean({1., 2., 6.}, {1., 2., 1.}), 2.75, 1E-10);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(weightedMedian_test) {
+  std::mt19937                       generator{42};
+  std::uniform_int_distribution<int> value_distribution{0, 20};
+  std::uniform_int_distribution<int> weight_distribution{0, 10};
+  for (std::size_t size = 1; size < 200; ++size) {
+    std::vector<double> values{};
+    std::vector<double> weights{};
+    for (std::size_t i = 0; i < size; ++i) {
+      values.emplace_back(value_distribution(generator));
+      weights.emplace_back(weight_distribution(generator));
+    }
+    weights.front() += 1.;
+    BOOST_CHECK_EQUAL(PhotometricCorrectionStatistics::weightedMedian(values, weights),
+                      sortedWeightedMedian(values, weights));
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(parallel_filters_test) {
+
+  // Given
+  ThreadPool                                                                       thread_pool{4};
+  std::map<XYDataset::QualifiedName, PhotometricCorrectionStatistics::FilterSample> samples{};
+  samples[{"Filter_1"}] = {{1., 3., 2.}, {1., 1., 1.}};
+  samples[{"Filter_2"}] = {{4., 1., 2., 3.}, {1., 1., 1., 5.}};
+  samples[{"Filter_3"}] = {{}, {}};
+  samples[{"Filter_4"}] = {{2., 5.}, {0., 0.}};
+
+  // When
+  auto medians = PhotometricCorrectionStatistics{PhotometricCorrectionStatistics::Method::MEDIAN, &thread_pool}(
+      samples);
+  auto weighted_medians =
+      PhotometricCorrectionStatistics{PhotometricCorrectionStatistics::Method::WEIGHTED_MEDIAN, &thread_pool}(samples);
+
+  // Then
+  BOOST_CHECK_EQUAL(medians.size(), 4);
+  BOOST_CHECK_EQUAL(medians.at({"Filter_1"}), 2.);
+  BOOST_CHECK_EQUAL(medians.at({"Filter_2"}), 2.5);
+  BOOST_CHECK_EQUAL(medians.at({"Filter_3"}), 1.);
+  BOOST_CHECK_EQUAL(medians.at({"Filter_4"}), 3.5);
+  BOOST_CHECK_EQUAL(weighted_medians.at({"Filter_2"}), 3.);
+  BOOST_CHECK_EQUAL(weighted_medians.at({"Filter_3"}), 1.);
+  BOOST_CHECK_EQUAL(weighted_medians.at({"Filter_4"}), 1.);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE_END()
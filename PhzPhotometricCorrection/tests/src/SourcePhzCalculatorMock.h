@@ -42,14 +42,24 @@ public:
     return std::move(*res);
   }
 
+  PhzDataModel::SourceResults computeBestFitAtRedshift(const SourceCatalog::Source& source, double) {
+    return (*this)(source);
+  }
+
+  PhzDataModel::SourceResults computeBestFitAtRedshift(const SourceCatalog::Source& source, double,
+                                                       const PhzLikelihood::SourcePhzFunctor::ModelNeighbourhood&) {
+    return (*this)(source);
+  }
+
   void expectFunctorCall() {
-    PhzDataModel::SourceResults result{};
-    result.set<PhzDataModel::SourceResultType::BEST_MODEL_ITERATOR>(m_phot_grid.begin());
-    result.set<PhzDataModel::SourceResultType::Z_1D_PDF>(
-        PhzDataModel::Pdf1DParam<PhzDataModel::ModelParameter::Z>{GridContainer::GridAxis<double>{"Axis", {}}});
-    result.set<PhzDataModel::SourceResultType::BEST_MODEL_SCALE_FACTOR>(0);
-    result.set<PhzDataModel::SourceResultType::BEST_MODEL_POSTERIOR_LOG>(0);
-    EXPECT_CALL(*this, FunctorCall(_)).WillOnce(Return(new PhzDataModel::SourceResults{result}));
+    auto& phot_grid = m_phot_grid;
+    EXPECT_CALL(*this, FunctorCall(_)).WillRepeatedly(Invoke([&phot_grid](const SourceCatalog::Source&) {
+      auto result = new PhzDataModel::SourceResults{};
+      result->set<PhzDataModel::SourceResultType::BEST_MODEL_ITERATOR>(phot_grid.begin());
+      result->set<PhzDataModel::SourceResultType::BEST_MODEL_SCALE_FACTOR>(0);
+      result->set<PhzDataModel::SourceResultType::BEST_MODEL_POSTERIOR_LOG>(0);
+      return result;
+    }));
   };
 
 private:
@@ -0,0 +1,148 @@
+/*
+ * Copyright (C) 2022 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file PhzReferenceSample/CompactDataFile.h
+ * @date 2026/10/18
+ */
+
+#ifndef _REFERENCESAMPLE_COMPACTDATAFILE_H
+#define _REFERENCESAMPLE_COMPACTDATAFILE_H
+
+#include "NdArray/NdArray.h"
+#include "PhzReferenceSample/StorageMode.h"
+#include "XYDataset/XYDataset.h"
+#include <boost/filesystem/path.hpp>
+#include <memory>
+#include <unordered_map>
+
+namespace Euclid {
+namespace ReferenceSample {
+
+/**
+ * @class CompactDataFile
+ * @brief
+ *  Data file with the StorageMode::FLOAT16 or StorageMode::FLOAT32_SHARED_AXIS layout, used by the SED and PDZ
+ *  providers.
+ * @details
+ *  The entries are stored on a uint16 array. The first row is reserved, so the positions start at 1. Each entry
+ *  holds the index of its axis (on two columns), its scale (the bits of a float, on two columns) and its values.
+ *  With FLOAT16 the values are the half precision values divided by the scale, so the array has the shape
+ *  [n + 1, knots + 4]. With FLOAT32_SHARED_AXIS the values are the bits of the single precision values, on two
+ *  columns each, and the scale is always 1, so the array has the shape [n + 1, 2 * knots + 4]. The distinct axes
+ *  are stored on a float array of shape [axes, knots], on a file next to the data file.
+ */
+class CompactDataFile {
+
+public:
+  /// @return The path of the axis table of the given data file
+  static boost::filesystem::path axisPath(const boost::filesystem::path& path);
+
+  /// @return true if the given data file exists and has the compact layout
+  static bool isCompact(const boost::filesystem::path& path);
+
+  /**
+   * Constructor. The files are created when the first entry is added.
+   * @param path
+   *    Path of the data file.
+   * @param max_size
+   *    The maximum size of each of the files.
+   * @param read_only
+   *    If true, no entry can be added or modified
+   * @param storage_mode
+   *    The layout of the files if they are created, StorageMode::FLOAT16 or StorageMode::FLOAT32_SHARED_AXIS.
+   *    Existing files are read with the layout they were written with.
+   * @throw Elements::Exception
+   *    If the files exist but do not have the expected shape
+   */
+  CompactDataFile(boost::filesystem::path path, std::size_t max_size, bool read_only,
+                  StorageMode storage_mode = StorageMode::FLOAT16);
+
+  CompactDataFile(CompactDataFile&&) = default;
+
+  /// @return The layout of the file
+  StorageMode storageMode() const;
+
+  /// @return The number of knots of the entries, 0 if there is no entry yet
+  std::size_t knots() const;
+
+  /// @return The number of entries
+  std::size_t length() const;
+
+  /// @return The size on disk of the data file and the axis table
+  std::size_t diskSize() const;
+
+  /**
+   * Add an entry.
+   * @return The position of the entry
+   * @throw Elements::Exception
+   *    If the file is read-only, or the entry does not have the same number of knots as the previous ones
+   */
+  int64_t add(const XYDataset::XYDataset& data);
+
+  /**
+   * Replace an existing entry.
+   * @throw Elements::Exception
+   *    If the file is read-only, the position is out of bounds or the number of knots differs
+   */
+  void set(int64_t position, const XYDataset::XYDataset& data);
+
+  /// @return The decoded entry at the given position
+  XYDataset::XYDataset read(int64_t position) const;
+
+  /// @return The axis of the entry at the given position
+  const float* axis(int64_t position) const;
+
+  /**
+   * @return The half precision values of the entry at the given position, to be multiplied by its scale
+   * @throw Elements::Exception
+   *    If the file does not have the StorageMode::FLOAT16 layout
+   */
+  const std::uint16_t* halfValues(int64_t position) const;
+
+  /**
+   * @return The single precision values of the entry at the given position, each one on two words, to be read
+   *    with loadFloat()
+   * @throw Elements::Exception
+   *    If the file does not have the StorageMode::FLOAT32_SHARED_AXIS layout
+   */
+  const std::uint16_t* floatValues(int64_t position) const;
+
+  /// @return The scale of the entry at the given position
+  float scale(int64_t position) const;
+
+private:
+  boost::filesystem::path                             m_path;
+  std::size_t                                         m_max_size;
+  bool                                                m_read_only;
+  StorageMode                                         m_storage_mode;
+  std::unique_ptr<NdArray::NdArray<std::uint16_t>>    m_data;
+  std::unique_ptr<NdArray::NdArray<float>>            m_axes;
+  std::unordered_multimap<std::size_t, std::uint32_t> m_axis_hashes;
+
+  std::size_t   valueColumns(std::size_t knots) const;
+  void          create(std::size_t knots);
+  void          checkPosition(int64_t position) const;
+  std::uint32_t findOrAddAxis(const std::vector<float>& axis);
+  void          encode(const XYDataset::XYDataset& data, std::uint16_t* row);
+};
+
+}  // namespace ReferenceSample
+}  // namespace Euclid
+
+#endif
@@ -22,6 +22,8 @@
 #include "NdArray/NdArray.h"
 #include <boost/filesystem/path.hpp>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <set>
 
 namespace Euclid {
@@ -31,6 +33,16 @@ namespace ReferenceSample {
  * @class IndexProvider
  * @details
  *  Stores indexing information (object ID plus a set of file + offset) as a numpy array.
+ *  When the index is sorted, a permutation of its rows ordered by object ID is stored
+ *  next to it (index_sorted.npy for index.npy), so the IDs can be looked up with a
+ *  binary search on the mapped arrays. Only the rows added after the last sort are
+ *  kept in memory. The permutation starts with the number of rows it covers and a
+ *  checksum of their IDs, which is verified on the first lookup of an ID it does not
+ *  find, so opening the index does not read it all. A stale permutation is replaced
+ *  by a scan of the rows it covers and rebuilt on the next addition of an object.
+ *
+ *  The key the rows are sorted by is not persisted: after reopening the index,
+ *  findId scans it until sort() is called again.
  */
 class IndexProvider {
 public:
@@ -106,7 +118,8 @@ public:
   std::vector<int64_t> getIds() const;
 
   /**
-   * Sort the index for the given key so physically adjacent entries are also adjacent on the index
+   * Sort the index for the given key so physically adjacent entries are also adjacent on the index,
+   * and store the permutation of the rows ordered by object ID
    * @param key
    */
   void sort(IndexKey key);
@@ -120,6 +133,9 @@ public:
    * @param
    *    Start looking at this position
    * @return
+   * @note
+   *    If the index has been sorted for the same key by this instance, the location is
+   *    found with a binary search, otherwise the index is scanned.
    */
   int64_t findId(IndexKey key, const ObjectLocation& loc, size_t offset) const;
 
@@ -127,7 +143,30 @@ private:
   boost::filesystem::path                    m_path;
   bool                                       m_read_only;
   std::unique_ptr<NdArray::NdArray<int64_t>> m_data;
-  std::map<int64_t, size_t>                  m_index;
+  std::unique_ptr<NdArray::NdArray<int64_t>> m_sorted;
+  size_t                                     m_sorted_count;
+  std::map<int64_t, size_t>                  m_unsorted;
+  int                                        m_sort_key;
+  size_t                                     m_id_column;
+  std::unique_ptr<std::once_flag>            m_sorted_check;
+  mutable bool                               m_sorted_stale = false;
+
+  /**
+   * Find the row of an object ID.
+   * @return The row, or -1 if the ID is not on the index
+   */
+  ssize_t findRow(int64_t id) const;
+
+  /**
+   * @return True if the IDs of the rows covered by the sorted permutation changed
+   *    since it was written. They are checked on the first call only.
+   */
+  bool isSortedStale() const;
+
+  /**
+   * Write the permutation of the rows ordered by ID, and map it
+   */
+  void writeSorted();
 
   /**
    * Register a new object ID on the reference sample.
@@ -136,7 +175,7 @@ private:
    * @throw Elements::Exception
    *    On failure to write to the index file, or if the id already exists.
    */
-  std::map<int64_t, size_t>::iterator create(int64_t id);
+  size_t create(int64_t id);
 };
 
 }  // end of namespace ReferenceSample
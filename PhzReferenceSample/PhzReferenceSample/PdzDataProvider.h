@@ -25,6 +25,8 @@
 #define _REFERENCESAMPLE_PDZDATAPROVIDER_H
 
 #include "NdArray/NdArray.h"
+#include "PhzReferenceSample/CompactDataFile.h"
+#include "PhzReferenceSample/StorageMode.h"
 #include "XYDataset/XYDataset.h"
 
 #include <boost/filesystem/path.hpp>
@@ -38,6 +40,70 @@
 namespace Euclid {
 namespace ReferenceSample {
 
+/**
+ * @class PdzDataView
+ * @brief
+ *  Read-only view over a PDZ stored on a memory mapped PDZ data file
+ * @details
+ *  With the StorageMode::FLOAT16 layout, the values are decoded on access. With the
+ *  StorageMode::FLOAT32_SHARED_AXIS layout, they are copied from the words of the file. With the other layouts,
+ *  they are read as they are.
+ *  The view is valid while the provider it comes from is open and no PDZ is added to it.
+ */
+class PdzDataView {
+
+public:
+  PdzDataView(const float* bins, const float* values, std::size_t size)
+      : m_bins{bins}, m_values{values}, m_float_values{nullptr}, m_half_values{nullptr}, m_scale{1.f}, m_size{size} {}
+
+  /// View over single precision values, each one on two words (see loadFloat)
+  PdzDataView(const float* bins, const std::uint16_t* float_values, std::size_t size)
+      : m_bins{bins}
+      , m_values{nullptr}
+      , m_float_values{float_values}
+      , m_half_values{nullptr}
+      , m_scale{1.f}
+      , m_size{size} {}
+
+  /// View over half precision values, to be multiplied by the scale
+  PdzDataView(const float* bins, const std::uint16_t* half_values, float scale, std::size_t size)
+      : m_bins{bins}
+      , m_values{nullptr}
+      , m_float_values{nullptr}
+      , m_half_values{half_values}
+      , m_scale{scale}
+      , m_size{size} {}
+
+  /// @return Number of bins of the PDZ
+  std::size_t size() const {
+    return m_size;
+  }
+
+  /// @return Redshift of the given bin
+  float bin(std::size_t i) const {
+    return m_bins[i];
+  }
+
+  /// @return Value of the PDZ on the given bin
+  float value(std::size_t i) const {
+    if (m_half_values) {
+      return m_scale * halfToFloat(m_half_values[i]);
+    }
+    if (m_float_values) {
+      return loadFloat(m_float_values + 2 * i);
+    }
+    return m_values[i];
+  }
+
+private:
+  const float*         m_bins;
+  const float*         m_values;
+  const std::uint16_t* m_float_values;
+  const std::uint16_t* m_half_values;
+  float                m_scale;
+  std::size_t          m_size;
+};
+
 /**
  * @class PdzDataProvider
  * @brief
@@ -61,10 +127,13 @@ public:
    *    The maximum number of elements expected to be added. Defaults to 1 GiB.
    * @param read_only
    *    If true, the data provider can not be modified
+   * @param storage_mode
+   *    The layout used if the file does not exist yet. An existing file keeps its layout.
    * @throw Elements::Exception
    *    On failure to read the PDZ bins (only if the file is not empty)
    */
-  PdzDataProvider(const boost::filesystem::path& path, std::size_t max_size = DEFAULT_MAX_SIZE, bool read_only = false);
+  PdzDataProvider(const boost::filesystem::path& path, std::size_t max_size = DEFAULT_MAX_SIZE, bool read_only = false,
+                  StorageMode storage_mode = StorageMode::FLOAT32);
 
   /**
    * Move constructor.
@@ -81,6 +150,16 @@ public:
    */
   XYDataset::XYDataset readPdz(int64_t position) const;
 
+  /**
+   * Get a view over the PDZ stored on the given file position, without copying it.
+   * @param position
+   *    Address inside the file where the PDZ is stored.
+   * @return A view over the mapped PDZ data
+   * @throw Element::Exception
+   *    If the position is out of bounds.
+   */
+  PdzDataView readPdzView(int64_t position) const;
+
   /**
    * @return Size on disk of the data file.
    */
@@ -116,6 +195,7 @@ private:
   size_t                                   m_max_size;
   bool                                     m_read_only;
   std::unique_ptr<NdArray::NdArray<float>> m_array;
+  std::unique_ptr<CompactDataFile>         m_compact;
 
   std::vector<float> m_bins;
 
@@ -40,6 +40,7 @@
 #include "IndexProvider.h"
 #include "PdzDataProvider.h"
 #include "SedDataProvider.h"
+#include "StorageMode.h"
 
 #include <boost/filesystem/path.hpp>
 #include <boost/optional.hpp>
@@ -70,9 +71,14 @@ public:
    *    Maximum data file size. Defaults to 1GiB.
    * @param read_only
    *    If true, the reference sample will be open on read-only mode
+   * @param storage_mode
+   *    The layout of the data files created from now on. The existing files keep their layout.
    * @note Always open for read/write.
+   * @throw Elements::Exception
+   *    If an interrupted optimize(StorageMode) has to be completed and the reference sample is open read-only
    */
-  ReferenceSample(const boost::filesystem::path& path, size_t max_file_size = DEFAULT_MAX_SIZE, bool read_only = false);
+  ReferenceSample(const boost::filesystem::path& path, size_t max_file_size = DEFAULT_MAX_SIZE, bool read_only = false,
+                  StorageMode storage_mode = StorageMode::FLOAT32);
 
   /**
    * Move constructor
@@ -85,9 +91,12 @@ public:
    *    Path where to create the reference sample. It must not exist.
    * @param max_file_size
    *    Maximum data file size. Defaults to 1GiB.
+   * @param storage_mode
+   *    The layout of the data files.
    * @return A ReferenceSample instance
    */
-  static ReferenceSample create(const boost::filesystem::path& path, bool throw_on_exists = true ,  size_t max_file_size = 1073741824);
+  static ReferenceSample create(const boost::filesystem::path& path, bool throw_on_exists = true ,  size_t max_file_size = 1073741824,
+                                StorageMode storage_mode = StorageMode::FLOAT32);
 
   /**
    * Create a copy of the *state* reference sample.
@@ -123,6 +132,44 @@ public:
    */
   boost::optional<XYDataset::XYDataset> getPdzData(int64_t id) const;
 
+  /**
+   * Get a view over the SED data associated to the given ID, without copying it.
+   * @param id
+   *    Object ID.
+   * @return A view over the SED data if exists, none otherwise.
+   * @note
+   *    The view is valid until the reference sample is modified or destroyed.
+   */
+  boost::optional<SedDataView> getSedDataView(int64_t id) const;
+
+  /**
+   * Get a view over the PDZ data associated to the given ID, without copying it.
+   * @param id
+   *    Object ID.
+   * @return A view over the PDZ data if exists, none otherwise.
+   * @note
+   *    The view is valid until the reference sample is modified or destroyed.
+   */
+  boost::optional<PdzDataView> getPdzDataView(int64_t id) const;
+
+  /**
+   * Get views over the SED data of many objects.
+   * @param ids
+   *    Object IDs. The IDs without a SED are skipped.
+   * @return The pairs of ID and SED view, sorted by data file and offset, so
+   *    going through them in order reads the data files sequentially.
+   */
+  std::vector<std::pair<int64_t, SedDataView>> getSedDataViews(const std::vector<int64_t>& ids) const;
+
+  /**
+   * Get views over the PDZ data of many objects.
+   * @param ids
+   *    Object IDs. The IDs without a PDZ are skipped.
+   * @return The pairs of ID and PDZ view, sorted by data file and offset, so
+   *    going through them in order reads the data files sequentially.
+   */
+  std::vector<std::pair<int64_t, PdzDataView>> getPdzDataViews(const std::vector<int64_t>& ids) const;
+
   /**
    * Store SED data for the given object.
    * @param id
@@ -151,27 +198,82 @@ public:
   void addPdzData(int64_t id, const XYDataset::XYDataset& data);
 
   /**
-   * Optimize the index: sort it following the physical layout of the SED data files,
-   * so reading the index in order means reading the SEDs in order
+   * Optimize the reference sample, so reading the index in order means reading the SEDs and the PDZs in order.
+   * This is optimize(StorageMode) with the storage mode the reference sample has been open with, so the data is
+   * rewritten in parallel.
    */
   void optimize();
 
+  /**
+   * Rewrite all the SED and PDZ data on new files with the given layout, following the order of the index
+   * sorted by SED, and replace the existing data files with them. This is the migration path between the
+   * storage modes.
+   * The data is rewritten by PhzUtils::getThreadNumber() threads, each one on a contiguous range of the index.
+   * The new files and the new index are written on a work directory before replacing the existing ones. If the
+   * replacement is interrupted, it is completed the next time the reference sample is open.
+   * @param storage_mode
+   *    The layout of the new files, which is also used for the files created afterwards.
+   * @warning
+   *    The views obtained before are invalidated.
+   */
+  void optimize(StorageMode storage_mode);
+
+  /**
+   * Create a partition of a reference sample: an independent reference sample, with its own index and data
+   * files, on a sub-directory of the given one. Each partition can be filled by a different thread or process
+   * without any synchronization, and they are all added to the reference sample by mergePartitions().
+   * @param path
+   *    Path of the reference sample.
+   * @param partition
+   *    Number of the partition. The partitions are merged following their number.
+   * @param max_file_size
+   *    Maximum data file size.
+   * @param storage_mode
+   *    The layout of the data files of the partition.
+   * @throw Elements::Exception
+   *    If the partition already exists
+   */
+  static ReferenceSample createPartition(const boost::filesystem::path& path, size_t partition,
+                                         size_t max_file_size = DEFAULT_MAX_SIZE,
+                                         StorageMode storage_mode = StorageMode::FLOAT32);
+
+  /**
+   * Add all the partitions of this reference sample to it, and remove them. Their data files are moved
+   * without being rewritten, numbered after the existing ones, and their index entries are added to the
+   * index. Call optimize(StorageMode) afterwards to get a single sorted layout.
+   * The numbering of the files of each partition is recorded on it, and the index is updated before the files
+   * are moved. If the merge is interrupted, the index may point to files still on the partition, and calling
+   * mergePartitions() again resumes it.
+   * @throw Elements::Exception
+   *    If an object of a partition already has a SED or a PDZ on the reference sample, or in a partition
+   *    merged before. The partitions merged before the failing one are kept.
+   * @warning
+   *    The partitions must not be open for writing anymore.
+   */
+  void mergePartitions();
+
 private:
-  boost::filesystem::path                             m_root_path;
-  size_t                                              m_max_file_size;
-  bool                                                m_read_only;
-  std::shared_ptr<IndexProvider>                      m_index;
-  uint16_t                                            m_sed_provider_count;
-  uint16_t                                            m_pdz_provider_count;
-  std::map<int64_t, std::unique_ptr<SedDataProvider>> m_write_sed_provider;
-  std::map<size_t, int64_t>                           m_write_sed_idx;
-  mutable std::unique_ptr<SedDataProvider>            m_read_sed_provider;
-  mutable int64_t                                     m_read_sed_idx;
-  mutable std::unique_ptr<PdzDataProvider>            m_pdz_provider;
-  mutable int64_t                                     m_pdz_index;
+  boost::filesystem::path                                     m_root_path;
+  size_t                                                      m_max_file_size;
+  bool                                                        m_read_only;
+  StorageMode                                                 m_storage_mode;
+  std::shared_ptr<IndexProvider>                              m_index;
+  uint16_t                                                    m_sed_provider_count;
+  uint16_t                                                    m_pdz_provider_count;
+  std::map<int64_t, std::unique_ptr<SedDataProvider>>         m_write_sed_provider;
+  std::map<size_t, int64_t>                                   m_write_sed_idx;
+  mutable std::unique_ptr<SedDataProvider>                    m_read_sed_provider;
+  mutable int64_t                                             m_read_sed_idx;
+  mutable std::unique_ptr<PdzDataProvider>                    m_pdz_provider;
+  mutable int64_t                                             m_pdz_index;
+  mutable std::map<int64_t, std::unique_ptr<SedDataProvider>> m_view_sed_providers;
+  mutable std::map<int64_t, std::unique_ptr<PdzDataProvider>> m_view_pdz_providers;
 
   ReferenceSample(boost::filesystem::path root_path, size_t max_file_size, std::shared_ptr<IndexProvider> index,
-                  bool readonly);
+                  bool readonly, StorageMode storage_mode);
+
+  const SedDataProvider& getSedViewProvider(int64_t file) const;
+  const PdzDataProvider& getPdzViewProvider(int64_t file) const;
 
   void                                                 initSedProviders();
   void                                                 initPdzProviders();
@@ -25,6 +25,8 @@
 #define _REFERENCESAMPLE_SEDDATAPROVIDER_H
 
 #include "NdArray/NdArray.h"
+#include "PhzReferenceSample/CompactDataFile.h"
+#include "PhzReferenceSample/StorageMode.h"
 #include "XYDataset/XYDataset.h"
 #include <boost/filesystem/path.hpp>
 #include <fstream>
@@ -37,6 +39,81 @@
 namespace Euclid {
 namespace ReferenceSample {
 
+/**
+ * @class SedDataView
+ * @brief
+ *  Read-only view over a SED stored on a memory mapped SED data file
+ * @details
+ *  With the StorageMode::FLOAT32 layout, the wavelengths and the fluxes are stored interleaved, as single
+ *  precision floats. With the StorageMode::FLOAT16 layout, the wavelengths come from the axis table of the file
+ *  and the fluxes are decoded on access. With the StorageMode::FLOAT32_SHARED_AXIS layout, the wavelengths come
+ *  from the axis table and the fluxes are copied from the words of the file. The view is valid while the provider it comes from is
+ *  open and no SED is added to it.
+ */
+class SedDataView {
+
+public:
+  /// View over interleaved (wavelength, flux) pairs
+  SedDataView(const float* data, std::size_t knots)
+      : m_wavelengths{data}
+      , m_fluxes{data + 1}
+      , m_stride{2}
+      , m_float_fluxes{nullptr}
+      , m_half_fluxes{nullptr}
+      , m_scale{1.f}
+      , m_knots{knots} {}
+
+  /// View over a shared wavelength axis and single precision fluxes, each one on two words (see loadFloat)
+  SedDataView(const float* wavelengths, const std::uint16_t* float_fluxes, std::size_t knots)
+      : m_wavelengths{wavelengths}
+      , m_fluxes{nullptr}
+      , m_stride{1}
+      , m_float_fluxes{float_fluxes}
+      , m_half_fluxes{nullptr}
+      , m_scale{1.f}
+      , m_knots{knots} {}
+
+  /// View over a shared wavelength axis and half precision fluxes, to be multiplied by the scale
+  SedDataView(const float* wavelengths, const std::uint16_t* half_fluxes, float scale, std::size_t knots)
+      : m_wavelengths{wavelengths}
+      , m_fluxes{nullptr}
+      , m_stride{1}
+      , m_float_fluxes{nullptr}
+      , m_half_fluxes{half_fluxes}
+      , m_scale{scale}
+      , m_knots{knots} {}
+
+  /// @return Number of knots of the SED
+  std::size_t size() const {
+    return m_knots;
+  }
+
+  /// @return Wavelength of the given knot
+  float wavelength(std::size_t i) const {
+    return m_wavelengths[m_stride * i];
+  }
+
+  /// @return Flux of the given knot
+  float flux(std::size_t i) const {
+    if (m_half_fluxes) {
+      return m_scale * halfToFloat(m_half_fluxes[i]);
+    }
+    if (m_float_fluxes) {
+      return loadFloat(m_float_fluxes + 2 * i);
+    }
+    return m_fluxes[m_stride * i];
+  }
+
+private:
+  const float*         m_wavelengths;
+  const float*         m_fluxes;
+  std::size_t          m_stride;
+  const std::uint16_t* m_float_fluxes;
+  const std::uint16_t* m_half_fluxes;
+  float                m_scale;
+  std::size_t          m_knots;
+};
+
 /**
  * @class SedDataProvider
  * @brief
@@ -60,10 +137,13 @@ public:
    *    The maximum number of elements expected to be added. Defaults to 1 GiB.
    * @param read_only
    *    If true, the data provider can not be modified
+   * @param storage_mode
+   *    The layout used if the file does not exist yet. An existing file keeps its layout.
    * @throw Elements::Exception
    *    On failure to open the file.
    */
-  SedDataProvider(const boost::filesystem::path& path, std::size_t max_size = DEFAULT_MAX_SIZE, bool read_only = false);
+  SedDataProvider(const boost::filesystem::path& path, std::size_t max_size = DEFAULT_MAX_SIZE, bool read_only = false,
+                  StorageMode storage_mode = StorageMode::FLOAT32);
 
   /**
    * Move constructor.
@@ -80,6 +160,16 @@ public:
    */
   XYDataset::XYDataset readSed(int64_t position) const;
 
+  /**
+   * Get a view over the SED data, without copying it.
+   * @param position
+   *    Address inside the file where the SED is stored.
+   * @return A view over the mapped SED data
+   * @throw Element::Exception
+   *    If the position is out of bounds.
+   */
+  SedDataView readSedView(int64_t position) const;
+
   /**
    * @return Size on disk of the data file.
    */
@@ -112,6 +202,7 @@ private:
   size_t                                   m_max_size;
   bool                                     m_read_only;
   std::unique_ptr<NdArray::NdArray<float>> m_array;
+  std::unique_ptr<CompactDataFile>         m_compact;
   size_t                                   m_length;
 
   void create(size_t knots);
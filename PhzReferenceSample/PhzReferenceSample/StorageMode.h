@@ -0,0 +1,126 @@
+/*
+ * Copyright (C) 2022 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file PhzReferenceSample/StorageMode.h
+ * @date 2026/10/18
+ */
+
+#ifndef _REFERENCESAMPLE_STORAGEMODE_H
+#define _REFERENCESAMPLE_STORAGEMODE_H
+
+#include <cstdint>
+#include <cstring>
+
+namespace Euclid {
+namespace ReferenceSample {
+
+/// The layout used for the new SED and PDZ data files. Existing files are always read with the layout they were
+/// written with.
+enum class StorageMode {
+  /// SEDs as (wavelength, flux) single precision pairs, PDZs as single precision values after a row with the bins
+  FLOAT32,
+  /// Each file has a table with its distinct axes, and every entry is stored as the index of its axis, a single
+  /// precision scale and the half precision values divided by the scale
+  FLOAT16,
+  /// As FLOAT16, with the values kept in single precision, so only the axes are deduplicated
+  FLOAT32_SHARED_AXIS
+};
+
+/// Convert a single precision float to the bits of the closest IEEE 754 half precision float
+inline std::uint16_t floatToHalf(float value) {
+  std::uint32_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+
+  std::uint16_t sign     = (bits >> 16) & 0x8000;
+  std::int32_t  exponent = static_cast<std::int32_t>((bits >> 23) & 0xff) - 127 + 15;
+  std::uint32_t mantissa = bits & 0x7fffff;
+
+  // Infinity and NaN
+  if (exponent == 0xff - 127 + 15) {
+    return sign | 0x7c00 | (mantissa ? 0x200 : 0);
+  }
+  // Too big, rounds to infinity
+  if (exponent >= 0x1f) {
+    return sign | 0x7c00;
+  }
+  // Subnormal half, or too small, which rounds to zero
+  if (exponent <= 0) {
+    if (exponent < -10) {
+      return sign;
+    }
+    mantissa |= 0x800000;
+    std::uint32_t shift         = 14 - exponent;
+    std::uint32_t half_mantissa = mantissa >> shift;
+    std::uint32_t remainder     = mantissa & ((1u << shift) - 1);
+    std::uint32_t halfway       = 1u << (shift - 1);
+    if (remainder > halfway || (remainder == halfway && (half_mantissa & 1))) {
+      ++half_mantissa;
+    }
+    return sign | half_mantissa;
+  }
+
+  // Round to the nearest even. A carry from the mantissa correctly increases the exponent.
+  std::uint16_t half      = sign | (exponent << 10) | (mantissa >> 13);
+  std::uint32_t remainder = mantissa & 0x1fff;
+  if (remainder > 0x1000 || (remainder == 0x1000 && (half & 1))) {
+    ++half;
+  }
+  return half;
+}
+
+/// Convert the bits of an IEEE 754 half precision float to a single precision float
+inline float halfToFloat(std::uint16_t half) {
+  std::uint32_t sign     = static_cast<std::uint32_t>(half & 0x8000) << 16;
+  std::uint32_t exponent = (half >> 10) & 0x1f;
+  std::uint32_t mantissa = half & 0x3ff;
+  std::uint32_t bits;
+
+  if (exponent == 0x1f) {
+    bits = sign | 0x7f800000 | (mantissa << 13);
+  } else if (exponent != 0) {
+    bits = sign | ((exponent + 127 - 15) << 23) | (mantissa << 13);
+  } else if (mantissa == 0) {
+    bits = sign;
+  } else {
+    // Subnormal half, which is a normal float
+    exponent = 127 - 15 + 1;
+    while (!(mantissa & 0x400)) {
+      mantissa <<= 1;
+      --exponent;
+    }
+    bits = sign | (exponent << 23) | ((mantissa & 0x3ff) << 13);
+  }
+
+  float value;
+  std::memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+/// Read a single precision float stored on two 16 bits words. It is copied, as reading the words through a float
+/// pointer would break the strict aliasing rule.
+inline float loadFloat(const std::uint16_t* words) {
+  float value;
+  std::memcpy(&value, words, sizeof(value));
+  return value;
+}
+
+}  // namespace ReferenceSample
+}  // namespace Euclid
+
+#endif
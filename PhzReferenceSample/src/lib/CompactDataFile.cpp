@@ -0,0 +1,276 @@
+/*
+ * Copyright (C) 2022 Euclid Science Ground Segment
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation; either version 3.0 of the License, or (at your option)
+ * any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/**
+ * @file src/lib/CompactDataFile.cpp
+ * @date 2026/10/18
+ */
+
+#include "PhzReferenceSample/CompactDataFile.h"
+#include "NdArray/io/NpyMmap.h"
+#include <ElementsKernel/Exception.h>
+#include <boost/filesystem/operations.hpp>
+#include <boost/functional/hash.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace Euclid {
+namespace ReferenceSample {
+
+using NdArray::createMmapNpy;
+using NdArray::mmapNpy;
+using NdArray::NdArray;
+
+namespace {
+
+/// Number of columns before the values: the axis index and the scale, as pairs of uint16
+constexpr std::size_t HEADER_COLUMNS = 4;
+
+void splitBits(std::uint32_t bits, std::uint16_t* out) {
+  out[0] = static_cast<std::uint16_t>(bits & 0xffff);
+  out[1] = static_cast<std::uint16_t>(bits >> 16);
+}
+
+std::uint32_t joinBits(const std::uint16_t* in) {
+  return static_cast<std::uint32_t>(in[0]) | (static_cast<std::uint32_t>(in[1]) << 16);
+}
+
+}  // namespace
+
+boost::filesystem::path CompactDataFile::axisPath(const boost::filesystem::path& path) {
+  return path.parent_path() / (path.stem().string() + "_axis.npy");
+}
+
+bool CompactDataFile::isCompact(const boost::filesystem::path& path) {
+  return boost::filesystem::exists(path) && boost::filesystem::exists(axisPath(path));
+}
+
+CompactDataFile::CompactDataFile(boost::filesystem::path path, std::size_t max_size, bool read_only,
+                                 StorageMode storage_mode)
+    : m_path{std::move(path)}, m_max_size{max_size}, m_read_only{read_only}, m_storage_mode{storage_mode} {
+  using mmap_mode = boost::iostreams::mapped_file_base;
+
+  if (m_storage_mode == StorageMode::FLOAT32) {
+    throw Elements::Exception() << "The FLOAT32 storage mode does not have a compact layout";
+  }
+  if (!isCompact(m_path)) {
+    return;
+  }
+
+  auto mode = m_read_only ? mmap_mode::readonly : mmap_mode::readwrite;
+  m_data    = Euclid::make_unique<NdArray<std::uint16_t>>(mmapNpy<std::uint16_t>(m_path, mode, m_max_size + 1024));
+  m_axes    = Euclid::make_unique<NdArray<float>>(mmapNpy<float>(axisPath(m_path), mode, m_max_size + 1024));
+
+  if (m_data->shape().size() != 2 || m_axes->shape().size() != 2 || m_data->shape()[0] < 1) {
+    throw Elements::Exception() << "Unexpected shape for the compact data file " << m_path;
+  }
+
+  // The layout is told by the number of columns used by the values
+  std::size_t knots = m_axes->shape()[1];
+  if (m_data->shape()[1] == knots + HEADER_COLUMNS) {
+    m_storage_mode = StorageMode::FLOAT16;
+  } else if (m_data->shape()[1] == 2 * knots + HEADER_COLUMNS) {
+    m_storage_mode = StorageMode::FLOAT32_SHARED_AXIS;
+  } else {
+    throw Elements::Exception() << "Unexpected shape for the compact data file " << m_path;
+  }
+
+  if (!m_read_only) {
+    for (std::uint32_t i = 0; i < m_axes->shape()[0]; ++i) {
+      const float* row = &m_axes->at(i, 0);
+      m_axis_hashes.emplace(boost::hash_range(row, row + knots), i);
+    }
+  }
+}
+
+StorageMode CompactDataFile::storageMode() const {
+  return m_storage_mode;
+}
+
+std::size_t CompactDataFile::knots() const {
+  return m_axes ? m_axes->shape()[1] : 0;
+}
+
+std::size_t CompactDataFile::length() const {
+  return m_data ? m_data->shape()[0] - 1 : 0;
+}
+
+std::size_t CompactDataFile::diskSize() const {
+  if (!m_data) {
+    return 0;
+  }
+  return boost::filesystem::file_size(m_path) + boost::filesystem::file_size(axisPath(m_path));
+}
+
+int64_t CompactDataFile::add(const XYDataset::XYDataset& data) {
+  if (m_read_only) {
+    throw Elements::Exception("Can not modify a read-only data file");
+  }
+  if (!m_data) {
+    create(data.size());
+  }
+  if (data.size() != knots()) {
+    throw Elements::Exception() << "All the entries are expected to have the same number of knots (" << data.size()
+                                << " vs " << knots() << ")";
+  }
+
+  NdArray<std::uint16_t> row{1, valueColumns(knots()) + HEADER_COLUMNS};
+  encode(data, &row.at(0, 0));
+  m_data->concatenate(row);
+  return m_data->shape()[0] - 1;
+}
+
+void CompactDataFile::set(int64_t position, const XYDataset::XYDataset& data) {
+  if (m_read_only) {
+    throw Elements::Exception("Can not modify a read-only data file");
+  }
+  checkPosition(position);
+  if (data.size() != knots()) {
+    throw Elements::Exception() << "Invalid size";
+  }
+  encode(data, &m_data->at(static_cast<std::size_t>(position), 0));
+}
+
+XYDataset::XYDataset CompactDataFile::read(int64_t position) const {
+  const float* axis_row = axis(position);
+
+  std::vector<std::pair<double, double>> data(knots());
+  if (m_storage_mode == StorageMode::FLOAT32_SHARED_AXIS) {
+    const std::uint16_t* values_row = floatValues(position);
+    for (std::size_t i = 0; i < data.size(); ++i) {
+      data[i].first  = axis_row[i];
+      data[i].second = loadFloat(values_row + 2 * i);
+    }
+    return data;
+  }
+
+  const std::uint16_t* values_row = halfValues(position);
+  float                row_scale  = scale(position);
+  for (std::size_t i = 0; i < data.size(); ++i) {
+    data[i].first  = axis_row[i];
+    data[i].second = row_scale * halfToFloat(values_row[i]);
+  }
+  return data;
+}
+
+const float* CompactDataFile::axis(int64_t position) const {
+  checkPosition(position);
+  std::uint32_t axis_index = joinBits(&m_data->at(static_cast<std::size_t>(position), 0));
+  if (axis_index >= m_axes->shape()[0]) {
+    throw Elements::Exception() << "Invalid axis index " << axis_index << " in " << m_path;
+  }
+  return &m_axes->at(axis_index, 0);
+}
+
+const std::uint16_t* CompactDataFile::halfValues(int64_t position) const {
+  checkPosition(position);
+  if (m_storage_mode != StorageMode::FLOAT16) {
+    throw Elements::Exception() << "The values of " << m_path << " are not stored in half precision";
+  }
+  return &m_data->at(static_cast<std::size_t>(position), HEADER_COLUMNS);
+}
+
+const std::uint16_t* CompactDataFile::floatValues(int64_t position) const {
+  checkPosition(position);
+  if (m_storage_mode != StorageMode::FLOAT32_SHARED_AXIS) {
+    throw Elements::Exception() << "The values of " << m_path << " are not stored in single precision";
+  }
+  return &m_data->at(static_cast<std::size_t>(position), HEADER_COLUMNS);
+}
+
+float CompactDataFile::scale(int64_t position) const {
+  checkPosition(position);
+  std::uint32_t bits = joinBits(&m_data->at(static_cast<std::size_t>(position), 2));
+  float         value;
+  std::memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+std::size_t CompactDataFile::valueColumns(std::size_t knots) const {
+  return m_storage_mode == StorageMode::FLOAT16 ? knots : 2 * knots;
+}
+
+void CompactDataFile::create(std::size_t knots) {
+  // The first row is reserved, so the positions start at 1
+  m_data = Euclid::make_unique<NdArray<std::uint16_t>>(
+      createMmapNpy<std::uint16_t>(m_path, {1, valueColumns(knots) + HEADER_COLUMNS}, m_max_size + 1024));
+  m_axes = Euclid::make_unique<NdArray<float>>(createMmapNpy<float>(axisPath(m_path), {0, knots}, m_max_size));
+  std::fill(m_data->begin(), m_data->end(), 0);
+}
+
+void CompactDataFile::checkPosition(int64_t position) const {
+  if (!m_data) {
+    throw Elements::Exception() << "Need to create the data file first";
+  }
+  if (position < 1 || uint64_t(position) >= m_data->shape()[0]) {
+    throw Elements::Exception() << "Position out of bounds";
+  }
+}
+
+std::uint32_t CompactDataFile::findOrAddAxis(const std::vector<float>& axis) {
+  std::size_t hash  = boost::hash_range(axis.begin(), axis.end());
+  auto        range = m_axis_hashes.equal_range(hash);
+  for (auto i = range.first; i != range.second; ++i) {
+    const float* row = &m_axes->at(i->second, 0);
+    if (std::equal(axis.begin(), axis.end(), row)) {
+      return i->second;
+    }
+  }
+
+  NdArray<float> row{1, axis.size()};
+  std::copy(axis.begin(), axis.end(), row.begin());
+  m_axes->concatenate(row);
+  std::uint32_t index = static_cast<std::uint32_t>(m_axes->shape()[0] - 1);
+  m_axis_hashes.emplace(hash, index);
+  return index;
+}
+
+void CompactDataFile::encode(const XYDataset::XYDataset& data, std::uint16_t* row) {
+  std::vector<float> axis{};
+  axis.reserve(data.size());
+  float max_value = 0.f;
+  for (auto& p : data) {
+    axis.emplace_back(static_cast<float>(p.first));
+    if (std::isfinite(p.second)) {
+      max_value = std::max(max_value, static_cast<float>(std::abs(p.second)));
+    }
+  }
+
+  // The half precision values are stored relative to the biggest one, so their range is not a limitation
+  float row_scale = (m_storage_mode == StorageMode::FLOAT16 && max_value > 0.f) ? max_value : 1.f;
+
+  std::uint32_t scale_bits;
+  std::memcpy(&scale_bits, &row_scale, sizeof(scale_bits));
+  splitBits(findOrAddAxis(axis), row);
+  splitBits(scale_bits, row + 2);
+
+  std::size_t i = 0;
+  for (auto& p : data) {
+    if (m_storage_mode == StorageMode::FLOAT16) {
+      row[HEADER_COLUMNS + i] = floatToHalf(static_cast<float>(p.second / row_scale));
+    } else {
+      float value = static_cast<float>(p.second);
+      std::memcpy(row + HEADER_COLUMNS + 2 * i, &value, sizeof(value));
+    }
+    ++i;
+  }
+}
+
+}  // namespace ReferenceSample
+}  // namespace Euclid
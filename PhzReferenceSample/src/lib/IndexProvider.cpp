@@ -18,10 +18,14 @@
  */
 
 #include "PhzReferenceSample/IndexProvider.h"
+#include "ElementsKernel/Logging.h"
 #include "NdArray/Operations.h"
 #include "NdArray/io/NpyMmap.h"
+#include <algorithm>
 #include <boost/filesystem/operations.hpp>
 #include <fstream>
+#include <numeric>
+#include <utility>
 
 namespace Euclid {
 namespace ReferenceSample {
@@ -30,10 +34,29 @@ using NdArray::createMmapNpy;
 using NdArray::mmapNpy;
 using NdArray::NdArray;
 
+static Elements::Logging logger = Elements::Logging::getLogger("IndexProvider");
+
 static const std::vector<std::string> FIELDS{"id", "sed_file", "sed_offset", "pdz_file", "pdz_offset"};
 
+/// The permutation is preceded by the number of index rows it covers and the checksum of their IDs
+static const size_t SORTED_HEADER_SIZE = 2;
+
+/// Path of the permutation of the index rows sorted by ID, stored next to the index
+static boost::filesystem::path sortedPath(const boost::filesystem::path& index_path) {
+  return index_path.parent_path() / (index_path.stem().string() + "_sorted.npy");
+}
+
+/// FNV-1a hash of the IDs of the first rows of the index, in row order
+static int64_t idChecksum(const NdArray<int64_t>& data, size_t id_column, size_t count) {
+  uint64_t hash = 14695981039346656037ul;
+  for (size_t i = 0; i < count; ++i) {
+    hash = (hash ^ static_cast<uint64_t>(data.at(i, id_column))) * 1099511628211ul;
+  }
+  return static_cast<int64_t>(hash);
+}
+
 IndexProvider::IndexProvider(const boost::filesystem::path& path, bool read_only)
-    : m_path{path}, m_read_only(read_only) {
+    : m_path{path}, m_read_only(read_only), m_sorted_count{0}, m_sort_key{-1}, m_id_column{0} {
   using mmap_mode = boost::iostreams::mapped_file_base;
 
   if (boost::filesystem::exists(path)) {
@@ -43,23 +66,88 @@ IndexProvider::IndexProvider(const boost::filesystem::path& path, bool read_only
     if (m_data->shape().size() != 2) {
       throw Elements::Exception() << "Expected an array with two dimensions";
     }
+    auto& attrs = m_data->attributes();
+    m_id_column = std::find(attrs.begin(), attrs.end(), "id") - attrs.begin();
 
-    auto n_items = m_data->shape()[0];
-    for (size_t i = 0; i < n_items; ++i) {
-      m_index[m_data->at(i, "id")] = i;
+    // The rows covered by the sorted permutation are looked up on the mapped files,
+    // only the ones added after it are kept in memory. Checking that the IDs of the
+    // rows it covers did not change since it was written reads the whole index, so
+    // it is done on the first lookup miss.
+    auto n_items     = m_data->shape()[0];
+    auto sorted_path = sortedPath(path);
+    if (boost::filesystem::exists(sorted_path)) {
+      m_sorted = Euclid::make_unique<NdArray<int64_t>>(
+          mmapNpy<int64_t>(sorted_path, mmap_mode::readonly, boost::filesystem::file_size(sorted_path)));
+      auto& shape = m_sorted->shape();
+      if (shape.size() != 1 || shape[0] < SORTED_HEADER_SIZE || m_sorted->at(0) < 0 ||
+          static_cast<size_t>(m_sorted->at(0)) != shape[0] - SORTED_HEADER_SIZE ||
+          static_cast<size_t>(m_sorted->at(0)) > n_items) {
+        logger.warn() << "The sorted IDs " << sorted_path << " do not match the index";
+        m_sorted.reset();
+        if (!m_read_only) {
+          writeSorted();
+        }
+      } else {
+        m_sorted_count = m_sorted->at(0);
+        m_sorted_check = Euclid::make_unique<std::once_flag>();
+      }
+    }
+    for (size_t i = m_sorted_count; i < n_items; ++i) {
+      m_unsorted[m_data->at(i, m_id_column)] = i;
     }
   } else if (!read_only) {
     // Touch file so umask is honored
     std::ofstream _(path.native());
     // Create mmap version
     m_data = Euclid::make_unique<NdArray<int64_t>>(createMmapNpy<int64_t>(path, {0}, FIELDS, 2147483648));
+    boost::filesystem::remove(sortedPath(path));
   } else {
     throw Elements::Exception() << "Can not open a missing index in read-only mode";
   }
 }
 
-std::map<int64_t, size_t>::iterator IndexProvider::create(int64_t id) {
-  if (m_index.count(id)) {
+ssize_t IndexProvider::findRow(int64_t id) const {
+  auto unsorted_i = m_unsorted.find(id);
+  if (unsorted_i != m_unsorted.end()) {
+    return unsorted_i->second;
+  }
+  size_t low = 0, high = m_sorted_count;
+  while (low < high) {
+    size_t middle = low + (high - low) / 2;
+    if (m_data->at(m_sorted->at(SORTED_HEADER_SIZE + middle), m_id_column) < id) {
+      low = middle + 1;
+    } else {
+      high = middle;
+    }
+  }
+  if (low < m_sorted_count && m_data->at(m_sorted->at(SORTED_HEADER_SIZE + low), m_id_column) == id) {
+    return m_sorted->at(SORTED_HEADER_SIZE + low);
+  }
+  // A stale permutation can miss the rows it covers, which are then scanned
+  if (m_sorted_count > 0 && isSortedStale()) {
+    for (size_t i = 0; i < m_sorted_count; ++i) {
+      if (m_data->at(i, m_id_column) == id) {
+        return i;
+      }
+    }
+  }
+  return -1;
+}
+
+bool IndexProvider::isSortedStale() const {
+  if (m_sorted_check) {
+    std::call_once(*m_sorted_check, [this]() {
+      m_sorted_stale = m_sorted->at(1) != idChecksum(*m_data, m_id_column, m_sorted_count);
+      if (m_sorted_stale) {
+        logger.warn() << "The sorted IDs " << sortedPath(m_path) << " do not match the index";
+      }
+    });
+  }
+  return m_sorted_stale;
+}
+
+size_t IndexProvider::create(int64_t id) {
+  if (findRow(id) != -1) {
     throw Elements::Exception() << "The object " << id << " already exists on the index";
   }
 
@@ -67,9 +155,12 @@ std::map<int64_t, size_t>::iterator IndexProvider::create(int64_t id) {
   std::fill(entry.begin(), entry.end(), -1);
   entry.at(0, "id") = id;
   m_data->concatenate(entry);
-  return m_index.emplace(id, m_data->shape()[0] - 1).first;
+  // The new row breaks the location order
+  m_sort_key = -1;
+  size_t row = m_data->shape()[0] - 1;
+  m_unsorted.emplace(id, row);
+  return row;
 }
-
 static std::string to_string(IndexProvider::IndexKey key) {
   switch (key) {
   case IndexProvider::SED:
@@ -86,26 +177,32 @@ void IndexProvider::add(int64_t id, IndexKey key, const ObjectLocation& location
     throw Elements::Exception() << "Can not modify a read-only index";
   }
 
-  auto i = m_index.find(id);
-  if (i == m_index.end()) {
-    i = create(id);
+  auto row = findRow(id);
+  if (row == -1) {
+    // The miss checked the permutation
+    if (isSortedStale()) {
+      writeSorted();
+    }
+    row = create(id);
+  }
+  if (key == m_sort_key) {
+    m_sort_key = -1;
   }
 
-  m_data->at(i->second, to_string(key) + "_file")   = location.file;
-  m_data->at(i->second, to_string(key) + "_offset") = location.offset;
+  m_data->at(row, to_string(key) + "_file")   = location.file;
+  m_data->at(row, to_string(key) + "_offset") = location.offset;
 }
 
 auto IndexProvider::get(int64_t id, IndexKey key) const -> ObjectLocation {
-  auto i = m_index.find(id);
-  if (i != m_index.end()) {
-    return ObjectLocation{m_data->at(i->second, to_string(key) + "_file"),
-                          m_data->at(i->second, to_string(key) + "_offset")};
+  auto row = findRow(id);
+  if (row != -1) {
+    return ObjectLocation{m_data->at(row, to_string(key) + "_file"), m_data->at(row, to_string(key) + "_offset")};
   }
   return {-1, -1};
 }
 
 size_t IndexProvider::size() const {
-  return m_index.size();
+  return m_data->shape()[0];
 }
 
 std::set<size_t> IndexProvider::getFiles(IndexKey key) const {
@@ -136,11 +233,36 @@ void IndexProvider::sort(IndexKey key) {
 
   using Euclid::NdArray::sort;
   sort(*m_data, {to_string(key) + "_file", to_string(key) + "_offset"});
-  // Rebuild index
-  const size_t nobjs = m_data->shape()[0];
-  for (size_t i = 0; i < nobjs; ++i) {
-    m_index[m_data->at(i, "id")] = i;
+  m_sort_key = key;
+  // Rebuild the ID lookup
+  writeSorted();
+}
+
+void IndexProvider::writeSorted() {
+  const size_t         nobjs = m_data->shape()[0];
+  std::vector<int64_t> rows(nobjs);
+  std::iota(rows.begin(), rows.end(), 0);
+  std::sort(rows.begin(), rows.end(), [this](int64_t a, int64_t b) {
+    return m_data->at(a, m_id_column) < m_data->at(b, m_id_column);
+  });
+
+  auto sorted_path = sortedPath(m_path);
+  m_sorted.reset();
+  m_sorted_count = 0;
+  m_sorted_check.reset();
+  m_sorted_stale = false;
+  boost::filesystem::remove(sorted_path);
+  if (nobjs > 0) {
+    m_sorted = Euclid::make_unique<NdArray<int64_t>>(createMmapNpy<int64_t>(
+        sorted_path, {SORTED_HEADER_SIZE + nobjs}, (SORTED_HEADER_SIZE + nobjs) * sizeof(int64_t) + 1024));
+    m_sorted->at(0) = nobjs;
+    m_sorted->at(1) = idChecksum(*m_data, m_id_column, nobjs);
+    for (size_t i = 0; i < nobjs; ++i) {
+      m_sorted->at(SORTED_HEADER_SIZE + i) = rows[i];
+    }
+    m_sorted_count = nobjs;
   }
+  m_unsorted.clear();
 }
 
 int64_t IndexProvider::findId(IndexKey key, const ObjectLocation& loc, size_t start) const {
@@ -148,6 +270,25 @@ int64_t IndexProvider::findId(IndexKey key, const ObjectLocation& loc, size_t st
   const size_t file_idx   = std::find(attrs.begin(), attrs.end(), to_string(key) + "_file") - attrs.begin();
   const size_t offset_idx = std::find(attrs.begin(), attrs.end(), to_string(key) + "_offset") - attrs.begin();
   const size_t nobjs      = m_data->shape()[0];
+
+  // The index is sorted by this location: binary search it
+  if (key == m_sort_key) {
+    size_t low = start, high = nobjs;
+    while (low < high) {
+      size_t middle = low + (high - low) / 2;
+      if (std::make_pair(m_data->at(middle, file_idx), m_data->at(middle, offset_idx)) <
+          std::make_pair(static_cast<int64_t>(loc.file), static_cast<int64_t>(loc.offset))) {
+        low = middle + 1;
+      } else {
+        high = middle;
+      }
+    }
+    if (low < nobjs && m_data->at(low, file_idx) == loc.file && m_data->at(low, offset_idx) == loc.offset) {
+      return m_data->at(low, m_id_column);
+    }
+    throw Elements::Exception() << "Object '" << to_string(key) << loc.file << '[' << loc.offset << "]' not found";
+  }
+
   for (size_t i = start; i < nobjs; ++i) {
     int64_t file   = m_data->at(i, file_idx);
     int64_t offset = m_data->at(i, offset_idx);
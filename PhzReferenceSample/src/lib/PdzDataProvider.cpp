@@ -33,11 +33,18 @@ using NdArray::createMmapNpy;
 using NdArray::mmapNpy;
 using NdArray::NdArray;
 
-PdzDataProvider::PdzDataProvider(const boost::filesystem::path& path, size_t max_size, bool read_only)
+PdzDataProvider::PdzDataProvider(const boost::filesystem::path& path, size_t max_size, bool read_only,
+                                 StorageMode storage_mode)
     : m_data_path{path}, m_max_size{max_size}, m_read_only{read_only} {
   using mmap_mode = boost::iostreams::mapped_file_base;
 
-  if (boost::filesystem::exists(m_data_path)) {
+  if (CompactDataFile::isCompact(m_data_path)) {
+    // All the PDZs of a file share the same bins, so the axis table has a single row
+    m_compact = Euclid::make_unique<CompactDataFile>(m_data_path, m_max_size, m_read_only);
+    if (m_compact->length() > 0) {
+      m_bins.assign(m_compact->axis(1), m_compact->axis(1) + m_compact->knots());
+    }
+  } else if (boost::filesystem::exists(m_data_path)) {
     auto mode = m_read_only ? mmap_mode::readonly : mmap_mode::readwrite;
 
     m_array = Euclid::make_unique<NdArray<float>>(mmapNpy<float>(m_data_path, mode, m_max_size + 1024));
@@ -56,12 +63,18 @@ PdzDataProvider::PdzDataProvider(const boost::filesystem::path& path, size_t max
     std::fstream stream;
     stream.exceptions(~std::ios_base::goodbit);
     stream.open(path.native(), std::ios_base::out);
+    if (storage_mode != StorageMode::FLOAT32) {
+      m_compact = Euclid::make_unique<CompactDataFile>(m_data_path, m_max_size, m_read_only, storage_mode);
+    }
   } else {
     throw Elements::Exception() << "Can not open a missing pdz provider in read-only mode";
   }
 }
 
 XYDataset::XYDataset PdzDataProvider::readPdz(int64_t position) const {
+  if (m_compact) {
+    return m_compact->read(position);
+  }
   if (position < 0) {
     throw Elements::Exception() << "Negative offset";
   }
@@ -77,13 +90,37 @@ XYDataset::XYDataset PdzDataProvider::readPdz(int64_t position) const {
   return data;
 }
 
+PdzDataView PdzDataProvider::readPdzView(int64_t position) const {
+  if (m_compact) {
+    if (m_compact->storageMode() == StorageMode::FLOAT32_SHARED_AXIS) {
+      return {m_bins.data(), m_compact->floatValues(position), m_bins.size()};
+    }
+    return {m_bins.data(), m_compact->halfValues(position), m_compact->scale(position), m_bins.size()};
+  }
+  // The first row holds the bins
+  if (position < 1) {
+    throw Elements::Exception() << "Invalid offset";
+  }
+  if (!m_array) {
+    throw Elements::Exception() << "Need to create the PDZ file first";
+  }
+  if (uint64_t(position) >= m_array->shape()[0]) {
+    throw Elements::Exception() << "Position out of bounds";
+  }
+  return {&m_array->at(0, 0), &m_array->at(static_cast<size_t>(position), 0), m_bins.size()};
+}
+
 size_t PdzDataProvider::diskSize() const {
+  if (m_compact)
+    return m_compact->diskSize();
   if (m_array)
     return boost::filesystem::file_size(m_data_path);
   return 0;
 }
 
 size_t PdzDataProvider::length() const {
+  if (m_compact)
+    return m_compact->length();
   return m_array->shape()[0] - 1;
 }
 
@@ -108,6 +145,9 @@ int64_t PdzDataProvider::addPdz(const Euclid::XYDataset::XYDataset& data) {
   else
     validateBins(bins);
 
+  if (m_compact)
+    return m_compact->add(data);
+
   m_array->concatenate(values);
   return m_array->shape()[0] - 1;
 }
@@ -117,6 +157,12 @@ void PdzDataProvider::setBins(const std::vector<float>& bins) {
     throw Elements::Exception() << "PDZ bins not in order";
   }
 
+  // The compact files store the bins on their axis table
+  if (m_compact) {
+    m_bins = bins;
+    return;
+  }
+
   try {
     m_bins = bins;
     m_array =
@@ -143,6 +189,10 @@ void PdzDataProvider::setPdz(int64_t position, const XYDataset::XYDataset& data)
     throw Elements::Exception("Can not modify a read-only pdz provider");
   }
 
+  if (m_compact) {
+    m_compact->set(position, data);
+    return;
+  }
   if (position < 0) {
     throw Elements::Exception() << "Negative offset";
   }
@@ -35,6 +35,8 @@
  */
 
 #include "PhzReferenceSample/ReferenceSample.h"
+#include "PhzReferenceSample/CompactDataFile.h"
+#include "PhzUtils/Multithreading.h"
 #include <ElementsKernel/Exception.h>
 #include <ElementsKernel/Logging.h>
 #include <MathUtils/function/function_tools.h>
@@ -42,6 +44,12 @@
 #include <boost/filesystem.hpp>
 #include <boost/filesystem/path.hpp>
 #include <boost/format.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <fstream>
+#include <future>
+#include <tuple>
 
 namespace Euclid {
 namespace ReferenceSample {
@@ -53,17 +61,79 @@ static Elements::Logging logger = Elements::Logging::getLogger("ReferenceSample"
 static const std::string INDEX_FILE_NAME{"index.npy"};
 static const std::string SED_DATA_NAME_PATTERN{"sed_data_%1%.npy"};
 static const std::string PDZ_DATA_NAME_PATTERN{"pdz_data_%1%.npy"};
+static const std::string OPTIMIZE_DIR_NAME{"optimize.tmp"};
+static const std::string OPTIMIZE_COMMITTED_NAME{"committed"};
+static const std::string OPTIMIZE_SWAPPING_NAME{"swapping"};
+static const std::string PARTITION_DIR_NAME_PATTERN{"partition_%1%"};
+static const std::string PARTITION_MERGING_NAME{"merging"};
 
-ReferenceSample::ReferenceSample(const boost::filesystem::path& path, size_t max_file_size, bool read_only)
-    : m_root_path{path}
-    , m_max_file_size(max_file_size)
-    , m_read_only(read_only)
-    , m_index{std::make_shared<IndexProvider>(path / INDEX_FILE_NAME, m_read_only)} {
+namespace {
+
+/// @return true if the file name starts with the prefix of the given data file name pattern
+bool matchesDataPattern(const std::string& filename, const std::string& pattern) {
+  return filename.compare(0, pattern.find('%'), pattern, 0, pattern.find('%')) == 0;
+}
+
+/**
+ * Replace the data files and the index of the reference sample with the ones on the optimize work directory,
+ * once they are all written. Each step can be repeated, so a swap interrupted by a crash is completed the next
+ * time the reference sample is open:
+ *  - while the "committed" marker exists, the old data files are removed
+ *  - while the "swapping" marker exists, the new files are moved in place, the index last
+ */
+void completeOptimize(const boost::filesystem::path& root_path, bool read_only) {
+  auto work_path = root_path / OPTIMIZE_DIR_NAME;
+  if (!boost::filesystem::exists(work_path / OPTIMIZE_COMMITTED_NAME) &&
+      !boost::filesystem::exists(work_path / OPTIMIZE_SWAPPING_NAME)) {
+    return;
+  }
+  if (read_only) {
+    throw Elements::Exception() << "The optimization of " << root_path
+                                << " was interrupted, open it in read-write mode to complete it";
+  }
+  logger.info() << "Replacing the data files with the optimized ones";
+
+  if (boost::filesystem::exists(work_path / OPTIMIZE_COMMITTED_NAME)) {
+    for (boost::filesystem::directory_iterator i{root_path}; i != boost::filesystem::directory_iterator{}; ++i) {
+      auto filename = i->path().filename().string();
+      if (matchesDataPattern(filename, SED_DATA_NAME_PATTERN) || matchesDataPattern(filename, PDZ_DATA_NAME_PATTERN)) {
+        boost::filesystem::remove(i->path());
+      }
+    }
+    boost::filesystem::rename(work_path / OPTIMIZE_COMMITTED_NAME, work_path / OPTIMIZE_SWAPPING_NAME);
+  }
+
+  // The index only points to the new files once they are all in place
+  std::vector<boost::filesystem::path> new_files;
+  for (boost::filesystem::directory_iterator i{work_path}; i != boost::filesystem::directory_iterator{}; ++i) {
+    auto filename = i->path().filename().string();
+    if (boost::filesystem::is_regular_file(i->path()) && filename != OPTIMIZE_SWAPPING_NAME &&
+        filename != INDEX_FILE_NAME) {
+      new_files.emplace_back(i->path());
+    }
+  }
+  for (auto& new_file : new_files) {
+    boost::filesystem::rename(new_file, root_path / new_file.filename());
+  }
+  if (boost::filesystem::exists(work_path / INDEX_FILE_NAME)) {
+    boost::filesystem::rename(work_path / INDEX_FILE_NAME, root_path / INDEX_FILE_NAME);
+  }
+  boost::filesystem::remove_all(work_path);
+}
+
+}  // namespace
+
+ReferenceSample::ReferenceSample(const boost::filesystem::path& path, size_t max_file_size, bool read_only,
+                                 StorageMode storage_mode)
+    : m_root_path{path}, m_max_file_size(max_file_size), m_read_only(read_only), m_storage_mode(storage_mode) {
+  completeOptimize(m_root_path, m_read_only);
+  m_index = std::make_shared<IndexProvider>(m_root_path / INDEX_FILE_NAME, m_read_only);
   initSedProviders();
   initPdzProviders();
 }
 
-ReferenceSample ReferenceSample::create(const boost::filesystem::path& path, bool throw_on_exists, size_t max_file_size) {
+ReferenceSample ReferenceSample::create(const boost::filesystem::path& path, bool throw_on_exists, size_t max_file_size,
+                                        StorageMode storage_mode) {
   if (boost::filesystem::exists(path)) {
 	  if (throw_on_exists) {
 		  throw Elements::Exception() << "The directory already exists: " << path;
@@ -71,21 +141,23 @@ ReferenceSample ReferenceSample::create(const boost::filesystem::path& path, boo
   } else if (!boost::filesystem::create_directories(path)) {
     throw Elements::Exception() << "Unable to create the directory: " << path;
   }
-  return {path, max_file_size, false};
+  return {path, max_file_size, false, storage_mode};
 }
 
 ReferenceSample::ReferenceSample(boost::filesystem::path root_path, size_t max_file_size,
-                                 std::shared_ptr<IndexProvider> index, bool readonly)
+                                 std::shared_ptr<IndexProvider> index, bool readonly, StorageMode storage_mode)
     : m_root_path(std::move(root_path))
     , m_max_file_size(max_file_size)
     , m_read_only(readonly)
+    , m_storage_mode(storage_mode)
     , m_index(std::move(index)) {
   initSedProviders();
   initPdzProviders();
 }
 
 std::unique_ptr<ReferenceSample> ReferenceSample::clone() const {
-  return std::unique_ptr<ReferenceSample>(new ReferenceSample(m_root_path, m_max_file_size, m_index, m_read_only));
+  return std::unique_ptr<ReferenceSample>(
+      new ReferenceSample(m_root_path, m_max_file_size, m_index, m_read_only, m_storage_mode));
 }
 
 size_t ReferenceSample::size() const {
@@ -133,6 +205,96 @@ boost::optional<XYDataset::XYDataset> ReferenceSample::getPdzData(int64_t id) co
   return m_pdz_provider->readPdz(loc.offset);
 }
 
+namespace {
+
+/// Gets the locations of the given objects, skipping the missing ones, sorted by file and offset
+std::vector<std::pair<int64_t, IndexProvider::ObjectLocation>>
+sortedLocations(const IndexProvider& index, const std::vector<int64_t>& ids, IndexProvider::IndexKey key) {
+  std::vector<std::pair<int64_t, IndexProvider::ObjectLocation>> locations;
+  locations.reserve(ids.size());
+  for (auto id : ids) {
+    auto loc = index.get(id, key);
+    if (loc.file != -1) {
+      locations.emplace_back(id, loc);
+    }
+  }
+  std::sort(locations.begin(), locations.end(), [](const std::pair<int64_t, IndexProvider::ObjectLocation>& a,
+                                                   const std::pair<int64_t, IndexProvider::ObjectLocation>& b) {
+    return std::tie(a.second.file, a.second.offset) < std::tie(b.second.file, b.second.offset);
+  });
+  return locations;
+}
+
+}  // namespace
+
+const SedDataProvider& ReferenceSample::getSedViewProvider(int64_t file) const {
+  if (file > m_sed_provider_count) {
+    throw Elements::Exception() << "Invalid SED file " << file;
+  }
+  // The providers being written are used directly, so the views see their latest data
+  auto write_sed_i = m_write_sed_provider.find(file);
+  if (write_sed_i != m_write_sed_provider.end()) {
+    return *write_sed_i->second;
+  }
+  auto& provider = m_view_sed_providers[file];
+  if (!provider) {
+    auto sed_filename = boost::str(boost::format(SED_DATA_NAME_PATTERN) % file);
+    provider          = make_unique<SedDataProvider>(m_root_path / sed_filename, m_max_file_size, m_read_only);
+  }
+  return *provider;
+}
+
+const PdzDataProvider& ReferenceSample::getPdzViewProvider(int64_t file) const {
+  if (file > m_pdz_provider_count) {
+    throw Elements::Exception() << "Invalid PDZ file " << file;
+  }
+  if (m_pdz_provider && file == m_pdz_index) {
+    return *m_pdz_provider;
+  }
+  auto& provider = m_view_pdz_providers[file];
+  if (!provider) {
+    auto pdz_filename = boost::str(boost::format(PDZ_DATA_NAME_PATTERN) % file);
+    provider          = make_unique<PdzDataProvider>(m_root_path / pdz_filename, m_max_file_size, m_read_only);
+  }
+  return *provider;
+}
+
+boost::optional<SedDataView> ReferenceSample::getSedDataView(int64_t id) const {
+  auto loc = m_index->get(id, IndexProvider::SED);
+  if (loc.file == -1) {
+    return {};
+  }
+  return getSedViewProvider(loc.file).readSedView(loc.offset);
+}
+
+boost::optional<PdzDataView> ReferenceSample::getPdzDataView(int64_t id) const {
+  auto loc = m_index->get(id, IndexProvider::PDZ);
+  if (loc.file == -1) {
+    return {};
+  }
+  return getPdzViewProvider(loc.file).readPdzView(loc.offset);
+}
+
+std::vector<std::pair<int64_t, SedDataView>> ReferenceSample::getSedDataViews(const std::vector<int64_t>& ids) const {
+  std::vector<std::pair<int64_t, SedDataView>> views;
+  auto                                         locations = sortedLocations(*m_index, ids, IndexProvider::SED);
+  views.reserve(locations.size());
+  for (auto& id_loc : locations) {
+    views.emplace_back(id_loc.first, getSedViewProvider(id_loc.second.file).readSedView(id_loc.second.offset));
+  }
+  return views;
+}
+
+std::vector<std::pair<int64_t, PdzDataView>> ReferenceSample::getPdzDataViews(const std::vector<int64_t>& ids) const {
+  std::vector<std::pair<int64_t, PdzDataView>> views;
+  auto                                         locations = sortedLocations(*m_index, ids, IndexProvider::PDZ);
+  views.reserve(locations.size());
+  for (auto& id_loc : locations) {
+    views.emplace_back(id_loc.first, getPdzViewProvider(id_loc.second.file).readPdzView(id_loc.second.offset));
+  }
+  return views;
+}
+
 void ReferenceSample::addSedData(int64_t id, const XYDataset::XYDataset& data) {
   if (m_read_only) {
     throw Elements::Exception() << "Can not modify a read-only reference sample";
@@ -175,7 +337,8 @@ std::pair<int64_t, std::unique_ptr<SedDataProvider>> ReferenceSample::createNewS
   uint16_t new_sed_idx  = m_sed_provider_count;
   auto     sed_filename = boost::str(boost::format(SED_DATA_NAME_PATTERN) % new_sed_idx);
   auto     sed_path     = m_root_path / sed_filename;
-  return std::make_pair(new_sed_idx, make_unique<SedDataProvider>(sed_path, m_max_file_size, m_read_only));
+  return std::make_pair(new_sed_idx,
+                        make_unique<SedDataProvider>(sed_path, m_max_file_size, m_read_only, m_storage_mode));
 }
 
 void ReferenceSample::addPdzData(int64_t id, const XYDataset::XYDataset& data) {
@@ -217,7 +380,7 @@ void ReferenceSample::addPdzData(int64_t id, const XYDataset::XYDataset& data) {
     m_pdz_index       = ++m_pdz_provider_count;
     auto pdz_filename = boost::str(boost::format(PDZ_DATA_NAME_PATTERN) % m_pdz_index);
     auto pdz_path     = m_root_path / pdz_filename;
-    m_pdz_provider    = make_unique<PdzDataProvider>(pdz_path, m_max_file_size, m_read_only);
+    m_pdz_provider    = make_unique<PdzDataProvider>(pdz_path, m_max_file_size, m_read_only, m_storage_mode);
   }
 
   loc.file   = m_pdz_index;
@@ -261,62 +424,287 @@ void ReferenceSample::initPdzProviders() {
 }
 
 void ReferenceSample::optimize() {
+  optimize(m_storage_mode);
+}
+
+namespace {
+
+/// An object ID with its SED and PDZ locations
+using Locations = std::tuple<int64_t, IndexProvider::ObjectLocation, IndexProvider::ObjectLocation>;
+
+/// Rename a data file, with its axis table if it has the compact layout
+void moveDataFile(const boost::filesystem::path& from, const boost::filesystem::path& to) {
+  if (CompactDataFile::isCompact(from)) {
+    boost::filesystem::rename(CompactDataFile::axisPath(from), CompactDataFile::axisPath(to));
+  }
+  boost::filesystem::rename(from, to);
+}
+
+/**
+ * Rewrite the data of a range of the index on the given directory, with its own file numbering starting at 1.
+ * The locations are updated to point to the new files.
+ * @return The number of SED and PDZ files written
+ */
+std::pair<int64_t, int64_t> rewriteRange(const boost::filesystem::path& root_path,
+                                         const boost::filesystem::path& out_path, size_t max_file_size,
+                                         StorageMode storage_mode, std::vector<Locations>::iterator begin,
+                                         std::vector<Locations>::iterator end, std::atomic<size_t>& done) {
+  // The files are read with providers of their own, so the workers do not share any state
+  std::map<int64_t, std::unique_ptr<SedDataProvider>> sed_readers;
+  std::map<int64_t, std::unique_ptr<PdzDataProvider>> pdz_readers;
+
+  // One SED writer per number of knots, as for addSedData
+  std::map<size_t, std::pair<int64_t, std::unique_ptr<SedDataProvider>>> sed_writers;
+  std::unique_ptr<PdzDataProvider>                                       pdz_writer;
+  int64_t                                                                sed_count = 0, pdz_count = 0;
+
+  for (auto i = begin; i != end; ++i) {
+    auto& sed_loc = std::get<1>(*i);
+    if (sed_loc.file != -1) {
+      auto& reader = sed_readers[sed_loc.file];
+      if (!reader) {
+        auto sed_filename = boost::str(boost::format(SED_DATA_NAME_PATTERN) % sed_loc.file);
+        reader            = make_unique<SedDataProvider>(root_path / sed_filename, max_file_size, true);
+      }
+      auto  sed    = reader->readSed(sed_loc.offset);
+      auto& writer = sed_writers[sed.size()];
+      if (!writer.second || writer.second->diskSize() + sed.size() * 2 * sizeof(double) >= max_file_size) {
+        writer.first      = ++sed_count;
+        auto sed_filename = boost::str(boost::format(SED_DATA_NAME_PATTERN) % writer.first);
+        writer.second = make_unique<SedDataProvider>(out_path / sed_filename, max_file_size, false, storage_mode);
+      }
+      sed_loc.file   = writer.first;
+      sed_loc.offset = writer.second->addSed(sed);
+    }
+
+    auto& pdz_loc = std::get<2>(*i);
+    if (pdz_loc.file != -1) {
+      auto& reader = pdz_readers[pdz_loc.file];
+      if (!reader) {
+        auto pdz_filename = boost::str(boost::format(PDZ_DATA_NAME_PATTERN) % pdz_loc.file);
+        reader            = make_unique<PdzDataProvider>(root_path / pdz_filename, max_file_size, true);
+      }
+      auto pdz = reader->readPdz(pdz_loc.offset);
+      if (!pdz_writer || pdz_writer->diskSize() + pdz.size() * 2 * sizeof(double) >= max_file_size) {
+        auto pdz_filename = boost::str(boost::format(PDZ_DATA_NAME_PATTERN) % ++pdz_count);
+        pdz_writer = make_unique<PdzDataProvider>(out_path / pdz_filename, max_file_size, false, storage_mode);
+      }
+      pdz_loc.file   = pdz_count;
+      pdz_loc.offset = pdz_writer->addPdz(pdz);
+    }
+    ++done;
+  }
+  return {sed_count, pdz_count};
+}
+
+}  // namespace
+
+void ReferenceSample::optimize(StorageMode storage_mode) {
   if (m_read_only) {
     throw Elements::Exception() << "Can not modify a read-only reference sample";
   }
-  // Clear providers
+
+  logger.info() << "Sorting based on SED";
+  m_index->sort(IndexProvider::SED);
+
+  // The index is not thread safe, so all the locations are resolved first
+  std::vector<Locations> locations;
+  for (auto id : m_index->getIds()) {
+    locations.emplace_back(id, m_index->get(id, IndexProvider::SED), m_index->get(id, IndexProvider::PDZ));
+  }
+
+  // Each thread writes the data of a contiguous range of the index on its own work directory. The files
+  // are renumbered afterwards following the ranges, so they keep the index order.
+  auto work_path = m_root_path / OPTIMIZE_DIR_NAME;
+  boost::filesystem::remove_all(work_path);
+
+  size_t nobjs        = locations.size();
+  size_t thread_count = std::max<size_t>(1, std::min<size_t>(PhzUtils::getThreadNumber(), nobjs));
+  logger.info() << "Rewriting the data using " << thread_count << " threads";
+
+  std::atomic<size_t>                                   done{0};
+  std::vector<boost::filesystem::path>                  range_paths;
+  std::vector<std::future<std::pair<int64_t, int64_t>>> futures;
+  for (size_t t = 0; t < thread_count; ++t) {
+    range_paths.emplace_back(work_path / std::to_string(t));
+    boost::filesystem::create_directories(range_paths.back());
+    auto begin = locations.begin() + (t * nobjs) / thread_count;
+    auto end   = locations.begin() + ((t + 1) * nobjs) / thread_count;
+    futures.emplace_back(std::async(std::launch::async, rewriteRange, m_root_path, range_paths.back(),
+                                    m_max_file_size, storage_mode, begin, end, std::ref(done)));
+  }
+
+  // Wait for all of them before rethrowing any failure, so no thread is left writing
+  std::vector<std::pair<int64_t, int64_t>> file_counts;
+  std::exception_ptr                       failure;
+  for (auto& future : futures) {
+    try {
+      file_counts.emplace_back(future.get());
+    } catch (...) {
+      failure = std::current_exception();
+    }
+  }
+  if (failure) {
+    std::rethrow_exception(failure);
+  }
+  logger.info() << "Rewritten " << done.load() << " objects";
+
+  // The files are numbered following the ranges, on the work directory, and the new index is written next to
+  // them. Only then the existing files are replaced, so a crash leaves either the old or the new data.
+  {
+    IndexProvider new_index{work_path / INDEX_FILE_NAME};
+    int64_t       sed_base = 0, pdz_base = 0;
+    for (size_t t = 0; t < thread_count; ++t) {
+      for (int64_t f = 1; f <= file_counts[t].first; ++f) {
+        moveDataFile(range_paths[t] / boost::str(boost::format(SED_DATA_NAME_PATTERN) % f),
+                     work_path / boost::str(boost::format(SED_DATA_NAME_PATTERN) % (sed_base + f)));
+      }
+      for (int64_t f = 1; f <= file_counts[t].second; ++f) {
+        moveDataFile(range_paths[t] / boost::str(boost::format(PDZ_DATA_NAME_PATTERN) % f),
+                     work_path / boost::str(boost::format(PDZ_DATA_NAME_PATTERN) % (pdz_base + f)));
+      }
+
+      auto begin = locations.begin() + (t * nobjs) / thread_count;
+      auto end   = locations.begin() + ((t + 1) * nobjs) / thread_count;
+      for (auto i = begin; i != end; ++i) {
+        if (std::get<1>(*i).file != -1) {
+          std::get<1>(*i).file += sed_base;
+        }
+        if (std::get<2>(*i).file != -1) {
+          std::get<2>(*i).file += pdz_base;
+        }
+        new_index.add(std::get<0>(*i), IndexProvider::SED, std::get<1>(*i));
+        new_index.add(std::get<0>(*i), IndexProvider::PDZ, std::get<2>(*i));
+      }
+      sed_base += file_counts[t].first;
+      pdz_base += file_counts[t].second;
+      boost::filesystem::remove(range_paths[t]);
+    }
+    new_index.sort(IndexProvider::SED);
+  }
+
+  // Close all the files before replacing them
   m_pdz_provider.reset();
   m_read_sed_provider.reset();
   m_write_sed_provider.clear();
+  m_write_sed_idx.clear();
+  m_view_sed_providers.clear();
+  m_view_pdz_providers.clear();
+  m_index.reset();
 
-  // Sort index based on SED (biggest dataset)
-  logger.info() << "Sorting based on SED";
-  m_index->sort(IndexProvider::SED);
+  std::ofstream committed{(work_path / OPTIMIZE_COMMITTED_NAME).native()};
+  committed.close();
+  completeOptimize(m_root_path, m_read_only);
+
+  m_index        = std::make_shared<IndexProvider>(m_root_path / INDEX_FILE_NAME, m_read_only);
+  m_storage_mode = storage_mode;
+  initSedProviders();
+  initPdzProviders();
+}
 
-  // Map all PDZ providers
-  std::vector<std::unique_ptr<PdzDataProvider>> pdz_providers(m_pdz_provider_count);
-  for (int64_t i = 1; i <= m_pdz_provider_count; ++i) {
-    auto pdz_filename    = boost::str(boost::format(PDZ_DATA_NAME_PATTERN) % i);
-    auto pdz_path        = m_root_path / pdz_filename;
-    pdz_providers[i - 1] = make_unique<PdzDataProvider>(pdz_path, m_max_file_size, m_read_only);
+ReferenceSample ReferenceSample::createPartition(const boost::filesystem::path& path, size_t partition,
+                                                 size_t max_file_size, StorageMode storage_mode) {
+  auto partition_path = path / boost::str(boost::format(PARTITION_DIR_NAME_PATTERN) % partition);
+  return create(partition_path, true, max_file_size, storage_mode);
+}
+
+void ReferenceSample::mergePartitions() {
+  if (m_read_only) {
+    throw Elements::Exception() << "Can not modify a read-only reference sample";
   }
 
-  // Shuffle around the PDZs so they are in order too
-  logger.info() << "Reordering PDZ";
-  auto                          ids = m_index->getIds();
-  IndexProvider::ObjectLocation loc{1, 1};
-  int64_t                       prov_size = pdz_providers[loc.file - 1]->length();
-  size_t                        id_offset = 0, nobjs = ids.size(), last = 0;
-  for (auto id : ids) {
-    if (loc.offset >= prov_size + 1) {
-      ++loc.file;
-      loc.offset = 1;
-      prov_size  = pdz_providers[loc.file - 1]->length();
+  // Merge the partitions following their number
+  auto partition_prefix = PARTITION_DIR_NAME_PATTERN.substr(0, PARTITION_DIR_NAME_PATTERN.find('%'));
+  std::map<size_t, boost::filesystem::path> partitions;
+  for (boost::filesystem::directory_iterator i{m_root_path}; i != boost::filesystem::directory_iterator{}; ++i) {
+    auto filename = i->path().filename().string();
+    if (!boost::filesystem::is_directory(i->path()) ||
+        filename.compare(0, partition_prefix.size(), partition_prefix) != 0) {
+      continue;
+    }
+    auto number   = filename.substr(partition_prefix.size());
+    auto is_digit = [](char c) { return std::isdigit(static_cast<unsigned char>(c)) != 0; };
+    if (!number.empty() && std::all_of(number.begin(), number.end(), is_digit)) {
+      partitions.emplace(std::stoul(number), i->path());
     }
+  }
 
-    auto this_loc = m_index->get(id, IndexProvider::PDZ);
-    // If it does not match the expected position, swap
-    if (this_loc.file != loc.file || this_loc.offset != loc.offset) {
-      auto other_id  = m_index->findId(IndexProvider::PDZ, loc, id_offset);
-      auto other_pdz = pdz_providers[loc.file - 1]->readPdz(loc.offset);
-      auto this_pdz  = pdz_providers[this_loc.file - 1]->readPdz(this_loc.offset);
+  for (auto& partition : partitions) {
+    auto&         partition_path = partition.second;
+    IndexProvider partition_index{partition_path / INDEX_FILE_NAME, true};
+    auto          ids       = partition_index.getIds();
+    auto          sed_files = partition_index.getFiles(IndexProvider::SED);
+    auto          pdz_files = partition_index.getFiles(IndexProvider::PDZ);
+
+    // The files are moved, not copied, and numbered after the existing ones. The numbering is recorded on the
+    // partition before anything is modified, so an interrupted merge is resumed with the same one.
+    int64_t sed_base = m_sed_provider_count, pdz_base = m_pdz_provider_count;
+    auto    merging_path = partition_path / PARTITION_MERGING_NAME;
+    if (boost::filesystem::exists(merging_path)) {
+      std::ifstream merging{merging_path.native()};
+      if (!(merging >> sed_base >> pdz_base)) {
+        throw Elements::Exception() << "Failed to read the file numbering from " << merging_path;
+      }
+      logger.info() << "Resuming the merge of " << partition_path;
+    } else {
+      for (auto id : ids) {
+        bool has_sed = partition_index.get(id, IndexProvider::SED).file != -1;
+        bool has_pdz = partition_index.get(id, IndexProvider::PDZ).file != -1;
+        if ((has_sed && m_index->get(id, IndexProvider::SED).file != -1) ||
+            (has_pdz && m_index->get(id, IndexProvider::PDZ).file != -1)) {
+          throw Elements::Exception() << "The object " << id << " of " << partition_path
+                                      << " already has data on the reference sample";
+        }
+      }
+      auto          merging_tmp_path = partition_path / (PARTITION_MERGING_NAME + ".tmp");
+      std::ofstream merging{merging_tmp_path.native()};
+      merging << sed_base << ' ' << pdz_base << std::endl;
+      merging.close();
+      boost::filesystem::rename(merging_tmp_path, merging_path);
+    }
 
-      pdz_providers[loc.file - 1]->setPdz(loc.offset, this_pdz);
-      pdz_providers[this_loc.file - 1]->setPdz(this_loc.offset, other_pdz);
+    // The index goes first, so the data added after an interruption can not take the names of the files
+    // not moved yet. Adding the same locations again when resuming does not change it.
+    for (auto id : ids) {
+      auto sed_loc = partition_index.get(id, IndexProvider::SED);
+      if (sed_loc.file != -1) {
+        sed_loc.file += sed_base;
+        m_index->add(id, IndexProvider::SED, sed_loc);
+      }
+      auto pdz_loc = partition_index.get(id, IndexProvider::PDZ);
+      if (pdz_loc.file != -1) {
+        pdz_loc.file += pdz_base;
+        m_index->add(id, IndexProvider::PDZ, pdz_loc);
+      }
+    }
+    if (!sed_files.empty()) {
+      m_sed_provider_count =
+          std::max(m_sed_provider_count, static_cast<uint16_t>(sed_base + *sed_files.rbegin()));
+    }
+    if (!pdz_files.empty()) {
+      m_pdz_provider_count =
+          std::max(m_pdz_provider_count, static_cast<uint16_t>(pdz_base + *pdz_files.rbegin()));
+    }
 
-      m_index->add(other_id, IndexProvider::PDZ, this_loc);
-      m_index->add(id, IndexProvider::PDZ, loc);
+    // The files moved before an interruption are not on the partition anymore
+    for (auto f : sed_files) {
+      auto from = partition_path / boost::str(boost::format(SED_DATA_NAME_PATTERN) % f);
+      if (boost::filesystem::exists(from)) {
+        moveDataFile(from, m_root_path / boost::str(boost::format(SED_DATA_NAME_PATTERN) % (sed_base + f)));
+      }
     }
-    ++id_offset;
-    ++loc.offset;
-    if ((id_offset * 100) / nobjs > last) {
-      last = (id_offset * 100) / nobjs;
-      logger.info() << last << "% (" << id_offset << '/' << nobjs << ')';
+    for (auto f : pdz_files) {
+      auto from = partition_path / boost::str(boost::format(PDZ_DATA_NAME_PATTERN) % f);
+      if (boost::filesystem::exists(from)) {
+        moveDataFile(from, m_root_path / boost::str(boost::format(PDZ_DATA_NAME_PATTERN) % (pdz_base + f)));
+      }
     }
+
+    boost::filesystem::remove_all(partition_path);
+    logger.info() << "Merged " << ids.size() << " objects from " << partition_path;
   }
 
-  // Clear work area and reload
-  pdz_providers.clear();
+  // The new files are the ones written from now on
   initSedProviders();
   initPdzProviders();
 }
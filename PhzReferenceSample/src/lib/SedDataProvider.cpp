@@ -33,11 +33,15 @@ using NdArray::createMmapNpy;
 using NdArray::mmapNpy;
 using NdArray::NdArray;
 
-SedDataProvider::SedDataProvider(const boost::filesystem::path& path, std::size_t max_size, bool read_only)
+SedDataProvider::SedDataProvider(const boost::filesystem::path& path, std::size_t max_size, bool read_only,
+                                 StorageMode storage_mode)
     : m_data_path{path}, m_max_size{max_size}, m_read_only{read_only}, m_length{0} {
   using mmap_mode = boost::iostreams::mapped_file_base;
 
-  if (boost::filesystem::exists(m_data_path)) {
+  if (CompactDataFile::isCompact(m_data_path)) {
+    m_compact = Euclid::make_unique<CompactDataFile>(m_data_path, m_max_size, m_read_only);
+    m_length  = m_compact->knots();
+  } else if (boost::filesystem::exists(m_data_path)) {
     auto mode = m_read_only ? mmap_mode::readonly : mmap_mode::readwrite;
 
     m_array = Euclid::make_unique<NdArray<float>>(mmapNpy<float>(m_data_path, mode, m_max_size + 1024));
@@ -56,12 +60,18 @@ SedDataProvider::SedDataProvider(const boost::filesystem::path& path, std::size_
     std::fstream stream;
     stream.exceptions(~std::ios_base::goodbit);
     stream.open(path.native(), std::ios_base::out);
+    if (storage_mode != StorageMode::FLOAT32) {
+      m_compact = Euclid::make_unique<CompactDataFile>(m_data_path, m_max_size, m_read_only, storage_mode);
+    }
   } else {
     throw Elements::Exception() << "Can not open a missing sed provider in read-only mode";
   }
 }
 
 XYDataset::XYDataset SedDataProvider::readSed(int64_t position) const {
+  if (m_compact) {
+    return m_compact->read(position);
+  }
   if (position < 0) {
     throw Elements::Exception() << "Negative offset";
   }
@@ -80,11 +90,36 @@ XYDataset::XYDataset SedDataProvider::readSed(int64_t position) const {
   return data;
 }
 
+SedDataView SedDataProvider::readSedView(int64_t position) const {
+  if (m_compact) {
+    if (m_compact->storageMode() == StorageMode::FLOAT32_SHARED_AXIS) {
+      return {m_compact->axis(position), m_compact->floatValues(position), m_length};
+    }
+    return {m_compact->axis(position), m_compact->halfValues(position), m_compact->scale(position), m_length};
+  }
+  if (position < 0) {
+    throw Elements::Exception() << "Negative offset";
+  }
+  if (!m_array) {
+    throw Elements::Exception() << "Need to create the SED file first";
+  }
+  if (uint64_t(position) >= m_array->shape()[0]) {
+    throw Elements::Exception() << "Position out of bounds";
+  }
+  return {&m_array->at(static_cast<size_t>(position), 0, 0), m_length};
+}
+
 size_t SedDataProvider::diskSize() const {
+  if (m_compact) {
+    return m_compact->diskSize();
+  }
   return boost::filesystem::file_size(m_data_path);
 }
 
 size_t SedDataProvider::length() const {
+  if (m_compact) {
+    return m_compact->length();
+  }
   return m_array->shape()[0];
 }
 
@@ -98,15 +133,21 @@ int64_t SedDataProvider::addSed(const XYDataset::XYDataset& data) {
     return a.first < b.first;
   };
 
-  if (!m_array) {
+  if (!std::is_sorted(data.begin(), data.end(), cmp_bin_func)) {
+    throw Elements::Exception() << "SED bins not in order";
+  }
+  if (!m_array && !m_compact) {
     create(data.size());
   }
+  if (m_length == 0) {
+    m_length = data.size();
+  }
   if (data.size() != m_length) {
     throw Elements::Exception() << "All SEDs are expected to have the same number of knots (" << data.size() << " vs "
                                 << m_length << ")";
   }
-  if (!std::is_sorted(data.begin(), data.end(), cmp_bin_func)) {
-    throw Elements::Exception() << "SED bins not in order";
+  if (m_compact) {
+    return m_compact->add(data);
   }
 
   NdArray<float> values{1, m_length, 2};
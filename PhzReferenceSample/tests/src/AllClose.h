@@ -1,5 +1,7 @@
 #include <ElementsKernel/Real.h>
 #include <XYDataset/XYDataset.h>
+#include <algorithm>
+#include <cmath>
 #include <iomanip>
 
 namespace Euclid {
@@ -24,5 +26,30 @@ boost::test_tools::predicate_result checkAllClose(const XYDataset& a, const XYDa
   return res;
 }
 
+/// Same as above, but the values only need to match within a fraction of the biggest value of b
+boost::test_tools::predicate_result checkAllClose(const XYDataset& a, const XYDataset& b, double tolerance) {
+  boost::test_tools::predicate_result res(true);
+
+  double max_value = 0.;
+  for (auto& p : b) {
+    max_value = std::max(max_value, std::abs(p.second));
+  }
+
+  if (a.size() != b.size()) {
+    res = false;
+    res.message() << "Different sizes";
+  } else {
+    for (auto i = a.begin(), j = b.begin(); i != a.end() && j != b.end(); ++i, ++j) {
+      if (Elements::isNotEqual(i->first, j->first) || std::abs(i->second - j->second) > tolerance * max_value) {
+        res = false;
+        res.message() << '<' << i->first << ',' << i->second << '>' << " != " << '<' << j->first << ',' << j->second
+                      << ">\n";
+      }
+    }
+  }
+
+  return res;
+}
+
 }  // namespace XYDataset
 }  // namespace Euclid
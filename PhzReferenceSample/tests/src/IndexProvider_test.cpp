@@ -23,7 +23,10 @@
 
 #include <ElementsKernel/Exception.h>
 #include <ElementsKernel/Temporary.h>
+#include <boost/filesystem/operations.hpp>
 #include <boost/test/unit_test.hpp>
+#include <fstream>
+#include <iterator>
 
 #include "PhzReferenceSample/IndexProvider.h"
 
@@ -215,6 +218,101 @@ BOOST_FIXTURE_TEST_CASE(SortIndexProvider_test, IndexProvider_Fixture) {
 
 //-----------------------------------------------------------------------------
 
+BOOST_FIXTURE_TEST_CASE(SortedIdLookup_test, IndexProvider_Fixture) {
+  {
+    IndexProvider idx{m_index_bin};
+    idx.add(30, IndexProvider::SED, {1, 3});
+    idx.add(10, IndexProvider::SED, {2, 1});
+    idx.add(20, IndexProvider::SED, {1, 1});
+    idx.sort(IndexProvider::SED);
+
+    BOOST_CHECK(boost::filesystem::exists(m_top_dir.path() / "index_sorted.npy"));
+
+    // The index is sorted by SED location, so findId can do a binary search
+    BOOST_CHECK_EQUAL(idx.findId(IndexProvider::SED, {1, 3}, 0), 30);
+    BOOST_CHECK_EQUAL(idx.findId(IndexProvider::SED, {2, 1}, 0), 10);
+    BOOST_CHECK_THROW(idx.findId(IndexProvider::SED, {2, 2}, 0), Elements::Exception);
+  }
+
+  {
+    IndexProvider idx{m_index_bin};
+    BOOST_CHECK_EQUAL(idx.size(), 3);
+    BOOST_CHECK_EQUAL(idx.get(10, IndexProvider::SED).file, 2);
+    BOOST_CHECK_EQUAL(idx.get(20, IndexProvider::SED).offset, 1);
+    BOOST_CHECK_EQUAL(idx.get(30, IndexProvider::SED).offset, 3);
+    BOOST_CHECK_EQUAL(idx.get(15, IndexProvider::SED).file, -1);
+
+    // Added after the sort
+    idx.add(15, IndexProvider::SED, {2, 2});
+    BOOST_CHECK_EQUAL(idx.get(15, IndexProvider::SED).offset, 2);
+    idx.add(10, IndexProvider::PDZ, {1, 1});
+    idx.add(15, IndexProvider::PDZ, {1, 2});
+  }
+
+  {
+    IndexProvider idx{m_index_bin, true};
+    BOOST_CHECK_EQUAL(idx.size(), 4);
+    BOOST_CHECK_EQUAL(idx.get(15, IndexProvider::SED).offset, 2);
+    BOOST_CHECK_EQUAL(idx.findId(IndexProvider::PDZ, {1, 1}, 0), 10);
+    BOOST_CHECK_EQUAL(idx.findId(IndexProvider::PDZ, {1, 2}, 0), 15);
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(StaleSortedIds_test, IndexProvider_Fixture) {
+  auto sorted_path = m_top_dir.path() / "index_sorted.npy";
+  auto stale_path  = m_top_dir.path() / "stale_sorted.npy";
+
+  {
+    IndexProvider idx{m_index_bin};
+    idx.add(30, IndexProvider::SED, {1, 3});
+    idx.add(10, IndexProvider::SED, {2, 1});
+    idx.add(20, IndexProvider::SED, {1, 1});
+    idx.sort(IndexProvider::SED);
+    boost::filesystem::copy_file(sorted_path, stale_path);
+
+    // Same number of rows, different order
+    idx.add(30, IndexProvider::PDZ, {1, 1});
+    idx.add(10, IndexProvider::PDZ, {1, 2});
+    idx.add(20, IndexProvider::PDZ, {1, 3});
+    idx.sort(IndexProvider::PDZ);
+  }
+  boost::filesystem::remove(sorted_path);
+  boost::filesystem::copy_file(stale_path, sorted_path);
+
+  // The stale permutation is ignored
+  {
+    IndexProvider idx{m_index_bin, true};
+    BOOST_CHECK_EQUAL(idx.get(10, IndexProvider::SED).file, 2);
+    BOOST_CHECK_EQUAL(idx.get(20, IndexProvider::PDZ).offset, 3);
+    BOOST_CHECK_EQUAL(idx.get(30, IndexProvider::SED).offset, 3);
+    BOOST_CHECK_EQUAL(idx.get(15, IndexProvider::SED).file, -1);
+  }
+  BOOST_CHECK_EQUAL(boost::filesystem::file_size(sorted_path), boost::filesystem::file_size(stale_path));
+
+  // And rebuilt on the next addition when the index is writable
+  {
+    IndexProvider idx{m_index_bin};
+    BOOST_CHECK_EQUAL(idx.get(10, IndexProvider::PDZ).offset, 2);
+    BOOST_CHECK_EQUAL(idx.get(20, IndexProvider::SED).offset, 1);
+    idx.add(40, IndexProvider::SED, {3, 1});
+  }
+  std::ifstream sorted_file{sorted_path.native(), std::ios::binary}, stale_file{stale_path.native(), std::ios::binary};
+  std::string   sorted_content{std::istreambuf_iterator<char>(sorted_file), {}};
+  std::string   stale_content{std::istreambuf_iterator<char>(stale_file), {}};
+  BOOST_CHECK(sorted_content != stale_content);
+
+  {
+    IndexProvider idx{m_index_bin, true};
+    BOOST_CHECK_EQUAL(idx.get(10, IndexProvider::SED).file, 2);
+    BOOST_CHECK_EQUAL(idx.get(30, IndexProvider::PDZ).offset, 1);
+    BOOST_CHECK_EQUAL(idx.get(40, IndexProvider::SED).file, 3);
+  }
+}
+
+//-----------------------------------------------------------------------------
+
 BOOST_AUTO_TEST_SUITE_END()
 
 //-----------------------------------------------------------------------------
@@ -22,6 +22,7 @@
  */
 
 #include "PhzReferenceSample/PdzDataProvider.h"
+#include "PhzReferenceSample/CompactDataFile.h"
 #include <ElementsKernel/Exception.h>
 #include <ElementsKernel/Temporary.h>
 #include <boost/test/unit_test.hpp>
@@ -29,7 +30,9 @@
 #include "AllClose.h"
 
 using Elements::TempDir;
+using Euclid::ReferenceSample::CompactDataFile;
 using Euclid::ReferenceSample::PdzDataProvider;
+using Euclid::ReferenceSample::StorageMode;
 using Euclid::XYDataset::XYDataset;
 
 //-----------------------------------------------------------------------------
@@ -156,4 +159,49 @@ BOOST_FIXTURE_TEST_CASE(open_and_close_readonly, PdzDataProvider_Fixture) {
 
 //-----------------------------------------------------------------------------
 
+BOOST_FIXTURE_TEST_CASE(compact_add_set_and_read, PdzDataProvider_Fixture) {
+  XYDataset other{{{0, 0.5}, {1, 0.25}, {2, 0.125}, {3, 0}}};
+
+  PdzDataProvider pdz_provider{m_pdz_bin, PdzDataProvider::DEFAULT_MAX_SIZE, false, StorageMode::FLOAT16};
+  BOOST_CHECK_EQUAL(pdz_provider.diskSize(), 0);
+
+  auto offset1 = pdz_provider.addPdz(pdz);
+  auto offset2 = pdz_provider.addPdz(pdz);
+  BOOST_CHECK(CompactDataFile::isCompact(m_pdz_bin));
+  BOOST_CHECK_EQUAL(offset1, 1);
+  BOOST_CHECK_EQUAL(pdz_provider.length(), 2);
+  BOOST_CHECK_NE(pdz_provider.diskSize(), 0);
+
+  pdz_provider.setPdz(offset2, other);
+  BOOST_CHECK(checkAllClose(pdz_provider.readPdz(offset1), pdz, 1e-3));
+  BOOST_CHECK(checkAllClose(pdz_provider.readPdz(offset2), other, 1e-3));
+
+  auto view = pdz_provider.readPdzView(offset2);
+  BOOST_CHECK_EQUAL(view.size(), 4);
+  BOOST_CHECK_EQUAL(view.bin(3), 3.f);
+  BOOST_CHECK_EQUAL(view.value(1), 0.25f);
+
+  XYDataset pdz_different{{{2, 0}, {4, 4}, {8, 3}, {10, 1}}};
+  BOOST_CHECK_THROW(pdz_provider.addPdz(pdz_different), Elements::Exception);
+  BOOST_CHECK_THROW(pdz_provider.readPdz(3), Elements::Exception);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(compact_reopen_readonly, PdzDataProvider_Fixture) {
+  int64_t offset;
+
+  {
+    PdzDataProvider pdz_provider{m_pdz_bin, PdzDataProvider::DEFAULT_MAX_SIZE, false, StorageMode::FLOAT16};
+    offset = pdz_provider.addPdz(pdz);
+  }
+
+  PdzDataProvider pdz_provider(m_pdz_bin, PdzDataProvider::DEFAULT_MAX_SIZE, true);
+  BOOST_CHECK_EQUAL(pdz_provider.length(), 1);
+  BOOST_CHECK(checkAllClose(pdz_provider.readPdz(offset), pdz, 1e-3));
+  BOOST_CHECK_THROW(pdz_provider.addPdz(pdz), Elements::Exception);
+}
+
+//-----------------------------------------------------------------------------
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -26,7 +26,11 @@
 #include <boost/test/unit_test.hpp>
 
 #include "AllClose.h"
+#include "PhzReferenceSample/CompactDataFile.h"
 #include "PhzReferenceSample/ReferenceSample.h"
+#include "PhzUtils/Multithreading.h"
+#include <fstream>
+#include <future>
 
 using namespace Euclid::ReferenceSample;
 using Elements::TempPath;
@@ -271,4 +275,237 @@ BOOST_FIXTURE_TEST_CASE(test_read_only, ReferenceSampleOnDisk_Fixture) {
 
 //-----------------------------------------------------------------------------
 
+BOOST_FIXTURE_TEST_CASE(test_getSedView, ReferenceSample_Fixture) {
+  BOOST_CHECK(!m_ref.getSedDataView(1000));
+
+  auto view = m_ref.getSedDataView(11).get();
+  BOOST_CHECK_EQUAL(view.size(), m_sed[1].size());
+  size_t i = 0;
+  for (auto& point : m_sed[1]) {
+    BOOST_CHECK_CLOSE(view.wavelength(i), point.first, 1e-4);
+    BOOST_CHECK_CLOSE(view.flux(i), point.second, 1e-4);
+    ++i;
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(test_getPdzView, ReferenceSample_Fixture) {
+  BOOST_CHECK(!m_ref.getPdzDataView(1000));
+
+  auto view = m_ref.getPdzDataView(11).get();
+  auto pdz  = m_ref.getPdzData(11).get();
+  BOOST_CHECK_EQUAL(view.size(), pdz.size());
+  size_t i = 0;
+  for (auto& point : pdz) {
+    BOOST_CHECK_EQUAL(view.bin(i), point.first);
+    BOOST_CHECK_EQUAL(view.value(i), point.second);
+    ++i;
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(test_getDataViews_batch, ReferenceSampleOnDisk_Fixture) {
+  ReferenceSample ref(m_top_dir.path(), ReferenceSample::DEFAULT_MAX_SIZE, true);
+
+  // Given in reverse order, with a missing ID
+  auto sed_views = ref.getSedDataViews({12, 1000, 11, 10});
+  auto pdz_views = ref.getPdzDataViews({12, 1000, 11, 10});
+
+  // The views follow the order in the files
+  BOOST_CHECK_EQUAL(sed_views.size(), 3);
+  BOOST_CHECK_EQUAL(pdz_views.size(), 3);
+  for (size_t i = 0; i < m_obj_ids.size(); ++i) {
+    BOOST_CHECK_EQUAL(sed_views[i].first, m_obj_ids[i]);
+    BOOST_CHECK_EQUAL(pdz_views[i].first, m_obj_ids[i]);
+    BOOST_CHECK_CLOSE(sed_views[i].second.flux(0), m_sed[i].begin()->second, 1e-4);
+    BOOST_CHECK_EQUAL(pdz_views[i].second.value(0), ref.getPdzData(m_obj_ids[i])->begin()->second);
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(test_optimize_storage_mode, ReferenceSample_Fixture) {
+  std::vector<XYDataset> pdzs{};
+  for (auto id : m_obj_ids) {
+    pdzs.emplace_back(m_ref.getPdzData(id).get());
+  }
+
+  m_ref.optimize(StorageMode::FLOAT16);
+  BOOST_CHECK(CompactDataFile::isCompact(m_top_dir.path() / "sed_data_1.npy"));
+  BOOST_CHECK(CompactDataFile::isCompact(m_top_dir.path() / "pdz_data_1.npy"));
+  BOOST_CHECK(!boost::filesystem::exists(m_top_dir.path() / "optimize.tmp"));
+  for (size_t i = 0; i < m_obj_ids.size(); ++i) {
+    BOOST_CHECK(checkAllClose(m_ref.getSedData(m_obj_ids[i]).get(), m_sed[i], 1e-3));
+    BOOST_CHECK(checkAllClose(m_ref.getPdzData(m_obj_ids[i]).get(), pdzs[i], 1e-3));
+    BOOST_CHECK_CLOSE(m_ref.getSedDataView(m_obj_ids[i])->flux(2), m_sed[i].back().second, 0.1);
+  }
+
+  // New data goes to the compact files as well
+  m_ref.addSedData(20, m_sed[0]);
+  BOOST_CHECK(checkAllClose(m_ref.getSedData(20).get(), m_sed[0], 1e-3));
+
+  // And it can be read from a new instance
+  ReferenceSample ref(m_top_dir.path(), ReferenceSample::DEFAULT_MAX_SIZE, true);
+  BOOST_CHECK(checkAllClose(ref.getPdzData(m_obj_ids[1]).get(), pdzs[1], 1e-3));
+
+  // Single precision with a shared axis table
+  m_ref.optimize(StorageMode::FLOAT32_SHARED_AXIS);
+  BOOST_CHECK(CompactDataFile::isCompact(m_top_dir.path() / "sed_data_1.npy"));
+  BOOST_CHECK(CompactDataFile{m_top_dir.path() / "sed_data_1.npy", ReferenceSample::DEFAULT_MAX_SIZE, true}
+                  .storageMode() == StorageMode::FLOAT32_SHARED_AXIS);
+  for (size_t i = 0; i < m_obj_ids.size(); ++i) {
+    BOOST_CHECK(checkAllClose(m_ref.getSedData(m_obj_ids[i]).get(), m_sed[i], 1e-3));
+    BOOST_CHECK(checkAllClose(m_ref.getPdzData(m_obj_ids[i]).get(), pdzs[i], 1e-3));
+  }
+
+  // Back to single precision
+  m_ref.optimize(StorageMode::FLOAT32);
+  BOOST_CHECK(!CompactDataFile::isCompact(m_top_dir.path() / "sed_data_1.npy"));
+  for (size_t i = 0; i < m_obj_ids.size(); ++i) {
+    BOOST_CHECK(checkAllClose(m_ref.getSedData(m_obj_ids[i]).get(), m_sed[i], 1e-3));
+    BOOST_CHECK(checkAllClose(m_ref.getPdzData(m_obj_ids[i]).get(), pdzs[i], 1e-3));
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(test_optimize_interrupted, ReferenceSampleOnDisk_Fixture) {
+  // An optimization that crashed after writing the new index, but before replacing the old files
+  auto work_path = m_top_dir.path() / "optimize.tmp";
+  {
+    auto optimized = ReferenceSample::create(work_path, true, ReferenceSample::DEFAULT_MAX_SIZE,
+                                             StorageMode::FLOAT32_SHARED_AXIS);
+    optimized.addSedData(10, m_sed[1]);
+    optimized.addSedData(30, m_sed[2]);
+  }
+  std::ofstream{(work_path / "committed").native()}.close();
+
+  BOOST_CHECK_THROW(ReferenceSample(m_top_dir.path(), ReferenceSample::DEFAULT_MAX_SIZE, true), Elements::Exception);
+
+  // The replacement is completed when the reference sample is open
+  ReferenceSample ref(m_top_dir.path());
+  BOOST_CHECK(!boost::filesystem::exists(work_path));
+  BOOST_CHECK(!boost::filesystem::exists(m_top_dir.path() / "pdz_data_1.npy"));
+  BOOST_CHECK(CompactDataFile::isCompact(m_top_dir.path() / "sed_data_1.npy"));
+  BOOST_CHECK_EQUAL(ref.size(), 2);
+  BOOST_CHECK(checkAllClose(ref.getSedData(10).get(), m_sed[1]));
+  BOOST_CHECK(checkAllClose(ref.getSedData(30).get(), m_sed[2]));
+  BOOST_CHECK(!ref.getSedData(11));
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(test_optimize_parallel, ReferenceSamplePath_Fixture) {
+  // Small files, so each thread writes several of them
+  auto                   ref = ReferenceSample::create(m_top_dir.path(), true, 256);
+  std::vector<XYDataset> pdzs{};
+  for (int64_t id = 100; id < 140; ++id) {
+    ref.addSedData(id, XYDataset{{{1, double(id)}, {2, 2. * id}}});
+    ref.addPdzData(id, XYDataset{{{0, 1.}, {1, double(id)}}});
+    pdzs.emplace_back(ref.getPdzData(id).get());
+  }
+
+  auto thread_number                  = Euclid::PhzUtils::getThreadNumber().load();
+  Euclid::PhzUtils::getThreadNumber() = 3;
+  ref.optimize(StorageMode::FLOAT32);
+  Euclid::PhzUtils::getThreadNumber() = thread_number;
+
+  BOOST_CHECK_EQUAL(ref.size(), 40);
+  BOOST_CHECK(!boost::filesystem::exists(m_top_dir.path() / "optimize.tmp"));
+  for (int64_t id = 100; id < 140; ++id) {
+    BOOST_CHECK(checkAllClose(ref.getSedData(id).get(), XYDataset{{{1, double(id)}, {2, 2. * id}}}));
+    BOOST_CHECK(checkAllClose(ref.getPdzData(id).get(), pdzs[id - 100]));
+  }
+
+  // The files written by the different threads keep the index order
+  auto views = ref.getSedDataViews(ref.getIds());
+  BOOST_REQUIRE_EQUAL(views.size(), 40);
+  for (size_t i = 0; i < views.size(); ++i) {
+    BOOST_CHECK_EQUAL(views[i].first, 100 + int64_t(i));
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(test_partitions, ReferenceSample_Fixture) {
+  // Each partition is filled by its own thread
+  std::vector<std::future<void>> futures;
+  for (size_t partition = 0; partition < 4; ++partition) {
+    futures.emplace_back(std::async(std::launch::async, [this, partition]() {
+      auto ref = ReferenceSample::createPartition(m_top_dir.path(), partition);
+      for (int64_t id = 100 * (partition + 1); id < 100 * (partition + 1) + 10; ++id) {
+        ref.addSedData(id, m_sed[id % 3]);
+        ref.addPdzData(id, m_pdz[id % 2]);
+      }
+    }));
+  }
+  for (auto& future : futures) {
+    future.get();
+  }
+  BOOST_CHECK_THROW(ReferenceSample::createPartition(m_top_dir.path(), 0), Elements::Exception);
+
+  m_ref.mergePartitions();
+  BOOST_CHECK(!boost::filesystem::exists(m_top_dir.path() / "partition_0"));
+  BOOST_CHECK_EQUAL(m_ref.size(), 43);
+  for (size_t partition = 0; partition < 4; ++partition) {
+    for (int64_t id = 100 * (partition + 1); id < 100 * (partition + 1) + 10; ++id) {
+      BOOST_CHECK(checkAllClose(m_ref.getSedData(id).get(), m_sed[id % 3]));
+      BOOST_CHECK(checkAllClose(m_ref.getPdzData(id).get(), m_pdz[id % 2]));
+    }
+  }
+  BOOST_CHECK(checkAllClose(m_ref.getSedData(12).get(), m_sed[2]));
+
+  // The merged sample can be written and optimized
+  m_ref.addSedData(1000, m_sed[1]);
+  m_ref.optimize(StorageMode::FLOAT32);
+  BOOST_CHECK(checkAllClose(m_ref.getSedData(1000).get(), m_sed[1]));
+  BOOST_CHECK(checkAllClose(m_ref.getSedData(405).get(), m_sed[0]));
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(test_partitions_resumed, ReferenceSample_Fixture) {
+  // Small files, so the partition has several of them
+  {
+    auto ref = ReferenceSample::createPartition(m_top_dir.path(), 0, 256);
+    for (int64_t id = 100; id < 110; ++id) {
+      ref.addSedData(id, m_sed[id % 3]);
+      ref.addPdzData(id, m_pdz[id % 2]);
+    }
+  }
+
+  // A merge interrupted after moving the first SED file
+  auto partition_path = m_top_dir.path() / "partition_0";
+  BOOST_REQUIRE(boost::filesystem::exists(partition_path / "sed_data_2.npy"));
+  std::ofstream{(partition_path / "merging").native()} << "1 1" << std::endl;
+  boost::filesystem::rename(partition_path / "sed_data_1.npy", m_top_dir.path() / "sed_data_2.npy");
+
+  m_ref.mergePartitions();
+  BOOST_CHECK(!boost::filesystem::exists(partition_path));
+  BOOST_CHECK_EQUAL(m_ref.size(), 13);
+  for (int64_t id = 100; id < 110; ++id) {
+    BOOST_CHECK(checkAllClose(m_ref.getSedData(id).get(), m_sed[id % 3]));
+    BOOST_CHECK(checkAllClose(m_ref.getPdzData(id).get(), m_pdz[id % 2]));
+  }
+  BOOST_CHECK(checkAllClose(m_ref.getSedData(12).get(), m_sed[2]));
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(test_partitions_duplicated, ReferenceSample_Fixture) {
+  {
+    auto ref = ReferenceSample::createPartition(m_top_dir.path(), 1);
+    ref.addSedData(10, m_sed[0]);
+  }
+  BOOST_CHECK_THROW(m_ref.mergePartitions(), Elements::Exception);
+
+  // The failing partition is left untouched
+  BOOST_CHECK(boost::filesystem::exists(m_top_dir.path() / "partition_1" / "sed_data_1.npy"));
+  BOOST_CHECK_EQUAL(m_ref.size(), 3);
+}
+
+//-----------------------------------------------------------------------------
+
 BOOST_AUTO_TEST_SUITE_END()
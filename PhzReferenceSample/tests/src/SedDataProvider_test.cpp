@@ -26,10 +26,13 @@
 #include <boost/test/unit_test.hpp>
 
 #include "AllClose.h"
+#include "PhzReferenceSample/CompactDataFile.h"
 #include "PhzReferenceSample/SedDataProvider.h"
 
 using Elements::TempDir;
+using Euclid::ReferenceSample::CompactDataFile;
 using Euclid::ReferenceSample::SedDataProvider;
+using Euclid::ReferenceSample::StorageMode;
 using Euclid::XYDataset::XYDataset;
 
 //-----------------------------------------------------------------------------
@@ -152,4 +155,83 @@ BOOST_FIXTURE_TEST_CASE(open_and_close_readonly, SedDataProvider_Fixture) {
 
 //-----------------------------------------------------------------------------
 
+BOOST_FIXTURE_TEST_CASE(compact_add_and_read, SedDataProvider_Fixture) {
+  XYDataset other{{{0, 1e-12}, {1, 2e-12}, {2, 5e-13}, {3, 0}}};
+  XYDataset shifted{{{10, 0}, {11, 4}, {12, 3}, {13, 1}}};
+
+  SedDataProvider sed_provider{m_sed_bin, SedDataProvider::DEFAULT_MAX_SIZE, false, StorageMode::FLOAT16};
+  auto            offset1 = sed_provider.addSed(sed);
+  auto            offset2 = sed_provider.addSed(other);
+  auto            offset3 = sed_provider.addSed(shifted);
+  BOOST_CHECK(CompactDataFile::isCompact(m_sed_bin));
+  BOOST_CHECK_EQUAL(sed_provider.length(), 3);
+
+  // The values are stored relative to the biggest one of each SED, so small fluxes keep their precision
+  BOOST_CHECK(checkAllClose(sed_provider.readSed(offset1), sed, 1e-3));
+  BOOST_CHECK(checkAllClose(sed_provider.readSed(offset2), other, 1e-3));
+  BOOST_CHECK(checkAllClose(sed_provider.readSed(offset3), shifted, 1e-3));
+
+  auto view = sed_provider.readSedView(offset3);
+  BOOST_CHECK_EQUAL(view.size(), 4);
+  BOOST_CHECK_EQUAL(view.wavelength(0), 10.f);
+  BOOST_CHECK_CLOSE(view.flux(1), 4.f, 1e-1);
+
+  // The first two SEDs share their wavelengths
+  CompactDataFile compact{m_sed_bin, SedDataProvider::DEFAULT_MAX_SIZE, true};
+  BOOST_CHECK_EQUAL(compact.knots(), 4);
+  BOOST_CHECK_EQUAL(compact.axis(offset1), compact.axis(offset2));
+  BOOST_CHECK_NE(compact.axis(offset1), compact.axis(offset3));
+
+  BOOST_CHECK_THROW(sed_provider.addSed(XYDataset{{{0, 0}, {1, 1}}}), Elements::Exception);
+  BOOST_CHECK_THROW(sed_provider.readSed(0), Elements::Exception);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(compact_float32_add_and_read, SedDataProvider_Fixture) {
+  XYDataset other{{{0, 1e-12}, {1, 2e-12}, {2, 5e-13}, {3, 0}}};
+
+  SedDataProvider sed_provider{m_sed_bin, SedDataProvider::DEFAULT_MAX_SIZE, false, StorageMode::FLOAT32_SHARED_AXIS};
+  auto            offset1 = sed_provider.addSed(sed);
+  auto            offset2 = sed_provider.addSed(other);
+  BOOST_CHECK(CompactDataFile::isCompact(m_sed_bin));
+
+  // The values keep their single precision
+  BOOST_CHECK(checkAllClose(sed_provider.readSed(offset1), sed));
+  BOOST_CHECK(checkAllClose(sed_provider.readSed(offset2), other));
+
+  auto view = sed_provider.readSedView(offset2);
+  BOOST_CHECK_EQUAL(view.size(), 4);
+  BOOST_CHECK_EQUAL(view.wavelength(1), 1.f);
+  BOOST_CHECK_EQUAL(view.flux(1), 2e-12f);
+
+  // The layout is detected when the file is open again
+  CompactDataFile compact{m_sed_bin, SedDataProvider::DEFAULT_MAX_SIZE, true};
+  BOOST_CHECK(compact.storageMode() == StorageMode::FLOAT32_SHARED_AXIS);
+  BOOST_CHECK_EQUAL(compact.axis(offset1), compact.axis(offset2));
+  BOOST_CHECK_THROW(compact.halfValues(offset1), Elements::Exception);
+}
+
+//-----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_CASE(compact_reopen, SedDataProvider_Fixture) {
+  int64_t offset;
+
+  {
+    SedDataProvider sed_provider{m_sed_bin, SedDataProvider::DEFAULT_MAX_SIZE, false, StorageMode::FLOAT16};
+    offset = sed_provider.addSed(sed);
+  }
+
+  // The layout of an existing file is detected, whatever the requested storage mode
+  SedDataProvider sed_provider{m_sed_bin};
+  BOOST_CHECK_EQUAL(sed_provider.length(), 1);
+  BOOST_CHECK(checkAllClose(sed_provider.readSed(offset), sed, 1e-3));
+
+  auto offset2 = sed_provider.addSed(sed);
+  BOOST_CHECK_EQUAL(offset2, offset + 1);
+  BOOST_CHECK(CompactDataFile::isCompact(m_sed_bin));
+}
+
+//-----------------------------------------------------------------------------
+
 BOOST_AUTO_TEST_SUITE_END()